@@ -0,0 +1,270 @@
+#!/usr/bin/env python
+#############################################################################
+#
+#   Copyright (C) 2015 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+#############################################################################
+
+"""
+px_generate_mag_tables.py
+Generates the compressed earth magnetic field grid used by
+src/lib/geo_lookup/geo_mag_declination.c
+
+The field is evaluated from the World Magnetic Model at sea level on the
+WGS-84 ellipsoid. Tools/WMM2015.COF is the coefficient file of the official
+WMM2015 release (degree and order 12, epoch 2015.0, with secular variation).
+Before anything is printed the model is checked against the test values
+published with WMM2015, so a damaged or mistyped coefficient file cannot
+silently end up in the tables.
+
+Usage:
+    px_generate_mag_tables.py [--cof WMM.COF] [--year 2016.0] > geo_magnetic_tables.h
+    px_generate_mag_tables.py [--cof WMM.COF] [--year 2016.0] --point LAT LON [--height KM]
+"""
+from __future__ import print_function
+
+import argparse
+import math
+import os
+import sys
+
+# Grid layout, keep in sync with geo_mag_declination.c
+SAMPLING_RES_LAT = 5
+SAMPLING_RES_LON = 10
+SAMPLING_MIN_LAT = -90
+SAMPLING_MAX_LAT = 90
+SAMPLING_MIN_LON = -180
+SAMPLING_MAX_LON = 180
+
+# Fixed point scaling of the stored values
+ANGLE_LSB_DEG = 0.01
+STRENGTH_LSB_NT = 10.0
+
+# Geomagnetic reference radius in km
+REFERENCE_RADIUS = 6371.2
+
+DEFAULT_COF = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'WMM2015.COF')
+
+# Test values published in the WMM2015 technical report for
+# epoch 2015.0: lat [deg], lon [deg], height above WGS-84 [km],
+# X, Y, Z [nT], declination, inclination [deg]
+WMM2015_TEST_VALUES = [
+    (80.0, 0.0, 0.0, 6627.1, -445.9, 54432.3, -3.85, 83.04),
+    (0.0, 120.0, 0.0, 39518.2, 392.9, -11252.4, 0.57, -15.89),
+    (-80.0, 240.0, 0.0, 5797.3, 15761.1, -52919.1, 69.81, -72.39),
+    (80.0, 0.0, 100.0, 6314.3, -471.6, 52269.8, -4.27, 83.09),
+    (0.0, 120.0, 100.0, 37535.6, 364.4, -10773.4, 0.56, -16.01),
+    (-80.0, 240.0, 100.0, 5613.1, 14791.5, -50378.6, 69.22, -72.57),
+]
+WMM2015_TEST_EPOCH = 2015.0
+
+
+def read_cof(filename, year):
+    """Read a WMM.COF file and propagate the coefficients to the given year"""
+    coefficients = []
+    with open(filename) as f:
+        epoch = float(f.readline().split()[0])
+
+        for line in f:
+            fields = line.split()
+
+            if len(fields) < 6 or fields[0].startswith('9999'):
+                break
+
+            n, m = int(fields[0]), int(fields[1])
+            g, h, gdot, hdot = [float(v) for v in fields[2:6]]
+            dt = (year - epoch) if year is not None else 0.0
+            coefficients.append((n, m, g + gdot * dt, h + hdot * dt))
+
+    return epoch if year is None else year, coefficients
+
+
+def legendre(nmax, x):
+    """Associated Legendre functions P[n][m](x) without Condon-Shortley phase"""
+    s = math.sqrt(max(0.0, 1.0 - x * x))
+    p = {}
+
+    for m in range(nmax + 1):
+        pmm = 1.0
+
+        for k in range(1, m + 1):
+            pmm *= (2 * k - 1) * s
+
+        p[(m, m)] = pmm
+
+        if m + 1 <= nmax:
+            p[(m + 1, m)] = x * (2 * m + 1) * pmm
+
+        for n in range(m + 2, nmax + 1):
+            p[(n, m)] = ((2 * n - 1) * x * p[(n - 1, m)] - (n + m - 1) * p[(n - 2, m)]) / (n - m)
+
+    return p
+
+
+def potential(coefficients, r, theta, lon):
+    """Scalar potential with Schmidt semi-normalized coefficients"""
+    nmax = max(c[0] for c in coefficients)
+    p = legendre(nmax, math.cos(theta))
+    v = 0.0
+
+    for n, m, g, h in coefficients:
+        schmidt = 1.0 if m == 0 else math.sqrt(2.0 * math.factorial(n - m) / math.factorial(n + m))
+        v += (REFERENCE_RADIUS / r) ** (n + 1) * (g * math.cos(m * lon) + h * math.sin(m * lon)) * schmidt * p[(n, m)]
+
+    return REFERENCE_RADIUS * v
+
+
+def components(coefficients, lat, lon, height=0.0):
+    """North, east and down field components [nT] at a height [km] above WGS-84"""
+    a = 6378.137
+    f = 1.0 / 298.257223563
+    e2 = f * (2.0 - f)
+
+    phi = math.radians(lat)
+    lam = math.radians(lon)
+
+    # geodetic to geocentric
+    rc = a / math.sqrt(1.0 - e2 * math.sin(phi) ** 2)
+    p = (rc + height) * math.cos(phi)
+    z = (rc * (1.0 - e2) + height) * math.sin(phi)
+    r = math.hypot(p, z)
+    phic = math.asin(z / r)
+    theta = min(max(math.pi / 2 - phic, 1e-6), math.pi - 1e-6)
+
+    # field components from the numerical gradient of the potential
+    dr = 1e-3
+    dt = 1e-6
+    br = -(potential(coefficients, r + dr, theta, lam) - potential(coefficients, r - dr, theta, lam)) / (2 * dr)
+    bt = -(potential(coefficients, r, theta + dt, lam) - potential(coefficients, r, theta - dt, lam)) / (2 * dt) / r
+    bl = -(potential(coefficients, r, theta, lam + dt) - potential(coefficients, r, theta, lam - dt)) / (2 * dt) / (
+        r * math.sin(theta))
+
+    # geocentric north / east / down back to geodetic
+    psi = phic - phi
+    x = -bt * math.cos(psi) + br * math.sin(psi)
+    y = bl
+    z = -bt * math.sin(psi) - br * math.cos(psi)
+
+    return x, y, z
+
+
+def field(coefficients, lat, lon, height=0.0):
+    """Declination [deg], inclination [deg] and total intensity [nT]"""
+    x, y, z = components(coefficients, lat, lon, height)
+    h = math.hypot(x, y)
+
+    return math.degrees(math.atan2(y, x)), math.degrees(math.atan2(z, h)), math.sqrt(x * x + y * y + z * z)
+
+
+def check_test_values(filename):
+    """Compare the model against the published WMM2015 test values, return the failures"""
+    _, coefficients = read_cof(filename, WMM2015_TEST_EPOCH)
+    failures = []
+
+    for lat, lon, height, x, y, z, d, i in WMM2015_TEST_VALUES:
+        cx, cy, cz = components(coefficients, lat, lon, height)
+        cd, ci, _ = field(coefficients, lat, lon, height)
+
+        # the published values are rounded to 0.1 nT and 0.01 deg
+        if (abs(cx - x) > 0.1 or abs(cy - y) > 0.1 or abs(cz - z) > 0.1 or
+                abs(cd - d) > 0.01 or abs(ci - i) > 0.01):
+            failures.append('lat %g lon %g height %g km: X %.1f Y %.1f Z %.1f D %.2f I %.2f, expected '
+                            'X %.1f Y %.1f Z %.1f D %.2f I %.2f' % (lat, lon, height, cx, cy, cz, cd, ci,
+                                                                     x, y, z, d, i))
+
+    return failures
+
+
+
+def print_table(name, ctype, rows, comment):
+    print('/* %s */' % comment)
+    print('static const %s %s[%u][%u] = {' % (ctype, name, len(rows), len(rows[0])))
+
+    for row in rows:
+        print('\t{ %s },' % ', '.join('%d' % v for v in row))
+
+    print('};')
+    print('')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate the geo_lookup magnetic field tables')
+    parser.add_argument('--cof', default=DEFAULT_COF, help='WMM.COF coefficient file, default: %(default)s')
+    parser.add_argument('--year', type=float, help='decimal year to propagate the coefficients to, default: epoch')
+    parser.add_argument('--point', type=float, nargs=2, metavar=('LAT', 'LON'),
+                        help='print the field at a single point instead of the tables')
+    parser.add_argument('--height', type=float, default=0.0, help='height above WGS-84 in km for --point')
+    args = parser.parse_args()
+
+    # only the WMM2015 release comes with test values known to this script
+    if os.path.basename(args.cof) == 'WMM2015.COF':
+        failures = check_test_values(args.cof)
+
+        if failures:
+            for failure in failures:
+                print('WMM2015 test value mismatch, %s' % failure, file=sys.stderr)
+
+            sys.exit(1)
+
+    epoch, coefficients = read_cof(args.cof, args.year)
+
+    if args.point:
+        d, i, f = field(coefficients, args.point[0], args.point[1], args.height)
+        print('declination %.2f deg, inclination %.2f deg, intensity %.0f nT' % (d, i, f))
+        return
+
+    lats = range(SAMPLING_MIN_LAT, SAMPLING_MAX_LAT + 1, SAMPLING_RES_LAT)
+    lons = range(SAMPLING_MIN_LON, SAMPLING_MAX_LON + 1, SAMPLING_RES_LON)
+
+    declination = []
+    inclination = []
+    strength = []
+
+    for lat in lats:
+        values = [field(coefficients, lat, lon) for lon in lons]
+        declination.append([int(round(v[0] / ANGLE_LSB_DEG)) for v in values])
+        inclination.append([int(round(v[1] / ANGLE_LSB_DEG)) for v in values])
+        strength.append([int(round(v[2] / STRENGTH_LSB_NT)) for v in values])
+
+    print('/* Auto-generated by Tools/px_generate_mag_tables.py, do not edit */')
+    print('/* Epoch %.1f, %s, %d x %d deg grid */' % (epoch, os.path.basename(args.cof),
+                                                     SAMPLING_RES_LAT, SAMPLING_RES_LON))
+    print('')
+    print('#pragma once')
+    print('')
+    print('#include <stdint.h>')
+    print('')
+    print_table('declination_table', 'int16_t', declination, 'declination in %g deg, positive east' % ANGLE_LSB_DEG)
+    print_table('inclination_table', 'int16_t', inclination, 'inclination in %g deg, positive down' % ANGLE_LSB_DEG)
+    print_table('strength_table', 'int16_t', strength, 'total intensity in %g nT' % STRENGTH_LSB_NT)
+
+
+if __name__ == '__main__':
+    main()
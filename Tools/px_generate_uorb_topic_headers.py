@@ -50,6 +50,7 @@ sys.path.append(px4_tools_dir + "/gencpp/src")
 
 try:
         import genmsg.template_tools
+        import genmsg.msg_loader
 except ImportError as e:
         print("python import error: ", e)
         print('''
@@ -75,11 +76,84 @@ __email__ = "thomasgubler@gmail.com"
 
 
 msg_template_map = {'msg.h.template': '@NAME@.h'}
+
+# C type and size of the builtin msg types, the alignment equals the size
+field_types = {'int8': ('int8_t', 1),
+               'int16': ('int16_t', 2),
+               'int32': ('int32_t', 4),
+               'int64': ('int64_t', 8),
+               'uint8': ('uint8_t', 1),
+               'uint16': ('uint16_t', 2),
+               'uint32': ('uint32_t', 4),
+               'uint64': ('uint64_t', 8),
+               'float32': ('float', 4),
+               'float64': ('double', 8),
+               'bool': ('bool', 1),
+               'char': ('char', 1)}
 srv_template_map = {}
 incl_default = ['std_msgs:./msg/std_msgs']
 package = 'px4'
 
 
+def get_struct_layout(spec, msg_context, search_path):
+        """
+        Returns the layout of the C struct generated from a message spec as
+        (fields, size, alignment, nested) assuming natural alignment.
+        fields is a list of (type, count, name) in struct order including
+        the padding, count is 0 for scalars. nested lists the specs of the
+        embedded messages.
+        """
+        fields = []
+        nested = []
+        offset = 0
+        alignment = 1
+
+        def pad_to(field_alignment):
+                padding = (field_alignment - offset % field_alignment) % field_alignment
+                if padding > 0:
+                        fields.append(('uint8_t', padding,
+                                       '_padding%d' % len([f for f in fields if f[2].startswith('_padding')])))
+                return padding
+
+        for field in spec.parsed_fields():
+                if field.is_header:
+                        continue
+
+                if field.is_builtin:
+                        (type_name, size) = field_types[field.base_type]
+                        field_alignment = size
+                else:
+                        nested_spec = genmsg.msg_loader.load_msg_by_type(msg_context, field.base_type, search_path)
+                        (_, size, field_alignment, _) = get_struct_layout(nested_spec, msg_context, search_path)
+                        type_name = nested_spec.short_name
+                        if type_name not in [n.short_name for n in nested]:
+                                nested.append(nested_spec)
+
+                offset += pad_to(field_alignment)
+                count = field.array_len if field.is_array else 0
+                fields.append((type_name, count, field.name))
+                offset += size * max(count, 1)
+                alignment = max(alignment, field_alignment)
+
+        # trailing padding up to the size of the struct
+        offset += pad_to(alignment)
+
+        return (fields, offset, alignment, nested)
+
+
+def get_orb_fields(spec, msg_context, search_path):
+        """
+        Returns the field layout string of a message, see orb_metadata::o_fields
+        """
+        (fields, _, _, nested) = get_struct_layout(spec, msg_context, search_path)
+        layout = ''.join('%s%s %s;' % (type_name, '[%d]' % count if count else '', name)
+                         for (type_name, count, name) in fields)
+        for nested_spec in nested:
+                layout += '\n%s:%s' % (nested_spec.short_name,
+                                       get_orb_fields(nested_spec, msg_context, search_path))
+        return layout
+
+
 def convert_file(filename, outputdir, templatedir, includepath):
         """
         Converts a single .msg file to a uorb header
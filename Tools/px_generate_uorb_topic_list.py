@@ -0,0 +1,94 @@
+#!/usr/bin/env python
+#############################################################################
+#
+#   Copyright (C) 2015 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+#############################################################################
+
+"""
+px_generate_uorb_topic_list.py
+Generates the table of all uORB topics defined from .msg files,
+see orb_get_topics() in uORB.h
+"""
+from __future__ import print_function
+import os
+import argparse
+
+# msgs that are only used nested in other topics, or whose topics are
+# defined by a module that is not part of every build
+excluded_msgs = ['actuator_controls', 'position_setpoint',
+                 'uavcan_parameter_request', 'uavcan_parameter_value']
+
+
+def generate_topic_list(msg_dir):
+        """
+        Returns the source of the topic table for the .msg files in msg_dir
+        """
+        topics = sorted(os.path.splitext(f)[0] for f in os.listdir(msg_dir)
+                        if f.endswith('.msg') and not f.startswith('.'))
+        topics = [t for t in topics if t not in excluded_msgs]
+
+        lines = ['/* Auto-generated by Tools/px_generate_uorb_topic_list.py */',
+                 '',
+                 '#include <uORB/uORB.h>']
+        lines += ['#include <uORB/topics/%s.h>' % t for t in topics]
+        lines += ['',
+                  'static const struct orb_metadata *const orb_topics[] = {']
+        lines += ['\tORB_ID(%s),' % t for t in topics]
+        lines += ['};',
+                  '',
+                  'const struct orb_metadata *const *orb_get_topics(size_t *count)',
+                  '{',
+                  '\t*count = sizeof(orb_topics) / sizeof(orb_topics[0]);',
+                  '\treturn orb_topics;',
+                  '}',
+                  '']
+        return '\n'.join(lines)
+
+
+if __name__ == "__main__":
+        parser = argparse.ArgumentParser(
+            description='Generate the table of uORB topics from msg files')
+        parser.add_argument('-d', dest='dir', required=True,
+                            help='directory with msg files')
+        parser.add_argument('-o', dest='output', required=True,
+                            help='output source file')
+        args = parser.parse_args()
+
+        source = generate_topic_list(args.dir)
+
+        # only touch the output if it changed, to avoid rebuilds
+        if os.path.isfile(args.output):
+                with open(args.output, 'r') as f:
+                        if f.read() == source:
+                                exit(0)
+
+        with open(args.output, 'w') as f:
+                f.write(source)
@@ -0,0 +1,163 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (C) 2015 PX4 Development Team. All rights reserved.
+
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+
+
+"""
+px_mixer_to_bin.py:
+Convert text mixer definitions (.mix) to the binary format loaded by
+MixerGroup::load_from_binary(), so no parsing is needed on the vehicle.
+"""
+
+from __future__ import print_function
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b"PXMB"
+VERSION = 1
+
+
+class MixerError(Exception):
+        pass
+
+
+def mixer_lines(text):
+        """Return the definition lines of a mixer file, as load_mixer_file() does"""
+        lines = []
+        for line in text.splitlines():
+                if len(line) < 2 or not line[0].isupper() or line[1] != ':':
+                        continue
+                lines.append(line)
+        return lines
+
+
+def parse_ints(line, tag, count):
+        fields = line.split()
+        if fields[0] != tag + ':' or len(fields) != count + 1:
+                raise MixerError("expected %d values in '%s'" % (count, line))
+        return [int(v) for v in fields[1:]]
+
+
+def convert(text):
+        """Convert the text of a mixer file, return the binary definition"""
+        lines = mixer_lines(text)
+        records = []
+        i = 0
+
+        while i < len(lines):
+                tag = lines[i][0]
+
+                if tag == 'Z':
+                        records.append(b'Z')
+                        i += 1
+
+                elif tag == 'M':
+                        inputs = parse_ints(lines[i], 'M', 1)[0]
+                        if inputs > 255 or i + 1 + inputs >= len(lines):
+                                raise MixerError("bad simple mixer '%s'" % lines[i])
+                        record = struct.pack('<cB', b'M', inputs)
+                        record += struct.pack('<5i', *parse_ints(lines[i + 1], 'O', 5))
+                        for line in lines[i + 2:i + 2 + inputs]:
+                                s = parse_ints(line, 'S', 7)
+                                record += struct.pack('<BB5i', *s)
+                        records.append(record)
+                        i += 2 + inputs
+
+                elif tag == 'R':
+                        fields = lines[i].split()
+                        if len(fields) != 6 or len(fields[1]) > 7:
+                                raise MixerError("bad multirotor mixer '%s'" % lines[i])
+                        record = struct.pack('<c8s', b'R', fields[1].encode('ascii'))
+                        record += struct.pack('<4i', *[int(v) for v in fields[2:]])
+                        records.append(record)
+                        i += 1
+
+                else:
+                        # stray O: or S: lines are ignored by the text loader as well
+                        i += 1
+
+        if not records:
+                raise MixerError("no mixers found")
+
+        header = MAGIC + struct.pack('<BBH', VERSION, 0, len(records))
+        return header + b''.join(records)
+
+
+def convert_file(input, output):
+        """Convert a text mixer file, return False on error"""
+        with open(input, "r") as f:
+                text = f.read()
+
+        try:
+                blob = convert(text)
+        except (MixerError, ValueError, struct.error) as e:
+                print("%s: %s" % (input, e), file=sys.stderr)
+                return False
+
+        with open(output, "wb") as f:
+                f.write(blob)
+
+        return True
+
+
+def main():
+
+        # Parse commandline arguments
+        parser = argparse.ArgumentParser(description="Convert text mixer files to binary mixer files.")
+        parser.add_argument('input', nargs='?', help="Text mixer file (.mix).")
+        parser.add_argument('output', nargs='?', help="Binary mixer file to write.")
+        parser.add_argument('--folder', action="store",
+                            help="Write a .mixb file next to each .mix file in this folder.")
+        args = parser.parse_args()
+
+        if args.folder:
+                ok = True
+                for (root, dirs, files) in os.walk(args.folder):
+                        for file in files:
+                                if file.endswith(".mix"):
+                                        input = os.path.join(root, file)
+                                        ok = convert_file(input, input + "b") and ok
+                sys.exit(0 if ok else 1)
+
+        if not args.input or not args.output:
+                parser.error("an input and output file or --folder is required")
+
+        if not convert_file(args.input, args.output):
+                sys.exit(1)
+
+
+if __name__ == '__main__':
+        main()
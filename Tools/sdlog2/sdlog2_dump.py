@@ -21,7 +21,7 @@ Usage: python sdlog2_dump.py <log.bin> [-v] [-e] [-d delimiter] [-n null] [-m MS
 __author__  = "Anton Babushkin"
 __version__ = "1.2"
 
-import struct, sys
+import re, struct, sys
 
 if sys.hexversion >= 0x030000F0:
     runningPython3 = True
@@ -59,7 +59,27 @@ class SDLog2Parser:
         "M": ("b", None),
         "q": ("q", None),
         "Q": ("Q", None),
+        # length of the variable length data following the message
+        "V": ("H", None),
     }
+    # types of the generic topic field layouts, see orb_metadata::o_fields
+    FIELD_TO_STRUCT = {
+        "int8_t": "b",
+        "uint8_t": "B",
+        "bool": "?",
+        "char": "c",
+        "int16_t": "h",
+        "uint16_t": "H",
+        "int32_t": "i",
+        "uint32_t": "I",
+        "float": "f",
+        "int64_t": "q",
+        "uint64_t": "Q",
+        "double": "d",
+    }
+    MAX_NESTING_DEPTH = 4
+    # messages of the generic topic logging, decoded into the topic messages
+    GENERIC_MSGS = ("TOPF", "TOPD")
     __csv_delim = ","
     __csv_null = ""
     __msg_filter = []
@@ -76,6 +96,7 @@ class SDLog2Parser:
         self.__msg_descrs = {}      # message descriptions by message type map
         self.__msg_labels = {}      # message labels by message name map
         self.__msg_names = []       # message names in the same order as FORMAT messages
+        self.__topic_descrs = {}    # generic topic descriptions by TOPD id map
         self.__buffer = bytearray() # buffer for input binary data
         self.__ptr = 0              # read pointer in buffer
         self.__csv_columns = []     # CSV file columns in correct order in format "MSG.label"
@@ -147,12 +168,32 @@ class SDLog2Parser:
                     msg_length = msg_descr[0]
                     if self.__bytesLeft() < msg_length:
                         break
+                    data_len = 0
+                    if msg_descr[2].endswith("V"):
+                        # the described part ends with the length of the data following it
+                        p = self.__ptr + msg_length
+                        data_len = self.__buffer[p - 2] | (self.__buffer[p - 1] << 8)
+                        if self.__bytesLeft() < msg_length + data_len:
+                            break
+                    if msg_descr[1] == "TOPF":
+                        # generic topic format, describes the following TOPD messages
+                        self.__parseTopicDescr(msg_descr, data_len)
+                        continue
+                    if msg_descr[1] == "TOPD":
+                        topic_id = self.__buffer[self.__ptr + self.MSG_HEADER_LEN]
+                        msg_descr = self.__topic_descrs.get(topic_id)
+                        if msg_descr == None:
+                            raise Exception("Unknown topic id: %i" % topic_id)
+                        if msg_descr[0] != msg_length + data_len:
+                            raise Exception("Size of topic %s changed: %i" % (msg_descr[1], data_len))
+                        data_len = 0
                     if first_data_msg:
                         # build CSV columns and init data map
                         if not self.__debug_out:
                             self.__initCSV()
                         first_data_msg = False
                     self.__parseMsg(msg_descr)
+                    self.__ptr += data_len
             bytes_read += self.__ptr
             if not self.__debug_out and self.__time_msg != None and self.__csv_updated:
                 self.__printCSVRow()
@@ -170,7 +211,8 @@ class SDLog2Parser:
     def __initCSV(self):
         if len(self.__msg_filter) == 0:
             for msg_name in self.__msg_names:
-                self.__msg_filter.append((msg_name, "*"))
+                if msg_name not in self.GENERIC_MSGS:
+                    self.__msg_filter.append((msg_name, "*"))
         for msg_name, show_fields in self.__msg_filter:
             if show_fields == "*":
                 show_fields = self.__msg_labels.get(msg_name, [])
@@ -230,6 +272,76 @@ class SDLog2Parser:
                                 msg_type, msg_length, msg_name, msg_format, str(msg_labels), msg_struct, msg_mults))
         self.__ptr += self.MSG_FORMAT_PACKET_LEN
     
+    def __parseFields(self, fields, nested, prefix, depth):
+        """Convert a field layout to struct.unpack format and labels"""
+        if depth > self.MAX_NESTING_DEPTH:
+            raise Exception("Field layout nested too deep: %s" % prefix)
+        msg_struct = ""
+        msg_labels = []
+        for entry in fields.split(";"):
+            if len(entry) == 0:
+                continue
+            field_type, name = entry.split(" ")
+            m = re.match(r"^(\w+)\[(\d+)\]$", field_type)
+            count = None
+            if m != None:
+                field_type = m.group(1)
+                count = int(m.group(2))
+            if name.startswith("_padding"):
+                msg_struct += "%ix" % (count or 1)
+            elif field_type == "char" and count != None:
+                msg_struct += "%is" % count
+                msg_labels.append(prefix + name)
+            elif field_type in self.FIELD_TO_STRUCT:
+                if count == None:
+                    msg_struct += self.FIELD_TO_STRUCT[field_type]
+                    msg_labels.append(prefix + name)
+                else:
+                    for i in range(count):
+                        msg_struct += self.FIELD_TO_STRUCT[field_type]
+                        msg_labels.append("%s%s[%i]" % (prefix, name, i))
+            elif field_type in nested:
+                for i in range(count or 1):
+                    label = prefix + name
+                    if count != None:
+                        label += "[%i]" % i
+                    s, l = self.__parseFields(nested[field_type], nested, label + ".", depth + 1)
+                    msg_struct += s
+                    msg_labels += l
+            else:
+                raise Exception("Unknown field type: %s" % field_type)
+        return msg_struct, msg_labels
+
+    def __parseTopicDescr(self, msg_descr, data_len):
+        """Parse TOPF message, the topic name and the field layout follow it"""
+        msg_length, msg_name, msg_format, msg_labels, msg_struct, msg_mults = msg_descr
+        if runningPython3:
+            data = struct.unpack(msg_struct, self.__buffer[self.__ptr+self.MSG_HEADER_LEN:self.__ptr+msg_length])
+        else:
+            data = struct.unpack(msg_struct, str(self.__buffer[self.__ptr+self.MSG_HEADER_LEN:self.__ptr+msg_length]))
+        topic_id, instance, size, layout_len = data
+        p = self.__ptr + msg_length
+        topic_name, fields = bytes(self.__buffer[p:p+layout_len]).split(b"\0", 1)
+        topic_name = _parseCString(topic_name)
+        layout = _parseCString(fields).split("\n")
+        nested = dict(n.split(":", 1) for n in layout[1:])
+        topic_struct, topic_labels = self.__parseFields(layout[0], nested, "", 0)
+        # TOPD id and data length are skipped
+        topic_struct = "<xxx" + topic_struct
+        if struct.calcsize(topic_struct) != size + 3:
+            raise Exception("Field layout of %s doesn't match its size %i" % (topic_name, size))
+        if instance > 0:
+            topic_name += "_%i" % instance
+        self.__topic_descrs[topic_id] = (self.MSG_HEADER_LEN + 3 + size, topic_name, None, topic_labels,
+                                         topic_struct, [None] * len(topic_labels))
+        self.__msg_labels[topic_name] = topic_labels
+        self.__msg_names.append(topic_name)
+        if self.__debug_out:
+            if self.__filterMsg(topic_name) != None:
+                print("TOPIC FORMAT: id = %i, size = %i, name = %s, labels = %s, struct = %s" % (
+                            topic_id, size, topic_name, str(topic_labels), topic_struct))
+        self.__ptr += msg_length + layout_len
+
     def __parseMsg(self, msg_descr):
         msg_length, msg_name, msg_format, msg_labels, msg_struct, msg_mults = msg_descr
         if not self.__debug_out and self.__time_msg != None and msg_name == self.__time_msg and self.__csv_updated:
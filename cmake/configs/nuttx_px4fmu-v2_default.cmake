@@ -177,6 +177,9 @@ set(config_io_extra_libs
 	#${CMAKE_SOURCE_DIR}/src/lib/mathlib/CMSIS/libarm_cortexM3l_math.a
 	)
 
+# topic field layouts for sdlog2 -g, about 18 kB of flash
+#set(config_orb_fields 1)
+
 add_custom_target(sercon)
 set_target_properties(sercon PROPERTIES
 	MAIN "sercon" STACK "2048")
@@ -24,6 +24,7 @@ set(config_module_list
 	systemcmds/esc_calib
 	systemcmds/reboot
 	systemcmds/topic_listener
+	systemcmds/top
 	modules/uORB
 	modules/param
 	modules/systemlib
@@ -45,6 +46,8 @@ set(config_module_list
 	modules/fw_pos_control_l1
 	modules/dataman
 	modules/sdlog2
+	modules/replay
+	modules/muorb/shm
 	modules/commander
 	modules/controllib
 	lib/mathlib
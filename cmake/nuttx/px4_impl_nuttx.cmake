@@ -315,6 +315,7 @@ function(px4_nuttx_add_romfs)
 	set(romfs_src_dir ${CMAKE_SOURCE_DIR}/${ROOT})
 	set(romfs_autostart ${CMAKE_SOURCE_DIR}/Tools/px_process_airframes.py)
 	set(romfs_pruner ${CMAKE_SOURCE_DIR}/Tools/px_romfs_pruner.py)
+	set(romfs_mixer_to_bin ${CMAKE_SOURCE_DIR}/Tools/px_mixer_to_bin.py)
 	set(bin_to_obj ${CMAKE_SOURCE_DIR}/cmake/nuttx/bin_to_obj.py)
 	set(extras_dir ${CMAKE_CURRENT_BINARY_DIR}/extras)
 
@@ -344,6 +345,8 @@ function(px4_nuttx_add_romfs)
 			-s ${romfs_temp_dir}/init.d/rc.autostart
 		COMMAND ${PYTHON_EXECUTABLE} ${romfs_pruner}
 			--folder ${romfs_temp_dir}
+		COMMAND ${PYTHON_EXECUTABLE} ${romfs_mixer_to_bin}
+			--folder ${romfs_temp_dir}
 		COMMAND ${GENROMFS} -f ${CMAKE_CURRENT_BINARY_DIR}/romfs.bin
 			-d ${romfs_temp_dir} -V "NSHInitVol"
 		#COMMAND cmake -E remove_directory ${romfs_temp_dir}
@@ -355,7 +358,7 @@ function(px4_nuttx_add_romfs)
 			--obj romfs.o
 			--var romfs_img
 			--bin romfs.bin
-		DEPENDS ${romfs_src_files} ${extras}
+		DEPENDS ${romfs_src_files} ${extras} ${romfs_mixer_to_bin}
 		WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}
 		)
 	add_library(${OUT} STATIC romfs.o)
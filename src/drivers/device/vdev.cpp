@@ -40,6 +40,7 @@
 #include "px4_posix.h"
 #include "vdev.h"
 #include "drivers/drv_device.h"
+#include "drivers/drv_hrt.h"
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -441,6 +442,10 @@ VDev::poll_notify_one(px4_pollfd_struct_t *fds, pollevent_t events)
 	/* if the state is now interesting, wake the waiter if it's still asleep */
 	/* XXX semcount check here is a vile hack; counting semphores should not be abused as cvars */
 	if ((fds->revents != 0) && (value <= 0)) {
+		if (fds->notified == 0) {
+			fds->notified = hrt_absolute_time();
+		}
+
 		px4_sem_post(fds->sem);
 	}
 }
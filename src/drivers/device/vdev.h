@@ -321,6 +321,14 @@ public:
 	virtual int	ioctl(file_t *filep, int cmd, unsigned long arg);
 
 	static VDev *getDev(const char *path);
+
+	/**
+	 * Look up the open file behind a file descriptor.
+	 *
+	 * @param fd		A descriptor returned by px4_open.
+	 * @return		The file, or nullptr if fd is not open.
+	 */
+	static file_t *getFile(int fd);
 	static void showFiles(void);
 	static void showDevices(void);
 	static void showTopics(void);
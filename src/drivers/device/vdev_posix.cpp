@@ -40,6 +40,8 @@
 #include <px4_log.h>
 #include <px4_posix.h>
 #include <px4_time.h>
+#include <px4_tasks.h>
+#include <drivers/drv_hrt.h>
 #include "device.h"
 #include "vfile.h"
 
@@ -211,6 +213,7 @@ extern "C" {
 		int count = 0;
 		int ret = -1;
 		unsigned int i;
+		hrt_abstime elapsed = 0;
 
 		PX4_DEBUG("Called px4_poll timeout = %d", timeout);
 		px4_sem_init(&sem, 0, 0);
@@ -220,6 +223,7 @@ extern "C" {
 			fds[i].sem     = &sem;
 			fds[i].revents = 0;
 			fds[i].priv    = NULL;
+			fds[i].notified = 0;
 
 			// If fd is valid
 			if (valid_fd(fds[i].fd)) {
@@ -238,6 +242,8 @@ extern "C" {
 				// Use a work queue task
 				work_s _hpwork;
 
+				hrt_abstime start = hrt_absolute_time();
+
 				hrt_work_queue(&_hpwork, (worker_t)&timer_cb, (void *)&sem, 1000 * timeout);
 				px4_sem_wait(&sem);
 
@@ -245,10 +251,15 @@ extern "C" {
 				// out of scope
 				hrt_work_cancel(&_hpwork);
 
+				elapsed = hrt_absolute_time() - start;
+
 			} else if (timeout < 0) {
 				px4_sem_wait(&sem);
 			}
 
+			hrt_abstime woken = hrt_absolute_time();
+			hrt_abstime notified = 0;
+
 			// For each fd
 			for (i = 0; i < nfds; ++i) {
 				// If fd is valid
@@ -264,8 +275,21 @@ extern "C" {
 					if (fds[i].revents) {
 						count += 1;
 					}
+
+					// the first event posted is the one that woke the task
+					if (fds[i].notified != 0 && (notified == 0 || fds[i].notified < notified)) {
+						notified = fds[i].notified;
+					}
 				}
 			}
+
+			// account how late the task woke up after the timer expired or the data arrived
+			if (timeout > 0 && count == 0 && elapsed >= 1000 * (hrt_abstime)timeout) {
+				px4_task_wakeup_latency(elapsed - 1000 * (hrt_abstime)timeout);
+
+			} else if (timeout != 0 && count > 0 && notified != 0 && woken >= notified) {
+				px4_task_wakeup_latency(woken - notified);
+			}
 		}
 
 		px4_sem_destroy(&sem);
@@ -316,3 +340,8 @@ extern "C" {
 
 }
 
+
+file_t *VDev::getFile(int fd)
+{
+	return valid_fd(fd) ? filemap[fd] : nullptr;
+}
@@ -163,4 +163,17 @@ __EXPORT extern void	hrt_call_delay(struct hrt_call *entry, hrt_abstime delay);
  */
 __EXPORT extern void	hrt_init(void);
 
+#if defined(__PX4_POSIX) && !defined(__PX4_QURT)
+
+/*
+ * Switch the HRT to virtual time and set it, e.g. for log replay.
+ *
+ * From the first call on hrt_absolute_time() returns the last time set
+ * here instead of the system clock. Callouts that are due at the new
+ * time are run from the calling thread. The time must not go backwards.
+ */
+__EXPORT extern void	hrt_set_virtual_time(hrt_abstime now);
+
+#endif
+
 __END_DECLS
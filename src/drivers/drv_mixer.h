@@ -109,6 +109,21 @@ struct mixer_simple_s {
  */
 #define MIXERIOCLOADBUF		_MIXERIOC(5)
 
+/** first bytes of a binary mixer definition, see MixerGroup::load_from_binary() */
+#define MIXER_BINARY_MAGIC	"PXMB"
+#define MIXER_BINARY_VERSION	1
+
+/** binary mixer definition */
+struct mixer_binary_s {
+	const uint8_t		*buf;		/**< the definition, starting with the magic */
+	unsigned		buflen;		/**< length of the definition in bytes */
+};
+
+/**
+ * Add mixer(s) from the binary definition in (const struct mixer_binary_s *)arg
+ */
+#define MIXERIOCLOADBIN		_MIXERIOC(6)
+
 /*
  * XXX Thoughts for additional operations:
  *
@@ -1083,6 +1083,34 @@ MK::pwm_ioctl(file *filp, int cmd, unsigned long arg)
 
 				ret = _mixers->load_from_buf(buf, buflen);
 
+				if (ret != 0) {
+					DEVICE_DEBUG("mixer load failed with %d", ret);
+					delete _mixers;
+					_mixers = nullptr;
+					ret = -EINVAL;
+
+				} else {
+					_mixers->compile();
+				}
+			}
+
+			break;
+		}
+
+	case MIXERIOCLOADBIN: {
+			const struct mixer_binary_s *bin = (const struct mixer_binary_s *)arg;
+
+			if (_mixers == nullptr) {
+				_mixers = new MixerGroup(control_callback, (uintptr_t)&_controls);
+			}
+
+			if (_mixers == nullptr) {
+				ret = -ENOMEM;
+
+			} else {
+
+				ret = _mixers->load_from_binary(bin->buf, bin->buflen);
+
 				if (ret != 0) {
 					DEVICE_DEBUG("mixer load failed with %d", ret);
 					delete _mixers;
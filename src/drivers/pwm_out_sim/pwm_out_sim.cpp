@@ -75,6 +75,7 @@
 
 #include <systemlib/systemlib.h>
 #include <systemlib/mixer/mixer.h>
+#include <systemlib/perf_counter.h>
 
 #include <uORB/topics/actuator_controls.h>
 #include <uORB/topics/actuator_controls_0.h>
@@ -129,6 +130,8 @@ private:
 
 	actuator_controls_s _controls;
 
+	perf_counter_t	_perf_control_latency;	///< age of the controls sample at output
+
 	static void	task_main_trampoline(int argc, char *argv[]);
 	void		task_main();
 
@@ -182,7 +185,8 @@ PWMSim::PWMSim() :
 	_num_outputs(0),
 	_primary_pwm_device(false),
 	_task_should_exit(false),
-	_mixers(nullptr)
+	_mixers(nullptr),
+	_perf_control_latency(perf_alloc(PC_LATENCY, "pwm_out_sim control latency"))
 {
 	_debug_enabled = true;
 }
@@ -208,6 +212,8 @@ PWMSim::~PWMSim()
 		} while (_task != -1);
 	}
 
+	perf_free(_perf_control_latency);
+
 	g_pwm_sim = nullptr;
 }
 
@@ -417,6 +423,7 @@ PWMSim::task_main()
 				/* do mixing */
 				outputs.noutputs = _mixers->mix(&outputs.output[0], num_outputs, NULL);
 				outputs.timestamp = hrt_absolute_time();
+				outputs.timestamp_sample = _controls.timestamp_sample;
 
 				/* iterate actuators */
 				for (unsigned i = 0; i < num_outputs; i++) {
@@ -440,6 +447,10 @@ PWMSim::task_main()
 
 				/* and publish for anyone that cares to see */
 				orb_publish(ORB_ID(actuator_outputs), _t_outputs, &outputs);
+
+				if (outputs.timestamp_sample != 0) {
+					perf_set(_perf_control_latency, outputs.timestamp - outputs.timestamp_sample);
+				}
 			}
 		}
 
@@ -711,6 +722,34 @@ PWMSim::pwm_ioctl(device::file_t *filp, int cmd, unsigned long arg)
 
 				ret = _mixers->load_from_buf(buf, buflen);
 
+				if (ret != 0) {
+					DEVICE_DEBUG("mixer load failed with %d", ret);
+					delete _mixers;
+					_mixers = nullptr;
+					ret = -EINVAL;
+
+				} else {
+					_mixers->compile();
+				}
+			}
+
+			break;
+		}
+
+	case MIXERIOCLOADBIN: {
+			const struct mixer_binary_s *bin = (const struct mixer_binary_s *)arg;
+
+			if (_mixers == nullptr) {
+				_mixers = new MixerGroup(control_callback, (uintptr_t)&_controls);
+			}
+
+			if (_mixers == nullptr) {
+				ret = -ENOMEM;
+
+			} else {
+
+				ret = _mixers->load_from_binary(bin->buf, bin->buflen);
+
 				if (ret != 0) {
 					DEVICE_DEBUG("mixer load failed with %d", ret);
 					delete _mixers;
@@ -68,6 +68,7 @@
 #include <systemlib/pwm_limit/pwm_limit.h>
 #include <systemlib/board_serial.h>
 #include <systemlib/param/param.h>
+#include <systemlib/perf_counter.h>
 #include <drivers/drv_mixer.h>
 #include <drivers/drv_rc_input.h>
 
@@ -156,6 +157,8 @@ private:
 	pollfd	_poll_fds[actuator_controls_s::NUM_ACTUATOR_CONTROL_GROUPS];
 	unsigned	_poll_fds_num;
 
+	perf_counter_t	_perf_control_latency;	///< age of the attitude controls sample at output
+
 	static pwm_limit_t	_pwm_limit;
 	static actuator_armed_s	_armed;
 	uint16_t	_failsafe_pwm[_max_actuators];
@@ -282,6 +285,7 @@ PX4FMU::PX4FMU() :
 	_groups_subscribed(0),
 	_control_subs{ -1},
 	_poll_fds_num(0),
+	_perf_control_latency(perf_alloc(PC_LATENCY, "fmu control latency")),
 	_failsafe_pwm{0},
 	_disarmed_pwm{0},
 	_reverse_pwm_mask(0),
@@ -330,6 +334,8 @@ PX4FMU::~PX4FMU()
 	/* clean up the alternate device node */
 	unregister_class_devname(PWM_OUTPUT_BASE_DEVICE_PATH, _class_instance);
 
+	perf_free(_perf_control_latency);
+
 	g_fmu = nullptr;
 }
 
@@ -572,6 +578,11 @@ PX4FMU::publish_pwm_outputs(uint16_t *values, size_t numvalues)
 	actuator_outputs_s outputs;
 	outputs.noutputs = numvalues;
 	outputs.timestamp = hrt_absolute_time();
+	outputs.timestamp_sample = _controls[actuator_controls_s::GROUP_INDEX_ATTITUDE].timestamp_sample;
+
+	if (outputs.timestamp_sample != 0) {
+		perf_set(_perf_control_latency, outputs.timestamp - outputs.timestamp_sample);
+	}
 
 	for (size_t i = 0; i < _max_actuators; ++i) {
 		outputs.output[i] = i < numvalues ? (float)values[i] : 0;
@@ -1335,6 +1346,38 @@ PX4FMU::pwm_ioctl(file *filp, int cmd, unsigned long arg)
 
 				ret = _mixers->load_from_buf(buf, buflen);
 
+				if (ret != 0) {
+					DEVICE_DEBUG("mixer load failed with %d", ret);
+					delete _mixers;
+					_mixers = nullptr;
+					_groups_required = 0;
+					ret = -EINVAL;
+
+				} else {
+
+					_mixers->compile();
+					_mixers->groups_required(_groups_required);
+				}
+			}
+
+			break;
+		}
+
+	case MIXERIOCLOADBIN: {
+			const struct mixer_binary_s *bin = (const struct mixer_binary_s *)arg;
+
+			if (_mixers == nullptr) {
+				_mixers = new MixerGroup(control_callback, (uintptr_t)_controls);
+			}
+
+			if (_mixers == nullptr) {
+				_groups_required = 0;
+				ret = -ENOMEM;
+
+			} else {
+
+				ret = _mixers->load_from_binary(bin->buf, bin->buflen);
+
 				if (ret != 0) {
 					DEVICE_DEBUG("mixer load failed with %d", ret);
 					delete _mixers;
@@ -255,6 +255,7 @@ private:
 	unsigned		_max_rc_input;		///< Maximum receiver channels supported by PX4IO
 	unsigned		_max_relays;		///< Maximum relays supported by PX4IO
 	unsigned		_max_transfer;		///< Maximum number of I2C transfers supported by PX4IO
+	bool			_batch_supported;	///< Interface can run batched transactions
 
 	unsigned 		_update_interval;	///< Subscription interval limiting send rate
 	bool			_rc_handling_disabled;	///< If set, IO does not evaluate, but only forward the RC values
@@ -269,6 +270,7 @@ private:
 	perf_counter_t		_perf_update;		///< local performance counter for status updates
 	perf_counter_t		_perf_write;		///< local performance counter for PWM control writes
 	perf_counter_t		_perf_sample_latency;	///< total system latency (based on passed-through timestamp)
+	hrt_abstime		_last_sample_timestamp;	///< sample timestamp of the last attitude controls sent
 
 	/* cached IO state */
 	uint16_t		_status;		///< Various IO status flags
@@ -324,6 +326,15 @@ private:
 	 */
 	void			task_main();
 
+	/**
+	 * Fetch the controls of one group in register format.
+	 *
+	 * @param group		Control group to fetch.
+	 * @param regs		Filled with _max_controls register values.
+	 * @return		True if the group has to be sent to IO.
+	 */
+	bool			io_get_control_regs(unsigned group, uint16_t *regs);
+
 	/**
 	 * Send controls for one group to IO
 	 */
@@ -351,6 +362,14 @@ private:
 	 */
 	int			io_get_status();
 
+	/**
+	 * Handle the status registers read from IO.
+	 *
+	 * @param regs		Registers PX4IO_P_STATUS_FLAGS to
+	 *			PX4IO_P_STATUS_PRSSI of the status page.
+	 */
+	void			io_process_status(const uint16_t *regs);
+
 	/**
 	 * Disable RC input handling
 	 */
@@ -364,16 +383,60 @@ private:
 	 */
 	int			io_get_raw_rc_input(rc_input_values &input_rc);
 
+	/**
+	 * Decode the raw RC input page.
+	 *
+	 * @param regs		Raw RC input page from PX4IO_P_RAW_RC_COUNT, holding
+	 *			at least as many channels as it reports.
+	 * @param input_rc	Input structure to populate.
+	 */
+	void			io_decode_raw_rc(const uint16_t *regs, rc_input_values &input_rc);
+
 	/**
 	 * Fetch and publish raw RC input data.
 	 */
 	int			io_publish_raw_rc();
 
+	/**
+	 * Publish RC input data fetched from IO.
+	 */
+	void			io_publish_rc_input(rc_input_values &rc_val);
+
 	/**
 	 * Fetch and publish the PWM servo outputs.
 	 */
 	int			io_publish_pwm_outputs();
 
+	/**
+	 * Publish the servo outputs fetched from IO.
+	 *
+	 * @param servos	_max_actuators servo page registers.
+	 */
+	void			io_publish_servos(const uint16_t *servos);
+
+	/**
+	 * Publish the mixer status flags fetched from IO.
+	 */
+	void			io_publish_mixer_status(uint16_t mixer_status);
+
+	/**
+	 * Exchange controls and state with IO in a single batched transaction.
+	 *
+	 * Sends the changed control groups and, if polling, fetches and
+	 * publishes status, RC input and servo outputs.
+	 *
+	 * @param send_controls	Send the control groups that changed.
+	 * @param poll		Fetch and publish the IO state.
+	 * @return		OK if the transaction succeeded.
+	 */
+	int			io_batch_update(bool send_controls, bool poll);
+
+	/**
+	 * Check whether the interface and IO support batched transactions
+	 * large enough for io_batch_update().
+	 */
+	bool			io_batch_probe();
+
 	/**
 	 * write register(s)
 	 *
@@ -431,6 +494,16 @@ private:
 	 */
 	int			mixer_send(const char *buf, unsigned buflen, unsigned retries = 3);
 
+	/**
+	 * Send a binary mixer definition to IO
+	 */
+	int			mixer_send_binary(const uint8_t *buf, unsigned buflen, unsigned retries = 3);
+
+	/**
+	 * Write one mixer upload frame, retrying while IO is busy
+	 */
+	int			mixer_send_frame(uint8_t *frame, unsigned total_len);
+
 	/**
 	 * Handle a status update from IO.
 	 *
@@ -497,6 +570,7 @@ PX4IO::PX4IO(device::Device *interface) :
 	_max_rc_input(0),
 	_max_relays(0),
 	_max_transfer(16),	/* sensible default */
+	_batch_supported(false),
 	_update_interval(0),
 	_rc_handling_disabled(false),
 	_rc_chan_count(0),
@@ -506,7 +580,8 @@ PX4IO::PX4IO(device::Device *interface) :
 	_mavlink_fd(-1),
 	_perf_update(perf_alloc(PC_ELAPSED, "io update")),
 	_perf_write(perf_alloc(PC_ELAPSED, "io write")),
-	_perf_sample_latency(perf_alloc(PC_ELAPSED, "io latency")),
+	_perf_sample_latency(perf_alloc(PC_LATENCY, "io latency")),
+	_last_sample_timestamp(0),
 	_status(0),
 	_alarms(0),
 	_t_actuator_controls_0(-1),
@@ -683,6 +758,8 @@ PX4IO::init()
 		_max_rc_input = input_rc_s::RC_INPUT_MAX_CHANNELS;
 	}
 
+	_batch_supported = io_batch_probe();
+
 	param_get(param_find("RC_RSSI_PWM_CHAN"), &_rssi_pwm_chan);
 	param_get(param_find("RC_RSSI_PWM_MAX"), &_rssi_pwm_max);
 	param_get(param_find("RC_RSSI_PWM_MIN"), &_rssi_pwm_min);
@@ -968,26 +1045,37 @@ PX4IO::task_main()
 		perf_begin(_perf_update);
 		hrt_abstime now = hrt_absolute_time();
 
-		/* if we have new control data from the ORB, handle it */
-		if (fds[0].revents & POLLIN) {
+		/* we're not nice to the lower-priority control groups and only check them
+		   when the primary group updated. */
+		bool controls_updated = (fds[0].revents & POLLIN);
 
-			/* we're not nice to the lower-priority control groups and only check them
-			   when the primary group updated (which is now). */
-			(void)io_set_control_groups();
-		}
+		/* poll IO state at 50Hz */
+		bool poll_io = (now >= poll_last + IO_POLL_INTERVAL);
 
-		if (now >= poll_last + IO_POLL_INTERVAL) {
-			/* run at 50Hz */
+		if (poll_io) {
 			poll_last = now;
+		}
+
+		if (_batch_supported) {
+			/* controls out, status, R/C and servo outputs back in one exchange */
+			(void)io_batch_update(controls_updated, poll_io);
 
-			/* pull status and alarms from IO */
-			io_get_status();
+		} else {
+			/* if we have new control data from the ORB, handle it */
+			if (controls_updated) {
+				(void)io_set_control_groups();
+			}
 
-			/* get raw R/C input from IO */
-			io_publish_raw_rc();
+			if (poll_io) {
+				/* pull status and alarms from IO */
+				io_get_status();
 
-			/* fetch PWM outputs from IO */
-			io_publish_pwm_outputs();
+				/* get raw R/C input from IO */
+				io_publish_raw_rc();
+
+				/* fetch PWM outputs from IO */
+				io_publish_pwm_outputs();
+			}
 		}
 
 		if (now >= orb_check_last + ORB_CHECK_INTERVAL) {
@@ -1208,11 +1296,10 @@ PX4IO::io_set_control_groups()
 	return ret;
 }
 
-int
-PX4IO::io_set_control_state(unsigned group)
+bool
+PX4IO::io_get_control_regs(unsigned group, uint16_t *regs)
 {
 	actuator_controls_s	controls;	///< actuator outputs
-	uint16_t 		regs[_max_actuators];
 
 	/* get controls */
 	bool changed = false;
@@ -1224,6 +1311,7 @@ PX4IO::io_set_control_state(unsigned group)
 			if (changed) {
 				orb_copy(ORB_ID(actuator_controls_0), _t_actuator_controls_0, &controls);
 				perf_set(_perf_sample_latency, hrt_elapsed_time(&controls.timestamp_sample));
+				_last_sample_timestamp = controls.timestamp_sample;
 			}
 		}
 		break;
@@ -1257,7 +1345,7 @@ PX4IO::io_set_control_state(unsigned group)
 	}
 
 	if (!changed && (!_in_esc_calibration_mode || group != 0)) {
-		return -1;
+		return false;
 
 	} else if (_in_esc_calibration_mode && group == 0) {
 		/* modify controls to get max pwm (full thrust) on every esc */
@@ -1282,6 +1370,18 @@ PX4IO::io_set_control_state(unsigned group)
 		regs[i] = FLOAT_TO_REG(ctrl);
 	}
 
+	return true;
+}
+
+int
+PX4IO::io_set_control_state(unsigned group)
+{
+	uint16_t regs[_max_controls];
+
+	if (!io_get_control_regs(group, regs)) {
+		return -1;
+	}
+
 	/* copy values to registers in IO */
 	return io_reg_set(PX4IO_PAGE_CONTROLS, group * PX4IO_PROTOCOL_MAX_CONTROL_COUNT, regs, _max_controls);
 }
@@ -1695,6 +1795,14 @@ PX4IO::io_get_status()
 		return ret;
 	}
 
+	io_process_status(regs);
+
+	return ret;
+}
+
+void
+PX4IO::io_process_status(const uint16_t *regs)
+{
 	io_handle_status(regs[0]);
 	io_handle_alarms(regs[1]);
 
@@ -1705,8 +1813,6 @@ PX4IO::io_get_status()
 #ifdef CONFIG_ARCH_BOARD_PX4FMU_V2
 	io_handle_vservo(regs[4], regs[5]);
 #endif
-
-	return ret;
 }
 
 int
@@ -1715,9 +1821,6 @@ PX4IO::io_get_raw_rc_input(rc_input_values &input_rc)
 	uint32_t channel_count;
 	int	ret;
 
-	/* we don't have the status bits, so input_source has to be set elsewhere */
-	input_rc.input_source = input_rc_s::RC_INPUT_SOURCE_UNKNOWN;
-
 	const unsigned prolog = (PX4IO_P_RAW_RC_BASE - PX4IO_P_RAW_RC_COUNT);
 	uint16_t regs[input_rc_s::RC_INPUT_MAX_CHANNELS + prolog];
 
@@ -1743,6 +1846,33 @@ PX4IO::io_get_raw_rc_input(rc_input_values &input_rc)
 		channel_count = input_rc_s::RC_INPUT_MAX_CHANNELS;
 	}
 
+	if (channel_count > 9) {
+		ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_BASE + 9, &regs[prolog + 9], channel_count - 9);
+
+		if (ret != OK) {
+			return ret;
+		}
+	}
+
+	io_decode_raw_rc(regs, input_rc);
+
+	return ret;
+}
+
+void
+PX4IO::io_decode_raw_rc(const uint16_t *regs, rc_input_values &input_rc)
+{
+	const unsigned prolog = (PX4IO_P_RAW_RC_BASE - PX4IO_P_RAW_RC_COUNT);
+	uint32_t channel_count = regs[PX4IO_P_RAW_RC_COUNT];
+
+	/* we don't have the status bits, so input_source has to be set elsewhere */
+	input_rc.input_source = input_rc_s::RC_INPUT_SOURCE_UNKNOWN;
+
+	/* limit the channel count */
+	if (channel_count > input_rc_s::RC_INPUT_MAX_CHANNELS) {
+		channel_count = input_rc_s::RC_INPUT_MAX_CHANNELS;
+	}
+
 	_rc_chan_count = channel_count;
 
 	input_rc.timestamp_publication = hrt_absolute_time();
@@ -1765,14 +1895,6 @@ PX4IO::io_get_raw_rc_input(rc_input_values &input_rc)
 	/* FIELDS NOT SET HERE */
 	/* input_rc.input_source is set after this call XXX we might want to mirror the flags in the RC struct */
 
-	if (channel_count > 9) {
-		ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_BASE + 9, &regs[prolog + 9], channel_count - 9);
-
-		if (ret != OK) {
-			return ret;
-		}
-	}
-
 	/* last thing set are the actual channel values as 16 bit values */
 	for (unsigned i = 0; i < channel_count; i++) {
 		input_rc.values[i] = regs[prolog + i];
@@ -1786,8 +1908,6 @@ PX4IO::io_get_raw_rc_input(rc_input_values &input_rc)
 		rssi = rssi < 0 ? 0 : rssi;
 		input_rc.rssi = rssi;
 	}
-
-	return ret;
 }
 
 int
@@ -1806,6 +1926,14 @@ PX4IO::io_publish_raw_rc()
 		return ret;
 	}
 
+	io_publish_rc_input(rc_val);
+
+	return OK;
+}
+
+void
+PX4IO::io_publish_rc_input(rc_input_values &rc_val)
+{
 	/* sort out the source of the values */
 	if (_status & PX4IO_P_STATUS_FLAGS_RC_PPM) {
 		rc_val.input_source = input_rc_s::RC_INPUT_SOURCE_PX4IO_PPM;
@@ -1825,7 +1953,7 @@ PX4IO::io_publish_raw_rc()
 		/* only keep publishing RC input if we ever got a valid input */
 		if (_rc_last_valid == 0) {
 			/* we have never seen valid RC signals, abort */
-			return OK;
+			return;
 		}
 	}
 
@@ -1836,19 +1964,11 @@ PX4IO::io_publish_raw_rc()
 	} else {
 		orb_publish(ORB_ID(input_rc), _to_input_rc, &rc_val);
 	}
-
-	return OK;
 }
 
 int
 PX4IO::io_publish_pwm_outputs()
 {
-	/* data we are going to fetch */
-	actuator_outputs_s outputs;
-	multirotor_motor_limits_s motor_limits;
-
-	outputs.timestamp = hrt_absolute_time();
-
 	/* get servo values from IO */
 	uint16_t ctl[_max_actuators];
 	int ret = io_reg_get(PX4IO_PAGE_SERVOS, 0, ctl, _max_actuators);
@@ -1857,9 +1977,33 @@ PX4IO::io_publish_pwm_outputs()
 		return ret;
 	}
 
+	io_publish_servos(ctl);
+
+	/* get mixer status flags from IO */
+	uint16_t mixer_status;
+	ret = io_reg_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_MIXER, &mixer_status, sizeof(mixer_status) / sizeof(uint16_t));
+
+	if (ret != OK) {
+		return ret;
+	}
+
+	io_publish_mixer_status(mixer_status);
+
+	return OK;
+}
+
+void
+PX4IO::io_publish_servos(const uint16_t *servos)
+{
+	/* data we are going to publish */
+	actuator_outputs_s outputs;
+
+	outputs.timestamp = hrt_absolute_time();
+	outputs.timestamp_sample = _last_sample_timestamp;
+
 	/* convert from register format to float */
 	for (unsigned i = 0; i < _max_actuators; i++) {
-		outputs.output[i] = ctl[i];
+		outputs.output[i] = servos[i];
 	}
 
 	outputs.noutputs = _max_actuators;
@@ -1873,16 +2017,14 @@ PX4IO::io_publish_pwm_outputs()
 	} else {
 		orb_publish(ORB_ID(actuator_outputs), _to_outputs, &outputs);
 	}
+}
 
-	/* get mixer status flags from IO */
-	uint16_t mixer_status;
-	ret = io_reg_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_MIXER, &mixer_status, sizeof(mixer_status) / sizeof(uint16_t));
+void
+PX4IO::io_publish_mixer_status(uint16_t mixer_status)
+{
+	multirotor_motor_limits_s motor_limits;
 	memcpy(&motor_limits, &mixer_status, sizeof(motor_limits));
 
-	if (ret != OK) {
-		return ret;
-	}
-
 	/* publish mixer status */
 	if (_to_mixer_status == nullptr) {
 		_to_mixer_status = orb_advertise(ORB_ID(multirotor_motor_limits), &motor_limits);
@@ -1890,6 +2032,93 @@ PX4IO::io_publish_pwm_outputs()
 	} else {
 		orb_publish(ORB_ID(multirotor_motor_limits), _to_mixer_status, &motor_limits);
 	}
+}
+
+bool
+PX4IO::io_batch_probe()
+{
+	const unsigned prolog = (PX4IO_P_RAW_RC_BASE - PX4IO_P_RAW_RC_COUNT);
+	const unsigned status_count = PX4IO_P_STATUS_MIXER - PX4IO_P_STATUS_FLAGS + 1;
+
+	/* a full update, four control groups out and three reads back, has to fit into one packet each way */
+	if (4 * (2 + _max_controls) + 3 * 2 > PKT_MAX_REGS ||
+	    status_count + prolog + _max_rc_input + _max_actuators > PKT_MAX_REGS) {
+		return false;
+	}
+
+	/* read the protocol version to check the interface and IO both handle batches */
+	const uint16_t request[] = {
+		PX4IO_BATCH_ADDRESS(PX4IO_PAGE_CONFIG, PX4IO_P_CONFIG_PROTOCOL_VERSION),
+		PX4IO_BATCH_READ | 1
+	};
+	uint16_t version = 0;
+	px4io_batch_s batch = { request, 2, &version, 1 };
+	unsigned arg = reinterpret_cast<unsigned>(&batch);
+
+	return (_interface->ioctl(PX4IO_INTERFACE_BATCH, arg) == OK) && (version == PX4IO_PROTOCOL_VERSION);
+}
+
+int
+PX4IO::io_batch_update(bool send_controls, bool poll)
+{
+	const unsigned prolog = (PX4IO_P_RAW_RC_BASE - PX4IO_P_RAW_RC_COUNT);
+	const unsigned status_count = PX4IO_P_STATUS_MIXER - PX4IO_P_STATUS_FLAGS + 1;
+	uint16_t request[PKT_MAX_REGS];
+	uint16_t reply[PKT_MAX_REGS];
+	unsigned request_count = 0;
+	unsigned reply_count = 0;
+
+	if (send_controls) {
+		for (unsigned group = 0; group < 4; group++) {
+			if (io_get_control_regs(group, &request[request_count + 2])) {
+				request[request_count] = PX4IO_BATCH_ADDRESS(PX4IO_PAGE_CONTROLS,
+							 group * PX4IO_PROTOCOL_MAX_CONTROL_COUNT);
+				request[request_count + 1] = PX4IO_BATCH_WRITE | _max_controls;
+				request_count += 2 + _max_controls;
+			}
+		}
+	}
+
+	if (poll) {
+		request[request_count++] = PX4IO_BATCH_ADDRESS(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS);
+		request[request_count++] = PX4IO_BATCH_READ | status_count;
+		request[request_count++] = PX4IO_BATCH_ADDRESS(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT);
+		request[request_count++] = PX4IO_BATCH_READ | (prolog + _max_rc_input);
+		request[request_count++] = PX4IO_BATCH_ADDRESS(PX4IO_PAGE_SERVOS, 0);
+		request[request_count++] = PX4IO_BATCH_READ | _max_actuators;
+		reply_count = status_count + prolog + _max_rc_input + _max_actuators;
+	}
+
+	if (request_count == 0) {
+		return OK;
+	}
+
+	px4io_batch_s batch = { request, request_count, reply, reply_count };
+	unsigned arg = reinterpret_cast<unsigned>(&batch);
+	int ret = _interface->ioctl(PX4IO_INTERFACE_BATCH, arg);
+
+	if (ret != OK || !poll) {
+		return ret;
+	}
+
+	const uint16_t *status = &reply[0];
+	const uint16_t *raw_rc = &reply[status_count];
+	const uint16_t *servos = &reply[status_count + prolog + _max_rc_input];
+
+	io_process_status(status);
+
+	/* set the RC status flag ORDER MATTERS! */
+	rc_input_values	rc_val;
+	rc_val.rc_lost = !(_status & PX4IO_P_STATUS_FLAGS_RC_OK);
+
+	/* IO never reports more channels than it has */
+	if (raw_rc[PX4IO_P_RAW_RC_COUNT] <= _max_rc_input) {
+		io_decode_raw_rc(raw_rc, rc_val);
+		io_publish_rc_input(rc_val);
+	}
+
+	io_publish_servos(servos);
+	io_publish_mixer_status(status[PX4IO_P_STATUS_MIXER - PX4IO_P_STATUS_FLAGS]);
 
 	return OK;
 }
@@ -2058,19 +2287,7 @@ PX4IO::mixer_send(const char *buf, unsigned buflen, unsigned retries)
 				total_len++;
 			}
 
-			int ret;
-
-			for (int i = 0; i < 30; i++) {
-				/* failed, but give it a 2nd shot */
-				ret = io_reg_set(PX4IO_PAGE_MIXERLOAD, 0, (uint16_t *)frame, total_len / 2);
-
-				if (ret) {
-					usleep(333);
-
-				} else {
-					break;
-				}
-			}
+			int ret = mixer_send_frame(frame, total_len);
 
 			/* print mixer chunk */
 			if (debuglevel > 5 || ret) {
@@ -2094,27 +2311,110 @@ PX4IO::mixer_send(const char *buf, unsigned buflen, unsigned retries)
 		msg->text[0] = '\n';
 		msg->text[1] = '\0';
 
-		int ret;
+		int ret = mixer_send_frame(frame, sizeof(px4io_mixdata) + 2);
 
-		for (int i = 0; i < 30; i++) {
-			/* failed, but give it a 2nd shot */
-			ret = io_reg_set(PX4IO_PAGE_MIXERLOAD, 0, (uint16_t *)frame, (sizeof(px4io_mixdata) + 2) / 2);
+		if (ret) {
+			return ret;
+		}
 
-			if (ret) {
-				usleep(333);
+		retries--;
 
-			} else {
-				break;
-			}
-		}
+		DEVICE_LOG("mixer sent");
+
+	} while (retries > 0 && (!(io_reg_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS) & PX4IO_P_STATUS_FLAGS_MIXER_OK)));
+
+	/* check for the mixer-OK flag */
+	if (io_reg_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS) & PX4IO_P_STATUS_FLAGS_MIXER_OK) {
+		mavlink_log_info(_mavlink_fd, "[IO] mixer upload ok");
+		return 0;
+	}
+
+	DEVICE_LOG("mixer rejected by IO");
+	mavlink_log_info(_mavlink_fd, "[IO] mixer upload fail");
+
+	/* load must have failed for some reason */
+	return -EINVAL;
+}
+
+int
+PX4IO::mixer_send_frame(uint8_t *frame, unsigned total_len)
+{
+	int ret;
+
+	for (int i = 0; i < 30; i++) {
+		/* failed, but give it a 2nd shot */
+		ret = io_reg_set(PX4IO_PAGE_MIXERLOAD, 0, (uint16_t *)frame, total_len / 2);
 
 		if (ret) {
-			return ret;
+			usleep(333);
+
+		} else {
+			break;
 		}
+	}
+
+	return ret;
+}
+
+int
+PX4IO::mixer_send_binary(const uint8_t *buf, unsigned buflen, unsigned retries)
+{
+	uint8_t	frame[_max_transfer];
+
+	/* IO has no room for a larger definition, retrying will not help */
+	if (buflen > PX4IO_MIXER_BINARY_MAX) {
+		DEVICE_LOG("binary mixer too large (%u > %u bytes)", buflen, PX4IO_MIXER_BINARY_MAX);
+		return -E2BIG;
+	}
+
+	do {
+		px4io_mixdata *msg = (px4io_mixdata *)&frame[0];
+		unsigned max_len = _max_transfer - sizeof(px4io_mixdata);
+		const uint8_t *p = buf;
+		unsigned resid = buflen;
+
+		msg->f2i_mixer_magic = F2I_MIXER_MAGIC;
+		msg->action = F2I_MIXER_ACTION_BINARY_RESET;
+
+		/* the first frame announces the length of the definition */
+		msg->text[0] = buflen & 0xff;
+		msg->text[1] = buflen >> 8;
+		unsigned offset = 2;
+
+		do {
+			unsigned count = resid;
+
+			if (count > max_len - offset) {
+				count = max_len - offset;
+			}
+
+			memcpy(&msg->text[offset], p, count);
+			p += count;
+			resid -= count;
+
+			/* IO drops the pad byte of an odd frame */
+			unsigned total_len = sizeof(px4io_mixdata) + offset + count;
+
+			if (total_len % 2) {
+				msg->text[offset + count] = '\0';
+				total_len++;
+			}
+
+			int ret = mixer_send_frame(frame, total_len);
+
+			if (ret) {
+				DEVICE_LOG("mixer send error %d", ret);
+				return ret;
+			}
+
+			msg->action = F2I_MIXER_ACTION_BINARY_APPEND;
+			offset = 0;
+
+		} while (resid > 0);
 
 		retries--;
 
-		DEVICE_LOG("mixer sent");
+		DEVICE_LOG("binary mixer sent");
 
 	} while (retries > 0 && (!(io_reg_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS) & PX4IO_P_STATUS_FLAGS_MIXER_OK)));
 
@@ -2142,6 +2442,7 @@ PX4IO::print_status(bool extended_status)
 	       io_reg_get(PX4IO_PAGE_CONFIG, PX4IO_P_CONFIG_MAX_TRANSFER),
 	       io_reg_get(PX4IO_PAGE_SETUP,  PX4IO_P_SETUP_CRC),
 	       io_reg_get(PX4IO_PAGE_SETUP,  PX4IO_P_SETUP_CRC + 1));
+	printf("batched transactions %s\n", _batch_supported ? "enabled" : "disabled");
 	printf("%u controls %u actuators %u R/C inputs %u analog inputs %u relays\n",
 	       io_reg_get(PX4IO_PAGE_CONFIG, PX4IO_P_CONFIG_CONTROL_COUNT),
 	       io_reg_get(PX4IO_PAGE_CONFIG, PX4IO_P_CONFIG_ACTUATOR_COUNT),
@@ -2742,6 +3043,12 @@ PX4IO::ioctl(file *filep, int cmd, unsigned long arg)
 			break;
 		}
 
+	case MIXERIOCLOADBIN: {
+			const struct mixer_binary_s *bin = (const struct mixer_binary_s *)arg;
+			ret = mixer_send_binary(bin->buf, bin->buflen);
+			break;
+		}
+
 	case RC_INPUT_GET: {
 			uint16_t status;
 			rc_input_values *rc_val = (rc_input_values *)arg;
@@ -41,6 +41,21 @@
 
 #include <board_config.h>
 
+/**
+ * Batched register transaction, see PKT_CODE_BATCH.
+ *
+ * Passed by address to the interface ioctl PX4IO_INTERFACE_BATCH.
+ * Interfaces without batch support fail the ioctl.
+ */
+struct px4io_batch_s {
+	const uint16_t	*request;	///< operation list
+	unsigned	request_count;	///< registers in the operation list
+	uint16_t	*reply;		///< values of the read operations
+	unsigned	reply_count;	///< expected number of values read
+};
+
+#define PX4IO_INTERFACE_BATCH	2
+
 #ifdef PX4_I2C_OBDEV_PX4IO
 device::Device	*PX4IO_i2c_interface();
 #endif
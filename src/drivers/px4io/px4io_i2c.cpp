@@ -108,6 +108,11 @@ out:
 int
 PX4IO_I2C::ioctl(unsigned operation, unsigned &arg)
 {
+	/* batches are a serial link feature, the driver falls back to single transfers */
+	if (operation == PX4IO_INTERFACE_BATCH) {
+		return -ENOTTY;
+	}
+
 	return 0;
 }
 
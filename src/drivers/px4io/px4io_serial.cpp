@@ -95,6 +95,12 @@ public:
 	virtual int	ioctl(unsigned operation, unsigned &arg);
 
 private:
+	/**
+	 * Run a batched transaction, writing and reading several register
+	 * ranges in a single packet exchange.
+	 */
+	int			_batch(const px4io_batch_s &batch);
+
 	/*
 	 * XXX tune this value
 	 *
@@ -296,6 +302,9 @@ PX4IO_serial::ioctl(unsigned operation, unsigned &arg)
 
 	switch (operation) {
 
+	case PX4IO_INTERFACE_BATCH:
+		return _batch(*reinterpret_cast<const px4io_batch_s *>(arg));
+
 	case 1:		/* XXX magic number - test operation */
 		switch (arg) {
 		case 0:
@@ -478,6 +487,60 @@ PX4IO_serial::read(unsigned address, void *data, unsigned count)
 	return result;
 }
 
+int
+PX4IO_serial::_batch(const px4io_batch_s &batch)
+{
+	if ((batch.request_count > PKT_MAX_REGS) || (batch.reply_count > PKT_MAX_REGS)) {
+		return -EINVAL;
+	}
+
+	px4_sem_wait(&_bus_semaphore);
+
+	int result;
+
+	for (unsigned retries = 0; retries < 3; retries++) {
+
+		_dma_buffer.count_code = batch.request_count | PKT_CODE_BATCH;
+		_dma_buffer.page = 0;
+		_dma_buffer.offset = 0;
+		memcpy((void *)&_dma_buffer.regs[0], (const void *)batch.request, (2 * batch.request_count));
+
+		/* start the transaction and wait for it to complete */
+		result = _wait_complete();
+
+		/* successful transaction? */
+		if (result == OK) {
+
+			/* check result in packet */
+			if (PKT_CODE(_dma_buffer) == PKT_CODE_ERROR) {
+
+				/* IO didn't like it - no point retrying */
+				result = -EINVAL;
+				perf_count(_pc_protoerrs);
+
+			} else if (PKT_COUNT(_dma_buffer) != batch.reply_count) {
+
+				/* IO returned the wrong number of registers - no point retrying */
+				result = -EIO;
+				perf_count(_pc_protoerrs);
+
+			} else {
+
+				/* copy back the values read */
+				memcpy(batch.reply, &_dma_buffer.regs[0], (2 * batch.reply_count));
+			}
+
+			break;
+		}
+
+		perf_count(_pc_retries);
+	}
+
+	px4_sem_post(&_bus_semaphore);
+
+	return result;
+}
+
 int
 PX4IO_serial::_wait_complete()
 {
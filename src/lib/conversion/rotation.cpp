@@ -50,188 +50,35 @@ get_rot_matrix(enum Rotation rot, math::Matrix<3, 3> *rot_matrix)
 	rot_matrix->from_euler(roll, pitch, yaw);
 }
 
-#define HALF_SQRT_2 0.70710678118654757f
-
 __EXPORT void
 rotate_3f(enum Rotation rot, float &x, float &y, float &z)
 {
-	float tmp;
-
-	switch (rot) {
-	case ROTATION_NONE:
-	case ROTATION_MAX:
+	if (rot == ROTATION_NONE || (unsigned)rot >= ROTATION_MAX) {
 		return;
+	}
 
-	case ROTATION_YAW_45: {
-			tmp = HALF_SQRT_2 * (x - y);
-			y   = HALF_SQRT_2 * (x + y);
-			x = tmp;
-			return;
-		}
-
-	case ROTATION_YAW_90: {
-			tmp = x; x = -y; y = tmp;
-			return;
-		}
+	const rot_table_t &entry = rot_table[rot];
+	const float v[3] = { x, y, z };
 
-	case ROTATION_YAW_135: {
-			tmp = -HALF_SQRT_2 * (x + y);
-			y   =  HALF_SQRT_2 * (x - y);
-			x = tmp;
-			return;
-		}
+	x = rotate_row(entry.row[0], v);
+	y = rotate_row(entry.row[1], v);
+	z = rotate_row(entry.row[2], v);
+}
 
-	case ROTATION_YAW_180:
-		x = -x; y = -y;
+__EXPORT void
+rotate_3f_array(enum Rotation rot, float *xyz, size_t count)
+{
+	if (rot == ROTATION_NONE || (unsigned)rot >= ROTATION_MAX) {
 		return;
+	}
 
-	case ROTATION_YAW_225: {
-			tmp = HALF_SQRT_2 * (y - x);
-			y   = -HALF_SQRT_2 * (x + y);
-			x = tmp;
-			return;
-		}
-
-	case ROTATION_YAW_270: {
-			tmp = x; x = y; y = -tmp;
-			return;
-		}
-
-	case ROTATION_YAW_315: {
-			tmp = HALF_SQRT_2 * (x + y);
-			y   = HALF_SQRT_2 * (y - x);
-			x = tmp;
-			return;
-		}
-
-	case ROTATION_ROLL_180: {
-			y = -y; z = -z;
-			return;
-		}
-
-	case ROTATION_ROLL_180_YAW_45: {
-			tmp = HALF_SQRT_2 * (x + y);
-			y   = HALF_SQRT_2 * (x - y);
-			x = tmp; z = -z;
-			return;
-		}
-
-	case ROTATION_ROLL_180_YAW_90: {
-			tmp = x; x = y; y = tmp; z = -z;
-			return;
-		}
-
-	case ROTATION_ROLL_180_YAW_135: {
-			tmp = HALF_SQRT_2 * (y - x);
-			y   = HALF_SQRT_2 * (y + x);
-			x = tmp; z = -z;
-			return;
-		}
-
-	case ROTATION_PITCH_180: {
-			x = -x; z = -z;
-			return;
-		}
-
-	case ROTATION_ROLL_180_YAW_225: {
-			tmp = -HALF_SQRT_2 * (x + y);
-			y   =  HALF_SQRT_2 * (y - x);
-			x = tmp; z = -z;
-			return;
-		}
-
-	case ROTATION_ROLL_180_YAW_270: {
-			tmp = x; x = -y; y = -tmp; z = -z;
-			return;
-		}
-
-	case ROTATION_ROLL_180_YAW_315: {
-			tmp =  HALF_SQRT_2 * (x - y);
-			y   = -HALF_SQRT_2 * (x + y);
-			x = tmp; z = -z;
-			return;
-		}
-
-	case ROTATION_ROLL_90: {
-			tmp = z; z = y; y = -tmp;
-			return;
-		}
-
-	case ROTATION_ROLL_90_YAW_45: {
-			tmp = z; z = y; y = -tmp;
-			tmp = HALF_SQRT_2 * (x - y);
-			y   = HALF_SQRT_2 * (x + y);
-			x = tmp;
-			return;
-		}
-
-	case ROTATION_ROLL_90_YAW_90: {
-			tmp = z; z = y; y = -tmp;
-			tmp = x; x = -y; y = tmp;
-			return;
-		}
-
-	case ROTATION_ROLL_90_YAW_135: {
-			tmp = z; z = y; y = -tmp;
-			tmp = -HALF_SQRT_2 * (x + y);
-			y   =  HALF_SQRT_2 * (x - y);
-			x = tmp;
-			return;
-		}
-
-	case ROTATION_ROLL_270: {
-			tmp = z; z = -y; y = tmp;
-			return;
-		}
-
-	case ROTATION_ROLL_270_YAW_45: {
-			tmp = z; z = -y; y = tmp;
-			tmp = HALF_SQRT_2 * (x - y);
-			y   = HALF_SQRT_2 * (x + y);
-			x = tmp;
-			return;
-		}
-
-	case ROTATION_ROLL_270_YAW_90: {
-			tmp = z; z = -y; y = tmp;
-			tmp = x; x = -y; y = tmp;
-			return;
-		}
-
-	case ROTATION_ROLL_270_YAW_135: {
-			tmp = z; z = -y; y = tmp;
-			tmp = -HALF_SQRT_2 * (x + y);
-			y   =  HALF_SQRT_2 * (x - y);
-			x = tmp;
-			return;
-		}
-
-	case ROTATION_ROLL_270_YAW_270: {
-			tmp = z; z = -y; y = tmp;
-			tmp = x; x = y; y = -tmp;
-			return;
-		}
-
-	case ROTATION_PITCH_90: {
-			tmp = z; z = -x; x = tmp;
-			return;
-		}
-
-	case ROTATION_PITCH_270: {
-			tmp = z; z = x; x = -tmp;
-			return;
-		}
+	const rot_table_t &entry = rot_table[rot];
 
-	case ROTATION_ROLL_180_PITCH_270: {
-			tmp = z; z = x; x = tmp;
-			y = -y;
-			return;
-		}
+	for (size_t i = 0; i < count; i++, xyz += 3) {
+		const float v[3] = { xyz[0], xyz[1], xyz[2] };
 
-	case ROTATION_PITCH_90_YAW_180: {
-			tmp = x; x = z; z = tmp;
-			y = -y;
-			return;
-		}
+		xyz[0] = rotate_row(entry.row[0], v);
+		xyz[1] = rotate_row(entry.row[1], v);
+		xyz[2] = rotate_row(entry.row[2], v);
 	}
 }
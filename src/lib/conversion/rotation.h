@@ -118,6 +118,61 @@ const rot_lookup_t rot_lookup[] = {
 	{  0,  90, 180 }
 };
 
+#define ROT_HALF_SQRT_2 0.70710678118654757f
+
+/**
+ * One output axis of a board rotation.
+ *
+ * All supported rotations are multiples of 45 degrees, so every output axis is
+ * either a signed input axis or the scaled sum / difference of two input axes.
+ */
+typedef struct {
+	float scale;	///< 1, -1 or +-sqrt(2)/2
+	uint8_t a;	///< first input axis
+	uint8_t b;	///< second input axis, unused if op is 0
+	int8_t op;	///< 0: scale * v[a], 1: scale * (v[a] + v[b]), -1: scale * (v[a] - v[b])
+} rot_row_t;
+
+typedef struct {
+	rot_row_t row[3];
+} rot_table_t;
+
+/**
+ * Rotation kernels, indexed by enum Rotation. The operand order of every row
+ * matches the reference implementation so the results are bit-identical.
+ */
+constexpr rot_table_t rot_table[ROTATION_MAX] = {
+	{{ { 1.0f,             0, 0,  0 }, { 1.0f,             1, 0,  0 }, { 1.0f,             2, 0,  0 } }},	// ROTATION_NONE
+	{{ { ROT_HALF_SQRT_2,  0, 1, -1 }, { ROT_HALF_SQRT_2,  0, 1, +1 }, { 1.0f,             2, 0,  0 } }},	// ROTATION_YAW_45
+	{{ { -1.0f,            1, 0,  0 }, { 1.0f,             0, 0,  0 }, { 1.0f,             2, 0,  0 } }},	// ROTATION_YAW_90
+	{{ { -ROT_HALF_SQRT_2, 0, 1, +1 }, { ROT_HALF_SQRT_2,  0, 1, -1 }, { 1.0f,             2, 0,  0 } }},	// ROTATION_YAW_135
+	{{ { -1.0f,            0, 0,  0 }, { -1.0f,            1, 0,  0 }, { 1.0f,             2, 0,  0 } }},	// ROTATION_YAW_180
+	{{ { ROT_HALF_SQRT_2,  1, 0, -1 }, { -ROT_HALF_SQRT_2, 0, 1, +1 }, { 1.0f,             2, 0,  0 } }},	// ROTATION_YAW_225
+	{{ { 1.0f,             1, 0,  0 }, { -1.0f,            0, 0,  0 }, { 1.0f,             2, 0,  0 } }},	// ROTATION_YAW_270
+	{{ { ROT_HALF_SQRT_2,  0, 1, +1 }, { ROT_HALF_SQRT_2,  1, 0, -1 }, { 1.0f,             2, 0,  0 } }},	// ROTATION_YAW_315
+	{{ { 1.0f,             0, 0,  0 }, { -1.0f,            1, 0,  0 }, { -1.0f,            2, 0,  0 } }},	// ROTATION_ROLL_180
+	{{ { ROT_HALF_SQRT_2,  0, 1, +1 }, { ROT_HALF_SQRT_2,  0, 1, -1 }, { -1.0f,            2, 0,  0 } }},	// ROTATION_ROLL_180_YAW_45
+	{{ { 1.0f,             1, 0,  0 }, { 1.0f,             0, 0,  0 }, { -1.0f,            2, 0,  0 } }},	// ROTATION_ROLL_180_YAW_90
+	{{ { ROT_HALF_SQRT_2,  1, 0, -1 }, { ROT_HALF_SQRT_2,  1, 0, +1 }, { -1.0f,            2, 0,  0 } }},	// ROTATION_ROLL_180_YAW_135
+	{{ { -1.0f,            0, 0,  0 }, { 1.0f,             1, 0,  0 }, { -1.0f,            2, 0,  0 } }},	// ROTATION_PITCH_180
+	{{ { -ROT_HALF_SQRT_2, 0, 1, +1 }, { ROT_HALF_SQRT_2,  1, 0, -1 }, { -1.0f,            2, 0,  0 } }},	// ROTATION_ROLL_180_YAW_225
+	{{ { -1.0f,            1, 0,  0 }, { -1.0f,            0, 0,  0 }, { -1.0f,            2, 0,  0 } }},	// ROTATION_ROLL_180_YAW_270
+	{{ { ROT_HALF_SQRT_2,  0, 1, -1 }, { -ROT_HALF_SQRT_2, 0, 1, +1 }, { -1.0f,            2, 0,  0 } }},	// ROTATION_ROLL_180_YAW_315
+	{{ { 1.0f,             0, 0,  0 }, { -1.0f,            2, 0,  0 }, { 1.0f,             1, 0,  0 } }},	// ROTATION_ROLL_90
+	{{ { ROT_HALF_SQRT_2,  0, 2, +1 }, { ROT_HALF_SQRT_2,  0, 2, -1 }, { 1.0f,             1, 0,  0 } }},	// ROTATION_ROLL_90_YAW_45
+	{{ { 1.0f,             2, 0,  0 }, { 1.0f,             0, 0,  0 }, { 1.0f,             1, 0,  0 } }},	// ROTATION_ROLL_90_YAW_90
+	{{ { -ROT_HALF_SQRT_2, 0, 2, -1 }, { ROT_HALF_SQRT_2,  0, 2, +1 }, { 1.0f,             1, 0,  0 } }},	// ROTATION_ROLL_90_YAW_135
+	{{ { 1.0f,             0, 0,  0 }, { 1.0f,             2, 0,  0 }, { -1.0f,            1, 0,  0 } }},	// ROTATION_ROLL_270
+	{{ { ROT_HALF_SQRT_2,  0, 2, -1 }, { ROT_HALF_SQRT_2,  0, 2, +1 }, { -1.0f,            1, 0,  0 } }},	// ROTATION_ROLL_270_YAW_45
+	{{ { -1.0f,            2, 0,  0 }, { 1.0f,             0, 0,  0 }, { -1.0f,            1, 0,  0 } }},	// ROTATION_ROLL_270_YAW_90
+	{{ { -ROT_HALF_SQRT_2, 0, 2, +1 }, { ROT_HALF_SQRT_2,  0, 2, -1 }, { -1.0f,            1, 0,  0 } }},	// ROTATION_ROLL_270_YAW_135
+	{{ { 1.0f,             2, 0,  0 }, { 1.0f,             1, 0,  0 }, { -1.0f,            0, 0,  0 } }},	// ROTATION_PITCH_90
+	{{ { -1.0f,            2, 0,  0 }, { 1.0f,             1, 0,  0 }, { 1.0f,             0, 0,  0 } }},	// ROTATION_PITCH_270
+	{{ { 1.0f,             2, 0,  0 }, { -1.0f,            0, 0,  0 }, { -1.0f,            1, 0,  0 } }},	// ROTATION_ROLL_270_YAW_270
+	{{ { 1.0f,             2, 0,  0 }, { -1.0f,            1, 0,  0 }, { 1.0f,             0, 0,  0 } }},	// ROTATION_ROLL_180_PITCH_270
+	{{ { 1.0f,             2, 0,  0 }, { -1.0f,            1, 0,  0 }, { 1.0f,             0, 0,  0 } }},	// ROTATION_PITCH_90_YAW_180
+};
+
 /**
  * Get the rotation matrix
  */
@@ -131,5 +186,39 @@ get_rot_matrix(enum Rotation rot, math::Matrix<3, 3> *rot_matrix);
 __EXPORT void
 rotate_3f(enum Rotation rot, float &x, float &y, float &z);
 
+/**
+ * rotate an array of interleaved x, y, z samples in-place
+ */
+__EXPORT void
+rotate_3f_array(enum Rotation rot, float *xyz, size_t count);
+
+/**
+ * apply one row of a rotation table entry
+ */
+static inline float
+rotate_row(const rot_row_t &row, const float v[3])
+{
+	if (row.op == 0) {
+		return row.scale * v[row.a];
+	}
+
+	return row.scale * ((row.op > 0) ? (v[row.a] + v[row.b]) : (v[row.a] - v[row.b]));
+}
+
+/**
+ * rotate a 3 element float vector in-place, for a rotation known at compile time
+ */
+template <enum Rotation ROT>
+inline void
+rotate_3f(float &x, float &y, float &z)
+{
+	static_assert(ROT < ROTATION_MAX, "invalid rotation");
+
+	const float v[3] = { x, y, z };
+	x = rotate_row(rot_table[ROT].row[0], v);
+	y = rotate_row(rot_table[ROT].row[1], v);
+	z = rotate_row(rot_table[ROT].row[2], v);
+}
+
 
 #endif /* ROTATION_H_ */
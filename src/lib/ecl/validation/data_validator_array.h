@@ -0,0 +1,353 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file data_validator_array.h
+ *
+ * A fixed-size data validation group to identify anomalies in data streams.
+ *
+ * Same checks and switching rules as DataValidatorGroup, but the state of
+ * all instances lives in contiguous arrays sized at compile time, so there
+ * is no heap allocation and no list walk per sample.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <stdint.h>
+#include <ecl/ecl.h>
+
+template <unsigned N>
+class DataValidatorArray {
+public:
+	DataValidatorArray() :
+		_time_last{},
+		_timeout_interval(20000),
+		_event_count{},
+		_error_count{},
+		_error_density{},
+		_priority{},
+		_mean{},
+		_lp{},
+		_M2{},
+		_rms{},
+		_value{},
+		_value_equal_count{},
+		_curr_best(-1),
+		_prev_best(-1),
+		_first_failover_time(0),
+		_toggle_count(0)
+	{
+	}
+
+	/**
+	 * Put an item into the validator group.
+	 *
+	 * @param index		Sensor index, must be less than N
+	 * @param timestamp	The timestamp of the measurement
+	 * @param val		The 3D vector
+	 * @param error_count	The current error count of the sensor
+	 * @param priority	The priority of the sensor
+	 */
+	void			put(unsigned index, uint64_t timestamp,
+				    const float val[3], uint64_t error_count, int priority);
+
+	/**
+	 * Compute the confidence of all instances in one pass
+	 *
+	 * @param timestamp	The current time
+	 * @param confidence	Output, confidence between 0 and 1 per instance
+	 */
+	void			confidence(uint64_t timestamp, float confidence[N]);
+
+	/**
+	 * Get the best data triplet of the group
+	 *
+	 * @return		pointer to the array of best values
+	 */
+	const float		*get_best(uint64_t timestamp, int *index);
+
+	/**
+	 * Get the RMS / vibration factor
+	 *
+	 * @return		float value representing the RMS, which a valid indicator for vibration
+	 */
+	float			get_vibration_factor(uint64_t timestamp);
+
+	/**
+	 * Get the number of failover events
+	 *
+	 * @return		the number of failovers
+	 */
+	unsigned		failover_count() { return _toggle_count; }
+
+	/**
+	 * Print the validator value
+	 *
+	 */
+	void			print();
+
+	/**
+	 * Set the timeout value
+	 *
+	 * @param timeout_interval_us The timeout interval in microseconds
+	 */
+	void			set_timeout(uint64_t timeout_interval_us) { _timeout_interval = timeout_interval_us; }
+
+private:
+	static const unsigned _dimensions = 3;
+
+	uint64_t _time_last[N];			/**< last timestamp */
+	uint64_t _timeout_interval;		/**< interval in which the datastream times out in us */
+	uint64_t _event_count[N];		/**< total data counter */
+	uint64_t _error_count[N];		/**< error count */
+	int _error_density[N];			/**< ratio between successful reads and errors */
+	int _priority[N];			/**< sensor nominal priority */
+	float _mean[N][_dimensions];		/**< mean of value */
+	float _lp[N][_dimensions];		/**< low pass value */
+	float _M2[N][_dimensions];		/**< RMS component value */
+	float _rms[N][_dimensions];		/**< root mean square error */
+	float _value[N][_dimensions];		/**< last value */
+	float _value_equal_count[N];		/**< equal values in a row */
+
+	int _curr_best;				/**< currently best index */
+	int _prev_best;				/**< the previous best index */
+	uint64_t _first_failover_time;		/**< timestamp where the first failover occured or zero if none occured */
+	unsigned _toggle_count;			/**< number of back and forth switches between two sensors */
+
+	static constexpr unsigned NORETURN_ERRCOUNT = 10000;	/**< if the error count reaches this value, return sensor as invalid */
+	static constexpr float ERROR_DENSITY_WINDOW = 100.0f;	/**< window in measurement counts for errors */
+	static constexpr unsigned VALUE_EQUAL_COUNT_MAX = 100;	/**< if the sensor value is the same (accumulated also between axes) this many times, flag it */
+	static constexpr float MIN_REGULAR_CONFIDENCE = 0.9f;
+
+	/* we don't want this class to be copied */
+	DataValidatorArray(const DataValidatorArray &);
+	DataValidatorArray operator=(const DataValidatorArray &);
+};
+
+template <unsigned N>
+void
+DataValidatorArray<N>::put(unsigned index, uint64_t timestamp, const float val[3], uint64_t error_count_in,
+			   int priority_in)
+{
+	if (index >= N) {
+		return;
+	}
+
+	_event_count[index]++;
+
+	if (error_count_in > _error_count[index]) {
+		_error_density[index] += (error_count_in - _error_count[index]);
+
+	} else if (_error_density[index] > 0) {
+		_error_density[index]--;
+	}
+
+	_error_count[index] = error_count_in;
+	_priority[index] = priority_in;
+
+	float *mean = _mean[index];
+	float *lp = _lp[index];
+	float *M2 = _M2[index];
+	float *rms = _rms[index];
+	float *value = _value[index];
+
+	for (unsigned i = 0; i < _dimensions; i++) {
+		if (_time_last[index] == 0) {
+			mean[i] = 0;
+			lp[i] = val[i];
+			M2[i] = 0;
+
+		} else {
+			float lp_val = val[i] - lp[i];
+
+			float delta_val = lp_val - mean[i];
+			mean[i] += delta_val / _event_count[index];
+			M2[i] += delta_val * (lp_val - mean[i]);
+			rms[i] = sqrtf(M2[i] / (_event_count[index] - 1));
+
+			if (fabsf(value[i] - val[i]) < 0.000001f) {
+				_value_equal_count[index]++;
+
+			} else {
+				_value_equal_count[index] = 0;
+			}
+		}
+
+		lp[i] = lp[i] * 0.5f + val[i] * 0.5f;
+
+		value[i] = val[i];
+	}
+
+	_time_last[index] = timestamp;
+}
+
+template <unsigned N>
+void
+DataValidatorArray<N>::confidence(uint64_t timestamp, float confidence[N])
+{
+	for (unsigned i = 0; i < N; i++) {
+		/* no data, too many errors, stuck value or timed out */
+		const bool valid = (_time_last[i] != 0) &&
+				   (_error_count[i] <= NORETURN_ERRCOUNT) &&
+				   (_value_equal_count[i] <= VALUE_EQUAL_COUNT_MAX) &&
+				   (timestamp - _time_last[i] <= _timeout_interval);
+
+		/* cap error density counter at window size */
+		if (valid && _error_density[i] > ERROR_DENSITY_WINDOW) {
+			_error_density[i] = ERROR_DENSITY_WINDOW;
+		}
+
+		/* local error density for last N measurements */
+		confidence[i] = valid ? 1.0f - (_error_density[i] / ERROR_DENSITY_WINDOW) : 0.0f;
+	}
+}
+
+template <unsigned N>
+const float *
+DataValidatorArray<N>::get_best(uint64_t timestamp, int *index)
+{
+	float conf[N];
+	confidence(timestamp, conf);
+
+	int pre_check_best = _curr_best;
+	float pre_check_confidence = (pre_check_best >= 0) ? conf[pre_check_best] : 1.0f;
+	int pre_check_prio = (pre_check_best >= 0) ? _priority[pre_check_best] : -1;
+	float max_confidence = -1.0f;
+	int max_priority = -1000;
+	int max_index = -1;
+
+	for (unsigned i = 0; i < N; i++) {
+		/*
+		 * Switch if:
+		 * 1) the confidence is higher and priority is equal or higher
+		 * 2) the confidence is no less than 1% different and the priority is higher
+		 */
+		if (((max_confidence < MIN_REGULAR_CONFIDENCE) && (conf[i] >= MIN_REGULAR_CONFIDENCE)) ||
+		    (conf[i] > max_confidence && (_priority[i] >= max_priority)) ||
+		    (fabsf(conf[i] - max_confidence) < 0.01f && (_priority[i] > max_priority))
+		   ) {
+			max_index = i;
+			max_confidence = conf[i];
+			max_priority = _priority[i];
+		}
+	}
+
+	/* the current best sensor is not matching the previous best sensor */
+	if (max_index != _curr_best) {
+
+		bool true_failsafe = true;
+
+		/* check wether the switch was a failsafe or preferring a higher priority sensor */
+		if (pre_check_prio != -1 && pre_check_prio < max_priority &&
+		    fabsf(pre_check_confidence - max_confidence) < 0.1f) {
+			/* this is not a failover */
+			true_failsafe = false;
+		}
+
+		/* if we're no initialized, initialize the bookkeeping but do not count a failsafe */
+		if (_curr_best < 0) {
+			_prev_best = max_index;
+
+		} else {
+			/* we were initialized before, this is a real failsafe */
+			_prev_best = pre_check_best;
+
+			if (true_failsafe) {
+				_toggle_count++;
+
+				/* if this is the first time, log when we failed */
+				if (_first_failover_time == 0) {
+					_first_failover_time = timestamp;
+				}
+			}
+		}
+
+		/* for all cases we want to keep a record of the best index */
+		_curr_best = max_index;
+	}
+
+	*index = max_index;
+	return (max_index >= 0) ? _value[max_index] : nullptr;
+}
+
+template <unsigned N>
+float
+DataValidatorArray<N>::get_vibration_factor(uint64_t timestamp)
+{
+	float conf[N];
+	confidence(timestamp, conf);
+
+	float vibe = 0.0f;
+
+	/* find the best RMS value of a non-timed out sensor */
+	for (unsigned i = 0; i < N; i++) {
+		if (conf[i] > 0.5f) {
+			for (unsigned j = 0; j < _dimensions; j++) {
+				if (_rms[i][j] > vibe) {
+					vibe = _rms[i][j];
+				}
+			}
+		}
+	}
+
+	return vibe;
+}
+
+template <unsigned N>
+void
+DataValidatorArray<N>::print()
+{
+	/* print the group's state */
+	ECL_INFO("validator: best: %d, prev best: %d, failsafe: %s (# %u)",
+		 _curr_best, _prev_best, (_toggle_count > 0) ? "YES" : "NO",
+		 _toggle_count);
+
+	float conf[N];
+	confidence(hrt_absolute_time(), conf);
+
+	for (unsigned i = 0; i < N; i++) {
+		if (_time_last[i] == 0) {
+			continue;
+		}
+
+		ECL_INFO("sensor #%u, prio: %d", i, _priority[i]);
+
+		for (unsigned j = 0; j < _dimensions; j++) {
+			ECL_INFO("\tval: %8.4f, lp: %8.4f mean dev: %8.4f RMS: %8.4f conf: %8.4f",
+				 (double)_value[i][j], (double)_lp[i][j], (double)_mean[i][j],
+				 (double)_rms[i][j], (double)conf[i]);
+		}
+	}
+}
@@ -60,7 +60,7 @@
  * formulas according to: http://mathworld.wolfram.com/AzimuthalEquidistantProjection.html
  */
 
-static struct map_projection_reference_s mp_ref = {0.0, 0.0, 0.0, 0.0, false, 0};
+static struct map_projection_reference_s mp_ref = {0.0, 0.0, 0.0, 0.0, 0.0f, false, 0};
 static struct globallocal_converter_reference_s gl_ref = {0.0f, false};
 
 __EXPORT bool map_projection_global_initialized()
@@ -103,6 +103,17 @@ __EXPORT int map_projection_init_timestamped(struct map_projection_reference_s *
 	ref->sin_lat = sin(ref->lat_rad);
 	ref->cos_lat = cos(ref->lat_rad);
 
+	/* The error of the second order expansion in map_projection_project_array()
+	 * grows with d^3 / R^2 and with the convergence of the meridians, it stays
+	 * below 0.2 * d^3 / R^2 * (1 + 2 tan^2(lat_0)). Solve for the distance at
+	 * which it reaches the allowed error, once here rather than per call. */
+	const double cos2 = ref->cos_lat * ref->cos_lat;
+	const double sin2 = ref->sin_lat * ref->sin_lat;
+	const double radius_earth = CONSTANTS_RADIUS_OF_EARTH;
+	const double fast_radius = cbrt((double)MAP_PROJECTION_FAST_MAX_ERROR * radius_earth * radius_earth * cos2 /
+					(0.2 * (cos2 + 2.0 * sin2)));
+	ref->fast_radius_rad_sq = (float)(fast_radius * fast_radius / (radius_earth * radius_earth));
+
 	ref->timestamp = timestamp;
 	ref->init_done = true;
 
@@ -162,6 +173,36 @@ __EXPORT int map_projection_project(const struct map_projection_reference_s *ref
 	return 0;
 }
 
+__EXPORT int map_projection_project_array(const struct map_projection_reference_s *ref, const double lat[],
+		const double lon[], float x[], float y[], unsigned count)
+{
+	if (!map_projection_initialized(ref)) {
+		return -1;
+	}
+
+	/* the valid radius of the expansion is computed by map_projection_init() */
+	const float fast_radius_rad_sq = ref->fast_radius_rad_sq;
+	const float sin_lat_0 = (float)ref->sin_lat;
+	const float cos_lat_0 = (float)ref->cos_lat;
+
+	for (unsigned i = 0; i < count; i++) {
+		/* differences in double, the rest only needs single precision */
+		const float d_lat = (float)(lat[i] * M_DEG_TO_RAD - ref->lat_rad);
+		const float d_lon = (float)(lon[i] * M_DEG_TO_RAD - ref->lon_rad);
+		const float d_lon_east = cos_lat_0 * d_lon;
+
+		if (d_lat * d_lat + d_lon_east * d_lon_east > fast_radius_rad_sq) {
+			map_projection_project(ref, lat[i], lon[i], &x[i], &y[i]);
+			continue;
+		}
+
+		x[i] = (d_lat + 0.5f * sin_lat_0 * d_lon_east * d_lon) * CONSTANTS_RADIUS_OF_EARTH;
+		y[i] = (d_lon_east - sin_lat_0 * d_lat * d_lon) * CONSTANTS_RADIUS_OF_EARTH;
+	}
+
+	return 0;
+}
+
 __EXPORT int map_projection_global_reproject(float x, float y, double *lat, double *lon)
 {
 	return map_projection_reproject(&mp_ref, x, y, lat, lon);
@@ -70,6 +70,7 @@ struct map_projection_reference_s {
 	double lon_rad;
 	double sin_lat;
 	double cos_lat;
+	float fast_radius_rad_sq;	/**< squared radius of the fast projection, see map_projection_project_array() */
 	bool init_done;
 	uint64_t timestamp;
 };
@@ -170,6 +171,31 @@ __EXPORT int map_projection_global_project(double lat, double lon, float *x, flo
 __EXPORT int map_projection_project(const struct map_projection_reference_s *ref, double lat, double lon, float *x,
 				    float *y);
 
+/**
+ * Maximum error in meters of the local tangent approximation used by
+ * map_projection_project_array(), points further out are projected exactly
+ */
+#define MAP_PROJECTION_FAST_MAX_ERROR	0.05f
+
+/**
+ * Transforms an array of points in the geographic coordinate system to the local
+ * azimuthal equidistant plane using the projection given by the argument.
+ *
+ * Points close to the reference use a second order local tangent expansion in
+ * single precision, which stays within MAP_PROJECTION_FAST_MAX_ERROR of
+ * map_projection_project(). The valid radius shrinks towards the poles, points
+ * outside of it fall back to the exact formula.
+ *
+ * @param lat array of latitudes in degrees
+ * @param lon array of longitudes in degrees
+ * @param x array of north coordinates
+ * @param y array of east coordinates
+ * @param count number of points
+ * @return 0 if map_projection_init was called before, -1 else
+ */
+__EXPORT int map_projection_project_array(const struct map_projection_reference_s *ref, const double lat[],
+		const double lon[], float x[], float y[], unsigned count);
+
 /**
  * Transforms a point in the local azimuthal equidistant plane to the
  * geographic coordinate system using the global projection
@@ -34,98 +34,163 @@
 /**
 * @file geo_mag_declination.c
 *
-* Calculation / lookup table for earth magnetic field declination.
+* Calculation / lookup table for earth magnetic field declination,
+* inclination and strength.
 *
-* Lookup table from Scott Ferguson <scottfromscott@gmail.com>
-*
-* XXX Lookup table currently too coarse in resolution (only full degrees)
-* and lat/lon res - needs extension medium term.
+* The grid in geo_magnetic_tables.h is generated by
+* Tools/px_generate_mag_tables.py and covers the whole globe.
 *
 */
 
 #include <geo/geo.h>
+#include <math.h>
+
+#include "geo_mag_declination.h"
+#include "geo_magnetic_tables.h"
 
-/** set this always to the sampling in degrees for the table below */
-#define SAMPLING_RES		10.0f
-#define SAMPLING_MIN_LAT	-60.0f
-#define SAMPLING_MAX_LAT	60.0f
+/** set these always to the sampling in degrees of the tables */
+#define SAMPLING_RES_LAT	5.0f
+#define SAMPLING_RES_LON	10.0f
+#define SAMPLING_MIN_LAT	-90.0f
+#define SAMPLING_MAX_LAT	90.0f
 #define SAMPLING_MIN_LON	-180.0f
 #define SAMPLING_MAX_LON	180.0f
 
-static const int8_t declination_table[13][37] = \
+#define SAMPLING_LAT_CELLS	((int)((SAMPLING_MAX_LAT - SAMPLING_MIN_LAT) / SAMPLING_RES_LAT))
+#define SAMPLING_LON_CELLS	((int)((SAMPLING_MAX_LON - SAMPLING_MIN_LON) / SAMPLING_RES_LON))
+
+/** fixed point scaling of the tables */
+#define TABLE_ANGLE_LSB		0.01f		/**< degrees */
+#define TABLE_STRENGTH_LSB	0.0001f		/**< Gauss, 10 nT */
+
+static float wrap_180(float angle)
 {
-	{ 46, 45, 44, 42, 41, 40, 38, 36, 33, 28, 23, 16, 10, 4, -1, -5, -9, -14, -19, -26, -33, -40, -48, -55, -61, -66, -71, -74, -75, -72, -61, -25, 22, 40, 45, 47, 46 },
-	{ 30, 30, 30, 30, 29, 29, 29, 29, 27, 24, 18, 11, 3, -3, -9, -12, -15, -17, -21, -26, -32, -39, -45, -51, -55, -57, -56, -53, -44, -31, -14, 0, 13, 21, 26, 29, 30 },
-	{ 21, 22, 22, 22, 22, 22, 22, 22, 21, 18, 13, 5, -3, -11, -17, -20, -21, -22, -23, -25, -29, -35, -40, -44, -45, -44, -40, -32, -22, -12, -3, 3, 9, 14, 18, 20, 21 },
-	{ 16, 17, 17, 17, 17, 17, 16, 16, 16, 13, 8, 0, -9, -16, -21, -24, -25, -25, -23, -20, -21, -24, -28, -31, -31, -29, -24, -17, -9, -3, 0, 4, 7, 10, 13, 15, 16 },
-	{ 12, 13, 13, 13, 13, 13, 12, 12, 11, 9, 3, -4, -12, -19, -23, -24, -24, -22, -17, -12, -9, -10, -13, -17, -18, -16, -13, -8, -3, 0, 1, 3, 6, 8, 10, 12, 12 },
-	{ 10, 10, 10, 10, 10, 10, 10, 9, 9, 6, 0, -6, -14, -20, -22, -22, -19, -15, -10, -6, -2, -2, -4, -7, -8, -8, -7, -4, 0, 1, 1, 2, 4, 6, 8, 10, 10 },
-	{ 9, 9, 9, 9, 9, 9, 8, 8, 7, 4, -1, -8, -15, -19, -20, -18, -14, -9, -5, -2, 0, 1, 0, -2, -3, -4, -3, -2, 0, 0, 0, 1, 3, 5, 7, 8, 9 },
-	{ 8, 8, 8, 9, 9, 9, 8, 8, 6, 2, -3, -9, -15, -18, -17, -14, -10, -6, -2, 0, 1, 2, 2, 0, -1, -1, -2, -1, 0, 0, 0, 0, 1, 3, 5, 7, 8 },
-	{ 8, 9, 9, 10, 10, 10, 10, 8, 5, 0, -5, -11, -15, -16, -15, -12, -8, -4, -1, 0, 2, 3, 2, 1, 0, 0, 0, 0, 0, -1, -2, -2, -1, 0, 3, 6, 8 },
-	{ 6, 9, 10, 11, 12, 12, 11, 9, 5, 0, -7, -12, -15, -15, -13, -10, -7, -3, 0, 1, 2, 3, 3, 3, 2, 1, 0, 0, -1, -3, -4, -5, -5, -2, 0, 3, 6 },
-	{ 5, 8, 11, 13, 15, 15, 14, 11, 5, -1, -9, -14, -17, -16, -14, -11, -7, -3, 0, 1, 3, 4, 5, 5, 5, 4, 3, 1, -1, -4, -7, -8, -8, -6, -2, 1, 5 },
-	{ 4, 8, 12, 15, 17, 18, 16, 12, 5, -3, -12, -18, -20, -19, -16, -13, -8, -4, -1, 1, 4, 6, 8, 9, 9, 9, 7, 3, -1, -6, -10, -12, -11, -9, -5, 0, 4 },
-	{ 3, 9, 14, 17, 20, 21, 19, 14, 4, -8, -19, -25, -26, -25, -21, -17, -12, -7, -2, 1, 5, 9, 13, 15, 16, 16, 13, 7, 0, -7, -12, -15, -14, -11, -6, -1, 3 },
-};
-
-static float get_lookup_table_val(unsigned lat, unsigned lon);
+	while (angle > 180.0f) {
+		angle -= 360.0f;
+	}
 
-__EXPORT float get_mag_declination(float lat, float lon)
+	while (angle < -180.0f) {
+		angle += 360.0f;
+	}
+
+	return angle;
+}
+
+/**
+ * Load the bilinear coefficients of one table cell: v = c0 + c1 * x + c2 * y + c3 * x * y
+ */
+static void load_cell(const int16_t table[SAMPLING_LAT_CELLS + 1][SAMPLING_LON_CELLS + 1], int lat_index, int lon_index,
+		      float lsb, bool wrap, float coeff[4])
+{
+	float sw = table[lat_index][lon_index] * lsb;
+	float se = table[lat_index][lon_index + 1] * lsb;
+	float nw = table[lat_index + 1][lon_index] * lsb;
+	float ne = table[lat_index + 1][lon_index + 1] * lsb;
+
+	/* declination wraps around near the magnetic poles, interpolate relative to the first corner */
+	if (wrap) {
+		se = sw + wrap_180(se - sw);
+		nw = sw + wrap_180(nw - sw);
+		ne = sw + wrap_180(ne - sw);
+	}
+
+	coeff[0] = sw;
+	coeff[1] = se - sw;
+	coeff[2] = nw - sw;
+	coeff[3] = ne - nw - se + sw;
+}
+
+__EXPORT void mag_field_cache_init(struct mag_field_cache_s *cache)
+{
+	cache->lat_index = -1;
+	cache->lon_index = -1;
+}
+
+__EXPORT int get_mag_field(struct mag_field_cache_s *cache, float lat, float lon,
+			   float *declination, float *inclination, float *strength)
 {
 	/*
-	 * If the values exceed valid ranges, return zero as default
-	 * as we have no way of knowing what the closest real value
+	 * If the values exceed valid ranges, return an error as
+	 * we have no way of knowing what the closest real value
 	 * would be.
 	 */
-	if (lat < -90.0f || lat > 90.0f ||
-	    lon < -180.0f || lon > 180.0f) {
-		return 0.0f;
+	if (!(lat >= SAMPLING_MIN_LAT && lat <= SAMPLING_MAX_LAT &&
+	      lon >= SAMPLING_MIN_LON && lon <= SAMPLING_MAX_LON)) {
+		return -1;
 	}
 
-	/* round down to nearest sampling resolution */
-	int min_lat = (int)(lat / SAMPLING_RES) * SAMPLING_RES;
-	int min_lon = (int)(lon / SAMPLING_RES) * SAMPLING_RES;
+	/* index of the cell, the upper bounds belong to the last cell */
+	int lat_index = (int)((lat - SAMPLING_MIN_LAT) / SAMPLING_RES_LAT);
+	int lon_index = (int)((lon - SAMPLING_MIN_LON) / SAMPLING_RES_LON);
 
-	/* for the rare case of hitting the bounds exactly
-	 * the rounding logic wouldn't fit, so enforce it.
-	 */
+	if (lat_index >= SAMPLING_LAT_CELLS) {
+		lat_index = SAMPLING_LAT_CELLS - 1;
+	}
 
-	/* limit to table bounds - required for maxima even when table spans full globe range */
-	if (lat <= SAMPLING_MIN_LAT) {
-		min_lat = SAMPLING_MIN_LAT;
+	if (lon_index >= SAMPLING_LON_CELLS) {
+		lon_index = SAMPLING_LON_CELLS - 1;
 	}
 
-	if (lat >= SAMPLING_MAX_LAT) {
-		min_lat = (int)(lat / SAMPLING_RES) * SAMPLING_RES - SAMPLING_RES;
+	/* only touch the tables when entering a new cell */
+	if (lat_index != cache->lat_index || lon_index != cache->lon_index) {
+		load_cell(declination_table, lat_index, lon_index, TABLE_ANGLE_LSB, true, cache->declination);
+		load_cell(inclination_table, lat_index, lon_index, TABLE_ANGLE_LSB, false, cache->inclination);
+		load_cell(strength_table, lat_index, lon_index, TABLE_STRENGTH_LSB, false, cache->strength);
+		cache->lat_index = lat_index;
+		cache->lon_index = lon_index;
 	}
 
-	if (lon <= SAMPLING_MIN_LON) {
-		min_lon = SAMPLING_MIN_LON;
+	const float x = (lon - SAMPLING_MIN_LON) / SAMPLING_RES_LON - lon_index;
+	const float y = (lat - SAMPLING_MIN_LAT) / SAMPLING_RES_LAT - lat_index;
+	const float xy = x * y;
+
+	if (declination != NULL) {
+		const float *c = cache->declination;
+		*declination = wrap_180(c[0] + c[1] * x + c[2] * y + c[3] * xy);
 	}
 
-	if (lon >= SAMPLING_MAX_LON) {
-		min_lon = (int)(lon / SAMPLING_RES) * SAMPLING_RES - SAMPLING_RES;
+	if (inclination != NULL) {
+		const float *c = cache->inclination;
+		*inclination = c[0] + c[1] * x + c[2] * y + c[3] * xy;
 	}
 
-	/* find index of nearest low sampling point */
-	unsigned min_lat_index = (-(SAMPLING_MIN_LAT) + min_lat)  / SAMPLING_RES;
-	unsigned min_lon_index = (-(SAMPLING_MIN_LON) + min_lon) / SAMPLING_RES;
+	if (strength != NULL) {
+		const float *c = cache->strength;
+		*strength = c[0] + c[1] * x + c[2] * y + c[3] * xy;
+	}
 
-	float declination_sw = get_lookup_table_val(min_lat_index, min_lon_index);
-	float declination_se = get_lookup_table_val(min_lat_index, min_lon_index + 1);
-	float declination_ne = get_lookup_table_val(min_lat_index + 1, min_lon_index + 1);
-	float declination_nw = get_lookup_table_val(min_lat_index + 1, min_lon_index);
+	return 0;
+}
 
-	/* perform bilinear interpolation on the four grid corners */
+__EXPORT float get_mag_declination(float lat, float lon)
+{
+	struct mag_field_cache_s cache;
+	float declination = 0.0f;
 
-	float declination_min = ((lon - min_lon) / SAMPLING_RES) * (declination_se - declination_sw) + declination_sw;
-	float declination_max = ((lon - min_lon) / SAMPLING_RES) * (declination_ne - declination_nw) + declination_nw;
+	mag_field_cache_init(&cache);
+	get_mag_field(&cache, lat, lon, &declination, NULL, NULL);
 
-	return ((lat - min_lat) / SAMPLING_RES) * (declination_max - declination_min) + declination_min;
+	return declination;
 }
 
-float get_lookup_table_val(unsigned lat_index, unsigned lon_index)
+__EXPORT float get_mag_inclination(float lat, float lon)
 {
-	return declination_table[lat_index][lon_index];
-}
\ No newline at end of file
+	struct mag_field_cache_s cache;
+	float inclination = 0.0f;
+
+	mag_field_cache_init(&cache);
+	get_mag_field(&cache, lat, lon, NULL, &inclination, NULL);
+
+	return inclination;
+}
+
+__EXPORT float get_mag_strength(float lat, float lon)
+{
+	struct mag_field_cache_s cache;
+	float strength = 0.0f;
+
+	mag_field_cache_init(&cache);
+	get_mag_field(&cache, lat, lon, NULL, NULL, &strength);
+
+	return strength;
+}
@@ -34,7 +34,8 @@
 /**
 * @file geo_mag_declination.h
 *
-* Calculation / lookup table for earth magnetic field declination.
+* Calculation / lookup table for earth magnetic field declination,
+* inclination and strength.
 *
 */
 
@@ -42,6 +43,42 @@
 
 __BEGIN_DECLS
 
+/**
+ * Bilinear coefficients of the last table cell looked up, so repeated
+ * queries within the same cell do not touch the tables again.
+ * Initialize with mag_field_cache_init(), one instance per caller.
+ */
+struct mag_field_cache_s {
+	int lat_index;
+	int lon_index;
+	float declination[4];
+	float inclination[4];
+	float strength[4];
+};
+
+__EXPORT void mag_field_cache_init(struct mag_field_cache_s *cache);
+
+/**
+ * Look up the earth magnetic field at sea level.
+ *
+ * @param cache		cell cache of the caller
+ * @param lat		latitude in degrees
+ * @param lon		longitude in degrees
+ * @param declination	declination in degrees, positive east, may be NULL
+ * @param inclination	inclination in degrees, positive down, may be NULL
+ * @param strength	total field strength in Gauss, may be NULL
+ * @return		0 on success, -1 if lat / lon are out of range
+ */
+__EXPORT int get_mag_field(struct mag_field_cache_s *cache, float lat, float lon,
+			   float *declination, float *inclination, float *strength);
+
+/** declination in degrees, 0 if lat / lon are out of range */
 __EXPORT float get_mag_declination(float lat, float lon);
 
+/** inclination in degrees, 0 if lat / lon are out of range */
+__EXPORT float get_mag_inclination(float lat, float lon);
+
+/** total field strength in Gauss, 0 if lat / lon are out of range */
+__EXPORT float get_mag_strength(float lat, float lon);
+
 __END_DECLS
@@ -0,0 +1,130 @@
+/* Auto-generated by Tools/px_generate_mag_tables.py, do not edit */
+/* Epoch 2015.0, WMM2015.COF, 5 x 10 deg grid */
+
+#pragma once
+
+#include <stdint.h>
+
+/* declination in 0.01 deg, positive east */
+static const int16_t declination_table[37][37] = {
+	{ 14994, 13996, 12996, 11996, 10995, 9995, 8996, 7996, 6995, 5996, 4994, 3995, 2997, 1996, 995, -4, -1005, -2006, -3006, -4004, -5004, -6004, -7005, -8004, -9004, -10004, -11005, -12005, -13006, -14005, -15002, -16004, -17005, 17996, 16996, 15995, 14994 },
+	{ 14257, 13131, 12040, 10985, 9966, 8979, 8021, 7088, 6177, 5282, 4401, 3530, 2666, 1805, 945, 83, -785, -1660, -2547, -3445, -4359, -5289, -6236, -7203, -8192, -9203, -10240, -11303, -12395, -13516, -14663, -15834, -17021, 17784, 16592, 15413, 14257 },
+	{ 13040, 11804, 10680, 9655, 8709, 7823, 6981, 6169, 5379, 4604, 3839, 3082, 2331, 1584, 836, 83, -681, -1460, -2260, -3084, -3932, -4804, -5700, -6620, -7567, -8544, -9560, -10626, -11754, -12960, -14256, -15646, -17119, 17361, 15847, 14393, 13040 },
+	{ 11096, 9918, 8943, 8106, 7359, 6665, 5998, 5340, 4679, 4012, 3339, 2665, 1995, 1331, 673, 13, -660, -1357, -2088, -2856, -3659, -4490, -5344, -6214, -7101, -8009, -8949, -9942, -11022, -12237, -13654, -15350, -17352, 16460, 14356, 12555, 11096 },
+	{ 8551, 7755, 7120, 6581, 6095, 5628, 5155, 4654, 4114, 3533, 2920, 2291, 1664, 1052, 461, -119, -707, -1328, -1998, -2723, -3496, -4299, -5117, -5935, -6746, -7552, -8364, -9205, -10116, -11177, -12558, -14637, 17999, 14024, 11273, 9633, 8551 },
+	{ 6258, 5899, 5581, 5297, 5031, 4764, 4465, 4108, 3674, 3161, 2581, 1962, 1340, 746, 198, -312, -818, -1360, -1970, -2658, -3408, -4191, -4974, -5733, -6453, -7131, -7767, -8371, -8956, -9548, -10223, -11422, 10995, 7910, 7172, 6672, 6258 },
+	{ 4704, 4586, 4447, 4312, 4187, 4059, 3899, 3666, 3328, 2870, 2304, 1668, 1017, 409, -120, -572, -993, -1448, -1990, -2637, -3365, -4126, -4871, -5563, -6180, -6706, -7128, -7421, -7526, -7277, -6129, -2349, 2398, 4130, 4644, 4755, 4704 },
+	{ 3715, 3700, 3644, 3580, 3526, 3481, 3417, 3285, 3032, 2624, 2063, 1391, 685, 35, -495, -900, -1235, -1588, -2044, -2635, -3333, -4067, -4769, -5387, -5887, -6245, -6426, -6370, -5946, -4906, -2944, -377, 1652, 2805, 3382, 3637, 3715 },
+	{ 3053, 3081, 3063, 3029, 3003, 2996, 2990, 2931, 2752, 2392, 1832, 1114, 338, -368, -913, -1282, -1535, -1779, -2123, -2633, -3283, -3982, -4631, -5165, -5540, -5719, -5654, -5264, -4436, -3105, -1447, 130, 1341, 2158, 2660, 2933, 3053 },
+	{ 2575, 2621, 2622, 2602, 2584, 2585, 2601, 2588, 2466, 2149, 1592, 827, -19, -779, -1336, -1676, -1867, -2007, -2218, -2608, -3183, -3830, -4418, -4860, -5104, -5106, -4818, -4178, -3169, -1930, -715, 319, 1140, 1757, 2184, 2444, 2575 },
+	{ 2205, 2259, 2272, 2262, 2243, 2236, 2249, 2253, 2169, 1888, 1335, 533, -367, -1158, -1711, -2027, -2180, -2242, -2308, -2532, -2989, -3563, -4083, -4435, -4554, -4404, -3953, -3186, -2188, -1176, -314, 393, 986, 1472, 1838, 2078, 2205 },
+	{ 1908, 1961, 1983, 1982, 1962, 1942, 1938, 1940, 1874, 1617, 1068, 243, -684, -1476, -2004, -2291, -2420, -2425, -2348, -2362, -2645, -3123, -3583, -3865, -3894, -3645, -3118, -2345, -1463, -682, -80, 414, 860, 1255, 1572, 1789, 1908 },
+	{ 1663, 1711, 1737, 1745, 1728, 1697, 1673, 1661, 1599, 1353, 805, -28, -954, -1719, -2205, -2455, -2550, -2494, -2274, -2058, -2126, -2490, -2910, -3169, -3165, -2891, -2378, -1678, -941, -355, 58, 407, 755, 1085, 1362, 1557, 1663 },
+	{ 1462, 1501, 1526, 1541, 1529, 1491, 1451, 1425, 1358, 1112, 562, -267, -1168, -1888, -2322, -2519, -2552, -2408, -2053, -1646, -1508, -1745, -2141, -2420, -2443, -2209, -1770, -1177, -576, -141, 135, 383, 665, 949, 1195, 1371, 1462 },
+	{ 1300, 1325, 1346, 1364, 1357, 1318, 1270, 1235, 1159, 904, 349, -466, -1327, -1992, -2366, -2490, -2427, -2175, -1723, -1217, -942, -1055, -1412, -1722, -1800, -1642, -1299, -816, -329, -7, 169, 347, 587, 839, 1062, 1223, 1300 },
+	{ 1172, 1183, 1194, 1212, 1210, 1174, 1126, 1087, 1001, 731, 170, -625, -1435, -2040, -2346, -2379, -2202, -1851, -1361, -851, -523, -536, -830, -1148, -1278, -1196, -948, -565, -172, 67, 173, 304, 516, 749, 957, 1108, 1172 },
+	{ 1076, 1072, 1072, 1088, 1088, 1057, 1013, 974, 878, 589, 23, -745, -1502, -2042, -2273, -2208, -1922, -1506, -1030, -573, -249, -194, -419, -719, -879, -859, -691, -395, -79, 96, 153, 252, 447, 671, 873, 1020, 1076 },
+	{ 1006, 992, 980, 992, 996, 970, 931, 892, 780, 470, -100, -837, -1537, -2010, -2162, -2006, -1638, -1191, -758, -372, -78, 15, -148, -416, -586, -608, -505, -282, -34, 92, 113, 191, 375, 596, 801, 952, 1006 },
+	{ 957, 938, 919, 930, 938, 917, 880, 835, 702, 367, -205, -907, -1550, -1953, -2030, -1800, -1382, -932, -546, -227, 31, 141, 26, -209, -376, -423, -368, -208, -20, 62, 57, 117, 294, 516, 732, 897, 957 },
+	{ 922, 908, 887, 900, 916, 900, 862, 801, 638, 274, -299, -967, -1549, -1881, -1887, -1607, -1170, -730, -385, -119, 104, 218, 137, -67, -226, -286, -265, -159, -27, 15, -14, 30, 197, 424, 657, 843, 922 },
+	{ 891, 895, 882, 903, 930, 920, 876, 790, 588, 189, -388, -1021, -1541, -1800, -1746, -1437, -1001, -579, -264, -37, 157, 269, 211, 33, -115, -180, -183, -123, -44, -43, -97, -73, 82, 314, 566, 783, 891 },
+	{ 855, 893, 900, 936, 977, 974, 920, 802, 553, 114, -474, -1076, -1532, -1718, -1614, -1293, -870, -468, -173, 30, 200, 307, 265, 109, -26, -92, -113, -92, -65, -107, -191, -191, -52, 182, 456, 706, 855 },
+	{ 808, 894, 935, 994, 1051, 1054, 988, 835, 534, 48, -558, -1134, -1527, -1645, -1500, -1177, -773, -388, -104, 84, 237, 339, 311, 178, 54, -11, -45, -60, -86, -175, -293, -323, -203, 31, 324, 611, 808 },
+	{ 745, 891, 981, 1071, 1145, 1154, 1075, 885, 531, -8, -640, -1198, -1534, -1591, -1413, -1091, -705, -333, -54, 131, 273, 370, 358, 250, 141, 75, 27, -24, -103, -244, -403, -464, -366, -135, 175, 495, 745 },
+	{ 668, 880, 1031, 1159, 1252, 1266, 1174, 947, 538, -57, -723, -1270, -1559, -1565, -1361, -1039, -665, -302, -19, 169, 309, 406, 415, 336, 245, 178, 111, 20, -117, -315, -518, -612, -535, -306, 17, 367, 668 },
+	{ 583, 863, 1080, 1252, 1366, 1384, 1278, 1016, 552, -105, -811, -1356, -1609, -1577, -1351, -1026, -655, -293, -2, 199, 345, 452, 487, 446, 377, 306, 214, 75, -127, -389, -639, -765, -703, -476, -140, 235, 583 },
+	{ 500, 842, 1125, 1344, 1482, 1505, 1386, 1088, 564, -160, -914, -1464, -1693, -1633, -1390, -1054, -679, -309, -3, 220, 385, 513, 585, 588, 546, 470, 343, 145, -133, -466, -767, -919, -868, -637, -289, 110, 500 },
+	{ 430, 826, 1166, 1432, 1598, 1632, 1501, 1162, 571, -234, -1045, -1607, -1820, -1740, -1480, -1129, -740, -355, -24, 232, 431, 595, 714, 769, 758, 676, 507, 236, -132, -547, -900, -1073, -1024, -784, -420, 2, 430 },
+	{ 379, 819, 1208, 1518, 1716, 1766, 1626, 1241, 564, -343, -1224, -1802, -2002, -1905, -1627, -1255, -843, -433, -67, 236, 488, 706, 883, 995, 1019, 934, 717, 358, -119, -630, -1036, -1226, -1170, -914, -530, -83, 379 },
+	{ 348, 825, 1255, 1606, 1839, 1912, 1765, 1325, 534, -511, -1479, -2073, -2256, -2136, -1833, -1433, -990, -543, -129, 237, 560, 848, 1095, 1271, 1337, 1254, 987, 525, -84, -708, -1174, -1374, -1304, -1027, -619, -145, 348 },
+	{ 333, 843, 1310, 1699, 1971, 2071, 1919, 1408, 456, -781, -1855, -2453, -2601, -2442, -2101, -1662, -1176, -680, -203, 241, 650, 1024, 1351, 1598, 1716, 1650, 1342, 767, -3, -768, -1303, -1512, -1426, -1125, -691, -190, 333 },
+	{ 328, 870, 1371, 1800, 2112, 2240, 2077, 1461, 267, -1240, -2416, -2976, -3050, -2825, -2426, -1932, -1389, -830, -278, 254, 758, 1228, 1644, 1973, 2163, 2140, 1819, 1137, 174, -773, -1403, -1631, -1531, -1208, -750, -223, 328 },
+	{ 327, 898, 1433, 1899, 2248, 2396, 2195, 1393, -201, -2053, -3240, -3662, -3601, -3269, -2786, -2219, -1606, -974, -340, 283, 884, 1451, 1963, 2388, 2675, 2741, 2469, 1732, 563, -637, -1419, -1700, -1604, -1270, -796, -249, 327 },
+	{ 332, 923, 1484, 1976, 2340, 2466, 2125, 887, -1414, -3457, -4350, -4476, -4208, -3734, -3145, -2490, -1798, -1089, -375, 332, 1021, 1681, 2292, 2826, 3240, 3458, 3350, 2721, 1443, -101, -1189, -1623, -1591, -1280, -811, -258, 332 },
+	{ 388, 965, 1511, 1972, 2252, 2141, 1128, -1526, -4340, -5493, -5635, -5330, -4809, -4171, -3465, -2720, -1951, -1169, -385, 395, 1161, 1905, 2614, 3268, 3838, 4273, 4481, 4288, 3415, 1744, 8, -965, -1228, -1070, -684, -176, 388 },
+	{ 1224, 1440, 1541, 1127, -1150, -6146, -8272, -8531, -8206, -7645, -6967, -6223, -5437, -4624, -3794, -2951, -2102, -1250, -398, 450, 1290, 2119, 2931, 3718, 4472, 5178, 5811, 6334, 6678, 6718, 6238, 4993, 3226, 1844, 1206, 1084, 1224 },
+	{ 17389, -17621, -16612, -15617, -14615, -13619, -12617, -11613, -10616, -9614, -8615, -7616, -6617, -5617, -4615, -3610, -2609, -1627, -611, 379, 1381, 2383, 3385, 4381, 5383, 6387, 7384, 8386, 9385, 10384, 11382, 12383, 13390, 14390, 15391, 16380, 17389 },
+};
+
+/* inclination in 0.01 deg, positive down */
+static const int16_t inclination_table[37][37] = {
+	{ -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7229, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7229, -7228, -7228, -7228, -7228, -7228, -7228, -7228, -7228 },
+	{ -7560, -7529, -7489, -7442, -7388, -7330, -7270, -7210, -7151, -7095, -7044, -6999, -6960, -6928, -6904, -6888, -6881, -6883, -6893, -6912, -6941, -6977, -7022, -7074, -7131, -7193, -7257, -7321, -7383, -7440, -7490, -7532, -7562, -7580, -7586, -7579, -7560 },
+	{ -7857, -7781, -7689, -7586, -7474, -7358, -7239, -7123, -7012, -6909, -6818, -6740, -6676, -6626, -6590, -6567, -6556, -6558, -6574, -6605, -6652, -6716, -6797, -6895, -7006, -7129, -7260, -7393, -7524, -7646, -7755, -7843, -7906, -7939, -7940, -7911, -7857 },
+	{ -8066, -7933, -7786, -7632, -7470, -7303, -7135, -6969, -6811, -6667, -6544, -6445, -6372, -6321, -6290, -6273, -6267, -6272, -6290, -6326, -6383, -6467, -6578, -6716, -6878, -7059, -7254, -7456, -7658, -7851, -8024, -8165, -8259, -8291, -8260, -8180, -8066 },
+	{ -8119, -7936, -7753, -7568, -7376, -7177, -6971, -6763, -6562, -6381, -6230, -6120, -6051, -6020, -6014, -6022, -6032, -6045, -6063, -6096, -6156, -6251, -6385, -6558, -6765, -6999, -7252, -7517, -7784, -8044, -8288, -8493, -8615, -8596, -8468, -8299, -8119 },
+	{ -7998, -7798, -7604, -7410, -7210, -6996, -6767, -6527, -6287, -6068, -5891, -5776, -5728, -5737, -5781, -5835, -5877, -5902, -5917, -5940, -5990, -6084, -6232, -6433, -6677, -6955, -7256, -7569, -7885, -8198, -8501, -8788, -8917, -8672, -8433, -8209, -7998 },
+	{ -7766, -7567, -7375, -7186, -6989, -6775, -6536, -6273, -6001, -5746, -5545, -5431, -5416, -5488, -5608, -5730, -5822, -5868, -5878, -5877, -5901, -5980, -6128, -6346, -6618, -6928, -7260, -7601, -7939, -8261, -8546, -8719, -8638, -8426, -8198, -7977, -7766 },
+	{ -7482, -7287, -7100, -6916, -6727, -6519, -6281, -6008, -5711, -5426, -5203, -5094, -5126, -5279, -5496, -5708, -5866, -5946, -5953, -5921, -5899, -5941, -6073, -6295, -6584, -6912, -7257, -7600, -7920, -8189, -8362, -8386, -8276, -8097, -7893, -7685, -7482 },
+	{ -7167, -6975, -6790, -6608, -6423, -6224, -5994, -5722, -5413, -5105, -4863, -4764, -4852, -5100, -5424, -5736, -5973, -6105, -6126, -6064, -5985, -5967, -6062, -6272, -6564, -6896, -7234, -7551, -7815, -7994, -8061, -8022, -7907, -7746, -7560, -7364, -7167 },
+	{ -6823, -6632, -6444, -6259, -6073, -5878, -5659, -5397, -5088, -4764, -4507, -4423, -4573, -4919, -5350, -5758, -6081, -6286, -6350, -6281, -6145, -6051, -6086, -6263, -6541, -6860, -7172, -7439, -7627, -7713, -7707, -7638, -7525, -7379, -7206, -7017, -6823 },
+	{ -6440, -6246, -6054, -5860, -5665, -5469, -5259, -5012, -4709, -4375, -4106, -4038, -4253, -4698, -5228, -5722, -6129, -6421, -6558, -6517, -6346, -6173, -6126, -6248, -6490, -6778, -7047, -7252, -7359, -7367, -7312, -7228, -7120, -6985, -6820, -6634, -6440 },
+	{ -6003, -5804, -5605, -5400, -5192, -4987, -4780, -4544, -4248, -3905, -3624, -3575, -3862, -4407, -5030, -5604, -6088, -6466, -6688, -6702, -6527, -6287, -6147, -6192, -6379, -6618, -6835, -6978, -7014, -6960, -6873, -6782, -6680, -6551, -6390, -6202, -6003 },
+	{ -5496, -5290, -5083, -4866, -4641, -4422, -4211, -3980, -3683, -3326, -3033, -3010, -3375, -4026, -4748, -5401, -5953, -6399, -6691, -6759, -6600, -6317, -6092, -6049, -6168, -6351, -6517, -6607, -6587, -6487, -6377, -6286, -6190, -6065, -5901, -5705, -5496 },
+	{ -4904, -4686, -4472, -4244, -4004, -3768, -3547, -3311, -3001, -2623, -2321, -2332, -2783, -3547, -4377, -5115, -5725, -6210, -6535, -6632, -6485, -6180, -5890, -5770, -5823, -5953, -6077, -6130, -6071, -5936, -5813, -5727, -5638, -5511, -5340, -5130, -4904 },
+	{ -4213, -3979, -3758, -3522, -3269, -3019, -2786, -2535, -2203, -1800, -1496, -1549, -2085, -2961, -3908, -4737, -5393, -5886, -6199, -6291, -6144, -5824, -5493, -5318, -5320, -5410, -5505, -5538, -5454, -5295, -5167, -5092, -5009, -4878, -4694, -4462, -4213 },
+	{ -3415, -3161, -2932, -2693, -2434, -2175, -1931, -1663, -1304, -881, -588, -686, -1293, -2269, -3329, -4247, -4936, -5405, -5674, -5735, -5576, -5243, -4884, -4676, -4648, -4712, -4794, -4820, -4724, -4553, -4427, -4368, -4295, -4158, -3956, -3696, -3415 },
+	{ -2514, -2235, -2000, -1763, -1505, -1246, -998, -715, -336, 91, 359, 219, -435, -1478, -2629, -3621, -4323, -4749, -4956, -4977, -4802, -4454, -4075, -3849, -3807, -3859, -3937, -3968, -3872, -3698, -3584, -3548, -3488, -3347, -3126, -2833, -2514 },
+	{ -1529, -1226, -986, -757, -508, -257, -13, 275, 658, 1066, 1293, 1121, 455, -611, -1810, -2841, -3537, -3909, -4050, -4030, -3840, -3482, -3088, -2853, -2807, -2856, -2936, -2977, -2893, -2729, -2635, -2628, -2588, -2449, -2211, -1886, -1529 },
+	{ -499, -177, 62, 278, 511, 749, 983, 1264, 1630, 1997, 2174, 1981, 1333, 298, -888, -1911, -2579, -2894, -2974, -2917, -2718, -2357, -1959, -1723, -1679, -1726, -1808, -1861, -1795, -1653, -1589, -1618, -1605, -1477, -1234, -886, -499 },
+	{ 523, 854, 1088, 1287, 1501, 1723, 1945, 2212, 2544, 2854, 2978, 2772, 2167, 1208, 101, -860, -1475, -1734, -1762, -1677, -1475, -1124, -738, -511, -471, -517, -596, -655, -610, -502, -475, -540, -562, -459, -228, 124, 523 },
+	{ 1487, 1814, 2038, 2220, 2416, 2624, 2837, 3085, 3376, 3625, 3696, 3483, 2933, 2083, 1107, 258, -281, -488, -476, -370, -175, 150, 506, 714, 748, 706, 637, 580, 605, 675, 663, 562, 501, 564, 766, 1098, 1487 },
+	{ 2356, 2665, 2879, 3047, 3229, 3428, 3635, 3867, 4118, 4310, 4335, 4118, 3625, 2899, 2083, 1377, 928, 769, 808, 925, 1106, 1391, 1701, 1883, 1912, 1876, 1820, 1773, 1782, 1815, 1769, 1639, 1538, 1554, 1709, 1999, 2356 },
+	{ 3116, 3397, 3599, 3758, 3932, 4127, 4333, 4554, 4773, 4918, 4906, 4685, 4249, 3645, 2992, 2434, 2079, 1961, 2014, 2133, 2297, 2537, 2794, 2945, 2970, 2942, 2901, 2867, 2868, 2871, 2797, 2644, 2509, 2475, 2574, 2807, 3116 },
+	{ 3772, 4017, 4206, 4362, 4533, 4729, 4938, 5153, 5348, 5459, 5420, 5200, 4814, 4320, 3812, 3388, 3120, 3037, 3095, 3209, 3354, 3549, 3753, 3877, 3901, 3881, 3855, 3836, 3832, 3814, 3720, 3551, 3388, 3309, 3352, 3521, 3772 },
+	{ 4340, 4545, 4720, 4878, 5053, 5252, 5465, 5676, 5856, 5946, 5890, 5674, 5332, 4929, 4540, 4225, 4028, 3973, 4030, 4136, 4261, 4417, 4575, 4675, 4701, 4693, 4682, 4675, 4671, 4638, 4530, 4351, 4168, 4053, 4044, 4151, 4340 },
+	{ 4844, 5008, 5169, 5330, 5512, 5717, 5933, 6142, 6311, 6387, 6322, 6115, 5813, 5482, 5182, 4948, 4806, 4771, 4824, 4918, 5025, 5147, 5268, 5350, 5381, 5388, 5392, 5398, 5394, 5351, 5234, 5049, 4854, 4712, 4662, 4713, 4844 },
+	{ 5307, 5433, 5579, 5744, 5933, 6143, 6361, 6567, 6727, 6792, 6723, 6528, 6260, 5984, 5747, 5570, 5467, 5445, 5491, 5571, 5661, 5756, 5849, 5919, 5959, 5983, 6004, 6021, 6019, 5969, 5845, 5658, 5458, 5300, 5219, 5226, 5307 },
+	{ 5748, 5844, 5977, 6141, 6334, 6546, 6763, 6963, 7113, 7169, 7098, 6915, 6677, 6442, 6247, 6107, 6028, 6013, 6051, 6116, 6188, 6263, 6336, 6400, 6451, 6494, 6534, 6563, 6563, 6507, 6379, 6194, 5995, 5831, 5731, 5705, 5748 },
+	{ 6183, 6257, 6377, 6536, 6726, 6935, 7146, 7337, 7475, 7519, 7446, 7276, 7063, 6858, 6692, 6574, 6509, 6494, 6521, 6570, 6627, 6687, 6748, 6811, 6874, 6937, 6996, 7038, 7041, 6982, 6852, 6671, 6480, 6317, 6209, 6164, 6183 },
+	{ 6618, 6677, 6784, 6933, 7113, 7312, 7511, 7688, 7812, 7843, 7766, 7608, 7416, 7235, 7087, 6983, 6923, 6904, 6918, 6952, 6996, 7045, 7102, 7167, 7243, 7324, 7401, 7456, 7464, 7403, 7275, 7103, 6923, 6770, 6663, 6612, 6618 },
+	{ 7051, 7100, 7194, 7327, 7490, 7670, 7851, 8011, 8117, 8135, 8053, 7904, 7732, 7570, 7437, 7340, 7281, 7255, 7257, 7278, 7311, 7354, 7409, 7480, 7566, 7662, 7755, 7822, 7836, 7779, 7656, 7498, 7336, 7198, 7100, 7050, 7051 },
+	{ 7475, 7516, 7596, 7709, 7849, 8004, 8161, 8299, 8384, 8384, 8296, 8158, 8005, 7862, 7743, 7653, 7593, 7560, 7552, 7562, 7587, 7627, 7683, 7757, 7850, 7954, 8058, 8136, 8159, 8110, 8001, 7861, 7722, 7603, 7519, 7476, 7475 },
+	{ 7880, 7912, 7976, 8067, 8179, 8305, 8433, 8543, 8603, 8581, 8488, 8362, 8230, 8108, 8005, 7924, 7867, 7831, 7817, 7820, 7840, 7877, 7932, 8006, 8097, 8202, 8307, 8393, 8428, 8396, 8308, 8194, 8081, 7985, 7917, 7881, 7880 },
+	{ 8258, 8280, 8326, 8393, 8476, 8569, 8663, 8740, 8764, 8716, 8623, 8516, 8410, 8313, 8230, 8162, 8112, 8079, 8064, 8064, 8081, 8114, 8164, 8230, 8311, 8405, 8501, 8587, 8638, 8632, 8574, 8492, 8409, 8338, 8287, 8260, 8258 },
+	{ 8602, 8615, 8644, 8685, 8738, 8797, 8852, 8880, 8852, 8787, 8709, 8631, 8555, 8487, 8428, 8379, 8342, 8317, 8304, 8305, 8318, 8344, 8383, 8434, 8496, 8566, 8642, 8715, 8775, 8804, 8791, 8749, 8700, 8656, 8623, 8604, 8602 },
+	{ 8911, 8917, 8930, 8949, 8967, 8964, 8934, 8896, 8853, 8809, 8765, 8722, 8682, 8646, 8614, 8588, 8568, 8555, 8549, 8550, 8558, 8573, 8595, 8624, 8658, 8696, 8738, 8781, 8824, 8865, 8898, 8921, 8929, 8924, 8916, 8911, 8911 },
+	{ 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806, 8806 },
+};
+
+/* total intensity in 10 nT */
+static const int16_t strength_table[37][37] = {
+	{ 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494, 5494 },
+	{ 5836, 5808, 5771, 5725, 5673, 5615, 5554, 5490, 5425, 5362, 5301, 5245, 5196, 5154, 5120, 5097, 5085, 5084, 5096, 5119, 5154, 5200, 5255, 5317, 5385, 5456, 5528, 5597, 5662, 5720, 5770, 5810, 5838, 5855, 5860, 5853, 5836 },
+	{ 6100, 6041, 5966, 5877, 5778, 5668, 5552, 5431, 5309, 5189, 5074, 4967, 4872, 4791, 4725, 4678, 4651, 4645, 4663, 4706, 4772, 4862, 4973, 5102, 5243, 5391, 5539, 5682, 5813, 5928, 6022, 6093, 6140, 6163, 6163, 6141, 6100 },
+	{ 6271, 6179, 6068, 5942, 5801, 5647, 5484, 5313, 5139, 4968, 4805, 4654, 4521, 4408, 4317, 4250, 4209, 4197, 4219, 4276, 4371, 4503, 4670, 4866, 5082, 5309, 5536, 5752, 5947, 6112, 6242, 6334, 6388, 6404, 6388, 6342, 6271 },
+	{ 6344, 6219, 6076, 5918, 5744, 5555, 5352, 5138, 4918, 4701, 4495, 4309, 4148, 4014, 3907, 3828, 3777, 3761, 3784, 3853, 3972, 4144, 4365, 4626, 4916, 5220, 5522, 5806, 6058, 6265, 6420, 6520, 6567, 6566, 6524, 6447, 6344 },
+	{ 6324, 6168, 5998, 5815, 5617, 5403, 5170, 4919, 4659, 4401, 4159, 3945, 3766, 3623, 3513, 3431, 3377, 3357, 3380, 3458, 3598, 3806, 4076, 4397, 4754, 5127, 5496, 5838, 6136, 6373, 6541, 6639, 6670, 6644, 6570, 6460, 6324 },
+	{ 6226, 6044, 5851, 5649, 5436, 5206, 4952, 4674, 4381, 4088, 3816, 3582, 3396, 3257, 3156, 3082, 3031, 3009, 3030, 3111, 3266, 3503, 3816, 4191, 4605, 5036, 5458, 5845, 6174, 6429, 6599, 6685, 6695, 6640, 6535, 6393, 6226 },
+	{ 6070, 5866, 5656, 5442, 5219, 4981, 4716, 4421, 4104, 3784, 3490, 3244, 3062, 2938, 2858, 2802, 2761, 2738, 2752, 2827, 2988, 3245, 3593, 4013, 4475, 4950, 5409, 5824, 6170, 6428, 6591, 6660, 6646, 6565, 6432, 6263, 6070 },
+	{ 5876, 5655, 5431, 5208, 4982, 4741, 4474, 4172, 3843, 3508, 3200, 2951, 2781, 2683, 2634, 2604, 2576, 2554, 2558, 2619, 2772, 3038, 3412, 3867, 4366, 4872, 5352, 5778, 6124, 6373, 6519, 6568, 6534, 6431, 6278, 6087, 5876 },
+	{ 5655, 5423, 5191, 4962, 4733, 4495, 4233, 3936, 3608, 3270, 2959, 2715, 2563, 2497, 2483, 2482, 2474, 2458, 2452, 2493, 2626, 2886, 3272, 3753, 4279, 4803, 5290, 5710, 6041, 6268, 6390, 6419, 6368, 6252, 6084, 5880, 5655 },
+	{ 5416, 5178, 4942, 4709, 4480, 4247, 3995, 3713, 3400, 3072, 2768, 2536, 2407, 2373, 2393, 2421, 2436, 2435, 2429, 2451, 2555, 2794, 3177, 3670, 4211, 4742, 5223, 5624, 5925, 6119, 6213, 6222, 6159, 6036, 5861, 5649, 5416 },
+	{ 5162, 4923, 4687, 4455, 4227, 4001, 3765, 3506, 3219, 2913, 2627, 2413, 2307, 2300, 2347, 2401, 2444, 2470, 2479, 2492, 2565, 2767, 3127, 3614, 4156, 4682, 5146, 5519, 5781, 5932, 5994, 5985, 5915, 5788, 5612, 5397, 5162 },
+	{ 4894, 4660, 4429, 4202, 3980, 3763, 3546, 3317, 3064, 2791, 2531, 2339, 2253, 2266, 2331, 2407, 2480, 2544, 2583, 2600, 2647, 2803, 3121, 3580, 4105, 4613, 5053, 5391, 5607, 5711, 5740, 5716, 5640, 5513, 5338, 5126, 4894 },
+	{ 4615, 4392, 4173, 3956, 3744, 3543, 3349, 3154, 2940, 2706, 2479, 2310, 2241, 2264, 2340, 2434, 2538, 2642, 2719, 2753, 2782, 2890, 3149, 3560, 4049, 4527, 4936, 5235, 5403, 5459, 5456, 5419, 5340, 5214, 5043, 4838, 4615 },
+	{ 4331, 4125, 3924, 3725, 3532, 3351, 3184, 3024, 2853, 2661, 2471, 2327, 2267, 2292, 2372, 2480, 2610, 2750, 2862, 2917, 2937, 3001, 3197, 3546, 3983, 4417, 4789, 5049, 5171, 5184, 5153, 5104, 5022, 4897, 4733, 4539, 4331 },
+	{ 4053, 3870, 3694, 3521, 3354, 3200, 3065, 2942, 2812, 2665, 2512, 2389, 2330, 2348, 2426, 2544, 2691, 2853, 2989, 3062, 3080, 3112, 3248, 3530, 3905, 4287, 4615, 4837, 4919, 4897, 4843, 4785, 4699, 4575, 4419, 4240, 4053 },
+	{ 3796, 3642, 3496, 3355, 3221, 3103, 3002, 2916, 2828, 2722, 2604, 2497, 2432, 2432, 2499, 2619, 2772, 2940, 3084, 3168, 3190, 3203, 3294, 3514, 3823, 4147, 4428, 4613, 4665, 4619, 4549, 4481, 4389, 4265, 4118, 3958, 3796 },
+	{ 3579, 3458, 3345, 3239, 3145, 3066, 3004, 2956, 2907, 2838, 2747, 2648, 2571, 2545, 2592, 2701, 2848, 3006, 3145, 3234, 3264, 3273, 3338, 3507, 3755, 4019, 4252, 4403, 4435, 4376, 4296, 4216, 4115, 3989, 3851, 3712, 3579 },
+	{ 3416, 3330, 3251, 3183, 3130, 3094, 3073, 3063, 3050, 3012, 2938, 2840, 2745, 2689, 2705, 2793, 2921, 3060, 3186, 3276, 3317, 3335, 3391, 3526, 3721, 3931, 4119, 4239, 4259, 4197, 4109, 4014, 3899, 3769, 3638, 3519, 3416 },
+	{ 3319, 3265, 3220, 3188, 3176, 3184, 3206, 3233, 3252, 3236, 3170, 3066, 2950, 2863, 2845, 2901, 3003, 3120, 3232, 3321, 3375, 3412, 3475, 3590, 3744, 3909, 4057, 4153, 4167, 4108, 4012, 3896, 3762, 3622, 3494, 3392, 3319 },
+	{ 3286, 3261, 3247, 3249, 3277, 3329, 3392, 3456, 3502, 3502, 3437, 3322, 3184, 3069, 3017, 3040, 3112, 3207, 3310, 3399, 3467, 3526, 3604, 3711, 3835, 3967, 4086, 4164, 4177, 4122, 4017, 3876, 3716, 3559, 3428, 3337, 3286 },
+	{ 3316, 3313, 3326, 3360, 3425, 3516, 3618, 3717, 3788, 3798, 3731, 3601, 3443, 3303, 3224, 3217, 3262, 3340, 3435, 3528, 3608, 3687, 3780, 3885, 3993, 4103, 4205, 4274, 4289, 4238, 4121, 3953, 3762, 3583, 3441, 3352, 3316 },
+	{ 3402, 3414, 3449, 3512, 3610, 3738, 3875, 4003, 4094, 4114, 4044, 3899, 3721, 3562, 3464, 3433, 3456, 3519, 3610, 3706, 3794, 3887, 3992, 4098, 4200, 4301, 4398, 4468, 4487, 4438, 4309, 4114, 3892, 3686, 3527, 3433, 3402 },
+	{ 3539, 3558, 3612, 3701, 3829, 3986, 4151, 4301, 4408, 4435, 4363, 4208, 4015, 3841, 3728, 3680, 3684, 3735, 3821, 3917, 4010, 4108, 4219, 4330, 4434, 4539, 4640, 4717, 4744, 4696, 4557, 4339, 4090, 3858, 3680, 3573, 3539 },
+	{ 3723, 3743, 3812, 3924, 4077, 4257, 4440, 4604, 4720, 4751, 4679, 4518, 4315, 4131, 4005, 3942, 3932, 3970, 4048, 4140, 4232, 4331, 4443, 4559, 4674, 4791, 4905, 4993, 5028, 4982, 4836, 4604, 4334, 4083, 3887, 3766, 3723 },
+	{ 3952, 3970, 4048, 4178, 4349, 4543, 4735, 4903, 5019, 5050, 4978, 4816, 4611, 4420, 4283, 4206, 4181, 4206, 4271, 4355, 4443, 4538, 4650, 4773, 4903, 5039, 5169, 5271, 5314, 5270, 5121, 4883, 4606, 4343, 4136, 4004, 3952 },
+	{ 4219, 4236, 4319, 4458, 4638, 4835, 5025, 5186, 5293, 5319, 5248, 5090, 4888, 4696, 4550, 4460, 4420, 4429, 4480, 4552, 4631, 4722, 4833, 4965, 5113, 5269, 5416, 5530, 5580, 5538, 5392, 5159, 4885, 4624, 4415, 4278, 4219 },
+	{ 4516, 4531, 4614, 4754, 4930, 5119, 5295, 5439, 5531, 5547, 5475, 5326, 5134, 4946, 4795, 4693, 4639, 4632, 4665, 4723, 4794, 4882, 4994, 5134, 5297, 5470, 5631, 5754, 5809, 5771, 5633, 5413, 5155, 4907, 4707, 4574, 4516 },
+	{ 4824, 4839, 4917, 5046, 5206, 5373, 5526, 5647, 5717, 5721, 5649, 5512, 5337, 5159, 5009, 4899, 4833, 4810, 4826, 4869, 4933, 5018, 5133, 5279, 5452, 5635, 5803, 5930, 5988, 5956, 5831, 5634, 5402, 5179, 4998, 4877, 4824 },
+	{ 5122, 5135, 5202, 5310, 5443, 5580, 5702, 5793, 5840, 5832, 5763, 5641, 5486, 5326, 5183, 5071, 4998, 4963, 4964, 4995, 5052, 5136, 5252, 5401, 5575, 5757, 5924, 6048, 6106, 6082, 5977, 5810, 5613, 5424, 5269, 5166, 5122 },
+	{ 5383, 5392, 5443, 5524, 5623, 5723, 5810, 5871, 5896, 5878, 5814, 5710, 5579, 5441, 5313, 5208, 5134, 5092, 5084, 5106, 5158, 5240, 5353, 5497, 5663, 5834, 5988, 6102, 6158, 6144, 6063, 5931, 5776, 5625, 5502, 5419, 5383 },
+	{ 5586, 5589, 5620, 5672, 5735, 5798, 5851, 5884, 5891, 5866, 5809, 5724, 5619, 5508, 5402, 5311, 5243, 5203, 5191, 5209, 5256, 5332, 5437, 5567, 5714, 5862, 5995, 6093, 6144, 6141, 6086, 5994, 5882, 5771, 5679, 5616, 5586 },
+	{ 5718, 5714, 5726, 5751, 5783, 5813, 5836, 5846, 5839, 5812, 5764, 5698, 5620, 5536, 5456, 5386, 5333, 5300, 5291, 5307, 5349, 5415, 5505, 5612, 5730, 5848, 5952, 6031, 6075, 6082, 6053, 5996, 5925, 5853, 5790, 5744, 5718 },
+	{ 5780, 5769, 5767, 5772, 5779, 5785, 5787, 5782, 5766, 5740, 5702, 5655, 5602, 5546, 5493, 5447, 5412, 5391, 5388, 5403, 5437, 5489, 5557, 5635, 5720, 5802, 5876, 5933, 5969, 5982, 5973, 5947, 5910, 5869, 5831, 5801, 5780 },
+	{ 5780, 5769, 5760, 5753, 5746, 5739, 5729, 5717, 5699, 5678, 5652, 5622, 5591, 5559, 5531, 5507, 5490, 5482, 5484, 5497, 5520, 5554, 5596, 5644, 5694, 5743, 5787, 5823, 5849, 5863, 5866, 5860, 5847, 5830, 5812, 5795, 5780 },
+	{ 5736, 5729, 5721, 5712, 5704, 5694, 5684, 5673, 5661, 5648, 5635, 5621, 5608, 5596, 5586, 5578, 5574, 5573, 5577, 5585, 5596, 5612, 5630, 5650, 5671, 5691, 5710, 5726, 5740, 5749, 5755, 5758, 5757, 5754, 5750, 5743, 5736 },
+	{ 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664, 5664 },
+};
+
@@ -69,6 +69,7 @@
 #include <systemlib/param/param.h>
 #include <systemlib/perf_counter.h>
 #include <systemlib/err.h>
+#include <systemlib/attitude_pipeline.h>
 
 extern "C" __EXPORT int attitude_estimator_q_main(int argc, char *argv[]);
 
@@ -100,9 +101,11 @@ public:
 	/**
 	 * Start task.
 	 *
+	 * @param pipeline	if true, host the attitude pipeline and run the
+	 *			attached rate controller stage on our thread.
 	 * @return		OK on success.
 	 */
-	int		start();
+	int		start(bool pipeline);
 
 	static void	task_main_trampoline(int argc, char *argv[]);
 
@@ -114,6 +117,7 @@ private:
 	static constexpr float _dt_max = 0.02;
 	bool		_task_should_exit = false;		/**< if true, task should exit */
 	int		_control_task = -1;			/**< task handle for task */
+	bool		_pipeline = false;			/**< hosting the attitude pipeline */
 
 	int		_sensors_sub = -1;
 	int		_params_sub = -1;
@@ -136,6 +140,7 @@ private:
 	float		_w_gyro_bias = 0.0f;
 	float		_mag_decl = 0.0f;
 	bool		_mag_decl_auto = false;
+	struct mag_field_cache_s _mag_field_cache;		/**< declination lookup cell cache */
 	bool		_acc_comp = false;
 	float		_bias_max = 0.0f;
 	float		_vibration_warning_threshold = 1.0f;
@@ -194,6 +199,8 @@ AttitudeEstimatorQ::AttitudeEstimatorQ() :
 {
 	_voter_mag.set_timeout(200000);
 
+	mag_field_cache_init(&_mag_field_cache);
+
 	_params_handles.w_acc		= param_find("ATT_W_ACC");
 	_params_handles.w_mag		= param_find("ATT_W_MAG");
 	_params_handles.w_gyro_bias	= param_find("ATT_W_GYRO_BIAS");
@@ -231,15 +238,17 @@ AttitudeEstimatorQ::~AttitudeEstimatorQ()
 	attitude_estimator_q::instance = nullptr;
 }
 
-int AttitudeEstimatorQ::start()
+int AttitudeEstimatorQ::start(bool pipeline)
 {
 	ASSERT(_control_task == -1);
 
-	/* start the task */
+	_pipeline = pipeline;
+
+	/* start the task, a pipeline host also carries the rate controller stack */
 	_control_task = px4_task_spawn_cmd("attitude_estimator_q",
 					   SCHED_DEFAULT,
 					   SCHED_PRIORITY_MAX - 5,
-					   2100,
+					   pipeline ? 2100 + 1500 : 2100,
 					   (px4_main_t)&AttitudeEstimatorQ::task_main_trampoline,
 					   nullptr);
 
@@ -259,6 +268,10 @@ void AttitudeEstimatorQ::print()
 	_voter_accel.print();
 	warnx("mag status:");
 	_voter_mag.print();
+
+	if (_pipeline) {
+		warnx("hosting attitude pipeline");
+	}
 }
 
 void AttitudeEstimatorQ::task_main_trampoline(int argc, char *argv[])
@@ -274,6 +287,11 @@ void AttitudeEstimatorQ::task_main()
 
 	update_parameters(true);
 
+	if (_pipeline && attitude_pipeline_open() != OK) {
+		warnx("attitude pipeline already hosted");
+		_pipeline = false;
+	}
+
 	hrt_abstime last_time = 0;
 
 	px4_pollfd_struct_t fds[1];
@@ -382,7 +400,11 @@ void AttitudeEstimatorQ::task_main()
 
 			if (_mag_decl_auto && _gpos.eph < 20.0f && hrt_elapsed_time(&_gpos.timestamp) < 1000000) {
 				/* set magnetic declination automatically */
-				_mag_decl = math::radians(get_mag_declination(_gpos.lat, _gpos.lon));
+				float mag_decl_deg;
+
+				if (get_mag_field(&_mag_field_cache, _gpos.lat, _gpos.lon, &mag_decl_deg, nullptr, nullptr) == 0) {
+					_mag_decl = math::radians(mag_decl_deg);
+				}
 			}
 		}
 
@@ -461,7 +483,18 @@ void AttitudeEstimatorQ::task_main()
 		} else {
 			orb_publish(ORB_ID(vehicle_attitude), _att_pub, &att);
 		}
+
+		/* hand the sample straight to the rate controller stage */
+		if (_pipeline) {
+			attitude_pipeline_run(&att);
+		}
 	}
+
+	if (_pipeline) {
+		attitude_pipeline_close();
+	}
+
+	_control_task = -1;
 }
 
 void AttitudeEstimatorQ::update_parameters(bool force)
@@ -598,7 +631,7 @@ bool AttitudeEstimatorQ::update(float dt)
 int attitude_estimator_q_main(int argc, char *argv[])
 {
 	if (argc < 1) {
-		warnx("usage: attitude_estimator_q {start|stop|status}");
+		warnx("usage: attitude_estimator_q {start [-p]|stop|status}");
 		return 1;
 	}
 
@@ -616,7 +649,10 @@ int attitude_estimator_q_main(int argc, char *argv[])
 			return 1;
 		}
 
-		if (OK != attitude_estimator_q::instance->start()) {
+		/* -p: host the attitude pipeline */
+		bool pipeline = (argc > 2 && !strcmp(argv[2], "-p"));
+
+		if (OK != attitude_estimator_q::instance->start(pipeline)) {
 			delete attitude_estimator_q::instance;
 			attitude_estimator_q::instance = nullptr;
 			warnx("start failed");
@@ -233,6 +233,251 @@ int sphere_fit_least_squares(const float x[], const float y[], const float z[],
 	return 0;
 }
 
+/// Index of element (row, col), row <= col, in the packed upper triangle
+static inline unsigned ellipsoid_fit_index(unsigned row, unsigned col)
+{
+	return row * ellipsoid_fit_terms - (row * (row - 1)) / 2 + (col - row);
+}
+
+static double ellipsoid_fit_sum(const struct ellipsoid_fit_s *fit, unsigned row, unsigned col)
+{
+	return (row <= col) ? fit->sums[ellipsoid_fit_index(row, col)] : fit->sums[ellipsoid_fit_index(col, row)];
+}
+
+static unsigned ellipsoid_fit_cell(const struct ellipsoid_fit_s *fit, float x, float y, float z)
+{
+	int32_t ix = (int32_t)floorf(x / fit->cell_size);
+	int32_t iy = (int32_t)floorf(y / fit->cell_size);
+	int32_t iz = (int32_t)floorf(z / fit->cell_size);
+
+	uint32_t hash = ((uint32_t)ix * 73856093u) ^ ((uint32_t)iy * 19349663u) ^ ((uint32_t)iz * 83492791u);
+
+	return hash % (ellipsoid_fit_coverage_bytes * 8);
+}
+
+/// Solve a x = b in place by Gaussian elimination with partial pivoting
+///	@return 0 on success, 1 if the matrix is singular
+static int ellipsoid_fit_linsolve(double *a, double *b, unsigned n)
+{
+	for (unsigned col = 0; col < n; col++) {
+		unsigned pivot = col;
+
+		for (unsigned row = col + 1; row < n; row++) {
+			if (fabs(a[row * n + col]) > fabs(a[pivot * n + col])) {
+				pivot = row;
+			}
+		}
+
+		if (fabs(a[pivot * n + col]) < 1e-15) {
+			return 1;
+		}
+
+		if (pivot != col) {
+			for (unsigned k = 0; k < n; k++) {
+				double tmp = a[col * n + k];
+				a[col * n + k] = a[pivot * n + k];
+				a[pivot * n + k] = tmp;
+			}
+
+			double tmp = b[col];
+			b[col] = b[pivot];
+			b[pivot] = tmp;
+		}
+
+		for (unsigned row = col + 1; row < n; row++) {
+			double f = a[row * n + col] / a[col * n + col];
+
+			for (unsigned k = col; k < n; k++) {
+				a[row * n + k] -= f * a[col * n + k];
+			}
+
+			b[row] -= f * b[col];
+		}
+	}
+
+	for (unsigned i = n; i-- > 0;) {
+		double acc = b[i];
+
+		for (unsigned k = i + 1; k < n; k++) {
+			acc -= a[i * n + k] * b[k];
+		}
+
+		b[i] = acc / a[i * n + i];
+	}
+
+	return 0;
+}
+
+void ellipsoid_fit_init(struct ellipsoid_fit_s *fit, float cell_size)
+{
+	memset(fit, 0, sizeof(*fit));
+	fit->cell_size = cell_size;
+}
+
+bool ellipsoid_fit_covered(const struct ellipsoid_fit_s *fit, float x, float y, float z)
+{
+	unsigned cell = ellipsoid_fit_cell(fit, x, y, z);
+
+	return (fit->coverage[cell / 8] & (1 << (cell % 8))) != 0;
+}
+
+void ellipsoid_fit_add(struct ellipsoid_fit_s *fit, float x, float y, float z)
+{
+	unsigned cell = ellipsoid_fit_cell(fit, x, y, z);
+	fit->coverage[cell / 8] |= (1 << (cell % 8));
+
+	const double dx = x;
+	const double dy = y;
+	const double dz = z;
+	const double u[ellipsoid_fit_terms] = {
+		dx * dx, dy * dy, dz * dz,
+		2.0 * dx * dy, 2.0 * dx * dz, 2.0 * dy * dz,
+		2.0 * dx, 2.0 * dy, 2.0 * dz,
+		1.0
+	};
+
+	double *sum = fit->sums;
+
+	for (unsigned row = 0; row < ellipsoid_fit_terms; row++) {
+		for (unsigned col = row; col < ellipsoid_fit_terms; col++) {
+			*sum++ += u[row] * u[col];
+		}
+	}
+
+	fit->count++;
+}
+
+int ellipsoid_fit_solve(const struct ellipsoid_fit_s *fit, float offset[3], float scale[3], float *radius)
+{
+	// Model: [x y z] A [x y z]^T + 2 b^T [x y z]^T = 1, with the nine unknowns
+	// of A and b regressed against the constant term.
+	const unsigned n = ellipsoid_fit_terms - 1;
+	double a[n * n];
+	double v[n];
+
+	if (fit->count < 2 * n) {
+		return 1;
+	}
+
+	for (unsigned row = 0; row < n; row++) {
+		for (unsigned col = 0; col < n; col++) {
+			a[row * n + col] = ellipsoid_fit_sum(fit, row, col);
+		}
+
+		v[row] = ellipsoid_fit_sum(fit, row, n);
+	}
+
+	if (ellipsoid_fit_linsolve(a, v, n) != 0) {
+		return 1;
+	}
+
+	const double A[3][3] = {
+		{ v[0], v[3], v[4] },
+		{ v[3], v[1], v[5] },
+		{ v[4], v[5], v[2] }
+	};
+
+	// A must be positive definite for the quadric to be an ellipsoid
+	const double minor2 = A[0][0] * A[1][1] - A[0][1] * A[0][1];
+	const double det = A[0][0] * (A[1][1] * A[2][2] - A[1][2] * A[2][1])
+			   - A[0][1] * (A[1][0] * A[2][2] - A[1][2] * A[2][0])
+			   + A[0][2] * (A[1][0] * A[2][1] - A[1][1] * A[2][0]);
+
+	if (!(A[0][0] > 0.0 && minor2 > 0.0 && det > 0.0)) {
+		return 1;
+	}
+
+	// center = -A^-1 b
+	double m[3 * 3];
+	double c[3] = { -v[6], -v[7], -v[8] };
+
+	for (unsigned row = 0; row < 3; row++) {
+		for (unsigned col = 0; col < 3; col++) {
+			m[row * 3 + col] = A[row][col];
+		}
+	}
+
+	if (ellipsoid_fit_linsolve(m, c, 3) != 0) {
+		return 1;
+	}
+
+	// (p - c)^T A (p - c) = 1 + c^T A c
+	double k = 1.0;
+
+	for (unsigned row = 0; row < 3; row++) {
+		for (unsigned col = 0; col < 3; col++) {
+			k += c[row] * A[row][col] * c[col];
+		}
+	}
+
+	if (!(k > 0.0)) {
+		return 1;
+	}
+
+	// Keep the diagonal of the normalized shape matrix and scale it to unit volume
+	double d[3];
+
+	for (unsigned i = 0; i < 3; i++) {
+		d[i] = sqrt(A[i][i] / k);
+	}
+
+	const double r = 1.0 / cbrt(d[0] * d[1] * d[2]);
+
+	for (unsigned i = 0; i < 3; i++) {
+		offset[i] = (float)c[i];
+		scale[i] = (float)(d[i] * r);
+
+		if (!PX4_ISFINITE(offset[i]) || scale[i] < 0.5f || scale[i] > 2.0f) {
+			return 1;
+		}
+	}
+
+	*radius = (float)r;
+
+	return 0;
+}
+
+int ellipsoid_fit_sphere(const struct ellipsoid_fit_s *fit, float center[3], float *radius)
+{
+	// Model: x^2 + y^2 + z^2 + 2 g x + 2 h y + 2 i z + k = 0, which uses the
+	// last four regressors of the ellipsoid against the sum of the first three.
+	const unsigned first = ellipsoid_fit_terms - 4;
+	const unsigned n = 4;
+	double a[n * n];
+	double v[n];
+
+	if (fit->count < 2 * n) {
+		return 1;
+	}
+
+	for (unsigned row = 0; row < n; row++) {
+		for (unsigned col = 0; col < n; col++) {
+			a[row * n + col] = ellipsoid_fit_sum(fit, first + row, first + col);
+		}
+
+		v[row] = -(ellipsoid_fit_sum(fit, 0, first + row) +
+			   ellipsoid_fit_sum(fit, 1, first + row) +
+			   ellipsoid_fit_sum(fit, 2, first + row));
+	}
+
+	if (ellipsoid_fit_linsolve(a, v, n) != 0) {
+		return 1;
+	}
+
+	const double rsq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2] - v[3];
+
+	if (!(rsq > 0.0)) {
+		return 1;
+	}
+
+	center[0] = (float)(-v[0]);
+	center[1] = (float)(-v[1]);
+	center[2] = (float)(-v[2]);
+	*radius = (float)sqrt(rsq);
+
+	return 0;
+}
+
 enum detect_orientation_return detect_orientation(int mavlink_fd, int cancel_sub, int accel_sub, bool lenient_still_position)
 {
 	const unsigned ndim = 3;
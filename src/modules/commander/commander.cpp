@@ -92,6 +92,7 @@
 #include <uORB/topics/telemetry_status.h>
 #include <uORB/topics/vtol_vehicle_status.h>
 #include <uORB/topics/vehicle_land_detected.h>
+#include <uORB/topics/cpuload.h>
 
 #include <drivers/drv_led.h>
 #include <drivers/drv_hrt.h>
@@ -102,6 +103,7 @@
 #include <systemlib/systemlib.h>
 #include <systemlib/err.h>
 #include <systemlib/cpuload.h>
+#include <systemlib/printload.h>
 #include <systemlib/rc_check.h>
 #include <geo/geo.h>
 #include <systemlib/state_table.h>
@@ -1081,7 +1083,15 @@ int commander_thread_main(int argc, char *argv[])
 	bool low_battery_voltage_actions_done = false;
 	bool critical_battery_voltage_actions_done = false;
 
+#ifdef __PX4_POSIX
+	/* no idle task to measure, the load is accounted per thread */
+	struct print_load_s load_state;
+	init_print_load_s(hrt_absolute_time(), &load_state);
+	struct cpuload_s cpuload;
+	orb_advert_t cpuload_pub = nullptr;
+#else
 	hrt_abstime last_idle_time = 0;
+#endif
 
 	bool status_changed = true;
 	bool param_init_forced = true;
@@ -1702,6 +1712,18 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		if (counter % (1000000 / COMMANDER_MONITORING_INTERVAL) == 0) {
+#ifdef __PX4_POSIX
+			cpuload_sample(hrt_absolute_time(), &load_state, &cpuload);
+			status.load = cpuload.load;
+
+			if (cpuload_pub != nullptr) {
+				orb_publish(ORB_ID(cpuload), cpuload_pub, &cpuload);
+
+			} else {
+				cpuload_pub = orb_advertise(ORB_ID(cpuload), &cpuload);
+			}
+
+#else
 			/* compute system load */
 			uint64_t interval_runtime = system_load.tasks[0].total_runtime - last_idle_time;
 
@@ -1710,6 +1732,7 @@ int commander_thread_main(int argc, char *argv[])
 			}
 
 			last_idle_time = system_load.tasks[0].total_runtime;
+#endif
 		}
 
 		/* if battery voltage is getting lower, warn using buzzer, etc. */
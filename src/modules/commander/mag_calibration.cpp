@@ -73,6 +73,9 @@ static constexpr unsigned int calibration_sides = 6;			///< The total number of
 static constexpr unsigned int calibration_total_points = 240;		///< The total points per magnetometer
 static constexpr unsigned int calibraton_duration_seconds = 42; 	///< The total duration the routine is allowed to take
 
+static_assert(calibration_total_points * 16 <= ellipsoid_fit_coverage_bytes * 8,
+	      "coverage bitmap too small, more than 1 in 16 new cells would be rejected as covered");
+
 int32_t	device_ids[max_mags];
 int device_prio_max = 0;
 int32_t device_id_primary = 0;
@@ -89,9 +92,7 @@ typedef struct  {
 	uint64_t	calibration_interval_perside_useconds;
 	unsigned int	calibration_counter_total[max_mags];
 	bool		side_data_collected[detect_orientation_side_count];
-	float*		x[max_mags];
-	float*		y[max_mags];
-	float*		z[max_mags];
+	struct ellipsoid_fit_s *fit[max_mags];
 } mag_worker_data_t;
 
 
@@ -194,24 +195,6 @@ int do_mag_calibration(int mavlink_fd)
 	return result;
 }
 
-static bool reject_sample(float sx, float sy, float sz, float x[], float y[], float z[], unsigned count, unsigned max_count)
-{
-	float min_sample_dist = fabsf(5.4f * mag_sphere_radius / sqrtf(max_count)) / 3.0f;
-
-	for (size_t i = 0; i < count; i++) {
-		float dx = sx - x[i];
-		float dy = sy - y[i];
-		float dz = sz - z[i];
-		float dist = sqrtf(dx * dx + dy * dy + dz * dz);
-
-		if (dist < min_sample_dist) {
-			return true;
-		}
-	}
-
-	return false;
-}
-
 static unsigned progress_percentage(mag_worker_data_t* worker_data) {
 	return 100 * ((float)worker_data->done_count) / calibration_sides;
 }
@@ -221,6 +204,7 @@ static calibrate_return mag_calibration_worker(detect_orientation_return orienta
 	calibrate_return result = calibrate_return_ok;
 	
 	unsigned int calibration_counter_side;
+	unsigned int calibration_counter_mag[max_mags] = {};
 
 	mag_worker_data_t* worker_data = (mag_worker_data_t*)(data);
 	
@@ -319,40 +303,33 @@ static calibrate_return mag_calibration_worker(detect_orientation_return orienta
 		
 		if (poll_ret > 0) {
 
-			int prev_count[max_mags];
-			bool rejected = false;
+			unsigned int prev_counter_side = calibration_counter_side;
 
-			for (size_t cur_mag=0; cur_mag<max_mags; cur_mag++) {
+			// Each mag fills its own fit; the side is as far along as the slowest mag
+			calibration_counter_side = worker_data->calibration_points_perside;
 
-				prev_count[cur_mag] = worker_data->calibration_counter_total[cur_mag];
+			for (size_t cur_mag=0; cur_mag<max_mags; cur_mag++) {
 
 				if (worker_data->sub_mag[cur_mag] >= 0) {
 					struct mag_report mag;
 
 					orb_copy(ORB_ID(sensor_mag), worker_data->sub_mag[cur_mag], &mag);
 
-					// Check if this measurement is good to go in
-					rejected = rejected || reject_sample(mag.x, mag.y, mag.z,
-						worker_data->x[cur_mag], worker_data->y[cur_mag], worker_data->z[cur_mag],
-						worker_data->calibration_counter_total[cur_mag],
-						calibration_sides * worker_data->calibration_points_perside);
-					
-					worker_data->x[cur_mag][worker_data->calibration_counter_total[cur_mag]] = mag.x;
-					worker_data->y[cur_mag][worker_data->calibration_counter_total[cur_mag]] = mag.y;
-					worker_data->z[cur_mag][worker_data->calibration_counter_total[cur_mag]] = mag.z;
-					worker_data->calibration_counter_total[cur_mag]++;
-				}
-			}
+					// Only take samples which land in a cell not covered yet
+					if (calibration_counter_mag[cur_mag] < worker_data->calibration_points_perside &&
+					    !ellipsoid_fit_covered(worker_data->fit[cur_mag], mag.x, mag.y, mag.z)) {
+						ellipsoid_fit_add(worker_data->fit[cur_mag], mag.x, mag.y, mag.z);
+						worker_data->calibration_counter_total[cur_mag]++;
+						calibration_counter_mag[cur_mag]++;
+					}
 
-			// Keep calibration of all mags in lockstep
-			if (rejected) {
-				// Reset counts, since one of the mags rejected the measurement
-				for (size_t cur_mag = 0; cur_mag < max_mags; cur_mag++) {
-					worker_data->calibration_counter_total[cur_mag] = prev_count[cur_mag];
+					if (calibration_counter_mag[cur_mag] < calibration_counter_side) {
+						calibration_counter_side = calibration_counter_mag[cur_mag];
+					}
 				}
-			} else {
-				calibration_counter_side++;
+			}
 
+			if (calibration_counter_side > prev_counter_side) {
 				// Progress indicator for side
 				mavlink_and_console_log_info(worker_data->mavlink_fd,
 							     "[cal] %s side calibration: progress <%u>",
@@ -405,23 +382,29 @@ calibrate_return mag_calibrate_all(int mavlink_fd, int32_t (&device_ids)[max_mag
 		worker_data.sub_mag[cur_mag] = -1;
 		
 		// Initialize to no memory allocated
-		worker_data.x[cur_mag] = NULL;
-		worker_data.y[cur_mag] = NULL;
-		worker_data.z[cur_mag] = NULL;
+		worker_data.fit[cur_mag] = NULL;
 		worker_data.calibration_counter_total[cur_mag] = 0;
 	}
 
 	const unsigned int calibration_points_maxcount = calibration_sides * worker_data.calibration_points_perside;
+
+	// Samples closer than this are not worth adding, cells of the coverage map are this size
+	const float min_sample_dist = fabsf(5.4f * mag_sphere_radius / sqrtf(calibration_points_maxcount)) / 3.0f;
 	
 	char str[30];
 	
+	// The fit state is fixed-size, independent of how many samples are taken
 	for (size_t cur_mag=0; cur_mag<max_mags; cur_mag++) {
-		worker_data.x[cur_mag] = reinterpret_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
-		worker_data.y[cur_mag] = reinterpret_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
-		worker_data.z[cur_mag] = reinterpret_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
-		if (worker_data.x[cur_mag] == NULL || worker_data.y[cur_mag] == NULL || worker_data.z[cur_mag] == NULL) {
+		if (device_ids[cur_mag] == 0) {
+			continue;
+		}
+
+		worker_data.fit[cur_mag] = reinterpret_cast<struct ellipsoid_fit_s *>(malloc(sizeof(struct ellipsoid_fit_s)));
+		if (worker_data.fit[cur_mag] == NULL) {
 			mavlink_and_console_log_critical(mavlink_fd, "[cal] ERROR: out of memory");
 			result = calibrate_return_error;
+		} else {
+			ellipsoid_fit_init(worker_data.fit[cur_mag], min_sample_dist);
 		}
 	}
 
@@ -486,24 +469,29 @@ calibrate_return mag_calibrate_all(int mavlink_fd, int32_t (&device_ids)[max_mag
 	// Calculate calibration values for each mag
 	
 	
-	float sphere_x[max_mags];
-	float sphere_y[max_mags];
-	float sphere_z[max_mags];
-	float sphere_radius[max_mags];
+	float offset[max_mags][3];
+	float scale[max_mags][3];
+	float radius[max_mags];
 	
-	// Sphere fit the data to get calibration values
+	// Ellipsoid fit the accumulated sums, falling back to a sphere if the ellipsoid is degenerate
 	if (result == calibrate_return_ok) {
 		for (unsigned cur_mag=0; cur_mag<max_mags; cur_mag++) {
 			if (device_ids[cur_mag] != 0) {
 				// Mag in this slot is available and we should have values for it to calibrate
 				
-				sphere_fit_least_squares(worker_data.x[cur_mag], worker_data.y[cur_mag], worker_data.z[cur_mag],
-							 worker_data.calibration_counter_total[cur_mag],
-							 100, 0.0f,
-							 &sphere_x[cur_mag], &sphere_y[cur_mag], &sphere_z[cur_mag],
-							 &sphere_radius[cur_mag]);
+				if (ellipsoid_fit_solve(worker_data.fit[cur_mag], offset[cur_mag], scale[cur_mag], &radius[cur_mag]) != 0) {
+					mavlink_and_console_log_info(mavlink_fd, "[cal] mag #%u ellipsoid fit failed, using sphere", cur_mag);
+
+					scale[cur_mag][0] = 1.0f;
+					scale[cur_mag][1] = 1.0f;
+					scale[cur_mag][2] = 1.0f;
+
+					if (ellipsoid_fit_sphere(worker_data.fit[cur_mag], offset[cur_mag], &radius[cur_mag]) != 0) {
+						offset[cur_mag][0] = NAN;
+					}
+				}
 				
-				if (!PX4_ISFINITE(sphere_x[cur_mag]) || !PX4_ISFINITE(sphere_y[cur_mag]) || !PX4_ISFINITE(sphere_z[cur_mag])) {
+				if (!PX4_ISFINITE(offset[cur_mag][0]) || !PX4_ISFINITE(offset[cur_mag][1]) || !PX4_ISFINITE(offset[cur_mag][2])) {
 					mavlink_and_console_log_critical(mavlink_fd, "[cal] ERROR: NaN in sphere fit for mag #%u", cur_mag);
 					result = calibrate_return_error;
 				}
@@ -511,54 +499,25 @@ calibrate_return mag_calibrate_all(int mavlink_fd, int32_t (&device_ids)[max_mag
 		}
 	}
 
-	// Print uncalibrated data points
+	// Print fit results
 	if (result == calibrate_return_ok) {
-
-		printf("RAW DATA:\n--------------------\n");
-		for (size_t cur_mag = 0; cur_mag < max_mags; cur_mag++) {
-
-			if (worker_data.calibration_counter_total[cur_mag] == 0) {
-				continue;
-			}
-
-			printf("RAW: MAG %u with %u samples:\n", (unsigned)cur_mag, (unsigned)worker_data.calibration_counter_total[cur_mag]);
-
-			for (size_t i = 0; i < worker_data.calibration_counter_total[cur_mag]; i++) {
-				float x = worker_data.x[cur_mag][i];
-				float y = worker_data.y[cur_mag][i];
-				float z = worker_data.z[cur_mag][i];
-				printf("%8.4f, %8.4f, %8.4f\n", (double)x, (double)y, (double)z);
-			}
-
-			printf(">>>>>>>\n");
-		}
-
-		printf("CALIBRATED DATA:\n--------------------\n");
 		for (size_t cur_mag = 0; cur_mag < max_mags; cur_mag++) {
 
 			if (worker_data.calibration_counter_total[cur_mag] == 0) {
 				continue;
 			}
 
-			printf("Calibrated: MAG %u with %u samples:\n", (unsigned)cur_mag, (unsigned)worker_data.calibration_counter_total[cur_mag]);
-
-			for (size_t i = 0; i < worker_data.calibration_counter_total[cur_mag]; i++) {
-				float x = worker_data.x[cur_mag][i] - sphere_x[cur_mag];
-				float y = worker_data.y[cur_mag][i] - sphere_y[cur_mag];
-				float z = worker_data.z[cur_mag][i] - sphere_z[cur_mag];
-				printf("%8.4f, %8.4f, %8.4f\n", (double)x, (double)y, (double)z);
-			}
-
-			printf("SPHERE RADIUS: %8.4f\n", (double)sphere_radius[cur_mag]);
-			printf(">>>>>>>\n");
+			printf("MAG %u with %u samples: center %8.4f, %8.4f, %8.4f scale %8.4f, %8.4f, %8.4f radius %8.4f\n",
+			       (unsigned)cur_mag, (unsigned)worker_data.calibration_counter_total[cur_mag],
+			       (double)offset[cur_mag][0], (double)offset[cur_mag][1], (double)offset[cur_mag][2],
+			       (double)scale[cur_mag][0], (double)scale[cur_mag][1], (double)scale[cur_mag][2],
+			       (double)radius[cur_mag]);
 		}
 	}
 	
-	// Data points are no longer needed
+	// Fit state is no longer needed
 	for (size_t cur_mag=0; cur_mag<max_mags; cur_mag++) {
-		free(worker_data.x[cur_mag]);
-		free(worker_data.y[cur_mag]);
-		free(worker_data.z[cur_mag]);
+		free(worker_data.fit[cur_mag]);
 	}
 	
 	if (result == calibrate_return_ok) {
@@ -587,9 +546,14 @@ calibrate_return mag_calibrate_all(int mavlink_fd, int32_t (&device_ids)[max_mag
 				}
 
 				if (result == calibrate_return_ok) {
-					mscale.x_offset = sphere_x[cur_mag];
-					mscale.y_offset = sphere_y[cur_mag];
-					mscale.z_offset = sphere_z[cur_mag];
+					// Samples were taken with the range scale from MAGIOCCALIBRATE applied and no
+					// offset, the driver subtracts the offset before applying the scale.
+					mscale.x_offset = offset[cur_mag][0] / mscale.x_scale;
+					mscale.y_offset = offset[cur_mag][1] / mscale.y_scale;
+					mscale.z_offset = offset[cur_mag][2] / mscale.z_scale;
+					mscale.x_scale *= scale[cur_mag][0];
+					mscale.y_scale *= scale[cur_mag][1];
+					mscale.z_scale *= scale[cur_mag][2];
 
 					if (px4_ioctl(fd_mag, MAGIOCSSCALE, (long unsigned int)&mscale) != OK) {
 						mavlink_and_console_log_critical(mavlink_fd, CAL_ERROR_APPLY_CAL_MSG, cur_mag);
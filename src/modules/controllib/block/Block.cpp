@@ -41,6 +41,7 @@
 #include <string.h>
 #include <stdio.h>
 
+#include <systemlib/perf_counter.h>
 #include <uORB/Subscription.hpp>
 #include <uORB/Publication.hpp>
 
@@ -50,6 +51,11 @@
 namespace control
 {
 
+// shared by all blocks, copies / updates gives the
+// average number of topics copied per subscription update
+static perf_counter_t _perf_sub_updates = NULL;
+static perf_counter_t _perf_sub_copies = NULL;
+
 Block::Block(SuperBlock *parent, const char *name) :
 	_name(name),
 	_parent(parent),
@@ -82,38 +88,102 @@ void Block::getName(char *buf, size_t n)
 
 void Block::updateParams()
 {
+	// fetch the params in batches under a single lock of the
+	// param store, only values that changed since the last
+	// update are copied
+	param_t handles[paramBatchSize];
+	void *vals[paramBatchSize];
+	uint32_t seqs[paramBatchSize];
+	BlockParamBase *params[paramBatchSize];
+
 	BlockParamBase *param = getParams().getHead();
 	int count = 0;
 
 	while (param != NULL) {
-		if (count++ > maxParamsPerBlock) {
-			char name[blockNameLengthMax];
-			getName(name, blockNameLengthMax);
-			printf("exceeded max params for block: %s\n", name);
-			break;
+		unsigned n = 0;
+
+		while (param != NULL && n < paramBatchSize) {
+			if (count++ > maxParamsPerBlock) {
+				char name[blockNameLengthMax];
+				getName(name, blockNameLengthMax);
+				printf("exceeded max params for block: %s\n", name);
+				param = NULL;
+				break;
+			}
+
+			if (param->_handle != PARAM_INVALID) {
+				params[n] = param;
+				handles[n] = param->_handle;
+				vals[n] = param->getValuePtr();
+				seqs[n] = param->_seq;
+				n++;
+			}
+
+			param = param->getSibling();
 		}
 
-		//printf("updating param: %s\n", param->getName());
-		param->update();
-		param = param->getSibling();
+		if (n == 0 || param_get_many(handles, vals, seqs, n) == 0) {
+			continue;
+		}
+
+		for (unsigned i = 0; i < n; i++) {
+			params[i]->_seq = seqs[i];
+		}
 	}
 }
 
 void Block::updateSubscriptions()
 {
+	if (_perf_sub_updates == NULL) {
+		_perf_sub_updates = perf_alloc_once(PC_COUNT, "block_sub_updates");
+		_perf_sub_copies = perf_alloc_once(PC_COUNT, "block_sub_copies");
+	}
+
+	perf_count(_perf_sub_updates);
+
+	// check the subscriptions in batches with a single
+	// orb_check_multi each, instead of an orb_check
+	// per subscription, and only copy the updated ones.
+	// The batch saves the driver calls on POSIX only,
+	// on NuttX it still costs one ioctl per subscription
+	uORB::SubscriptionNode *subs[subscriptionBatchSize];
+	int handles[subscriptionBatchSize];
+	bool updated[subscriptionBatchSize];
+
 	uORB::SubscriptionNode *sub = getSubscriptions().getHead();
 	int count = 0;
 
 	while (sub != NULL) {
-		if (count++ > maxSubscriptionsPerBlock) {
-			char name[blockNameLengthMax];
-			getName(name, blockNameLengthMax);
-			printf("exceeded max subscriptions for block: %s\n", name);
-			break;
+		unsigned n = 0;
+
+		while (sub != NULL && n < subscriptionBatchSize) {
+			if (count++ > maxSubscriptionsPerBlock) {
+				char name[blockNameLengthMax];
+				getName(name, blockNameLengthMax);
+				printf("exceeded max subscriptions for block: %s\n", name);
+				sub = NULL;
+				break;
+			}
+
+			subs[n] = sub;
+			handles[n] = sub->getHandle();
+			n++;
+			sub = sub->getSibling();
 		}
 
-		sub->update();
-		sub = sub->getSibling();
+		if (n == 0) {
+			continue;
+		}
+
+		// a failed handle reports no update, the others are still valid
+		orb_check_multi(handles, updated, n);
+
+		for (unsigned i = 0; i < n; i++) {
+			if (updated[i]) {
+				subs[i]->copy();
+				perf_count(_perf_sub_copies);
+			}
+		}
 	}
 }
 
@@ -55,6 +55,8 @@ static const uint16_t maxChildrenPerBlock = 100;
 static const uint16_t maxParamsPerBlock = 100;
 static const uint16_t maxSubscriptionsPerBlock = 100;
 static const uint16_t maxPublicationsPerBlock = 100;
+static const uint8_t subscriptionBatchSize = 16;
+static const uint8_t paramBatchSize = 16;
 static const uint8_t blockNameLengthMax = 80;
 
 // forward declaration
@@ -49,7 +49,8 @@ namespace control
 {
 
 BlockParamBase::BlockParamBase(Block *parent, const char *name, bool parent_prefix) :
-	_handle(PARAM_INVALID)
+	_handle(PARAM_INVALID),
+	_seq(0)
 {
 	char fullname[blockNameLengthMax];
 
@@ -93,12 +94,20 @@ template <class T>
 T BlockParam<T>::get() { return _val; }
 
 template <class T>
-void BlockParam<T>::set(T val) { _val = val; }
+void BlockParam<T>::set(T val)
+{
+	_val = val;
+	// the local value no longer matches the param store
+	_seq = 0;
+}
 
 template <class T>
 void BlockParam<T>::update()
 {
-	if (_handle != PARAM_INVALID) { param_get(_handle, &_val); }
+	if (_handle != PARAM_INVALID) {
+		void *val = &_val;
+		param_get_many(&_handle, &val, &_seq, 1);
+	}
 }
 
 template <class T>
@@ -65,7 +65,16 @@ public:
 	virtual void update() = 0;
 	const char *getName() { return param_name(_handle); }
 protected:
+	friend class Block;
+
+	/**
+	 * Storage of the cached value, used by the block
+	 * to fetch all of its params in one batch.
+	 */
+	virtual void *getValuePtr() = 0;
+
 	param_t _handle;
+	uint32_t _seq; /**< change sequence number of the cached value, 0 to force a fetch */
 };
 
 /**
@@ -84,6 +93,7 @@ public:
 	void update();
 	virtual ~BlockParam();
 protected:
+	void *getValuePtr() { return &_val; }
 	T _val;
 };
 
@@ -1585,11 +1585,11 @@ int AttitudePositionEstimatorEKF::trip_nan()
 		usleep(100000);
 
 		PX4_INFO("tripping covariance #1 with NaN");
-		_ekf->KH[2][2] = nan_val; //  intermediate result used for covariance updates
+		_ekf->HP[2] = nan_val; // intermediate result used for covariance updates
 		usleep(100000);
 
 		PX4_INFO("tripping covariance #2 with NaN");
-		_ekf->KHP[5][5] = nan_val; // intermediate result used for covariance updates
+		_ekf->P[5][5] = nan_val; // covariance matrix
 		usleep(100000);
 
 		PX4_INFO("tripping covariance #3 with NaN");
@@ -114,14 +114,13 @@ public:
 
 
     // Global variables
-    float KH[EKF_STATE_ESTIMATES][EKF_STATE_ESTIMATES]; //  intermediate result used for covariance updates
-    float KHP[EKF_STATE_ESTIMATES][EKF_STATE_ESTIMATES]; // intermediate result used for covariance updates
+    float HP[EKF_STATE_ESTIMATES]; // intermediate result used for covariance updates, H*P for the current observation
     float P[EKF_STATE_ESTIMATES][EKF_STATE_ESTIMATES]; // covariance matrix
     float Kfusion[EKF_STATE_ESTIMATES]; // Kalman gains
     float states[EKF_STATE_ESTIMATES]; // state matrix
     float resetStates[EKF_STATE_ESTIMATES];
-    float storedStates[EKF_STATE_ESTIMATES][EKF_DATA_BUFFER_SIZE]; // state vectors stored for the last 50 time steps
-    uint32_t statetimeStamp[EKF_DATA_BUFFER_SIZE]; // time stamp for each state vector stored
+    float storedStates[EKF_DATA_BUFFER_SIZE][EKF_STATE_ESTIMATES]; // state vectors stored for the last 50 time steps, oldest overwritten first
+    uint32_t statetimeStamp[EKF_DATA_BUFFER_SIZE]; // time stamp for each state vector stored, monotonic along the ring
 
     // Times
     uint64_t lastVelPosFusion;  // the time of the last velocity fusion, in the standard time unit of the filter
@@ -229,10 +228,11 @@ public:
 
     bool numericalProtection;
 
-    unsigned storeIndex;
+    unsigned storeIndex;            // ring index the next state vector is written to
+    unsigned storeCount;            // number of valid entries in the ring, saturates at EKF_DATA_BUFFER_SIZE
 
     // Optical Flow error estimation
-    float storedOmega[3][EKF_DATA_BUFFER_SIZE]; // angular rate vector stored for the last 50 time steps used by optical flow eror estimators
+    float storedOmega[EKF_DATA_BUFFER_SIZE][3]; // angular rate vector stored for the last 50 time steps used by optical flow eror estimators
 
     // Two state EKF used to estimate focal length scale factor and terrain position
     float Popt[2][2];                       // state covariance matrix
@@ -299,6 +299,16 @@ public:
 
     void RecallOmega(float *omegaForFusion, uint64_t msec);
 
+    /**
+     * Find the stored entry closest in time to msec.
+     *
+     * The ring is time-ordered, so the search starts at the index predicted
+     * from the mean store interval and only walks to the neighbours.
+     *
+     * @return ring index of the closest entry, or -1 if the ring is empty
+     */
+    int FindStoreIndex(uint64_t msec, uint32_t &timeDelta) const;
+
     void quat2Tbn(Mat3f &TBodyNed, const float (&quat)[4]);
 
     void calcEarthRateNED(Vector3f &omega, float latitude);
@@ -327,7 +337,9 @@ public:
 
     void ConstrainStates();
 
-    void ForceSymmetry();
+    void CheckCovarianceDiverged();
+
+    void SymmetricCovarianceUpdate(const float *K, size_t n);
 
     /**
     * @brief
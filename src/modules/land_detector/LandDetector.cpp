@@ -46,43 +46,33 @@
 #include <px4_defines.h>
 
 LandDetector::LandDetector() :
+	ScheduledWorkItem("land_detector", LPWORK),
 	_landDetectedPub(0),
 	_landDetected( {0, false}),
 	       _arming_time(0),
-	       _taskShouldExit(false),
-	       _taskIsRunning(false),
-_work{} {
+	       _taskIsRunning(false)
+{
 	// ctor
 }
 
 LandDetector::~LandDetector()
 {
-	work_cancel(LPWORK, &_work);
-	_taskShouldExit = true;
+	ScheduleClear();
 }
 
 int LandDetector::start()
 {
-	/* schedule a cycle to start things */
-	work_queue(LPWORK, &_work, (worker_t)&LandDetector::cycle_trampoline, this, 0);
-
-	return 0;
+	/* first cycle right away, then at the update rate */
+	return ScheduleOnInterval(1000000 / LAND_DETECTOR_UPDATE_RATE);
 }
 
 void LandDetector::shutdown()
 {
-	_taskShouldExit = true;
-}
-
-void
-LandDetector::cycle_trampoline(void *arg)
-{
-	LandDetector *dev = reinterpret_cast<LandDetector *>(arg);
-
-	dev->cycle();
+	ScheduleClear();
+	_taskIsRunning = false;
 }
 
-void LandDetector::cycle()
+void LandDetector::Run()
 {
 	if (!_taskIsRunning) {
 		// advertise the first land detected uORB
@@ -95,7 +85,6 @@ void LandDetector::cycle()
 
 		// task is now running, keep doing so until shutdown() has been called
 		_taskIsRunning = true;
-		_taskShouldExit = false;
 	}
 
 	bool landDetected = update();
@@ -108,11 +97,6 @@ void LandDetector::cycle()
 		// publish the land detected broadcast
 		orb_publish(ORB_ID(vehicle_land_detected), (orb_advert_t)_landDetectedPub, &_landDetected);
 	}
-
-	if (!_taskShouldExit) {
-		work_queue(LPWORK, &_work, (worker_t)&LandDetector::cycle_trampoline, this,
-			   USEC2TICK(1000000 / LAND_DETECTOR_UPDATE_RATE));
-	}
 }
 
 bool LandDetector::orb_update(const struct orb_metadata *meta, int handle, void *buffer)
@@ -41,11 +41,11 @@
 #ifndef __LAND_DETECTOR_H__
 #define __LAND_DETECTOR_H__
 
-#include <px4_workqueue.h>
+#include <px4_work_item.h>
 #include <uORB/uORB.h>
 #include <uORB/topics/vehicle_land_detected.h>
 
-class LandDetector
+class LandDetector : public px4::ScheduledWorkItem
 {
 public:
 
@@ -63,18 +63,16 @@ public:
 	bool isLanded() { return _landDetected.landed; }
 
 	/**
-	 * @brief  Tells the Land Detector task that it should exit
+	 * @brief  Stops the land detector, returns once a cycle in progress has finished
 	 **/
 	void shutdown();
 
 	/**
-	 * @brief Blocking function that should be called from it's own task thread. This method will
+	 * @brief Schedules the land detector on the low priority work queue. It will
 	 *        run the underlying algorithm at the desired update rate and publish if the landing state changes.
 	 **/
 	int start();
 
-	static void	cycle_trampoline(void *arg);
-
 protected:
 
 	/**
@@ -108,11 +106,9 @@ protected:
 	uint64_t				_arming_time;			/**< timestamp of arming time */
 
 private:
-	bool _taskShouldExit;                                               /**< true if it is requested that this task should exit */
 	bool _taskIsRunning;                                                /**< task has reached main loop and is currently running */
-	struct work_s	_work;
 
-	void		cycle();
+	void		Run();
 };
 
 #endif //__LAND_DETECTOR_H__
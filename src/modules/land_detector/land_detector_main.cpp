@@ -79,18 +79,9 @@ static void land_detector_stop()
 		return;
 	}
 
+	// returns once a cycle in progress has finished
 	land_detector_task->shutdown();
 
-	// Wait for task to die
-	int i = 0;
-
-	do {
-		/* wait 20ms */
-		usleep(20000);
-
-	} while (land_detector_task->isRunning() && ++i < 50);
-
-
 	delete land_detector_task;
 	land_detector_task = nullptr;
 	warnx("land_detector has been stopped");
@@ -191,6 +182,7 @@ int land_detector_main(int argc, char *argv[])
 
 			if (land_detector_task->isRunning()) {
 				warnx("running (%s): %s", _currentMode, (land_detector_task->isLanded()) ? "LANDED" : "IN AIR");
+				land_detector_task->print_status();
 
 			} else {
 				warnx("exists, but not running (%s)", _currentMode);
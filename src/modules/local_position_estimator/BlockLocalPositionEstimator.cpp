@@ -811,7 +811,9 @@ void BlockLocalPositionEstimator::predict()
 	Q(X_bz, X_bz) = _pn_b_noise_power.get();
 
 	// continuous time kalman filter prediction
-	Matrix<float, n_x, 1> dx = (A * _x + B * _u) * getDt();
+	Matrix<float, n_x, 1> dx;
+	dx.addProduct(A, _x, getDt());
+	dx.addProduct(B, _u, getDt());
 
 	// only predict for components we have
 	// valid measurements for
@@ -829,8 +831,11 @@ void BlockLocalPositionEstimator::predict()
 
 	// propagate
 	_x += dx;
-	_P += (A * _P + _P * A.transpose() +
-	       B * R * B.transpose() + Q) * getDt();
+	Matrix<float, n_x, n_x> dP = Q;
+	dP.addProduct(A, _P);
+	dP.addProductTranspose(_P, A);
+	dP += B.quadForm(R);
+	_P.addScaled(dP, getDt());
 }
 
 void BlockLocalPositionEstimator::correctFlow()
@@ -913,7 +918,7 @@ void BlockLocalPositionEstimator::correctFlow()
 
 	// residual covariance, (inverse)
 	Matrix<float, n_y_flow, n_y_flow> S_I =
-		(C * _P * C.transpose() + R).inverse();
+		(C.quadForm(_P) + R).choleskyInverse();
 
 	// fault detection
 	float beta = sqrtf((r.transpose() * (S_I * r))(0, 0));
@@ -941,7 +946,7 @@ void BlockLocalPositionEstimator::correctFlow()
 	// kalman filter correction if no fault
 	if (_flowFault == FAULT_NONE) {
 		Matrix<float, n_x, n_y_flow> K =
-			_P * C.transpose() * S_I;
+			_P.multTranspose(C) * S_I;
 		_x += K * r;
 		_P -= K * C * _P;
 		// reset flow integral to current estimate of position
@@ -991,7 +996,7 @@ void BlockLocalPositionEstimator::correctSonar()
 
 	// residual covariance, (inverse)
 	Matrix<float, n_y_sonar, n_y_sonar> S_I =
-		(C * _P * C.transpose() + R).inverse();
+		(C.quadForm(_P) + R).choleskyInverse();
 
 	// fault detection
 	float beta = sqrtf((r.transpose()  * (S_I * r))(0, 0));
@@ -1020,7 +1025,7 @@ void BlockLocalPositionEstimator::correctSonar()
 	// kalman filter correction if no fault
 	if (_sonarFault == FAULT_NONE) {
 		Matrix<float, n_x, n_y_sonar> K =
-			_P * C.transpose() * S_I;
+			_P.multTranspose(C) * S_I;
 		_x += K * r;
 		_P -= K * C * _P;
 	}
@@ -1046,7 +1051,7 @@ void BlockLocalPositionEstimator::correctBaro()
 
 	// residual
 	Matrix<float, n_y_baro, n_y_baro> S_I =
-		((C * _P * C.transpose()) + R).inverse();
+		(C.quadForm(_P) + R).choleskyInverse();
 	Matrix<float, n_y_baro, 1> r = y - (C * _x);
 
 	// fault detection
@@ -1060,7 +1065,7 @@ void BlockLocalPositionEstimator::correctBaro()
 		}
 
 		// lower baro trust
-		S_I = ((C * _P * C.transpose()) + R * 10).inverse();
+		S_I = (C.quadForm(_P) + R * 10).choleskyInverse();
 
 	} else if (_baroFault) {
 		_baroFault = FAULT_NONE;
@@ -1070,7 +1075,7 @@ void BlockLocalPositionEstimator::correctBaro()
 
 	// kalman filter correction if no fault
 	if (_baroFault == FAULT_NONE) {
-		Matrix<float, n_x, n_y_baro> K = _P * C.transpose() * S_I;
+		Matrix<float, n_x, n_y_baro> K = _P.multTranspose(C) * S_I;
 		_x += K * r;
 		_P -= K * C * _P;
 	}
@@ -1111,7 +1116,7 @@ void BlockLocalPositionEstimator::correctLidar()
 	       cosf(_sub_att.get().pitch);
 
 	// residual
-	Matrix<float, n_y_lidar, n_y_lidar> S_I = ((C * _P * C.transpose()) + R).inverse();
+	Matrix<float, n_y_lidar, n_y_lidar> S_I = (C.quadForm(_P) + R).choleskyInverse();
 	Matrix<float, n_y_lidar, 1> r = y - C * _x;
 
 	// fault detection
@@ -1141,7 +1146,7 @@ void BlockLocalPositionEstimator::correctLidar()
 
 	// kalman filter correction if no fault
 	if (_lidarFault == FAULT_NONE) {
-		Matrix<float, n_x, n_y_lidar> K = _P * C.transpose() * S_I;
+		Matrix<float, n_x, n_y_lidar> K = _P.multTranspose(C) * S_I;
 		_x += K * r;
 		_P -= K * C * _P;
 	}
@@ -1214,7 +1219,7 @@ void BlockLocalPositionEstimator::correctGps()  	// TODO : use another other met
 
 	// residual
 	Matrix<float, 6, 1> r = y - C * _x;
-	Matrix<float, 6, 6> S_I = (C * _P * C.transpose() + R).inverse();
+	Matrix<float, 6, 6> S_I = (C.quadForm(_P) + R).choleskyInverse();
 
 	// fault detection
 	float beta = sqrtf((r.transpose() * (S_I * r))(0, 0));
@@ -1245,7 +1250,7 @@ void BlockLocalPositionEstimator::correctGps()  	// TODO : use another other met
 		}
 
 		// trust GPS less
-		S_I = ((C * _P * C.transpose()) + R * 10).inverse();
+		S_I = (C.quadForm(_P) + R * 10).choleskyInverse();
 
 	} else if (_gpsFault) {
 		_gpsFault = FAULT_NONE;
@@ -1255,7 +1260,7 @@ void BlockLocalPositionEstimator::correctGps()  	// TODO : use another other met
 
 	// kalman filter correction if no hard fault
 	if (_gpsFault == FAULT_NONE) {
-		Matrix<float, n_x, n_y_gps> K = _P * C.transpose() * S_I;
+		Matrix<float, n_x, n_y_gps> K = _P.multTranspose(C) * S_I;
 		_x += K * r;
 		_P -= K * C * _P;
 	}
@@ -1287,7 +1292,7 @@ void BlockLocalPositionEstimator::correctVision()
 	R(Y_vision_z, Y_vision_z) = _vision_z_stddev.get() * _vision_z_stddev.get();
 
 	// residual
-	Matrix<float, n_y_vision, n_y_vision> S_I = ((C * _P * C.transpose()) + R).inverse();
+	Matrix<float, n_y_vision, n_y_vision> S_I = (C.quadForm(_P) + R).choleskyInverse();
 	Matrix<float, n_y_vision, 1> r = y - C * _x;
 
 	// fault detection
@@ -1301,7 +1306,7 @@ void BlockLocalPositionEstimator::correctVision()
 		}
 
 		// trust less
-		S_I = ((C * _P * C.transpose()) + R * 10).inverse();
+		S_I = (C.quadForm(_P) + R * 10).choleskyInverse();
 
 	} else if (_visionFault) {
 		_visionFault = FAULT_NONE;
@@ -1311,7 +1316,7 @@ void BlockLocalPositionEstimator::correctVision()
 
 	// kalman filter correction if no fault
 	if (_visionFault == FAULT_NONE) {
-		Matrix<float, n_x, n_y_vision> K = _P * C.transpose() * S_I;
+		Matrix<float, n_x, n_y_vision> K = _P.multTranspose(C) * S_I;
 		_x += K * r;
 		_P -= K * C * _P;
 	}
@@ -1345,7 +1350,7 @@ void BlockLocalPositionEstimator::correctmocap()
 	R(Y_mocap_z, Y_mocap_z) = mocap_p_var;
 
 	// residual
-	Matrix<float, n_y_mocap, n_y_mocap> S_I = ((C * _P * C.transpose()) + R).inverse();
+	Matrix<float, n_y_mocap, n_y_mocap> S_I = (C.quadForm(_P) + R).choleskyInverse();
 	Matrix<float, n_y_mocap, 1> r = y - C * _x;
 
 	// fault detection
@@ -1359,7 +1364,7 @@ void BlockLocalPositionEstimator::correctmocap()
 		}
 
 		// trust less
-		S_I = ((C * _P * C.transpose()) + R * 10).inverse();
+		S_I = (C.quadForm(_P) + R * 10).choleskyInverse();
 
 	} else if (_mocapFault) {
 		_mocapFault = FAULT_NONE;
@@ -1369,7 +1374,7 @@ void BlockLocalPositionEstimator::correctmocap()
 
 	// kalman filter correction if no fault
 	if (_mocapFault == FAULT_NONE) {
-		Matrix<float, n_x, n_y_mocap> K = _P * C.transpose() * S_I;
+		Matrix<float, n_x, n_y_mocap> K = _P.multTranspose(C) * S_I;
 		_x += K * r;
 		_P -= K * C * _P;
 	}
@@ -70,7 +70,7 @@ public:
 
 	inline size_t cols() const
 	{
-		return _rows;
+		return _cols;
 	}
 
 	inline T operator()(size_t i) const
@@ -166,13 +166,23 @@ public:
 	void operator+=(const Matrix<T, M, N> &other)
 	{
 		Matrix<T, M, N> &self = *this;
-		self = self + other;
+
+		for (size_t i = 0; i < M; i++) {
+			for (size_t j = 0; j < N; j++) {
+				self(i, j) += other(i, j);
+			}
+		}
 	}
 
 	void operator-=(const Matrix<T, M, N> &other)
 	{
 		Matrix<T, M, N> &self = *this;
-		self = self - other;
+
+		for (size_t i = 0; i < M; i++) {
+			for (size_t j = 0; j < N; j++) {
+				self(i, j) -= other(i, j);
+			}
+		}
 	}
 
 	void operator*=(const Matrix<T, M, N> &other)
@@ -202,7 +212,7 @@ public:
 	Matrix<T, M, N> operator+(T scalar) const
 	{
 		Matrix<T, M, N> res;
-		Matrix<T, M, N> &self = *this;
+		const Matrix<T, M, N> &self = *this;
 
 		for (size_t i = 0; i < M; i++) {
 			for (size_t j = 0; j < N; j++) {
@@ -227,7 +237,101 @@ public:
 	void operator/=(T scalar)
 	{
 		Matrix<T, M, N> &self = *this;
-		self = self * (1.0f / scalar);
+		self *= (1.0f / scalar);
+	}
+
+	/**
+	 * Fused kernels
+	 *
+	 * These accumulate into *this in place, so that
+	 * expressions such as (A * x + B * u) * dt or
+	 * A * P + P * A' can be evaluated without building
+	 * a full temporary for every intermediate product.
+	 */
+
+	// self += scale * (A * B)
+	template<size_t P>
+	void addProduct(const Matrix<T, M, P> &A, const Matrix<T, P, N> &B, T scale = 1)
+	{
+		Matrix<T, M, N> &self = *this;
+
+		for (size_t i = 0; i < M; i++) {
+			for (size_t k = 0; k < N; k++) {
+				T sum = 0;
+
+				for (size_t j = 0; j < P; j++) {
+					sum += A(i, j) * B(j, k);
+				}
+
+				self(i, k) += scale * sum;
+			}
+		}
+	}
+
+	// self += scale * (A * B')
+	template<size_t P>
+	void addProductTranspose(const Matrix<T, M, P> &A, const Matrix<T, N, P> &B, T scale = 1)
+	{
+		Matrix<T, M, N> &self = *this;
+
+		for (size_t i = 0; i < M; i++) {
+			for (size_t k = 0; k < N; k++) {
+				T sum = 0;
+
+				for (size_t j = 0; j < P; j++) {
+					sum += A(i, j) * B(k, j);
+				}
+
+				self(i, k) += scale * sum;
+			}
+		}
+	}
+
+	// self += scale * other
+	void addScaled(const Matrix<T, M, N> &other, T scale)
+	{
+		Matrix<T, M, N> &self = *this;
+
+		for (size_t i = 0; i < M; i++) {
+			for (size_t j = 0; j < N; j++) {
+				self(i, j) += scale * other(i, j);
+			}
+		}
+	}
+
+	// self * other', without forming the transpose
+	template<size_t P>
+	Matrix<T, M, P> multTranspose(const Matrix<T, P, N> &other) const
+	{
+		Matrix<T, M, P> res;
+		res.addProductTranspose(*this, other);
+		return res;
+	}
+
+	// self * other * self', for symmetric other
+	// (e.g. C * P * C'), only the upper triangle
+	// is computed and then mirrored
+	Matrix<T, M, M> quadForm(const Matrix<T, N, N> &other) const
+	{
+		const Matrix<T, M, N> &self = *this;
+		Matrix<T, M, N> tmp;
+		tmp.addProduct(self, other);
+		Matrix<T, M, M> res;
+
+		for (size_t i = 0; i < M; i++) {
+			for (size_t k = i; k < M; k++) {
+				T sum = 0;
+
+				for (size_t j = 0; j < N; j++) {
+					sum += tmp(i, j) * self(k, j);
+				}
+
+				res(i, k) = sum;
+				res(k, i) = sum;
+			}
+		}
+
+		return res;
 	}
 
 	/**
@@ -455,6 +559,138 @@ public:
 		return X;
 	}
 
+	/**
+	 * Cholesky factorization A = L * L' for symmetric
+	 * positive definite matrices, only the lower
+	 * triangle of A is read
+	 *
+	 * @return false if the matrix is not positive definite
+	 */
+	bool cholesky(Matrix<T, M, M> &L) const
+	{
+		const Matrix<T, M, M> &A = (*this);
+		L.setZero();
+
+		for (size_t j = 0; j < M; j++) {
+			T d = A(j, j);
+
+			for (size_t k = 0; k < j; k++) {
+				d -= L(j, k) * L(j, k);
+			}
+
+			if (!(d > 1e-8f)) {
+				return false;
+			}
+
+			L(j, j) = sqrtf(d);
+			T d_inv = 1.0f / L(j, j);
+
+			for (size_t i = j + 1; i < M; i++) {
+				T sum = A(i, j);
+
+				for (size_t k = 0; k < j; k++) {
+					sum -= L(i, k) * L(j, k);
+				}
+
+				L(i, j) = sum * d_inv;
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * solve A * X = B for symmetric positive definite A
+	 * via cholesky, falls back to the LU inverse if
+	 * A is not positive definite
+	 */
+	template<size_t P>
+	Matrix<T, M, P> choleskySolve(const Matrix<T, M, P> &B) const
+	{
+		Matrix<T, M, M> L;
+
+		if (!cholesky(L)) {
+			return inverse() * B;
+		}
+
+		Matrix<T, M, P> X = B;
+
+		// forward subst L * Y = B
+		for (size_t c = 0; c < P; c++) {
+			for (size_t i = 0; i < M; i++) {
+				for (size_t j = 0; j < i; j++) {
+					X(i, c) -= L(i, j) * X(j, c);
+				}
+
+				X(i, c) /= L(i, i);
+			}
+		}
+
+		// back subst L' * X = Y
+		for (size_t c = 0; c < P; c++) {
+			for (size_t k = 0; k < M; k++) {
+				size_t i = M - 1 - k;
+
+				for (size_t j = i + 1; j < M; j++) {
+					X(i, c) -= L(j, i) * X(j, c);
+				}
+
+				X(i, c) /= L(i, i);
+			}
+		}
+
+		return X;
+	}
+
+	/**
+	 * inverse of a symmetric positive definite matrix,
+	 * such as an innovation covariance, via cholesky,
+	 * the result is exactly symmetric
+	 */
+	Matrix<T, M, M> choleskyInverse() const
+	{
+		Matrix<T, M, M> L;
+
+		if (!cholesky(L)) {
+			return inverse();
+		}
+
+		// invert the lower triangular factor in place
+		Matrix<T, M, M> L_I;
+
+		for (size_t j = 0; j < M; j++) {
+			L_I(j, j) = 1.0f / L(j, j);
+
+			for (size_t i = j + 1; i < M; i++) {
+				T sum = 0;
+
+				for (size_t k = j; k < i; k++) {
+					sum -= L(i, k) * L_I(k, j);
+				}
+
+				L_I(i, j) = sum / L(i, i);
+			}
+		}
+
+		// A^-1 = L^-T * L^-1, upper triangle mirrored
+		Matrix<T, M, M> res;
+
+		for (size_t i = 0; i < M; i++) {
+			for (size_t j = i; j < M; j++) {
+				T sum = 0;
+
+				for (size_t k = j; k < M; k++) {
+					sum += L_I(k, i) * L_I(k, j);
+				}
+
+				res(i, j) = sum;
+				res(j, i) = sum;
+			}
+		}
+
+		return res;
+	}
+
 };
 
 typedef Matrix<float, 2, 1> Vector2f;
@@ -0,0 +1,120 @@
+#include "Matrix.hpp"
+#include <assert.h>
+#include <stdio.h>
+#include <time.h>
+
+using namespace matrix;
+
+static const size_t n_x = 9;
+static const size_t n_u = 3;
+static const size_t n_y = 6;
+static const int iterations = 20000;
+
+static double elapsed(clock_t start)
+{
+	return double(clock() - start) / CLOCKS_PER_SEC * 1e6 / iterations;
+}
+
+// volatile sink so the optimizer keeps the loops
+static volatile float sink;
+
+int main()
+{
+	Matrix<float, n_x, n_x> A;
+	Matrix<float, n_x, n_u> B;
+	Matrix<float, n_u, n_u> R;
+	Matrix<float, n_x, n_x> Q;
+	Matrix<float, n_x, n_x> P;
+	Matrix<float, n_y, n_x> C;
+	Matrix<float, n_y, n_y> R_y;
+
+	for (size_t i = 0; i < n_x; i++) {
+		for (size_t j = 0; j < n_x; j++) {
+			A(i, j) = 0.01f * float(i + 2 * j);
+		}
+
+		P(i, i) = 1.0f + 0.1f * i;
+		Q(i, i) = 0.01f;
+	}
+
+	for (size_t i = 0; i < n_u; i++) {
+		B(i + 3, i) = 1;
+		R(i, i) = 0.1f;
+	}
+
+	for (size_t i = 0; i < n_y; i++) {
+		C(i, i) = 1;
+		R_y(i, i) = 0.5f;
+	}
+
+	float dt = 0.01f;
+
+	// covariance propagation
+	clock_t start = clock();
+	Matrix<float, n_x, n_x> P_naive = P;
+
+	for (int k = 0; k < iterations; k++) {
+		P_naive = P + (A * P + P * A.transpose() +
+			       B * R * B.transpose() + Q) * dt;
+		sink = P_naive(0, 0);
+	}
+
+	double t_naive = elapsed(start);
+
+	start = clock();
+	Matrix<float, n_x, n_x> P_fused = P;
+
+	for (int k = 0; k < iterations; k++) {
+		Matrix<float, n_x, n_x> dP = Q;
+		dP.addProduct(A, P);
+		dP.addProductTranspose(P, A);
+		dP += B.quadForm(R);
+		P_fused = P;
+		P_fused.addScaled(dP, dt);
+		sink = P_fused(0, 0);
+	}
+
+	double t_fused = elapsed(start);
+	printf("predict  %dx%d: naive %8.3f us fused    %8.3f us\n",
+	       int(n_x), int(n_x), t_naive, t_fused);
+
+	// innovation covariance inverse
+	start = clock();
+	Matrix<float, n_y, n_y> S_I_lu;
+
+	for (int k = 0; k < iterations; k++) {
+		S_I_lu = (C * P * C.transpose() + R_y).inverse();
+		sink = S_I_lu(0, 0);
+	}
+
+	double t_lu = elapsed(start);
+
+	start = clock();
+	Matrix<float, n_y, n_y> S_I_chol;
+
+	for (int k = 0; k < iterations; k++) {
+		Matrix<float, n_y, n_y> S = C.quadForm(P);
+		S += R_y;
+		S_I_chol = S.choleskyInverse();
+		sink = S_I_chol(0, 0);
+	}
+
+	double t_chol = elapsed(start);
+	printf("correct  %dx%d: lu    %8.3f us cholesky %8.3f us\n",
+	       int(n_y), int(n_y), t_lu, t_chol);
+
+	// both paths have to agree
+	for (size_t i = 0; i < n_x; i++) {
+		for (size_t j = 0; j < n_x; j++) {
+			assert(fabsf(P_naive(i, j) - P_fused(i, j)) < 1e-5f);
+		}
+	}
+
+	for (size_t i = 0; i < n_y; i++) {
+		for (size_t j = 0; j < n_y; j++) {
+			assert(fabsf(S_I_lu(i, j) - S_I_chol(i, j)) < 1e-5f);
+		}
+	}
+
+	return 0;
+}
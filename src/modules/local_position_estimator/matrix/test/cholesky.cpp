@@ -0,0 +1,114 @@
+#include "Matrix.hpp"
+#include <assert.h>
+#include <stdio.h>
+
+using namespace matrix;
+
+template<size_t M>
+static float maxError(const Matrix<float, M, M> &A, const Matrix<float, M, M> &B)
+{
+	float err = 0;
+
+	for (size_t i = 0; i < M; i++) {
+		for (size_t j = 0; j < M; j++) {
+			float e = fabsf(A(i, j) - B(i, j));
+
+			if (e > err) {
+				err = e;
+			}
+		}
+	}
+
+	return err;
+}
+
+// build a well conditioned spd matrix S = G * G' + M * I
+template<size_t M>
+static Matrix<float, M, M> spd(unsigned seed)
+{
+	Matrix<float, M, M> G;
+
+	for (size_t i = 0; i < M; i++) {
+		for (size_t j = 0; j < M; j++) {
+			seed = seed * 1103515245u + 12345u;
+			G(i, j) = float((seed >> 16) & 0xff) / 255.0f - 0.5f;
+		}
+	}
+
+	Matrix<float, M, M> S;
+	S.addProductTranspose(G, G);
+
+	for (size_t i = 0; i < M; i++) {
+		S(i, i) += M;
+	}
+
+	return S;
+}
+
+template<size_t M>
+static void check(unsigned seed)
+{
+	Matrix<float, M, M> S = spd<M>(seed);
+	Matrix<float, M, M> I;
+	I.setIdentity();
+
+	// factor
+	Matrix<float, M, M> L;
+	bool ok = S.cholesky(L);
+	(void)ok;
+	assert(ok);
+	float err_factor = maxError<M>(L.multTranspose(L), S);
+
+	// inverse, compare with lu inverse
+	Matrix<float, M, M> S_I = S.choleskyInverse();
+	float err_inv = maxError<M>(S * S_I, I);
+	float err_lu = maxError<M>(S_I, S.inverse());
+
+	// solve
+	Matrix<float, M, 1> b;
+
+	for (size_t i = 0; i < M; i++) {
+		b(i) = float(i) - 1.5f;
+	}
+
+	Matrix<float, M, 1> x = S.choleskySolve(b);
+	Matrix<float, M, 1> r = S * x - b;
+	float err_solve = 0;
+
+	for (size_t i = 0; i < M; i++) {
+		if (fabsf(r(i)) > err_solve) {
+			err_solve = fabsf(r(i));
+		}
+	}
+
+	printf("%2d x %2d: factor %8.2e inverse %8.2e vs lu %8.2e solve %8.2e\n",
+	       int(M), int(M), double(err_factor), double(err_inv),
+	       double(err_lu), double(err_solve));
+	assert(err_factor < 1e-4f);
+	assert(err_inv < 1e-4f);
+	assert(err_lu < 1e-4f);
+	assert(err_solve < 1e-4f);
+
+	// result is exactly symmetric
+	assert(S_I == S_I.transpose());
+}
+
+int main()
+{
+	check<1>(1);
+	check<2>(2);
+	check<3>(3);
+	check<4>(4);
+	check<6>(6);
+	check<9>(9);
+
+	// not positive definite, falls back to lu
+	float data[9] = {1, 0, 0, 0, -1, 0, 0, 0, 1};
+	Matrix3f A(data);
+	Matrix3f L;
+	bool ok = A.cholesky(L);
+	(void)ok;
+	assert(!ok);
+	assert(A.choleskyInverse() == A.inverse());
+	return 0;
+}
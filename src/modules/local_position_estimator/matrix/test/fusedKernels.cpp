@@ -0,0 +1,54 @@
+#include "Matrix.hpp"
+#include <assert.h>
+#include <stdio.h>
+
+using namespace matrix;
+
+int main()
+{
+	float data_A[9] = {1, 2, 3, 4, 5, 6, 7, 8, 10};
+	float data_B[6] = {1, 0, 0, 1, 1, 1};
+	float data_P[9] = {2, 1, 0, 1, 3, 1, 0, 1, 4};
+	Matrix3f A(data_A);
+	Matrix<float, 3, 2> B(data_B);
+	Matrix3f P(data_P);
+	Vector3f x(1, 2, 3);
+	Matrix<float, 2, 1> u;
+	u(0) = -1;
+	u(1) = 2;
+	float dt = 0.5f;
+
+	// (A * x + B * u) * dt
+	Vector3f dx;
+	dx.addProduct(A, x, dt);
+	dx.addProduct(B, u, dt);
+	Vector3f dx_check = (A * x + B * u) * dt;
+	dx.print();
+	(void)dx_check;
+	assert(dx == dx_check);
+
+	// A * P + P * A'
+	Matrix3f dP;
+	dP.addProduct(A, P);
+	dP.addProductTranspose(P, A);
+	assert(dP == A * P + P * A.transpose());
+
+	// P += dP * dt
+	Matrix3f P2 = P;
+	P2.addScaled(dP, dt);
+	assert(P2 == P + dP * dt);
+
+	// B * B'
+	assert(B.multTranspose(B) == B * B.transpose());
+
+	// A * P * A'
+	assert(A.quadForm(P) == A * P * A.transpose());
+
+	// in place add / subtract
+	Matrix3f C = A;
+	C += P;
+	assert(C == A + P);
+	C -= P;
+	assert(C == A);
+	return 0;
+}
@@ -87,6 +87,7 @@
 #include <systemlib/perf_counter.h>
 #include <systemlib/systemlib.h>
 #include <systemlib/circuit_breaker.h>
+#include <systemlib/attitude_pipeline.h>
 #include <lib/mathlib/mathlib.h>
 #include <lib/geo/geo.h>
 
@@ -118,14 +119,25 @@ public:
 	/**
 	 * Start the multicopter attitude control task.
 	 *
+	 * @param pipeline	if true, run as a stage on the attitude estimator
+	 *			thread instead of in a task of our own.
 	 * @return		OK on success.
 	 */
-	int		start();
+	int		start(bool pipeline);
+
+	/**
+	 * Print the run mode.
+	 *
+	 * @return		OK, or ERROR if nothing is running the controller.
+	 */
+	int		print();
 
 private:
 
 	bool	_task_should_exit;		/**< if true, task_main() should exit */
 	int		_control_task;			/**< task handle */
+	bool	_pipeline;				/**< running as an attitude pipeline stage */
+	bool	_subscribed;			/**< input topics subscribed on the running thread */
 
 	int		_v_att_sub;				/**< vehicle attitude subscription */
 	int		_v_att_sp_sub;			/**< vehicle attitude setpoint subscription */
@@ -274,6 +286,31 @@ private:
 	 */
 	void		vehicle_motor_limits_poll();
 
+	/**
+	 * Subscribe to the input topics on the calling thread.
+	 */
+	void		subscribe();
+
+	/**
+	 * Drop the subscriptions taken by subscribe().
+	 */
+	void		unsubscribe();
+
+	/**
+	 * Run one controller iteration on the attitude in _v_att.
+	 */
+	void		control_cycle();
+
+	/**
+	 * Attitude pipeline stage, runs on the estimator thread.
+	 */
+	static bool	pipeline_stage(void *arg, const struct vehicle_attitude_s *att);
+
+	/**
+	 * Spawn the controller task.
+	 */
+	int		start_task();
+
 	/**
 	 * Shim for calling task_main from task_create.
 	 */
@@ -301,15 +338,19 @@ MulticopterAttitudeControl::MulticopterAttitudeControl() :
 
 	_task_should_exit(false),
 	_control_task(-1),
+	_pipeline(false),
+	_subscribed(false),
 
 /* subscriptions */
 	_v_att_sub(-1),
 	_v_att_sp_sub(-1),
+	_v_rates_sp_sub(-1),
 	_v_control_mode_sub(-1),
 	_params_sub(-1),
 	_manual_control_sp_sub(-1),
 	_armed_sub(-1),
 	_vehicle_status_sub(-1),
+	_motor_limits_sub(-1),
 
 /* publications */
 	_v_rates_sp_pub(nullptr),
@@ -393,9 +434,29 @@ MulticopterAttitudeControl::MulticopterAttitudeControl() :
 
 MulticopterAttitudeControl::~MulticopterAttitudeControl()
 {
+	_task_should_exit = true;
+
+	if (_pipeline) {
+		/*
+		 * the stage drops its subscriptions on the estimator thread and detaches,
+		 * it may have started the task just before, which is waited for below
+		 */
+		unsigned i = 0;
+
+		while (attitude_pipeline_attached(&MulticopterAttitudeControl::pipeline_stage, this)) {
+			/* wait 20ms */
+			usleep(20000);
+
+			/* no attitude for a second, make sure the stage never runs again */
+			if (++i > 50) {
+				attitude_pipeline_detach(&MulticopterAttitudeControl::pipeline_stage, this);
+				break;
+			}
+		}
+	}
+
 	if (_control_task != -1) {
 		/* task wakes up every 100ms or so at the longest */
-		_task_should_exit = true;
 
 		/* wait for a second for the task to quit at our request */
 		unsigned i = 0;
@@ -740,15 +801,10 @@ MulticopterAttitudeControl::task_main_trampoline(int argc, char *argv[])
 }
 
 void
-MulticopterAttitudeControl::task_main()
+MulticopterAttitudeControl::subscribe()
 {
-
-	/*
-	 * do subscriptions
-	 */
 	_v_att_sp_sub = orb_subscribe(ORB_ID(vehicle_attitude_setpoint));
 	_v_rates_sp_sub = orb_subscribe(ORB_ID(vehicle_rates_setpoint));
-	_v_att_sub = orb_subscribe(ORB_ID(vehicle_attitude));
 	_v_control_mode_sub = orb_subscribe(ORB_ID(vehicle_control_mode));
 	_params_sub = orb_subscribe(ORB_ID(parameter_update));
 	_manual_control_sp_sub = orb_subscribe(ORB_ID(manual_control_setpoint));
@@ -756,6 +812,178 @@ MulticopterAttitudeControl::task_main()
 	_vehicle_status_sub = orb_subscribe(ORB_ID(vehicle_status));
 	_motor_limits_sub = orb_subscribe(ORB_ID(multirotor_motor_limits));
 
+	_subscribed = true;
+}
+
+void
+MulticopterAttitudeControl::unsubscribe()
+{
+	int *subs[] = {
+		&_v_att_sub, &_v_att_sp_sub, &_v_rates_sp_sub, &_v_control_mode_sub, &_params_sub,
+		&_manual_control_sp_sub, &_armed_sub, &_vehicle_status_sub, &_motor_limits_sub
+	};
+
+	for (unsigned i = 0; i < sizeof(subs) / sizeof(subs[0]); i++) {
+		if (*subs[i] >= 0) {
+			orb_unsubscribe(*subs[i]);
+			*subs[i] = -1;
+		}
+	}
+
+	_subscribed = false;
+}
+
+void
+MulticopterAttitudeControl::control_cycle()
+{
+	static uint64_t last_run = 0;
+	float dt = (hrt_absolute_time() - last_run) / 1000000.0f;
+	last_run = hrt_absolute_time();
+
+	/* guard against too small (< 2ms) and too large (> 20ms) dt's */
+	if (dt < 0.002f) {
+		dt = 0.002f;
+
+	} else if (dt > 0.02f) {
+		dt = 0.02f;
+	}
+
+	/* check for updates in other topics */
+	parameter_update_poll();
+	vehicle_control_mode_poll();
+	arming_status_poll();
+	vehicle_manual_poll();
+	vehicle_status_poll();
+	vehicle_motor_limits_poll();
+
+	if (_v_control_mode.flag_control_attitude_enabled) {
+		control_attitude(dt);
+
+		/* publish attitude rates setpoint */
+		_v_rates_sp.roll = _rates_sp(0);
+		_v_rates_sp.pitch = _rates_sp(1);
+		_v_rates_sp.yaw = _rates_sp(2);
+		_v_rates_sp.thrust = _thrust_sp;
+		_v_rates_sp.timestamp = hrt_absolute_time();
+
+		if (_v_rates_sp_pub != nullptr) {
+			orb_publish(_rates_sp_id, _v_rates_sp_pub, &_v_rates_sp);
+
+		} else if (_rates_sp_id) {
+			_v_rates_sp_pub = orb_advertise(_rates_sp_id, &_v_rates_sp);
+		}
+
+	} else {
+		/* attitude controller disabled, poll rates setpoint topic */
+		if (_v_control_mode.flag_control_manual_enabled) {
+			/* manual rates control - ACRO mode */
+			_rates_sp = math::Vector<3>(_manual_control_sp.y, -_manual_control_sp.x, _manual_control_sp.r).emult(_params.acro_rate_max);
+			_thrust_sp = math::min(_manual_control_sp.z, MANUAL_THROTTLE_MAX_MULTICOPTER);
+
+			/* publish attitude rates setpoint */
+			_v_rates_sp.roll = _rates_sp(0);
+			_v_rates_sp.pitch = _rates_sp(1);
+			_v_rates_sp.yaw = _rates_sp(2);
+			_v_rates_sp.thrust = _thrust_sp;
+			_v_rates_sp.timestamp = hrt_absolute_time();
+
+			if (_v_rates_sp_pub != nullptr) {
+				orb_publish(_rates_sp_id, _v_rates_sp_pub, &_v_rates_sp);
+
+			} else if (_rates_sp_id) {
+				_v_rates_sp_pub = orb_advertise(_rates_sp_id, &_v_rates_sp);
+			}
+
+		} else {
+			/* attitude controller disabled, poll rates setpoint topic */
+			vehicle_rates_setpoint_poll();
+			_rates_sp(0) = _v_rates_sp.roll;
+			_rates_sp(1) = _v_rates_sp.pitch;
+			_rates_sp(2) = _v_rates_sp.yaw;
+			_thrust_sp = _v_rates_sp.thrust;
+		}
+	}
+
+	if (_v_control_mode.flag_control_rates_enabled) {
+		control_attitude_rates(dt);
+
+		/* publish actuator controls */
+		_actuators.control[0] = (PX4_ISFINITE(_att_control(0))) ? _att_control(0) : 0.0f;
+		_actuators.control[1] = (PX4_ISFINITE(_att_control(1))) ? _att_control(1) : 0.0f;
+		_actuators.control[2] = (PX4_ISFINITE(_att_control(2))) ? _att_control(2) : 0.0f;
+		_actuators.control[3] = (PX4_ISFINITE(_thrust_sp)) ? _thrust_sp : 0.0f;
+		_actuators.timestamp = hrt_absolute_time();
+		_actuators.timestamp_sample = _v_att.timestamp;
+
+		_controller_status.roll_rate_integ = _rates_int(0);
+		_controller_status.pitch_rate_integ = _rates_int(1);
+		_controller_status.yaw_rate_integ = _rates_int(2);
+		_controller_status.timestamp = hrt_absolute_time();
+
+		if (!_actuators_0_circuit_breaker_enabled) {
+			if (_actuators_0_pub != nullptr) {
+				orb_publish(_actuators_id, _actuators_0_pub, &_actuators);
+				perf_end(_controller_latency_perf);
+
+			} else if (_actuators_id) {
+				_actuators_0_pub = orb_advertise(_actuators_id, &_actuators);
+			}
+
+		}
+
+		/* publish controller status */
+		if(_controller_status_pub != nullptr) {
+			orb_publish(ORB_ID(mc_att_ctrl_status),_controller_status_pub, &_controller_status);
+		} else {
+			_controller_status_pub = orb_advertise(ORB_ID(mc_att_ctrl_status), &_controller_status);
+		}
+	}
+}
+
+bool
+MulticopterAttitudeControl::pipeline_stage(void *arg, const struct vehicle_attitude_s *att)
+{
+	MulticopterAttitudeControl *control = (MulticopterAttitudeControl *)arg;
+
+	/* subscriptions belong to the estimator thread, release them there */
+	if (att == nullptr || control->_task_should_exit) {
+		control->unsubscribe();
+
+		/* the estimator stopped, keep controlling from a task of our own */
+		if (att == nullptr && !control->_task_should_exit) {
+			warnx("attitude pipeline host stopped, starting task");
+			control->start_task();
+		}
+
+		return false;
+	}
+
+	if (!control->_subscribed) {
+		control->subscribe();
+		control->parameters_update();
+	}
+
+	perf_begin(control->_loop_perf);
+
+	/* the estimator hands its sample over directly, no uORB round trip */
+	memcpy(&control->_v_att, att, sizeof(control->_v_att));
+	control->control_cycle();
+
+	perf_end(control->_loop_perf);
+
+	return true;
+}
+
+void
+MulticopterAttitudeControl::task_main()
+{
+
+	/*
+	 * do subscriptions
+	 */
+	subscribe();
+	_v_att_sub = orb_subscribe(ORB_ID(vehicle_attitude));
+
 	/* initialize parameters cache */
 	parameters_update();
 
@@ -786,125 +1014,43 @@ MulticopterAttitudeControl::task_main()
 
 		/* run controller on attitude changes */
 		if (fds[0].revents & POLLIN) {
-			static uint64_t last_run = 0;
-			float dt = (hrt_absolute_time() - last_run) / 1000000.0f;
-			last_run = hrt_absolute_time();
-
-			/* guard against too small (< 2ms) and too large (> 20ms) dt's */
-			if (dt < 0.002f) {
-				dt = 0.002f;
-
-			} else if (dt > 0.02f) {
-				dt = 0.02f;
-			}
-
 			/* copy attitude topic */
 			orb_copy(ORB_ID(vehicle_attitude), _v_att_sub, &_v_att);
 
-			/* check for updates in other topics */
-			parameter_update_poll();
-			vehicle_control_mode_poll();
-			arming_status_poll();
-			vehicle_manual_poll();
-			vehicle_status_poll();
-			vehicle_motor_limits_poll();
-
-			if (_v_control_mode.flag_control_attitude_enabled) {
-				control_attitude(dt);
-
-				/* publish attitude rates setpoint */
-				_v_rates_sp.roll = _rates_sp(0);
-				_v_rates_sp.pitch = _rates_sp(1);
-				_v_rates_sp.yaw = _rates_sp(2);
-				_v_rates_sp.thrust = _thrust_sp;
-				_v_rates_sp.timestamp = hrt_absolute_time();
-
-				if (_v_rates_sp_pub != nullptr) {
-					orb_publish(_rates_sp_id, _v_rates_sp_pub, &_v_rates_sp);
-
-				} else if (_rates_sp_id) {
-					_v_rates_sp_pub = orb_advertise(_rates_sp_id, &_v_rates_sp);
-				}
-
-			} else {
-				/* attitude controller disabled, poll rates setpoint topic */
-				if (_v_control_mode.flag_control_manual_enabled) {
-					/* manual rates control - ACRO mode */
-					_rates_sp = math::Vector<3>(_manual_control_sp.y, -_manual_control_sp.x, _manual_control_sp.r).emult(_params.acro_rate_max);
-					_thrust_sp = math::min(_manual_control_sp.z, MANUAL_THROTTLE_MAX_MULTICOPTER);
-
-					/* publish attitude rates setpoint */
-					_v_rates_sp.roll = _rates_sp(0);
-					_v_rates_sp.pitch = _rates_sp(1);
-					_v_rates_sp.yaw = _rates_sp(2);
-					_v_rates_sp.thrust = _thrust_sp;
-					_v_rates_sp.timestamp = hrt_absolute_time();
-
-					if (_v_rates_sp_pub != nullptr) {
-						orb_publish(_rates_sp_id, _v_rates_sp_pub, &_v_rates_sp);
-
-					} else if (_rates_sp_id) {
-						_v_rates_sp_pub = orb_advertise(_rates_sp_id, &_v_rates_sp);
-					}
-
-				} else {
-					/* attitude controller disabled, poll rates setpoint topic */
-					vehicle_rates_setpoint_poll();
-					_rates_sp(0) = _v_rates_sp.roll;
-					_rates_sp(1) = _v_rates_sp.pitch;
-					_rates_sp(2) = _v_rates_sp.yaw;
-					_thrust_sp = _v_rates_sp.thrust;
-				}
-			}
-
-			if (_v_control_mode.flag_control_rates_enabled) {
-				control_attitude_rates(dt);
+			control_cycle();
+		}
 
-				/* publish actuator controls */
-				_actuators.control[0] = (PX4_ISFINITE(_att_control(0))) ? _att_control(0) : 0.0f;
-				_actuators.control[1] = (PX4_ISFINITE(_att_control(1))) ? _att_control(1) : 0.0f;
-				_actuators.control[2] = (PX4_ISFINITE(_att_control(2))) ? _att_control(2) : 0.0f;
-				_actuators.control[3] = (PX4_ISFINITE(_thrust_sp)) ? _thrust_sp : 0.0f;
-				_actuators.timestamp = hrt_absolute_time();
-				_actuators.timestamp_sample = _v_att.timestamp;
+		perf_end(_loop_perf);
+	}
 
-				_controller_status.roll_rate_integ = _rates_int(0);
-				_controller_status.pitch_rate_integ = _rates_int(1);
-				_controller_status.yaw_rate_integ = _rates_int(2);
-				_controller_status.timestamp = hrt_absolute_time();
+	unsubscribe();
 
-				if (!_actuators_0_circuit_breaker_enabled) {
-					if (_actuators_0_pub != nullptr) {
-						orb_publish(_actuators_id, _actuators_0_pub, &_actuators);
-						perf_end(_controller_latency_perf);
+	_control_task = -1;
+	return;
+}
 
-					} else if (_actuators_id) {
-						_actuators_0_pub = orb_advertise(_actuators_id, &_actuators);
-					}
+int
+MulticopterAttitudeControl::start(bool pipeline)
+{
+	ASSERT(_control_task == -1);
 
-				}
+	if (pipeline) {
+		int ret = attitude_pipeline_attach(&MulticopterAttitudeControl::pipeline_stage, this);
 
-				/* publish controller status */
-				if(_controller_status_pub != nullptr) {
-					orb_publish(ORB_ID(mc_att_ctrl_status),_controller_status_pub, &_controller_status);
-				} else {
-					_controller_status_pub = orb_advertise(ORB_ID(mc_att_ctrl_status), &_controller_status);
-				}
-			}
+		if (ret == OK) {
+			_pipeline = true;
+			return OK;
 		}
 
-		perf_end(_loop_perf);
+		warnx("attitude pipeline unavailable (%d), starting task", ret);
 	}
 
-	_control_task = -1;
-	return;
+	return start_task();
 }
 
 int
-MulticopterAttitudeControl::start()
+MulticopterAttitudeControl::start_task()
 {
-	ASSERT(_control_task == -1);
-
 	/* start the task */
 	_control_task = px4_task_spawn_cmd("mc_att_control",
 				       SCHED_DEFAULT,
@@ -921,10 +1067,31 @@ MulticopterAttitudeControl::start()
 	return OK;
 }
 
+int
+MulticopterAttitudeControl::print()
+{
+	int ret = OK;
+
+	if (_pipeline && attitude_pipeline_attached(&MulticopterAttitudeControl::pipeline_stage, this)) {
+		warnx("running as attitude pipeline stage");
+
+	} else if (_control_task != -1) {
+		warnx("running%s", _pipeline ? ", attitude pipeline host stopped" : "");
+
+	} else {
+		warnx("not controlling, attitude pipeline stage detached");
+		ret = mc_att_control::ERROR;
+	}
+
+	perf_print_counter(_loop_perf);
+
+	return ret;
+}
+
 int mc_att_control_main(int argc, char *argv[])
 {
 	if (argc < 2) {
-		warnx("usage: mc_att_control {start|stop|status}");
+		warnx("usage: mc_att_control {start [-p]|stop|status}");
 		return 1;
 	}
 
@@ -942,7 +1109,10 @@ int mc_att_control_main(int argc, char *argv[])
 			return 1;
 		}
 
-		if (OK != mc_att_control::g_control->start()) {
+		/* -p: run on the attitude estimator thread */
+		bool pipeline = (argc > 2 && !strcmp(argv[2], "-p"));
+
+		if (OK != mc_att_control::g_control->start(pipeline)) {
 			delete mc_att_control::g_control;
 			mc_att_control::g_control = nullptr;
 			warnx("start failed");
@@ -965,8 +1135,7 @@ int mc_att_control_main(int argc, char *argv[])
 
 	if (!strcmp(argv[1], "status")) {
 		if (mc_att_control::g_control) {
-			warnx("running");
-			return 0;
+			return (mc_att_control::g_control->print() == OK) ? 0 : 1;
 
 		} else {
 			warnx("not running");
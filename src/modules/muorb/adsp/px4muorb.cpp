@@ -66,7 +66,7 @@ int px4muorb_add_subscriber(const char *name)
 	uORBCommunicator::IChannelRxHandler *rxHandler = channel->GetRxHandler();
 
 	if (rxHandler != nullptr) {
-		rc = rxHandler->process_add_subscription(name, 0);
+		rc = rxHandler->process_add_subscription(name, 0, 0);
 
 		if (rc != OK) {
 			channel->RemoveRemoteSubscriber(name);
@@ -87,7 +87,7 @@ int px4muorb_remove_subscriber(const char *name)
 	uORBCommunicator::IChannelRxHandler *rxHandler = channel->GetRxHandler();
 
 	if (rxHandler != nullptr) {
-		rc = rxHandler->process_remove_subscription(name);
+		rc = rxHandler->process_remove_subscription(name, 0);
 
 	} else {
 		rc = -1;
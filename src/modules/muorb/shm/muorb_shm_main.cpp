@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <string.h>
+#include <px4_getopt.h>
+#include <systemlib/err.h>
+#include "modules/uORB/uORBManager.hpp"
+#include "uORBShmChannel.hpp"
+
+extern "C" { __EXPORT int muorb_shm_main(int argc, char *argv[]); }
+
+static void usage()
+{
+	warnx("Usage: muorb_shm 'start' [-s <segment>], 'stop', 'status'");
+}
+
+int
+muorb_shm_main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		usage();
+		return -EINVAL;
+	}
+
+	uORB::ShmChannel *channel = uORB::ShmChannel::GetInstance();
+
+	if (!strcmp(argv[1], "start")) {
+		const char *segment = uORB::ShmChannel::DEFAULT_SEGMENT;
+		int myoptind = 1;
+		const char *myoptarg = nullptr;
+		int ch;
+
+		while ((ch = px4_getopt(argc - 1, &argv[1], "s:", &myoptind, &myoptarg)) != EOF) {
+			switch (ch) {
+			case 's':
+				segment = myoptarg;
+				break;
+
+			default:
+				usage();
+				return -EINVAL;
+			}
+		}
+
+		int ret = channel->attach(segment);
+
+		if (ret != 0) {
+			return ret;
+		}
+
+		// register the shared-memory channel with UORB.
+		uORB::Manager::get_instance()->set_uorb_communicator(channel);
+		channel->Start();
+		return OK;
+	}
+
+	if (!strcmp(argv[1], "stop")) {
+		uORB::Manager::get_instance()->set_uorb_communicator(nullptr);
+		channel->Stop();
+		channel->detach();
+		return OK;
+	}
+
+	if (!strcmp(argv[1], "status")) {
+		channel->print_status();
+		return OK;
+	}
+
+	usage();
+	return -EINVAL;
+}
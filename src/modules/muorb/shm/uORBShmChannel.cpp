@@ -0,0 +1,871 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "uORBShmChannel.hpp"
+#include "px4_log.h"
+#include "px4_tasks.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sched.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __PX4_LINUX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#define SHM_MAGIC	0x4f524253	// "SBRO"
+#define SHM_VERSION	2
+
+// time the receive thread sleeps at most, so it notices Stop()
+#define RECV_TIMEOUT_NS	100000000
+
+// reads of a slot that is written all the time give up after this
+#define MAX_READ_RETRIES 100
+
+// a writer spins this often on a locked slot before it checks the clock
+#define WRITE_SPINS	1000
+
+// a slot locked this long by a live process makes the writer drop the sample,
+// one locked by a process of unknown state is taken over after it
+#define WRITE_LOCK_TIMEOUT_US	10000
+
+// interval of the check for processes that exited without detaching
+#define REAP_INTERVAL_US	1000000
+
+const char *uORB::ShmChannel::DEFAULT_SEGMENT = "/px4_uorb";
+
+uORB::ShmChannel uORB::ShmChannel::_Instance;
+
+struct uORB::ShmChannel::SegmentHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t topic_count;
+	uint32_t slot_count;
+	uint32_t slot_data_size;
+	volatile uint32_t participants;		///< bit mask of the attached processes
+	volatile uint32_t wakeup;		///< futex, bumped on every publication
+	volatile uint32_t waiters;		///< receive threads sleeping on the futex
+	volatile uint32_t subscriptions;	///< bumped on every subscription change
+	volatile uint32_t slots_used;		///< slots are allocated in order and never freed
+	volatile int32_t pids[MAX_PARTICIPANTS];	///< process of each participant
+	pthread_mutex_t lock;			///< serializes attaching, subscriptions and allocation
+} __attribute__((aligned(64)));
+
+struct uORB::ShmChannel::Topic {
+	volatile uint32_t used;			///< name is valid
+	volatile uint32_t subscribers;		///< bit mask of the subscribed processes
+	volatile uint32_t interested;		///< processes that subscribed once, the data is kept for them
+	volatile int32_t rates[MAX_PARTICIPANTS];	///< rate requested by each subscriber, 0 for no limit
+	volatile int32_t slot;			///< data slot + 1, 0 if none is allocated yet
+	char name[MAX_NAME_LEN];
+};
+
+struct uORB::ShmChannel::Slot {
+	volatile uint32_t seq;			///< sequence lock, odd while the data is written
+	volatile uint32_t owner;		///< participant + 1 holding the write side, 0 if none
+	uint32_t topic;				///< directory entry of the topic
+	uint32_t length;
+	uint32_t writer;			///< process that wrote the data
+	uint8_t data[SLOT_DATA_SIZE];
+} __attribute__((aligned(64)));
+
+#define SEGMENT_SIZE	(sizeof(SegmentHeader) + MAX_TOPICS * sizeof(Topic) + MAX_SLOTS * sizeof(Slot))
+
+#ifdef __PX4_LINUX
+
+static void futex_wait(volatile uint32_t *addr, uint32_t val, const struct timespec *timeout)
+{
+	syscall(SYS_futex, addr, FUTEX_WAIT, val, timeout, NULL, 0);
+}
+
+static void futex_wake(volatile uint32_t *addr)
+{
+	syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+#else
+
+// no futexes, the receivers poll
+static void futex_wait(volatile uint32_t *addr, uint32_t val, const struct timespec *timeout)
+{
+	usleep(1000);
+}
+
+static void futex_wake(volatile uint32_t *addr)
+{
+}
+
+#endif
+
+static uint32_t name_hash(const char *name)
+{
+	// FNV-1a
+	uint32_t hash = 2166136261u;
+
+	for (const char *p = name; *p != '\0'; p++) {
+		hash = (hash ^ (uint8_t)*p) * 16777619u;
+	}
+
+	return hash;
+}
+
+static uint64_t monotonic_us()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+uORB::ShmChannel::ShmChannel() :
+	_RxHandler(nullptr),
+	_RecvThread(),
+	_ThreadStarted(false),
+	_ThreadShouldExit(false),
+	_header(nullptr),
+	_topics(nullptr),
+	_slots(nullptr),
+	_participant(-1),
+	_subscriptions_seen(0),
+	_last_reap(0),
+	_sent(0),
+	_received(0),
+	_retries(0),
+	_too_large(0),
+	_no_slot(0),
+	_lock_timeouts(0),
+	_lock_takeovers(0),
+	_reaped(0)
+{
+	_segment_name[0] = '\0';
+	memset(_last_seq, 0, sizeof(_last_seq));
+
+	memset(_remote_rate, 0xff, sizeof(_remote_rate));
+}
+
+uORB::ShmChannel::~ShmChannel()
+{
+	Stop();
+	detach();
+}
+
+void uORB::ShmChannel::lock_header()
+{
+#ifdef __PX4_LINUX
+
+	// the mutex is robust, a process that died holding it leaves only
+	// consistent state behind: every change under it is a single store
+	if (pthread_mutex_lock(&_header->lock) == EOWNERDEAD) {
+		pthread_mutex_consistent(&_header->lock);
+	}
+
+#else
+	pthread_mutex_lock(&_header->lock);
+#endif
+}
+
+void uORB::ShmChannel::unlock_header()
+{
+	pthread_mutex_unlock(&_header->lock);
+}
+
+bool uORB::ShmChannel::participant_alive(int participant)
+{
+	pid_t pid = _header->pids[participant];
+
+	return pid != 0 && (kill(pid, 0) == 0 || errno == EPERM);
+}
+
+int uORB::ShmChannel::attach(const char *segment)
+{
+	if (_header != nullptr) {
+		return -EBUSY;
+	}
+
+	const size_t size = SEGMENT_SIZE;
+	bool created = true;
+	int fd = shm_open(segment, O_RDWR | O_CREAT | O_EXCL, 0666);
+
+	if (fd < 0 && errno == EEXIST) {
+		created = false;
+		fd = shm_open(segment, O_RDWR, 0666);
+	}
+
+	if (fd < 0) {
+		PX4_ERR("shm_open %s failed: %d", segment, errno);
+		return -errno;
+	}
+
+	if (created && ftruncate(fd, size) != 0) {
+		int err = errno;
+		close(fd);
+		shm_unlink(segment);
+		return -err;
+	}
+
+	if (!created) {
+		// wait for the creator to size the segment
+		struct stat st;
+		int i = 0;
+
+		while (fstat(fd, &st) == 0 && (size_t)st.st_size < size && ++i < 100) {
+			usleep(10000);
+		}
+	}
+
+	void *mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (mem == MAP_FAILED) {
+		PX4_ERR("mmap %s failed: %d", segment, errno);
+		return -errno;
+	}
+
+	SegmentHeader *header = (SegmentHeader *)mem;
+
+	if (created) {
+		// the segment is zeroed by ftruncate, all topics and slots are free
+		pthread_mutexattr_t attr;
+		pthread_mutexattr_init(&attr);
+		pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+#ifdef __PX4_LINUX
+		pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+#endif
+		pthread_mutex_init(&header->lock, &attr);
+		pthread_mutexattr_destroy(&attr);
+
+		header->version = SHM_VERSION;
+		header->topic_count = MAX_TOPICS;
+		header->slot_count = MAX_SLOTS;
+		header->slot_data_size = SLOT_DATA_SIZE;
+		__sync_synchronize();
+		header->magic = SHM_MAGIC;
+
+	} else {
+		for (int i = 0; header->magic != SHM_MAGIC && i < 100; i++) {
+			usleep(10000);
+		}
+	}
+
+	if (header->magic != SHM_MAGIC || header->version != SHM_VERSION || header->topic_count != MAX_TOPICS ||
+	    header->slot_count != MAX_SLOTS || header->slot_data_size != SLOT_DATA_SIZE) {
+		PX4_ERR("segment %s has an incompatible layout", segment);
+		munmap(mem, size);
+		return -EINVAL;
+	}
+
+	strncpy(_segment_name, segment, sizeof(_segment_name) - 1);
+	_header = header;
+	_topics = (Topic *)(header + 1);
+	_slots = (Slot *)(_topics + MAX_TOPICS);
+
+	// free the participants of crashed processes before looking for one
+	reap();
+
+	lock_header();
+
+	int participant = -1;
+
+	for (int i = 0; i < MAX_PARTICIPANTS; i++) {
+		if ((header->participants & (1u << i)) == 0) {
+			participant = i;
+			header->pids[i] = getpid();
+			header->participants |= (1u << i);
+			break;
+		}
+	}
+
+	unlock_header();
+
+	if (participant < 0) {
+		PX4_ERR("segment %s has no free participant", segment);
+		munmap(mem, size);
+		_header = nullptr;
+		_topics = nullptr;
+		_slots = nullptr;
+		return -ENOSPC;
+	}
+
+	_participant = participant;
+	memset(_last_seq, 0, sizeof(_last_seq));
+	memset(_remote_rate, 0xff, sizeof(_remote_rate));
+
+	// the receive thread scans the subscriptions on its first pass
+	_subscriptions_seen = _header->subscriptions - 1;
+
+	return 0;
+}
+
+void uORB::ShmChannel::detach()
+{
+	if (_header == nullptr) {
+		return;
+	}
+
+	const uint32_t bit = 1u << _participant;
+
+	lock_header();
+
+	for (int i = 0; i < MAX_TOPICS; i++) {
+		__sync_fetch_and_and(&_topics[i].subscribers, ~bit);
+		__sync_fetch_and_and(&_topics[i].interested, ~bit);
+	}
+
+	_header->subscriptions++;
+	_header->pids[_participant] = 0;
+	_header->participants &= ~bit;
+	bool last = (_header->participants == 0);
+
+	unlock_header();
+
+	if (last) {
+		shm_unlink(_segment_name);
+	}
+
+	munmap(_header, SEGMENT_SIZE);
+	_header = nullptr;
+	_topics = nullptr;
+	_slots = nullptr;
+	_participant = -1;
+}
+
+int uORB::ShmChannel::reap()
+{
+	if (_header == nullptr) {
+		return 0;
+	}
+
+	int reaped = 0;
+
+	lock_header();
+
+	for (int p = 0; p < MAX_PARTICIPANTS; p++) {
+		const uint32_t bit = 1u << p;
+
+		if (p == _participant || (_header->participants & bit) == 0 || participant_alive(p)) {
+			continue;
+		}
+
+		for (int i = 0; i < MAX_TOPICS; i++) {
+			__sync_fetch_and_and(&_topics[i].subscribers, ~bit);
+			__sync_fetch_and_and(&_topics[i].interested, ~bit);
+		}
+
+		// the participant can be reused, a slot it left locked is taken over once its owner is unknown
+		for (uint32_t i = 0; i < _header->slots_used; i++) {
+			__sync_bool_compare_and_swap(&_slots[i].owner, (uint32_t)(p + 1), 0u);
+		}
+
+		_header->pids[p] = 0;
+		_header->participants &= ~bit;
+		reaped++;
+	}
+
+	if (reaped > 0) {
+		_header->subscriptions++;
+	}
+
+	unlock_header();
+
+	if (reaped > 0) {
+		// let the publishing processes drop the subscriptions
+		__sync_fetch_and_add(&_header->wakeup, 1);
+		futex_wake(&_header->wakeup);
+
+		PX4_WARN("released %d participant(s) of %s that exited without detaching", reaped, _segment_name);
+		_reaped += reaped;
+	}
+
+	return reaped;
+}
+
+int uORB::ShmChannel::find_topic(const char *name, bool create)
+{
+	if (_header == nullptr || strlen(name) >= MAX_NAME_LEN) {
+		return -1;
+	}
+
+	const uint32_t start = name_hash(name) % MAX_TOPICS;
+
+	// topics are never removed from the directory, so the lookup doesn't need the lock
+	for (int i = 0; i < MAX_TOPICS; i++) {
+		Topic *topic = &_topics[(start + i) % MAX_TOPICS];
+
+		if (!topic->used) {
+			break;
+		}
+
+		if (strcmp(topic->name, name) == 0) {
+			return (start + i) % MAX_TOPICS;
+		}
+	}
+
+	if (!create) {
+		return -1;
+	}
+
+	int index = -1;
+
+	lock_header();
+
+	for (int i = 0; i < MAX_TOPICS; i++) {
+		Topic *topic = &_topics[(start + i) % MAX_TOPICS];
+
+		if (!topic->used) {
+			strcpy(topic->name, name);
+			__sync_synchronize();
+			topic->used = 1;
+			index = (start + i) % MAX_TOPICS;
+			break;
+		}
+
+		if (strcmp(topic->name, name) == 0) {
+			index = (start + i) % MAX_TOPICS;
+			break;
+		}
+	}
+
+	unlock_header();
+
+	if (index < 0) {
+		PX4_ERR("no free directory entry for %s", name);
+	}
+
+	return index;
+}
+
+int uORB::ShmChannel::get_slot(int topic)
+{
+	int slot = _topics[topic].slot - 1;
+
+	if (slot >= 0) {
+		return slot;
+	}
+
+	lock_header();
+
+	slot = _topics[topic].slot - 1;
+
+	if (slot < 0 && _header->slots_used < MAX_SLOTS) {
+		slot = _header->slots_used;
+		_slots[slot].topic = topic;
+		__sync_synchronize();
+		_topics[topic].slot = slot + 1;
+		_header->slots_used = slot + 1;
+	}
+
+	unlock_header();
+
+	if (slot < 0 && _no_slot++ == 0) {
+		PX4_ERR("no free slot for %s", _topics[topic].name);
+	}
+
+	return slot;
+}
+
+int16_t uORB::ShmChannel::add_subscription(const char *messageName, int32_t msgRateInHz)
+{
+	int index = find_topic(messageName, true);
+
+	if (index < 0) {
+		return -1;
+	}
+
+	Topic *topic = &_topics[index];
+
+	lock_header();
+
+	topic->rates[_participant] = (msgRateInHz > 0) ? msgRateInHz : 0;
+	topic->subscribers |= 1u << _participant;
+	topic->interested |= 1u << _participant;
+	_header->subscriptions++;
+
+	unlock_header();
+
+	// deliver the current data once, like a local subscription would
+	if (topic->slot > 0) {
+		_last_seq[topic->slot - 1] = 0;
+	}
+
+	__sync_fetch_and_add(&_header->wakeup, 1);
+	futex_wake(&_header->wakeup);
+
+	return 0;
+}
+
+int16_t uORB::ShmChannel::remove_subscription(const char *messageName)
+{
+	int index = find_topic(messageName, false);
+
+	if (index < 0) {
+		return -1;
+	}
+
+	lock_header();
+	_topics[index].subscribers &= ~(1u << _participant);
+	_header->subscriptions++;
+	unlock_header();
+
+	// let the publishing processes know
+	__sync_fetch_and_add(&_header->wakeup, 1);
+	futex_wake(&_header->wakeup);
+
+	return 0;
+}
+
+int16_t uORB::ShmChannel::register_handler(uORBCommunicator::IChannelRxHandler *handler)
+{
+	_RxHandler = handler;
+	return 0;
+}
+
+bool uORB::ShmChannel::lock_slot(Slot *slot)
+{
+	uint32_t stuck_seq = 0;
+	uint64_t stuck_since = 0;
+	uint64_t waiting_since = 0;
+
+	for (unsigned spins = 0;; spins++) {
+		uint32_t seq = slot->seq;
+
+		if ((seq & 1) == 0) {
+			if (__sync_bool_compare_and_swap(&slot->seq, seq, seq + 1)) {
+				slot->owner = _participant + 1;
+				return true;
+			}
+
+			continue;
+		}
+
+		if (spins < WRITE_SPINS) {
+			continue;
+		}
+
+		// the writer is preempted, or it died while writing
+		sched_yield();
+
+		const uint64_t now = monotonic_us();
+
+		if (waiting_since == 0) {
+			waiting_since = now;
+		}
+
+		if (seq != stuck_seq) {
+			stuck_seq = seq;
+			stuck_since = now;
+		}
+
+		// the owner is only unknown if it died right after locking
+		const uint32_t owner = slot->owner;
+		const bool dead = (owner != 0) ? !participant_alive(owner - 1) : (now - stuck_since >= WRITE_LOCK_TIMEOUT_US);
+
+		if (dead) {
+			// keep the sequence odd, readers still see a write in progress
+			if (__sync_bool_compare_and_swap(&slot->seq, seq, seq + 2)) {
+				slot->owner = _participant + 1;
+				_lock_takeovers++;
+				return true;
+			}
+
+		} else if (now - waiting_since >= 2 * WRITE_LOCK_TIMEOUT_US) {
+			return false;
+		}
+	}
+}
+
+int16_t uORB::ShmChannel::send_message(const char *messageName, int32_t length, uint8_t *data)
+{
+	int index = find_topic(messageName, false);
+
+	// nothing to do unless a process other than this one subscribed
+	if (index < 0 || (_topics[index].interested & ~(1u << _participant)) == 0) {
+		return 0;
+	}
+
+	if (length > SLOT_DATA_SIZE) {
+		// not an error for the local publisher, the topic just isn't exchanged
+		_too_large++;
+		return 0;
+	}
+
+	int slot_index = get_slot(index);
+
+	if (slot_index < 0) {
+		return 0;
+	}
+
+	Slot *slot = &_slots[slot_index];
+
+	// there can be publishers in several processes
+	if (!lock_slot(slot)) {
+		_lock_timeouts++;
+		return 0;
+	}
+
+	const uint32_t seq = slot->seq;
+
+	slot->length = length;
+	slot->writer = _participant;
+	memcpy(slot->data, data, length);
+
+	slot->owner = 0;
+	__sync_synchronize();
+	slot->seq = seq + 1;
+
+	_sent++;
+
+	if ((_topics[index].subscribers & ~(1u << _participant)) != 0) {
+		__sync_fetch_and_add(&_header->wakeup, 1);
+
+		if (_header->waiters > 0) {
+			futex_wake(&_header->wakeup);
+		}
+	}
+
+	return 0;
+}
+
+void uORB::ShmChannel::receive_slot(int index)
+{
+	Slot *slot = &_slots[index];
+	uint32_t seq = slot->seq;
+
+	if (seq == 0 || seq == _last_seq[index]) {
+		return;
+	}
+
+	uint32_t length = 0;
+	uint32_t writer = 0;
+
+	for (int i = 0; i < MAX_READ_RETRIES; i++) {
+		seq = slot->seq;
+
+		if (seq & 1) {
+			_retries++;
+			continue;
+		}
+
+		__sync_synchronize();
+		length = slot->length;
+		writer = slot->writer;
+
+		if (length <= SLOT_DATA_SIZE) {
+			memcpy(_rx_buf, slot->data, length);
+		}
+
+		__sync_synchronize();
+
+		if (slot->seq == seq) {
+			break;
+		}
+
+		_retries++;
+		seq = 0;
+	}
+
+	// seq is odd or 0 if all retries failed, try again on the next wakeup
+	if (seq == 0 || (seq & 1)) {
+		return;
+	}
+
+	_last_seq[index] = seq;
+
+	// don't echo our own publications
+	if ((int)writer == _participant || _RxHandler == nullptr) {
+		return;
+	}
+
+	_received++;
+	_RxHandler->process_received_message(_topics[slot->topic].name, length, _rx_buf);
+}
+
+void uORB::ShmChannel::update_remote_subscriptions()
+{
+	const uint32_t subscriptions = _header->subscriptions;
+
+	if (subscriptions == _subscriptions_seen || _RxHandler == nullptr) {
+		return;
+	}
+
+	_subscriptions_seen = subscriptions;
+
+	// every process is a subscriber of its own, identified by its participant index
+	for (int i = 0; i < MAX_TOPICS; i++) {
+		Topic *topic = &_topics[i];
+
+		if (!topic->used) {
+			continue;
+		}
+
+		for (int p = 0; p < MAX_PARTICIPANTS; p++) {
+			if (p == _participant) {
+				continue;
+			}
+
+			const int32_t rate = (topic->subscribers & (1u << p)) ? topic->rates[p] : -1;
+
+			if (rate == _remote_rate[i][p]) {
+				continue;
+			}
+
+			_remote_rate[i][p] = rate;
+
+			if (rate >= 0) {
+				_RxHandler->process_add_subscription(topic->name, rate, p);
+
+			} else {
+				_RxHandler->process_remove_subscription(topic->name, p);
+			}
+		}
+	}
+}
+
+void uORB::ShmChannel::Start()
+{
+	if (_ThreadStarted || _header == nullptr) {
+		return;
+	}
+
+	_ThreadShouldExit = false;
+	pthread_attr_t recv_thread_attr;
+	pthread_attr_init(&recv_thread_attr);
+
+	struct sched_param param;
+	(void)pthread_attr_getschedparam(&recv_thread_attr, &param);
+	param.sched_priority = SCHED_PRIORITY_MAX - 40;
+	(void)pthread_attr_setschedparam(&recv_thread_attr, &param);
+
+	pthread_attr_setstacksize(&recv_thread_attr, PTHREAD_STACK_MIN + 4096);
+
+	if (pthread_create(&_RecvThread, &recv_thread_attr, thread_start, (void *)this) != 0) {
+		PX4_ERR("Error creating the receive thread for muorb_shm");
+
+	} else {
+		_ThreadStarted = true;
+#ifdef __PX4_LINUX
+		pthread_setname_np(_RecvThread, "muorb_shm_rx");
+#endif
+	}
+
+	pthread_attr_destroy(&recv_thread_attr);
+}
+
+void uORB::ShmChannel::Stop()
+{
+	if (!_ThreadStarted) {
+		return;
+	}
+
+	_ThreadShouldExit = true;
+
+	// wakes up the receive threads of all processes, they just scan again
+	__sync_fetch_and_add(&_header->wakeup, 1);
+	futex_wake(&_header->wakeup);
+
+	pthread_join(_RecvThread, NULL);
+	_ThreadStarted = false;
+}
+
+void uORB::ShmChannel::print_status()
+{
+	if (_header == nullptr) {
+		PX4_INFO("not attached");
+		return;
+	}
+
+	int topics_used = 0;
+
+	for (int i = 0; i < MAX_TOPICS; i++) {
+		if (_topics[i].used) {
+			topics_used++;
+		}
+	}
+
+	PX4_INFO("segment %s, participant %d, participants 0x%08x", _segment_name, _participant,
+		 (unsigned)_header->participants);
+	PX4_INFO("topics: %d/%d, slots used: %u/%d", topics_used, MAX_TOPICS, (unsigned)_header->slots_used, MAX_SLOTS);
+	PX4_INFO("sent: %u received: %u read retries: %u too large: %u no slot: %u", (unsigned)_sent,
+		 (unsigned)_received, (unsigned)_retries, (unsigned)_too_large, (unsigned)_no_slot);
+	PX4_INFO("write lock timeouts: %u taken over: %u, participants released: %u", (unsigned)_lock_timeouts,
+		 (unsigned)_lock_takeovers, (unsigned)_reaped);
+}
+
+void *uORB::ShmChannel::thread_start(void *handler)
+{
+	if (handler != nullptr) {
+		((uORB::ShmChannel *)handler)->recv_thread();
+	}
+
+	return 0;
+}
+
+void uORB::ShmChannel::recv_thread()
+{
+	const uint32_t bit = 1u << _participant;
+	const struct timespec timeout = {0, RECV_TIMEOUT_NS};
+
+	while (!_ThreadShouldExit) {
+		uint32_t wakeup = _header->wakeup;
+
+		update_remote_subscriptions();
+
+		const uint32_t slots_used = _header->slots_used;
+
+		for (uint32_t i = 0; i < slots_used; i++) {
+			if (_topics[_slots[i].topic].subscribers & bit) {
+				receive_slot(i);
+			}
+		}
+
+		const uint64_t now = monotonic_us();
+
+		if (now - _last_reap >= REAP_INTERVAL_US) {
+			_last_reap = now;
+			reap();
+		}
+
+		// sleep unless something was published while scanning
+		__sync_fetch_and_add(&_header->waiters, 1);
+
+		if (_header->wakeup == wakeup) {
+			futex_wait(&_header->wakeup, wakeup, &timeout);
+		}
+
+		__sync_fetch_and_sub(&_header->waiters, 1);
+	}
+}
@@ -0,0 +1,228 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef _uORBShmChannel_hpp_
+#define _uORBShmChannel_hpp_
+
+#include <stdint.h>
+#include <pthread.h>
+#include "uORB/uORBCommunicator.hpp"
+
+namespace uORB
+{
+class ShmChannel;
+}
+
+/**
+ * uORB channel between processes on the same host.
+ *
+ * All processes attached to the same POSIX shared-memory segment exchange
+ * topics through it. The segment holds a directory of the subscribed
+ * topics with the processes subscribed to each, and a data slot for every
+ * topic a process subscribed to remotely, holding its latest data under a
+ * sequence lock. Publishers copy the data into the slot, the receive
+ * thread of a subscribing process copies it out and publishes it locally.
+ * Slots are allocated by the first publisher that has a subscriber in
+ * another process, topics only used within one process never get one.
+ * On Linux receivers sleep on a futex in the segment that is bumped on
+ * every publication, elsewhere they poll.
+ *
+ * Like uORB itself a slot only holds the latest data, a slow receiver
+ * sees the newest sample and skips the ones in between.
+ *
+ * The subscriptions of the other processes are passed to the rx handler,
+ * so the publishing side applies the requested rate. Processes that exit
+ * without detaching are detected by their pid and their subscriptions
+ * are released; a slot they left locked is taken over by the next writer.
+ */
+class uORB::ShmChannel : public uORBCommunicator::IChannel
+{
+public:
+	static const char *DEFAULT_SEGMENT;		///< name of the segment used by the muorb_shm command
+
+	static const int MAX_PARTICIPANTS = 32;		///< processes attached at the same time
+	static const int MAX_TOPICS = 512;		///< topics subscribed in any process
+	static const int MAX_SLOTS = 128;		///< topics exchanged between processes
+	static const int SLOT_DATA_SIZE = 1024;		///< largest topic that can be exchanged
+	static const int MAX_NAME_LEN = 64;		///< length of the topic names including termination
+
+	/**
+	 * static method to get the IChannel Implementor.
+	 */
+	static uORB::ShmChannel *GetInstance()
+	{
+		return &(_Instance);
+	}
+
+	ShmChannel();
+	virtual ~ShmChannel();
+
+	/**
+	 * Open the segment, creating it if this is the first process.
+	 *
+	 * @param segment	POSIX shared-memory object name, starting with '/'
+	 * @return		0 on success, -errno otherwise
+	 */
+	int attach(const char *segment);
+
+	/**
+	 * Leave the segment. The last process removes it.
+	 */
+	void detach();
+
+	/**
+	 * @brief Interface to notify the remote entity of interest of a
+	 * subscription for a message.
+	 *
+	 * The current data of the topic, if any, is delivered right away.
+	 * msgRateInHz is passed on to the publishing processes, each process
+	 * is a separate subscriber to them.
+	 */
+	virtual int16_t add_subscription(const char *messageName, int32_t msgRateInHz);
+
+	/**
+	 * @brief Interface to notify the remote entity of removal of a subscription
+	 */
+	virtual int16_t remove_subscription(const char *messageName);
+
+	/**
+	 * Register Message Handler.  This is internal for the IChannel implementer*
+	 */
+	virtual int16_t register_handler(uORBCommunicator::IChannelRxHandler *handler);
+
+	/**
+	 * @brief Copies the data into the slot of the topic and wakes up the
+	 * receivers. Topics nobody subscribed to remotely are not copied.
+	 *
+	 * If another process holds the slot for too long the sample is dropped,
+	 * if that process died the slot is taken over.
+	 */
+	virtual int16_t send_message(const char *messageName, int32_t length, uint8_t *data);
+
+	/**
+	 * Start the receive thread.
+	 */
+	void Start();
+
+	/**
+	 * Stop the receive thread.
+	 */
+	void Stop();
+
+	/**
+	 * Release the subscriptions and the participant of processes that
+	 * exited without detaching. Called periodically by the receive thread.
+	 *
+	 * @return		number of participants released
+	 */
+	int reap();
+
+	void print_status();
+
+private:
+	struct SegmentHeader;
+	struct Topic;
+	struct Slot;
+
+	static uORB::ShmChannel _Instance;
+
+	uORBCommunicator::IChannelRxHandler *_RxHandler;
+	pthread_t	_RecvThread;
+	volatile bool	_ThreadStarted;
+	volatile bool	_ThreadShouldExit;
+
+	char		_segment_name[MAX_NAME_LEN];
+	SegmentHeader	*_header;
+	Topic		*_topics;
+	Slot		*_slots;
+	int		_participant;		///< index of this process, -1 if not attached
+
+	uint32_t	_last_seq[MAX_SLOTS];	///< last sequence delivered per slot
+	int32_t		_remote_rate[MAX_TOPICS][MAX_PARTICIPANTS];	///< rate passed to the handler per process, -1 if not subscribed
+	uint32_t	_subscriptions_seen;	///< subscription counter of the last directory scan
+	uint64_t	_last_reap;
+	uint8_t		_rx_buf[SLOT_DATA_SIZE];
+
+	/* statistics */
+	uint32_t	_sent;
+	uint32_t	_received;
+	uint32_t	_retries;
+	uint32_t	_too_large;
+	uint32_t	_no_slot;
+	uint32_t	_lock_timeouts;
+	uint32_t	_lock_takeovers;
+	uint32_t	_reaped;
+
+	/**
+	 * Find the directory entry of a topic.
+	 *
+	 * @param create	add the topic if it's not in the directory yet
+	 * @return		topic index, -1 if not found or the directory is full
+	 */
+	int find_topic(const char *name, bool create);
+
+	/**
+	 * Get the data slot of a topic, allocating it if needed.
+	 *
+	 * @return		slot index, -1 if all slots are in use
+	 */
+	int get_slot(int topic);
+
+	/**
+	 * Take the write side of the sequence lock of a slot.
+	 *
+	 * @return		false if another live process holds it for too long
+	 */
+	bool lock_slot(Slot *slot);
+
+	bool participant_alive(int participant);
+
+	void lock_header();
+	void unlock_header();
+
+	/**
+	 * Copy the data out of a slot and hand it to the handler if it changed.
+	 */
+	void receive_slot(int index);
+
+	/**
+	 * Pass the changes of the remote subscriptions to the handler.
+	 */
+	void update_remote_subscriptions();
+
+	static void *thread_start(void *handler);
+
+	void recv_thread();
+};
+
+#endif /* _uORBShmChannel_hpp_ */
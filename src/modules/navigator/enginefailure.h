@@ -63,6 +63,8 @@ public:
 
 	virtual void on_active();
 
+	virtual unsigned get_update_topics() { return NAV_TOPIC_GLOBAL_POS | NAV_TOPIC_VSTATUS; }
+
 private:
 	enum EFState {
 		EF_STATE_NONE = 0,
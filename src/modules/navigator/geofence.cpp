@@ -51,7 +51,10 @@
 #include <unistd.h>
 #include <mavlink/mavlink_log.h>
 #include <geo/geo.h>
+#include <mathlib/mathlib.h>
 #include <drivers/drv_hrt.h>
+#include <float.h>
+#include <math.h>
 
 #define GEOFENCE_RANGE_WARNING_LIMIT 3000000
 
@@ -71,6 +74,11 @@ Geofence::Geofence() :
 	_altitude_min(0),
 	_altitude_max(0),
 	_vertices_count(0),
+	_edges{},
+	_edges_count(0),
+	_edges_dirty(true),
+	_projection_ref{},
+	_inner_radius(0.0f),
 	_param_action(this, "ACTION"),
 	_param_altitude_mode(this, "ALTMODE"),
 	_param_source(this, "SOURCE"),
@@ -195,45 +203,205 @@ bool Geofence::inside_polygon(double lat, double lon, float altitude)
 			}
 
 			/*Horizontal check */
-			/* Adaptation of algorithm originally presented as
-			 * PNPOLY - Point Inclusion in Polygon Test
-			 * W. Randolph Franklin (WRF) */
+			if (!updateEdges()) {
+				return false;
+			}
 
-			bool c = false;
+			float x, y;
+			map_projection_project_array(&_projection_ref, &lat, &lon, &x, &y, 1);
 
-			struct fence_vertex_s temp_vertex_i;
-			struct fence_vertex_s temp_vertex_j;
+			return inside_local(x, y, nullptr);
 
-			/* Red until fence is finished */
-			for (unsigned i = 0, j = _vertices_count - 1; i < _vertices_count; j = i++) {
-				if (dm_read(DM_KEY_FENCE_POINTS, i, &temp_vertex_i, sizeof(struct fence_vertex_s)) != sizeof(struct fence_vertex_s)) {
-					break;
-				}
+		} else {
+			/* Empty fence --> accept all points */
+			return true;
+		}
 
-				if (dm_read(DM_KEY_FENCE_POINTS, j, &temp_vertex_j, sizeof(struct fence_vertex_s)) != sizeof(struct fence_vertex_s)) {
-					break;
-				}
+	} else {
+		/* Invalid fence --> accept all points */
+		return true;
+	}
+}
 
-				// skip vertex 0 (return point)
-				if (((double)temp_vertex_i.lon >= lon) != ((double)temp_vertex_j.lon >= lon) &&
-				    (lat <= (double)(temp_vertex_j.lat - temp_vertex_i.lat) * (lon - (double)temp_vertex_i.lon) /
-				     (double)(temp_vertex_j.lon - temp_vertex_i.lon) + (double)temp_vertex_i.lat)) {
-					c = !c;
-				}
+float Geofence::distance_to_polygon(double lat, double lon)
+{
+	if (!valid() || isEmpty() || !updateEdges()) {
+		return NAN;
+	}
 
-			}
+	float x, y;
+	map_projection_project_array(&_projection_ref, &lat, &lon, &x, &y, 1);
 
-			return c;
+	float distance;
+	inside_local(x, y, &distance);
 
-		} else {
-			/* Empty fence --> accept all points */
+	return distance;
+}
+
+bool Geofence::inside_local(float x, float y, float *distance)
+{
+	/* everything around the center of the fence is inside with a known margin */
+	if (distance == nullptr && x * x + y * y < _inner_radius * _inner_radius) {
+		return true;
+	}
+
+	/* Adaptation of algorithm originally presented as
+	 * PNPOLY - Point Inclusion in Polygon Test
+	 * W. Randolph Franklin (WRF) */
+
+	bool c = false;
+	float min_distance_sq = FLT_MAX;
+
+	for (unsigned k = 0; k < _edges_count; k++) {
+		const fence_edge_s &e = _edges[k];
+
+		/* edges starting east of the point can not straddle it, only the distance needs them */
+		if (e.y_min > y && distance == nullptr) {
+			break;
+		}
+
+		const float y_j = e.y_i + e.dy;
+
+		if ((e.y_i >= y) != (y_j >= y) &&
+		    (x <= e.dx * (y - e.y_i) / e.dy + e.x_i)) {
+			c = !c;
+		}
+
+		if (distance != nullptr) {
+			/* closest point on the edge */
+			float t = math::constrain(((x - e.x_i) * e.dx + (y - e.y_i) * e.dy) * e.inv_length_sq, 0.0f, 1.0f);
+			float ex = e.x_i + t * e.dx - x;
+			float ey = e.y_i + t * e.dy - y;
+			min_distance_sq = math::min(min_distance_sq, ex * ex + ey * ey);
+		}
+	}
+
+	if (distance != nullptr) {
+		*distance = c ? sqrtf(min_distance_sq) : -sqrtf(min_distance_sq);
+	}
+
+	return c;
+}
+
+/* side of c relative to the line a->b: 1 left, -1 right, 0 collinear */
+static int orientation(float a_x, float a_y, float b_x, float b_y, float c_x, float c_y)
+{
+	const float cross = (b_x - a_x) * (c_y - a_y) - (b_y - a_y) * (c_x - a_x);
+	return (cross > 0.0f) - (cross < 0.0f);
+}
+
+bool Geofence::crosses_polygon(double lat1, double lon1, double lat2, double lon2)
+{
+	if (!valid() || isEmpty()) {
+		return false;
+	}
+
+	if (!updateEdges()) {
+		/* can't tell, assume the worst */
+		return true;
+	}
+
+	const double lat[2] = { lat1, lat2 };
+	const double lon[2] = { lon1, lon2 };
+	float x[2], y[2];
+	map_projection_project_array(&_projection_ref, lat, lon, x, y, 2);
+
+	const float seg_x_min = math::min(x[0], x[1]);
+	const float seg_x_max = math::max(x[0], x[1]);
+	const float seg_y_min = math::min(y[0], y[1]);
+	const float seg_y_max = math::max(y[0], y[1]);
+
+	for (unsigned k = 0; k < _edges_count && _edges[k].y_min <= seg_y_max; k++) {
+		const fence_edge_s &e = _edges[k];
+
+		if (e.y_max < seg_y_min || e.x_max < seg_x_min || e.x_min > seg_x_max) {
+			continue;
+		}
+
+		const float x_j = e.x_i + e.dx;
+		const float y_j = e.y_i + e.dy;
+
+		/* touching counts as crossing, the bounding boxes overlap so collinear segments do too */
+		if (orientation(x[0], y[0], x[1], y[1], e.x_i, e.y_i) * orientation(x[0], y[0], x[1], y[1], x_j, y_j) <= 0 &&
+		    orientation(e.x_i, e.y_i, x_j, y_j, x[0], y[0]) * orientation(e.x_i, e.y_i, x_j, y_j, x[1], y[1]) <= 0) {
 			return true;
 		}
+	}
 
-	} else {
-		/* Invalid fence --> accept all points */
+	return false;
+}
+
+bool
+Geofence::updateEdges()
+{
+	if (!_edges_dirty) {
 		return true;
 	}
+
+	struct fence_vertex_s vertices[fence_s::GEOFENCE_MAX_VERTICES];
+	unsigned count = math::min((unsigned)_vertices_count, (unsigned)fence_s::GEOFENCE_MAX_VERTICES);
+
+	for (unsigned i = 0; i < count; i++) {
+		if (dm_read(DM_KEY_FENCE_POINTS, i, &vertices[i], sizeof(struct fence_vertex_s)) != sizeof(struct fence_vertex_s)) {
+			/* keep checking against the last fence that could be read, retry on the next call */
+			return _edges_count > 0;
+		}
+	}
+
+	/* project the vertices into a local frame centered on the fence */
+	double lat[fence_s::GEOFENCE_MAX_VERTICES];
+	double lon[fence_s::GEOFENCE_MAX_VERTICES];
+	float x[fence_s::GEOFENCE_MAX_VERTICES];
+	float y[fence_s::GEOFENCE_MAX_VERTICES];
+	double lat_center = 0.0;
+	double lon_center = 0.0;
+
+	for (unsigned i = 0; i < count; i++) {
+		lat[i] = (double)vertices[i].lat;
+		lon[i] = (double)vertices[i].lon;
+		lat_center += lat[i] / count;
+		lon_center += lon[i] / count;
+	}
+
+	map_projection_init(&_projection_ref, lat_center, lon_center);
+	map_projection_project_array(&_projection_ref, lat, lon, x, y, count);
+
+	_edges_count = 0;
+
+	for (unsigned i = 0, j = count - 1; i < count; j = i++) {
+		fence_edge_s e;
+		e.x_i = x[i];
+		e.y_i = y[i];
+		e.dx = x[j] - x[i];
+		e.dy = y[j] - y[i];
+		e.inv_length_sq = (e.dx * e.dx + e.dy * e.dy > FLT_EPSILON) ? 1.0f / (e.dx * e.dx + e.dy * e.dy) : 0.0f;
+		e.x_min = math::min(x[i], x[j]);
+		e.x_max = math::max(x[i], x[j]);
+		e.y_min = math::min(y[i], y[j]);
+		e.y_max = math::max(y[i], y[j]);
+
+		/* insertion sort by y_min, there are only a few edges */
+		unsigned k = _edges_count;
+
+		while (k > 0 && _edges[k - 1].y_min > e.y_min) {
+			_edges[k] = _edges[k - 1];
+			k--;
+		}
+
+		_edges[k] = e;
+		_edges_count++;
+	}
+
+	/* margin around the center for the fast path of inside_local() */
+	float center_distance;
+	_inner_radius = 0.0f;
+
+	if (inside_local(0.0f, 0.0f, &center_distance)) {
+		_inner_radius = center_distance;
+	}
+
+	_edges_dirty = false;
+	return true;
 }
 
 bool
@@ -263,6 +431,7 @@ Geofence::addPoint(int argc, char *argv[])
 
 	if ((argc == 1) && (strcmp("-clear", argv[0]) == 0)) {
 		dm_clear(DM_KEY_FENCE_POINTS);
+		_edges_dirty = true;
 		publishFence(0);
 		return;
 	}
@@ -272,6 +441,7 @@ Geofence::addPoint(int argc, char *argv[])
 	}
 
 	ix = atoi(argv[0]);
+	_edges_dirty = true;
 
 	if (ix >= DM_KEY_FENCE_POINTS_MAX) {
 		PX4_WARN("Sequence must be less than %d", DM_KEY_FENCE_POINTS_MAX);
@@ -324,8 +494,8 @@ Geofence::loadFromFile(const char *filename)
 	/* Make sure no data is left in the datamanager */
 	clearDm();
 
-	/* open the mixer definition file */
-	fp = fopen(GEOFENCE_FILENAME, "r");
+	/* open the fence definition file */
+	fp = fopen(filename, "r");
 
 	if (fp == NULL) {
 		return ERROR;
@@ -402,6 +572,7 @@ Geofence::loadFromFile(const char *filename)
 	/* Check if import was successful */
 	if (gotVertical && pointCounter > 0) {
 		_vertices_count = pointCounter;
+		_edges_dirty = true;
 		warnx("Geofence: imported successfully");
 		mavlink_log_info(_mavlinkFd, "Geofence imported");
 		rc = OK;
@@ -419,5 +590,6 @@ error:
 int Geofence::clearDm()
 {
 	dm_clear(DM_KEY_FENCE_POINTS);
+	_edges_dirty = true;
 	return OK;
 }
@@ -49,6 +49,7 @@
 #include <controllib/blocks.hpp>
 #include <controllib/block/BlockParam.hpp>
 #include <drivers/drv_hrt.h>
+#include <geo/geo.h>
 #include <px4_defines.h>
 
 #define GEOFENCE_FILENAME PX4_ROOTFSDIR"/fs/microsd/etc/geofence.txt"
@@ -84,6 +85,21 @@ public:
 
 	bool inside_polygon(double lat, double lon, float altitude);
 
+	/**
+	 * Return whether the straight segment between two positions crosses the fence border.
+	 *
+	 * Only the horizontal polygon is considered, use inside_polygon() for the endpoints.
+	 * @return true: the segment intersects a fence edge, false: it does not or the fence is empty/invalid
+	 */
+	bool crosses_polygon(double lat1, double lon1, double lat2, double lon2);
+
+	/**
+	 * Return the signed horizontal distance to the closest fence edge.
+	 *
+	 * @return distance in meters, positive inside and negative outside the fence, NAN for an empty or invalid fence
+	 */
+	float distance_to_polygon(double lat, double lon);
+
 	int clearDm();
 
 	bool valid();
@@ -121,6 +137,22 @@ private:
 
 	uint8_t _vertices_count;
 
+	/* fence edge from vertex i to its predecessor j in the local frame (x north, y east), with its bounding box */
+	struct fence_edge_s {
+		float x_i, y_i;
+		float dx, dy;			/**< vector from vertex i to vertex j */
+		float inv_length_sq;		/**< 1 / (dx^2 + dy^2), 0 for a degenerate edge */
+		float x_min, x_max;
+		float y_min, y_max;
+	};
+
+	fence_edge_s _edges[fence_s::GEOFENCE_MAX_VERTICES];	/**< edges sorted by y_min */
+	uint8_t _edges_count;
+	bool _edges_dirty;			/**< fence points changed since the edges were built */
+
+	struct map_projection_reference_s _projection_ref;	/**< local frame centered on the fence */
+	float _inner_radius;			/**< points this close to the frame origin are inside the fence */
+
 	/* Params */
 	control::BlockParamInt _param_action;
 	control::BlockParamInt _param_altitude_mode;
@@ -136,6 +168,20 @@ private:
 	bool inside(double lat, double lon, float altitude);
 	bool inside(const struct vehicle_global_position_s &global_position);
 	bool inside(const struct vehicle_global_position_s &global_position, float baro_altitude_amsl);
+
+	/**
+	 * Point in polygon test in the local frame of the fence.
+	 *
+	 * @param distance if not nullptr, the signed distance to the closest edge, positive inside
+	 */
+	bool inside_local(float x, float y, float *distance);
+
+	/**
+	 * Read the fence points from the datamanager into the edge index if they changed.
+	 *
+	 * @return false if no edges could be loaded yet, a failed read keeps the previous edges
+	 */
+	bool updateEdges();
 };
 
 
@@ -67,6 +67,9 @@ public:
 
 	virtual void on_active();
 
+	/* the open loop loiter is timed and position may be lost, run on every input */
+	virtual unsigned get_update_topics() { return NAV_TOPIC_ALL; }
+
 private:
 	/* Params */
 	control::BlockParamFloat _param_loitertime;
@@ -60,6 +60,9 @@ public:
 
 	virtual void on_active();
 
+	/* the loiter setpoint is only set on activation */
+	virtual unsigned get_update_topics() { return 0; }
+
 private:
 	control::BlockParamFloat _param_min_alt;
 };
@@ -84,7 +84,8 @@ Mission::Mission(Navigator *navigator, const char *name) :
 	_min_current_sp_distance_xy(FLT_MAX),
 	_mission_item_previous_alt(NAN),
   	_on_arrival_yaw(NAN),
-	_distance_current_previous(0.0f)
+	_distance_current_previous(0.0f),
+	_item_cache()
 {
 	/* load initial params */
 	updateParams();
@@ -195,11 +196,15 @@ Mission::on_active()
 		heading_sp_update();
 	}
 
+	prefetch_mission_items();
 }
 
 void
 Mission::update_onboard_mission()
 {
+	/* the items in the dataman may have changed */
+	_item_cache.invalidate();
+
 	if (orb_copy(ORB_ID(onboard_mission), _navigator->get_onboard_mission_sub(), &_onboard_mission) == OK) {
 		/* accept the current index set by the onboard mission if it is within bounds */
 		if (_onboard_mission.current_seq >=0
@@ -233,6 +238,9 @@ Mission::update_offboard_mission()
 {
 	bool failed = true;
 
+	/* the items in the dataman may have changed */
+	_item_cache.invalidate();
+
 	if (orb_copy(ORB_ID(offboard_mission), _navigator->get_offboard_mission_sub(), &_offboard_mission) == OK) {
 		warnx("offboard mission updated: dataman_id=%d, count=%d, current_seq=%d", _offboard_mission.dataman_id, _offboard_mission.count, _offboard_mission.current_seq);
 		/* determine current index */
@@ -666,8 +674,8 @@ Mission::read_mission_item(bool onboard, bool is_current, struct mission_item_s
 		/* read mission item to temp storage first to not overwrite current mission item if data damaged */
 		struct mission_item_s mission_item_tmp;
 
-		/* read mission item from datamanager */
-		if (dm_read(dm_item, *mission_index_ptr, &mission_item_tmp, len) != len) {
+		/* read mission item from the prefetched items or the datamanager */
+		if (!_item_cache.read(dm_item, *mission_index_ptr, &mission_item_tmp)) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			mavlink_and_console_log_critical(_navigator->get_mavlink_fd(),
 			                     "ERROR waypoint could not be read");
@@ -693,6 +701,14 @@ Mission::read_mission_item(bool onboard, bool is_current, struct mission_item_s
 								     "ERROR DO JUMP waypoint could not be written");
 						return false;
 					}
+
+					/* keep the cached copy in sync */
+					struct mission_item_s *cached = _item_cache.get(dm_item, *mission_index_ptr);
+
+					if (cached != nullptr) {
+						memcpy(cached, &mission_item_tmp, sizeof(struct mission_item_s));
+					}
+
 					report_do_jump_mission_changed(*mission_index_ptr,
 								       mission_item_tmp.do_jump_repeat_count);
 				}
@@ -722,6 +738,34 @@ Mission::read_mission_item(bool onboard, bool is_current, struct mission_item_s
 	return false;
 }
 
+void
+Mission::prefetch_mission_items()
+{
+	struct mission_s *mission;
+	int current;
+	dm_item_t dm_item;
+
+	switch (_mission_type) {
+	case MISSION_TYPE_ONBOARD:
+		mission = &_onboard_mission;
+		current = _current_onboard_mission_index;
+		dm_item = DM_KEY_WAYPOINTS_ONBOARD;
+		break;
+
+	case MISSION_TYPE_OFFBOARD:
+		mission = &_offboard_mission;
+		current = _current_offboard_mission_index;
+		dm_item = DM_KEY_WAYPOINTS_OFFBOARD(_offboard_mission.dataman_id);
+		break;
+
+	case MISSION_TYPE_NONE:
+	default:
+		return;
+	}
+
+	_item_cache.prefetch(dm_item, current, mission->count);
+}
+
 void
 Mission::save_offboard_mission_state()
 {
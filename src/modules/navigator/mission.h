@@ -63,6 +63,7 @@
 #include "navigator_mode.h"
 #include "mission_block.h"
 #include "mission_feasibility_checker.h"
+#include "mission_item_cache.h"
 
 class Navigator;
 
@@ -79,6 +80,8 @@ public:
 
 	virtual void on_active();
 
+	virtual unsigned get_update_topics() { return NAV_TOPIC_GLOBAL_POS | NAV_TOPIC_HOME_POS | NAV_TOPIC_VSTATUS | NAV_TOPIC_MISSION; }
+
 	enum mission_altitude_mode {
 		MISSION_ALTMODE_ZOH = 0,
 		MISSION_ALTMODE_FOH = 1
@@ -141,6 +144,11 @@ private:
 	 */
 	bool read_mission_item(bool onboard, bool is_current, struct mission_item_s *mission_item);
 
+	/**
+	 * Keep the upcoming items of the active mission in the item cache
+	 */
+	void prefetch_mission_items();
+
 	/**
 	 * Save current offboard mission state to dataman
 	 */
@@ -202,6 +210,8 @@ private:
 	float _on_arrival_yaw; /**< holds the yaw value that should be applied when the current waypoint is reached */
 	float _distance_current_previous; /**< distance from previous to current sp in pos_sp_triplet,
 					    only use if current and previous are valid */
+
+	MissionItemCache _item_cache;	/**< items from the current one onwards */
 };
 
 #endif
@@ -55,11 +55,28 @@ MissionFeasibilityChecker::MissionFeasibilityChecker() :
 	_mavlink_fd(-1),
 	_capabilities_sub(-1),
 	_initDone(false),
-	_dist_1wp_ok(false)
+	_dist_1wp_ok(false),
+	_home_alt_checked(false),
+	_landing_checked(false),
+	_have_position(false),
+	_position_index(0),
+	_position_lat(0.0),
+	_position_lon(0.0)
 {
 	_nav_caps = {0};
 }
 
+/* items the vehicle flies to, the legs between them are checked against the geofence */
+static bool item_has_position(const struct mission_item_s &missionitem)
+{
+	return (missionitem.nav_cmd == NAV_CMD_WAYPOINT ||
+		missionitem.nav_cmd == NAV_CMD_LOITER_TIME_LIMIT ||
+		missionitem.nav_cmd == NAV_CMD_LOITER_TURN_COUNT ||
+		missionitem.nav_cmd == NAV_CMD_LOITER_UNLIMITED ||
+		missionitem.nav_cmd == NAV_CMD_TAKEOFF ||
+		missionitem.nav_cmd == NAV_CMD_LAND ||
+		missionitem.nav_cmd == NAV_CMD_PATHPLANNING);
+}
 
 bool MissionFeasibilityChecker::checkMissionFeasible(int mavlink_fd, bool isRotarywing,
 	dm_item_t dm_current, size_t nMissionItems, Geofence &geofence,
@@ -74,215 +91,213 @@ bool MissionFeasibilityChecker::checkMissionFeasible(int mavlink_fd, bool isRota
 
 	// first check if we have a valid position
 	if (!home_valid /* can later use global / local pos for finer granularity */) {
-		failed = true;
-		warned = true;
 		mavlink_log_info(_mavlink_fd, "Not yet ready for mission, no position lock.");
-	} else {
-		failed = failed || !check_dist_1wp(dm_current, nMissionItems, curr_lat, curr_lon, max_waypoint_distance, warning_issued);
+		return false;
 	}
 
-	// check if all mission item commands are supported
-	failed = failed || !checkMissionItemValidity(dm_current, nMissionItems);
-	failed = failed || !checkGeofence(dm_current, nMissionItems, geofence);
-	failed = failed || !checkHomePositionAltitude(dm_current, nMissionItems, home_alt, home_valid, warned);
+	if (!isRotarywing) {
+		/* Update fixed wing navigation capabilites */
+		updateNavigationCapabilities();
+	}
 
-	if (isRotarywing) {
-		failed = failed || !checkMissionFeasibleRotarywing(dm_current, nMissionItems, geofence, home_alt, home_valid);
-	} else {
-		failed = failed || !checkMissionFeasibleFixedwing(dm_current, nMissionItems, geofence, home_alt, home_valid);
+	_home_alt_checked = false;
+	_landing_checked = false;
+	_have_position = false;
+
+	struct mission_item_s missionitem;
+	struct mission_item_s previous = {};
+	const ssize_t len = sizeof(struct mission_item_s);
+
+	/* read every item once and run all checks on it */
+	for (size_t i = 0; i < nMissionItems && !failed; i++) {
+		if (dm_read(dm_current, i, &missionitem, len) != len) {
+			// not supposed to happen unless the datamanager can't access the SD card, etc.
+			mavlink_log_critical(_mavlink_fd, "Rejecting Mission: Cannot access SD card");
+			return false;
+		}
+
+		failed = failed || !check_dist_1wp(missionitem, curr_lat, curr_lon, max_waypoint_distance, warning_issued);
+
+		// check if all mission item commands are supported
+		failed = failed || !checkMissionItemValidity(missionitem, i);
+		failed = failed || !checkGeofence(missionitem, i, geofence);
+		failed = failed || !checkHomePositionAltitude(missionitem, i, home_alt, home_valid, warned);
+
+		if (isRotarywing) {
+			failed = failed || !checkMissionFeasibleRotarywing(missionitem, previous, i);
+		} else {
+			failed = failed || !checkMissionFeasibleFixedwing(missionitem, previous, i);
+		}
+
+		previous = missionitem;
 	}
 
 	if (!failed) {
+		if (max_waypoint_distance > 0.0f) {
+			/* no waypoints found in mission, then we will not fly far away */
+			_dist_1wp_ok = true;
+		}
+
 		mavlink_log_info(_mavlink_fd, "Mission checked and ready.");
 	}
 
 	return !failed;
 }
 
-bool MissionFeasibilityChecker::checkMissionFeasibleRotarywing(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence, float home_alt, bool home_valid)
+bool MissionFeasibilityChecker::checkMissionFeasibleRotarywing(const mission_item_s &missionitem, const mission_item_s &previous, size_t index)
 {
 	/* no custom rotary wing checks yet */
 	return true;
 }
 
-bool MissionFeasibilityChecker::checkMissionFeasibleFixedwing(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence, float home_alt, bool home_valid)
+bool MissionFeasibilityChecker::checkMissionFeasibleFixedwing(const mission_item_s &missionitem, const mission_item_s &previous, size_t index)
 {
-	/* Update fixed wing navigation capabilites */
-	updateNavigationCapabilities();
-
 	/* Perform checks and issue feedback to the user for all checks */
-	bool resLanding = checkFixedWingLanding(dm_current, nMissionItems);
+	bool resLanding = checkFixedWingLanding(missionitem, previous, index);
 
 	/* Mission is only marked as feasible if all checks return true */
 	return resLanding;
 }
 
-bool MissionFeasibilityChecker::checkGeofence(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence)
+bool MissionFeasibilityChecker::checkGeofence(const mission_item_s &missionitem, size_t index, Geofence &geofence)
 {
 	/* Check if all mission items are inside the geofence (if we have a valid geofence) */
 	if (geofence.valid()) {
-		for (size_t i = 0; i < nMissionItems; i++) {
-			struct mission_item_s missionitem;
-			const ssize_t len = sizeof(missionitem);
+		if (!geofence.inside_polygon(missionitem.lat, missionitem.lon, missionitem.altitude)) {
+			mavlink_log_critical(_mavlink_fd, "Geofence violation for waypoint %d", index);
+			return false;
+		}
 
-			if (dm_read(dm_current, i, &missionitem, len) != len) {
-				/* not supposed to happen unless the datamanager can't access the SD card, etc. */
+		/* both ends of the leg are inside, a concave fence can still be left in between */
+		if (item_has_position(missionitem)) {
+			if (_have_position &&
+			    geofence.crosses_polygon(_position_lat, _position_lon, missionitem.lat, missionitem.lon)) {
+				mavlink_log_critical(_mavlink_fd, "Geofence violation between waypoints %d and %d", _position_index, index);
 				return false;
 			}
 
-			if (!geofence.inside_polygon(missionitem.lat, missionitem.lon, missionitem.altitude)) {
-				mavlink_log_critical(_mavlink_fd, "Geofence violation for waypoint %d", i);
-				return false;
-			}
+			_have_position = true;
+			_position_index = index;
+			_position_lat = missionitem.lat;
+			_position_lon = missionitem.lon;
 		}
 	}
 
 	return true;
 }
 
-bool MissionFeasibilityChecker::checkHomePositionAltitude(dm_item_t dm_current, size_t nMissionItems,
+bool MissionFeasibilityChecker::checkHomePositionAltitude(const mission_item_s &missionitem, size_t index,
 	float home_alt, bool home_valid, bool &warning_issued, bool throw_error)
 {
 	/* Check if all all waypoints are above the home altitude, only return false if bool throw_error = true */
-	for (size_t i = 0; i < nMissionItems; i++) {
-		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(struct mission_item_s);
-
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
-			warning_issued = true;
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-			return false;
-		}
+	if (_home_alt_checked) {
+		/* only the first waypoint below home is reported */
+		return true;
+	}
 
-		/* always reject relative alt without home set */
-		if (missionitem.altitude_is_relative && !home_valid) {
-			mavlink_log_critical(_mavlink_fd, "Rejecting Mission: No home pos, WP %d uses rel alt", i);
-			warning_issued = true;
-			return false;
-		}
+	/* always reject relative alt without home set */
+	if (missionitem.altitude_is_relative && !home_valid) {
+		mavlink_log_critical(_mavlink_fd, "Rejecting Mission: No home pos, WP %d uses rel alt", index);
+		warning_issued = true;
+		return false;
+	}
 
-		/* calculate the global waypoint altitude */
-		float wp_alt = (missionitem.altitude_is_relative) ? missionitem.altitude + home_alt : missionitem.altitude;
+	/* calculate the global waypoint altitude */
+	float wp_alt = (missionitem.altitude_is_relative) ? missionitem.altitude + home_alt : missionitem.altitude;
 
-		if (home_alt > wp_alt) {
+	if (home_alt > wp_alt) {
 
-			warning_issued = true;
+		warning_issued = true;
 
-			if (throw_error) {
-				mavlink_log_critical(_mavlink_fd, "Rejecting Mission: Waypoint %d below home", i);
-				return false;
-			} else	{
-				mavlink_log_critical(_mavlink_fd, "Warning: Waypoint %d below home", i);
-				return true;
-			}
+		if (throw_error) {
+			mavlink_log_critical(_mavlink_fd, "Rejecting Mission: Waypoint %d below home", index);
+			return false;
+		} else	{
+			mavlink_log_critical(_mavlink_fd, "Warning: Waypoint %d below home", index);
+			_home_alt_checked = true;
+			return true;
 		}
 	}
 
 	return true;
 }
 
-bool MissionFeasibilityChecker::checkMissionItemValidity(dm_item_t dm_current, size_t nMissionItems) {
-	// do not allow mission if we find unsupported item
-	for (size_t i = 0; i < nMissionItems; i++) {
-		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(struct mission_item_s);
-
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
-			// not supposed to happen unless the datamanager can't access the SD card, etc.
-			mavlink_log_critical(_mavlink_fd, "Rejecting Mission: Cannot access SD card");
-			return false;
-		}
-
-		// check if we find unsupported item and reject mission if so
-		if (missionitem.nav_cmd != NAV_CMD_IDLE &&
-			missionitem.nav_cmd != NAV_CMD_WAYPOINT &&
-			missionitem.nav_cmd != NAV_CMD_LOITER_UNLIMITED &&
-			missionitem.nav_cmd != NAV_CMD_LOITER_TURN_COUNT &&
-			missionitem.nav_cmd != NAV_CMD_LOITER_TIME_LIMIT &&
-			missionitem.nav_cmd != NAV_CMD_LAND &&
-			missionitem.nav_cmd != NAV_CMD_TAKEOFF &&
-			missionitem.nav_cmd != NAV_CMD_ROI &&
-			missionitem.nav_cmd != NAV_CMD_PATHPLANNING &&
-			missionitem.nav_cmd != NAV_CMD_DO_JUMP &&
-			missionitem.nav_cmd != NAV_CMD_DO_SET_SERVO) {
-
-			mavlink_log_critical(_mavlink_fd, "Rejecting mission item %i: unsupported action.", (int)(i+1));
-			return false;
-		}
+bool MissionFeasibilityChecker::checkMissionItemValidity(const mission_item_s &missionitem, size_t index) {
+	// check if we find unsupported item and reject mission if so
+	if (missionitem.nav_cmd != NAV_CMD_IDLE &&
+		missionitem.nav_cmd != NAV_CMD_WAYPOINT &&
+		missionitem.nav_cmd != NAV_CMD_LOITER_UNLIMITED &&
+		missionitem.nav_cmd != NAV_CMD_LOITER_TURN_COUNT &&
+		missionitem.nav_cmd != NAV_CMD_LOITER_TIME_LIMIT &&
+		missionitem.nav_cmd != NAV_CMD_LAND &&
+		missionitem.nav_cmd != NAV_CMD_TAKEOFF &&
+		missionitem.nav_cmd != NAV_CMD_ROI &&
+		missionitem.nav_cmd != NAV_CMD_PATHPLANNING &&
+		missionitem.nav_cmd != NAV_CMD_DO_JUMP &&
+		missionitem.nav_cmd != NAV_CMD_DO_SET_SERVO) {
+
+		mavlink_log_critical(_mavlink_fd, "Rejecting mission item %i: unsupported action.", (int)(index+1));
+		return false;
 	}
 	return true;
 }
 
-bool MissionFeasibilityChecker::checkFixedWingLanding(dm_item_t dm_current, size_t nMissionItems)
+bool MissionFeasibilityChecker::checkFixedWingLanding(const mission_item_s &missionitem, const mission_item_s &missionitem_previous, size_t index)
 {
-	/* Go through all mission items and search for a landing waypoint
+	/* Search for the first landing waypoint
 	 * if landing waypoint is found: the previous waypoint is checked to be at a feasible distance and altitude given the landing slope */
 
+	if (_landing_checked || missionitem.nav_cmd != NAV_CMD_LAND) {
+		/* No landing waypoint yet or already checked */
+		return true;
+	}
 
-	for (size_t i = 0; i < nMissionItems; i++) {
-		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(missionitem);
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-			return false;
-		}
-
-		if (missionitem.nav_cmd == NAV_CMD_LAND) {
-			struct mission_item_s missionitem_previous;
-			if (i != 0) {
-				if (dm_read(dm_current, i-1, &missionitem_previous, len) != len) {
-					/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-					return false;
-				}
-
-				float wp_distance = get_distance_to_next_waypoint(missionitem_previous.lat , missionitem_previous.lon, missionitem.lat, missionitem.lon);
-				float slope_alt_req = Landingslope::getLandingSlopeAbsoluteAltitude(wp_distance, missionitem.altitude, _nav_caps.landing_horizontal_slope_displacement, _nav_caps.landing_slope_angle_rad);
-				float wp_distance_req = Landingslope::getLandingSlopeWPDistance(missionitem_previous.altitude, missionitem.altitude, _nav_caps.landing_horizontal_slope_displacement, _nav_caps.landing_slope_angle_rad);
-				float delta_altitude = missionitem.altitude - missionitem_previous.altitude;
-//				warnx("wp_distance %.2f, delta_altitude %.2f, missionitem_previous.altitude %.2f, missionitem.altitude %.2f, slope_alt_req %.2f, wp_distance_req %.2f",
-//						wp_distance, delta_altitude, missionitem_previous.altitude, missionitem.altitude, slope_alt_req, wp_distance_req);
-//				warnx("_nav_caps.landing_horizontal_slope_displacement %.4f, _nav_caps.landing_slope_angle_rad %.4f, _nav_caps.landing_flare_length %.4f",
-//						_nav_caps.landing_horizontal_slope_displacement, _nav_caps.landing_slope_angle_rad, _nav_caps.landing_flare_length);
-
-				if (wp_distance > _nav_caps.landing_flare_length) {
-					/* Last wp is before flare region */
-
-					if (delta_altitude < 0) {
-						if (missionitem_previous.altitude <= slope_alt_req) {
-							/* Landing waypoint is at or below altitude of slope at the given waypoint distance: this is ok, aircraft will intersect the slope */
-							return true;
-						} else {
-							/* Landing waypoint is above altitude of slope at the given waypoint distance */
-							mavlink_log_critical(_mavlink_fd, "Landing: last waypoint too high/too close");
-							mavlink_log_critical(_mavlink_fd, "Move down to %.1fm or move further away by %.1fm",
-									(double)(slope_alt_req),
-									(double)(wp_distance_req - wp_distance));
-							return false;
-						}
-					} else {
-						/* Landing waypoint is above last waypoint */
-						mavlink_log_critical(_mavlink_fd, "Landing waypoint above last nav waypoint");
-						return false;
-					}
+	_landing_checked = true;
+
+	if (index != 0) {
+		float wp_distance = get_distance_to_next_waypoint(missionitem_previous.lat , missionitem_previous.lon, missionitem.lat, missionitem.lon);
+		float slope_alt_req = Landingslope::getLandingSlopeAbsoluteAltitude(wp_distance, missionitem.altitude, _nav_caps.landing_horizontal_slope_displacement, _nav_caps.landing_slope_angle_rad);
+		float wp_distance_req = Landingslope::getLandingSlopeWPDistance(missionitem_previous.altitude, missionitem.altitude, _nav_caps.landing_horizontal_slope_displacement, _nav_caps.landing_slope_angle_rad);
+		float delta_altitude = missionitem.altitude - missionitem_previous.altitude;
+//		warnx("wp_distance %.2f, delta_altitude %.2f, missionitem_previous.altitude %.2f, missionitem.altitude %.2f, slope_alt_req %.2f, wp_distance_req %.2f",
+//				wp_distance, delta_altitude, missionitem_previous.altitude, missionitem.altitude, slope_alt_req, wp_distance_req);
+//		warnx("_nav_caps.landing_horizontal_slope_displacement %.4f, _nav_caps.landing_slope_angle_rad %.4f, _nav_caps.landing_flare_length %.4f",
+//				_nav_caps.landing_horizontal_slope_displacement, _nav_caps.landing_slope_angle_rad, _nav_caps.landing_flare_length);
+
+		if (wp_distance > _nav_caps.landing_flare_length) {
+			/* Last wp is before flare region */
+
+			if (delta_altitude < 0) {
+				if (missionitem_previous.altitude <= slope_alt_req) {
+					/* Landing waypoint is at or below altitude of slope at the given waypoint distance: this is ok, aircraft will intersect the slope */
+					return true;
 				} else {
-					/* Last wp is in flare region */
-					//xxx give recommendations
-					mavlink_log_critical(_mavlink_fd, "Warning: Landing: last waypoint in flare region");
+					/* Landing waypoint is above altitude of slope at the given waypoint distance */
+					mavlink_log_critical(_mavlink_fd, "Landing: last waypoint too high/too close");
+					mavlink_log_critical(_mavlink_fd, "Move down to %.1fm or move further away by %.1fm",
+							(double)(slope_alt_req),
+							(double)(wp_distance_req - wp_distance));
 					return false;
 				}
 			} else {
-				mavlink_log_critical(_mavlink_fd, "Warning: starting with land waypoint");
+				/* Landing waypoint is above last waypoint */
+				mavlink_log_critical(_mavlink_fd, "Landing waypoint above last nav waypoint");
 				return false;
 			}
+		} else {
+			/* Last wp is in flare region */
+			//xxx give recommendations
+			mavlink_log_critical(_mavlink_fd, "Warning: Landing: last waypoint in flare region");
+			return false;
 		}
+	} else {
+		mavlink_log_critical(_mavlink_fd, "Warning: starting with land waypoint");
+		return false;
 	}
-
-	/* No landing waypoints or no waypoints */
-	return true;
 }
 
 bool
-MissionFeasibilityChecker::check_dist_1wp(dm_item_t dm_current, size_t nMissionItems, double curr_lat, double curr_lon, float dist_first_wp, bool &warning_issued)
+MissionFeasibilityChecker::check_dist_1wp(const mission_item_s &mission_item, double curr_lat, double curr_lon, float dist_first_wp, bool &warning_issued)
 {
 	if (_dist_1wp_ok) {
 		/* always return true after at least one successful check */
@@ -291,71 +306,53 @@ MissionFeasibilityChecker::check_dist_1wp(dm_item_t dm_current, size_t nMissionI
 
 	/* check if first waypoint is not too far from home */
 	if (dist_first_wp > 0.0f) {
-		struct mission_item_s mission_item;
-
-		/* find first waypoint (with lat/lon) item in datamanager */
-		for (unsigned i = 0; i < nMissionItems; i++) {
-			if (dm_read(dm_current, i,
-					&mission_item, sizeof(mission_item_s)) == sizeof(mission_item_s)) {
-				/* Check non navigation item */
-				if (mission_item.nav_cmd == NAV_CMD_DO_SET_SERVO){
-
-					/* check actuator number */
-					if (mission_item.actuator_num < 0 || mission_item.actuator_num > 5) {
-						mavlink_log_critical(_mavlink_fd, "Actuator number %d is out of bounds 0..5", (int)mission_item.actuator_num);
-						warning_issued = true;
-						return false;
-					}
-					/* check actuator value */
-					if (mission_item.actuator_value < -2000 || mission_item.actuator_value > 2000) {
-						mavlink_log_critical(_mavlink_fd, "Actuator value %d is out of bounds -2000..2000", (int)mission_item.actuator_value);
-						warning_issued = true;
-						return false;
-					}
-				}
-				/* check only items with valid lat/lon */
-				else if ( mission_item.nav_cmd == NAV_CMD_WAYPOINT ||
-						mission_item.nav_cmd == NAV_CMD_LOITER_TIME_LIMIT ||
-						mission_item.nav_cmd == NAV_CMD_LOITER_TURN_COUNT ||
-						mission_item.nav_cmd == NAV_CMD_LOITER_UNLIMITED ||
-						mission_item.nav_cmd == NAV_CMD_TAKEOFF ||
-						mission_item.nav_cmd == NAV_CMD_PATHPLANNING) {
-
-					/* check distance from current position to item */
-					float dist_to_1wp = get_distance_to_next_waypoint(
-							mission_item.lat, mission_item.lon, curr_lat, curr_lon);
-
-					if (dist_to_1wp < dist_first_wp) {
-						_dist_1wp_ok = true;
-						if (dist_to_1wp > ((dist_first_wp * 3) / 2)) {
-							/* allow at 2/3 distance, but warn */
-							mavlink_log_critical(_mavlink_fd, "Warning: First waypoint very far: %d m", (int)dist_to_1wp);
-							warning_issued = true;
-						}
-						return true;
-
-					} else {
-						/* item is too far from home */
-						mavlink_log_critical(_mavlink_fd, "First waypoint too far: %d m,refusing mission", (int)dist_to_1wp, (int)dist_first_wp);
-						warning_issued = true;
-						return false;
-					}
+		/* Check non navigation item */
+		if (mission_item.nav_cmd == NAV_CMD_DO_SET_SERVO){
+
+			/* check actuator number */
+			if (mission_item.actuator_num < 0 || mission_item.actuator_num > 5) {
+				mavlink_log_critical(_mavlink_fd, "Actuator number %d is out of bounds 0..5", (int)mission_item.actuator_num);
+				warning_issued = true;
+				return false;
+			}
+			/* check actuator value */
+			if (mission_item.actuator_value < -2000 || mission_item.actuator_value > 2000) {
+				mavlink_log_critical(_mavlink_fd, "Actuator value %d is out of bounds -2000..2000", (int)mission_item.actuator_value);
+				warning_issued = true;
+				return false;
+			}
+		}
+		/* check only items with valid lat/lon */
+		else if ( mission_item.nav_cmd == NAV_CMD_WAYPOINT ||
+				mission_item.nav_cmd == NAV_CMD_LOITER_TIME_LIMIT ||
+				mission_item.nav_cmd == NAV_CMD_LOITER_TURN_COUNT ||
+				mission_item.nav_cmd == NAV_CMD_LOITER_UNLIMITED ||
+				mission_item.nav_cmd == NAV_CMD_TAKEOFF ||
+				mission_item.nav_cmd == NAV_CMD_PATHPLANNING) {
+
+			/* check distance from current position to item */
+			float dist_to_1wp = get_distance_to_next_waypoint(
+					mission_item.lat, mission_item.lon, curr_lat, curr_lon);
+
+			if (dist_to_1wp < dist_first_wp) {
+				_dist_1wp_ok = true;
+				if (dist_to_1wp > ((dist_first_wp * 3) / 2)) {
+					/* allow at 2/3 distance, but warn */
+					mavlink_log_critical(_mavlink_fd, "Warning: First waypoint very far: %d m", (int)dist_to_1wp);
+					warning_issued = true;
 				}
+				return true;
 
 			} else {
-				/* error reading, mission is invalid */
-				mavlink_log_info(_mavlink_fd, "error reading offboard mission");
+				/* item is too far from home */
+				mavlink_log_critical(_mavlink_fd, "First waypoint too far: %d m,refusing mission", (int)dist_to_1wp, (int)dist_first_wp);
+				warning_issued = true;
 				return false;
 			}
 		}
-
-		/* no waypoints found in mission, then we will not fly far away */
-		_dist_1wp_ok = true;
-		return true;
-
-	} else {
-		return true;
 	}
+
+	return true;
 }
 
 void MissionFeasibilityChecker::updateNavigationCapabilities()
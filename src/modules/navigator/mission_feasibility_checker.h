@@ -58,21 +58,30 @@ private:
 
 	bool _initDone;
 	bool _dist_1wp_ok;
+
+	/* State of the pass over the mission items */
+	bool _home_alt_checked;		/**< a waypoint below home was already reported */
+	bool _landing_checked;		/**< the first landing waypoint was already checked */
+	bool _have_position;		/**< a previous item with a position exists */
+	size_t _position_index;		/**< index of the previous item with a position */
+	double _position_lat;
+	double _position_lon;
+
 	void init();
 
-	/* Checks for all airframes */
-	bool checkGeofence(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence);
-	bool checkHomePositionAltitude(dm_item_t dm_current, size_t nMissionItems, float home_alt, bool home_valid, bool &warning_issued, bool throw_error = false);
-	bool checkMissionItemValidity(dm_item_t dm_current, size_t nMissionItems);
-	bool check_dist_1wp(dm_item_t dm_current, size_t nMissionItems, double curr_lat, double curr_lon, float dist_first_wp, bool &warning_issued);
+	/* Checks for all airframes, called once per mission item */
+	bool checkGeofence(const mission_item_s &missionitem, size_t index, Geofence &geofence);
+	bool checkHomePositionAltitude(const mission_item_s &missionitem, size_t index, float home_alt, bool home_valid, bool &warning_issued, bool throw_error = false);
+	bool checkMissionItemValidity(const mission_item_s &missionitem, size_t index);
+	bool check_dist_1wp(const mission_item_s &missionitem, double curr_lat, double curr_lon, float dist_first_wp, bool &warning_issued);
 
 	/* Checks specific to fixedwing airframes */
-	bool checkMissionFeasibleFixedwing(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence, float home_alt, bool home_valid);
-	bool checkFixedWingLanding(dm_item_t dm_current, size_t nMissionItems);
+	bool checkMissionFeasibleFixedwing(const mission_item_s &missionitem, const mission_item_s &previous, size_t index);
+	bool checkFixedWingLanding(const mission_item_s &missionitem, const mission_item_s &previous, size_t index);
 	void updateNavigationCapabilities();
 
 	/* Checks specific to rotarywing airframes */
-	bool checkMissionFeasibleRotarywing(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence, float home_alt, bool home_valid);
+	bool checkMissionFeasibleRotarywing(const mission_item_s &missionitem, const mission_item_s &previous, size_t index);
 public:
 
 	MissionFeasibilityChecker();
@@ -80,6 +89,9 @@ public:
 
 	/*
 	 * Returns true if mission is feasible and false otherwise
+	 *
+	 * Every mission item is read from the datamanager once and all checks
+	 * are run on it before moving on to the next one.
 	 */
 	bool checkMissionFeasible(int mavlink_fd, bool isRotarywing, dm_item_t dm_current,
 		size_t nMissionItems, Geofence &geofence, float home_alt, bool home_valid,
@@ -0,0 +1,129 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file mission_item_cache.cpp
+ * Mission items from the current one onwards, held in memory
+ */
+
+#include <string.h>
+
+#include "mission_item_cache.h"
+
+MissionItemCache::MissionItemCache() :
+	_dm_item(DM_KEY_WAYPOINTS_OFFBOARD_0),
+	_first(0),
+	_count(0),
+	_items{},
+	_miss_perf(perf_alloc(PC_COUNT, "navigator MIS item miss"))
+{
+}
+
+MissionItemCache::~MissionItemCache()
+{
+	perf_free(_miss_perf);
+}
+
+void
+MissionItemCache::restart(dm_item_t dm_item, int index)
+{
+	_dm_item = dm_item;
+	_first = index;
+	_count = 0;
+}
+
+struct mission_item_s *
+MissionItemCache::get(dm_item_t dm_item, int index)
+{
+	if (_count == 0 || dm_item != _dm_item || index < _first || index >= _first + (int)_count) {
+		return nullptr;
+	}
+
+	return &_items[index % MISSION_ITEM_CACHE_SIZE];
+}
+
+bool
+MissionItemCache::read(dm_item_t dm_item, int index, struct mission_item_s *mission_item)
+{
+	struct mission_item_s *cached = get(dm_item, index);
+
+	if (cached != nullptr) {
+		memcpy(mission_item, cached, sizeof(struct mission_item_s));
+		return true;
+	}
+
+	perf_count(_miss_perf);
+
+	const ssize_t len = sizeof(struct mission_item_s);
+
+	if (dm_read(dm_item, index, mission_item, len) != len) {
+		return false;
+	}
+
+	/* extend the cache if the item follows it, otherwise restart it at this item */
+	if (_count == 0 || dm_item != _dm_item || index != _first + (int)_count || _count >= MISSION_ITEM_CACHE_SIZE) {
+		restart(dm_item, index);
+	}
+
+	memcpy(&_items[index % MISSION_ITEM_CACHE_SIZE], mission_item, sizeof(struct mission_item_s));
+	_count++;
+
+	return true;
+}
+
+void
+MissionItemCache::prefetch(dm_item_t dm_item, int current, int mission_count)
+{
+	if (current < 0 || current >= mission_count) {
+		return;
+	}
+
+	/* restart at the current item if the cache does not reach it, e.g. after a DO_JUMP */
+	if (_count == 0 || dm_item != _dm_item || current < _first || current > _first + (int)_count) {
+		restart(dm_item, current);
+	}
+
+	/* drop the items already flown */
+	_count -= current - _first;
+	_first = current;
+
+	/* read at most one item per cycle */
+	int index = _first + (int)_count;
+
+	if (_count < MISSION_ITEM_CACHE_SIZE && index < mission_count) {
+		const ssize_t len = sizeof(struct mission_item_s);
+
+		if (dm_read(dm_item, index, &_items[index % MISSION_ITEM_CACHE_SIZE], len) == len) {
+			_count++;
+		}
+	}
+}
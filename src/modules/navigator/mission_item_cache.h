@@ -0,0 +1,102 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file mission_item_cache.h
+ * Mission items from the current one onwards, held in memory so that
+ * waypoint transitions do not have to wait for the dataman
+ */
+
+#ifndef NAVIGATOR_MISSION_ITEM_CACHE_H
+#define NAVIGATOR_MISSION_ITEM_CACHE_H
+
+#include <dataman/dataman.h>
+#include <navigator/navigation.h>
+#include <systemlib/perf_counter.h>
+
+/**
+ * Number of mission items held in memory ahead of the current one
+ */
+#define MISSION_ITEM_CACHE_SIZE 8
+
+class MissionItemCache
+{
+public:
+	MissionItemCache();
+	~MissionItemCache();
+
+	/**
+	 * Forget all items, e.g. after the mission in the dataman changed
+	 */
+	void invalidate() { _count = 0; }
+
+	/**
+	 * Get the cached copy of a mission item
+	 * @return pointer into the cache or nullptr if the item is not cached
+	 */
+	struct mission_item_s *get(dm_item_t dm_item, int index);
+
+	/**
+	 * Read a mission item from the cache, from the dataman on a cache miss
+	 * @return true if successful
+	 */
+	bool read(dm_item_t dm_item, int index, struct mission_item_s *mission_item);
+
+	/**
+	 * Drop the items before the current one and read at most one upcoming
+	 * item, to spread the dataman access over the navigator cycles
+	 *
+	 * @param dm_item	dataman item the mission is stored in
+	 * @param current	index of the current mission item
+	 * @param mission_count	number of items in the mission
+	 */
+	void prefetch(dm_item_t dm_item, int current, int mission_count);
+
+private:
+	dm_item_t _dm_item;		/**< dataman item the cached mission is stored in */
+	int _first;			/**< mission index of the oldest cached item */
+	unsigned _count;		/**< number of consecutive cached items */
+	struct mission_item_s _items[MISSION_ITEM_CACHE_SIZE];	/**< ring buffer indexed by mission index */
+
+	perf_counter_t _miss_perf;	/**< mission items which had to be read on demand */
+
+	/**
+	 * Restart the cache empty at a mission index
+	 */
+	void restart(dm_item_t dm_item, int index);
+
+	/* do not allow copying this class */
+	MissionItemCache(const MissionItemCache &);
+	MissionItemCache operator=(const MissionItemCache &);
+};
+
+#endif
@@ -42,6 +42,7 @@
 #define NAVIGATOR_H
 
 #include <systemlib/perf_counter.h>
+#include <px4_work_item.h>
 
 #include <controllib/blocks.hpp>
 #include <controllib/block/BlockParam.hpp>
@@ -73,7 +74,7 @@
  */
 #define NAVIGATOR_MODE_ARRAY_SIZE 7
 
-class Navigator : public control::SuperBlock
+class Navigator : public control::SuperBlock, public px4::ScheduledWorkItem
 {
 public:
 	/**
@@ -87,7 +88,8 @@ public:
 	~Navigator();
 
 	/**
-	 * Start the navigator task.
+	 * Start the navigator task, on POSIX a low priority work item
+	 * triggered by the navigator inputs instead.
 	 *
 	 * @return		OK on success.
 	 */
@@ -170,6 +172,7 @@ private:
 
 	bool		_task_should_exit;		/**< if true, sensor task should exit */
 	int		_navigator_task;		/**< task handle for sensor task */
+	bool		_initialized;			/**< subscriptions done on the running thread */
 
 	int		_mavlink_fd;			/**< the file descriptor to send messages over mavlink */
 
@@ -289,6 +292,16 @@ private:
 	 */
 	void		task_main();
 
+	/**
+	 * Load the geofence and subscribe to all inputs on the running thread.
+	 */
+	void		init();
+
+	/**
+	 * Process updated inputs and run the active navigation mode once.
+	 */
+	void		Run();
+
 	/**
 	 * Translate mission item to a position setpoint.
 	 */
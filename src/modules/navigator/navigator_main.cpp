@@ -99,8 +99,10 @@ Navigator	*g_navigator;
 
 Navigator::Navigator() :
 	SuperBlock(NULL, "NAV"),
+	ScheduledWorkItem("navigator_wq", LPWORK),
 	_task_should_exit(false),
 	_navigator_task(-1),
+	_initialized(false),
 	_mavlink_fd(-1),
 	_global_pos_sub(-1),
 	_gps_pos_sub(-1),
@@ -164,6 +166,8 @@ Navigator::Navigator() :
 
 Navigator::~Navigator()
 {
+	ScheduleClear();
+
 	if (_navigator_task != -1) {
 
 		/* task wakes up every 100ms or so at the longest */
@@ -259,7 +263,7 @@ Navigator::task_main_trampoline(int argc, char *argv[])
 }
 
 void
-Navigator::task_main()
+Navigator::init()
 {
 	_mavlink_fd = px4_open(MAVLINK_LOG_DEVICE, 0);
 	_geofence.setMavlinkFd(_mavlink_fd);
@@ -306,11 +310,16 @@ Navigator::task_main()
 	orb_set_interval(_global_pos_sub, 20);
 	orb_set_interval(_sensor_combined_sub, 20);
 
-	hrt_abstime mavlink_open_time = 0;
-	const hrt_abstime mavlink_open_interval = 500000;
+	_initialized = true;
+}
+
+void
+Navigator::task_main()
+{
+	init();
 
 	/* wakeup source(s) */
-	px4_pollfd_struct_t fds[8];
+	px4_pollfd_struct_t fds[10];
 
 	/* Setup of loop */
 	fds[0].fd = _global_pos_sub;
@@ -329,6 +338,10 @@ Navigator::task_main()
 	fds[6].events = POLLIN;
 	fds[7].fd = _gps_pos_sub;
 	fds[7].events = POLLIN;
+	fds[8].fd = _onboard_mission_sub;
+	fds[8].events = POLLIN;
+	fds[9].fd = _offboard_mission_sub;
+	fds[9].events = POLLIN;
 
 	while (!_task_should_exit) {
 
@@ -346,178 +359,235 @@ Navigator::task_main()
 			continue;
 		}
 
-		perf_begin(_loop_perf);
+		Run();
+	}
+	warnx("exiting.");
 
-		if (_mavlink_fd < 0 && hrt_absolute_time() > mavlink_open_time) {
-			/* try to reopen the mavlink log device with specified interval */
-			mavlink_open_time = hrt_abstime() + mavlink_open_interval;
-			_mavlink_fd = px4_open(MAVLINK_LOG_DEVICE, 0);
-		}
+	_navigator_task = -1;
+	return;
+}
 
-		static bool have_geofence_position_data = false;
+void
+Navigator::Run()
+{
+	/* inputs updated in this cycle, modes only re-plan on the ones they depend on */
+	unsigned updated_topics = 0;
 
-		/* gps updated */
-		if (fds[7].revents & POLLIN) {
-			gps_position_update();
-			if (_geofence.getSource() == Geofence::GF_SOURCE_GPS) {
-				have_geofence_position_data = true;
-			}
-		}
+	/* work item: subscriptions belong to the worker thread */
+	if (!_initialized) {
+		init();
+		updated_topics = NAV_TOPIC_ALL;
+	}
 
-		/* sensors combined updated */
-		if (fds[6].revents & POLLIN) {
-			sensor_combined_update();
-		}
+	perf_begin(_loop_perf);
 
-		/* parameters updated */
-		if (fds[5].revents & POLLIN) {
-			params_update();
-			updateParams();
-		}
+	static hrt_abstime mavlink_open_time = 0;
+	const hrt_abstime mavlink_open_interval = 500000;
 
-		/* vehicle control mode updated */
-		if (fds[4].revents & POLLIN) {
-			vehicle_control_mode_update();
-		}
+	if (_mavlink_fd < 0 && hrt_absolute_time() > mavlink_open_time) {
+		/* try to reopen the mavlink log device with specified interval */
+		mavlink_open_time = hrt_abstime() + mavlink_open_interval;
+		_mavlink_fd = px4_open(MAVLINK_LOG_DEVICE, 0);
+	}
 
-		/* vehicle status updated */
-		if (fds[3].revents & POLLIN) {
-			vehicle_status_update();
-		}
+	static bool have_geofence_position_data = false;
+	bool updated;
+
+	/* gps updated */
+	orb_check(_gps_pos_sub, &updated);
 
-		/* navigation capabilities updated */
-		if (fds[2].revents & POLLIN) {
-			navigation_capabilities_update();
+	if (updated) {
+		gps_position_update();
+		updated_topics |= NAV_TOPIC_GPS_POS;
+		if (_geofence.getSource() == Geofence::GF_SOURCE_GPS) {
+			have_geofence_position_data = true;
 		}
+	}
+
+	/* sensors combined updated */
+	orb_check(_sensor_combined_sub, &updated);
+
+	if (updated) {
+		sensor_combined_update();
+		updated_topics |= NAV_TOPIC_SENSOR_COMBINED;
+	}
+
+	/* parameters updated */
+	orb_check(_param_update_sub, &updated);
 
-		/* home position updated */
-		if (fds[1].revents & POLLIN) {
-			home_position_update();
+	if (updated) {
+		params_update();
+		updateParams();
+		updated_topics |= NAV_TOPIC_PARAMS;
+	}
+
+	/* vehicle control mode updated */
+	orb_check(_control_mode_sub, &updated);
+
+	if (updated) {
+		vehicle_control_mode_update();
+		updated_topics |= NAV_TOPIC_CONTROL_MODE;
+	}
+
+	/* vehicle status updated */
+	orb_check(_vstatus_sub, &updated);
+
+	if (updated) {
+		vehicle_status_update();
+		updated_topics |= NAV_TOPIC_VSTATUS;
+	}
+
+	/* navigation capabilities updated */
+	orb_check(_capabilities_sub, &updated);
+
+	if (updated) {
+		navigation_capabilities_update();
+		updated_topics |= NAV_TOPIC_CAPABILITIES;
+	}
+
+	/* home position updated, checks for the update itself */
+	orb_check(_home_pos_sub, &updated);
+
+	if (updated) {
+		updated_topics |= NAV_TOPIC_HOME_POS;
+	}
+
+	home_position_update();
+
+	/* missions are copied by the mission mode, only flag them here */
+	orb_check(_onboard_mission_sub, &updated);
+
+	if (updated) {
+		updated_topics |= NAV_TOPIC_MISSION;
+	}
+
+	orb_check(_offboard_mission_sub, &updated);
+
+	if (updated) {
+		updated_topics |= NAV_TOPIC_MISSION;
+	}
+
+	/* global position updated */
+	orb_check(_global_pos_sub, &updated);
+
+	if (updated) {
+		global_position_update();
+		updated_topics |= NAV_TOPIC_GLOBAL_POS;
+		if (_geofence.getSource() == Geofence::GF_SOURCE_GLOBALPOS) {
+			have_geofence_position_data = true;
 		}
+	}
 
-		/* global position updated */
-		if (fds[0].revents & POLLIN) {
-			global_position_update();
-			if (_geofence.getSource() == Geofence::GF_SOURCE_GLOBALPOS) {
-				have_geofence_position_data = true;
+	/* Check geofence violation */
+	static hrt_abstime last_geofence_check = 0;
+	if (have_geofence_position_data &&
+		(_geofence.getGeofenceAction() != geofence_result_s::GF_ACTION_NONE) &&
+		(hrt_elapsed_time(&last_geofence_check) > GEOFENCE_CHECK_INTERVAL)) {
+		bool inside = _geofence.inside(_global_pos, _gps_pos, _sensor_combined.baro_alt_meter[0], _home_pos, _home_position_set);
+		last_geofence_check = hrt_absolute_time();
+		have_geofence_position_data = false;
+
+		_geofence_result.geofence_action = _geofence.getGeofenceAction();
+		if (!inside) {
+			/* inform other apps via the mission result */
+			_geofence_result.geofence_violated = true;
+			publish_geofence_result();
+
+			/* Issue a warning about the geofence violation once */
+			if (!_geofence_violation_warning_sent) {
+				mavlink_log_critical(_mavlink_fd, "Geofence violation");
+				_geofence_violation_warning_sent = true;
 			}
+		} else {
+			/* inform other apps via the mission result */
+			_geofence_result.geofence_violated = false;
+			publish_geofence_result();
+			/* Reset the _geofence_violation_warning_sent field */
+			_geofence_violation_warning_sent = false;
 		}
+	}
 
-		/* Check geofence violation */
-		static hrt_abstime last_geofence_check = 0;
-		if (have_geofence_position_data &&
-			(_geofence.getGeofenceAction() != geofence_result_s::GF_ACTION_NONE) &&
-			(hrt_elapsed_time(&last_geofence_check) > GEOFENCE_CHECK_INTERVAL)) {
-			bool inside = _geofence.inside(_global_pos, _gps_pos, _sensor_combined.baro_alt_meter[0], _home_pos, _home_position_set);
-			last_geofence_check = hrt_absolute_time();
-			have_geofence_position_data = false;
-
-			_geofence_result.geofence_action = _geofence.getGeofenceAction();
-			if (!inside) {
-				/* inform other apps via the mission result */
-				_geofence_result.geofence_violated = true;
-				publish_geofence_result();
-
-				/* Issue a warning about the geofence violation once */
-				if (!_geofence_violation_warning_sent) {
-					mavlink_log_critical(_mavlink_fd, "Geofence violation");
-					_geofence_violation_warning_sent = true;
-				}
+	/* Do stuff according to navigation state set by commander */
+	switch (_vstatus.nav_state) {
+		case vehicle_status_s::NAVIGATION_STATE_MANUAL:
+		case vehicle_status_s::NAVIGATION_STATE_ACRO:
+		case vehicle_status_s::NAVIGATION_STATE_ALTCTL:
+		case vehicle_status_s::NAVIGATION_STATE_POSCTL:
+		case vehicle_status_s::NAVIGATION_STATE_LAND:
+		case vehicle_status_s::NAVIGATION_STATE_TERMINATION:
+		case vehicle_status_s::NAVIGATION_STATE_OFFBOARD:
+			_navigation_mode = nullptr;
+			_can_loiter_at_sp = false;
+			break;
+		case vehicle_status_s::NAVIGATION_STATE_AUTO_MISSION:
+			_pos_sp_triplet_published_invalid_once = false;
+			_navigation_mode = &_mission;
+			break;
+		case vehicle_status_s::NAVIGATION_STATE_AUTO_LOITER:
+			_pos_sp_triplet_published_invalid_once = false;
+			_navigation_mode = &_loiter;
+			break;
+		case vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER:
+			_pos_sp_triplet_published_invalid_once = false;
+			if (_param_rcloss_obc.get() != 0) {
+				_navigation_mode = &_rcLoss;
 			} else {
-				/* inform other apps via the mission result */
-				_geofence_result.geofence_violated = false;
-				publish_geofence_result();
-				/* Reset the _geofence_violation_warning_sent field */
-				_geofence_violation_warning_sent = false;
+				_navigation_mode = &_rtl;
 			}
-		}
-
-		/* Do stuff according to navigation state set by commander */
-		switch (_vstatus.nav_state) {
-			case vehicle_status_s::NAVIGATION_STATE_MANUAL:
-			case vehicle_status_s::NAVIGATION_STATE_ACRO:
-			case vehicle_status_s::NAVIGATION_STATE_ALTCTL:
-			case vehicle_status_s::NAVIGATION_STATE_POSCTL:
-			case vehicle_status_s::NAVIGATION_STATE_LAND:
-			case vehicle_status_s::NAVIGATION_STATE_TERMINATION:
-			case vehicle_status_s::NAVIGATION_STATE_OFFBOARD:
-				_navigation_mode = nullptr;
-				_can_loiter_at_sp = false;
-				break;
-			case vehicle_status_s::NAVIGATION_STATE_AUTO_MISSION:
-				_pos_sp_triplet_published_invalid_once = false;
-				_navigation_mode = &_mission;
-				break;
-			case vehicle_status_s::NAVIGATION_STATE_AUTO_LOITER:
-				_pos_sp_triplet_published_invalid_once = false;
-				_navigation_mode = &_loiter;
-				break;
-			case vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER:
-				_pos_sp_triplet_published_invalid_once = false;
-				if (_param_rcloss_obc.get() != 0) {
-					_navigation_mode = &_rcLoss;
-				} else {
-					_navigation_mode = &_rtl;
-				}
-				break;
-			case vehicle_status_s::NAVIGATION_STATE_AUTO_RTL:
-				_pos_sp_triplet_published_invalid_once = false;
+			break;
+		case vehicle_status_s::NAVIGATION_STATE_AUTO_RTL:
+			_pos_sp_triplet_published_invalid_once = false;
+			_navigation_mode = &_rtl;
+			break;
+		case vehicle_status_s::NAVIGATION_STATE_AUTO_RTGS:
+			/* Use complex data link loss mode only when enabled via param
+			* otherwise use rtl */
+			_pos_sp_triplet_published_invalid_once = false;
+			if (_param_datalinkloss_obc.get() != 0) {
+				_navigation_mode = &_dataLinkLoss;
+			} else {
 				_navigation_mode = &_rtl;
-				break;
-			case vehicle_status_s::NAVIGATION_STATE_AUTO_RTGS:
-				/* Use complex data link loss mode only when enabled via param
-				* otherwise use rtl */
-				_pos_sp_triplet_published_invalid_once = false;
-				if (_param_datalinkloss_obc.get() != 0) {
-					_navigation_mode = &_dataLinkLoss;
-				} else {
-					_navigation_mode = &_rtl;
-				}
-				break;
-			case vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL:
-				_pos_sp_triplet_published_invalid_once = false;
-				_navigation_mode = &_engineFailure;
-				break;
-			case vehicle_status_s::NAVIGATION_STATE_AUTO_LANDGPSFAIL:
-				_pos_sp_triplet_published_invalid_once = false;
-				_navigation_mode = &_gpsFailure;
-				break;
-			default:
-				_navigation_mode = nullptr;
-				_can_loiter_at_sp = false;
-				break;
-		}
-
-		/* iterate through navigation modes and set active/inactive for each */
-		for(unsigned int i = 0; i < NAVIGATOR_MODE_ARRAY_SIZE; i++) {
-			_navigation_mode_array[i]->run(_navigation_mode == _navigation_mode_array[i]);
-		}
+			}
+			break;
+		case vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL:
+			_pos_sp_triplet_published_invalid_once = false;
+			_navigation_mode = &_engineFailure;
+			break;
+		case vehicle_status_s::NAVIGATION_STATE_AUTO_LANDGPSFAIL:
+			_pos_sp_triplet_published_invalid_once = false;
+			_navigation_mode = &_gpsFailure;
+			break;
+		default:
+			_navigation_mode = nullptr;
+			_can_loiter_at_sp = false;
+			break;
+	}
 
-		/* if nothing is running, set position setpoint triplet invalid once */
-		if (_navigation_mode == nullptr && !_pos_sp_triplet_published_invalid_once) {
-			_pos_sp_triplet_published_invalid_once = true;
-			_pos_sp_triplet.previous.valid = false;
-			_pos_sp_triplet.current.valid = false;
-			_pos_sp_triplet.next.valid = false;
-			_pos_sp_triplet_updated = true;
-		}
+	/* iterate through navigation modes and set active/inactive for each */
+	for(unsigned int i = 0; i < NAVIGATOR_MODE_ARRAY_SIZE; i++) {
+		_navigation_mode_array[i]->run(_navigation_mode == _navigation_mode_array[i], updated_topics);
+	}
 
-		if (_pos_sp_triplet_updated) {
-			publish_position_setpoint_triplet();
-			_pos_sp_triplet_updated = false;
-		}
+	/* if nothing is running, set position setpoint triplet invalid once */
+	if (_navigation_mode == nullptr && !_pos_sp_triplet_published_invalid_once) {
+		_pos_sp_triplet_published_invalid_once = true;
+		_pos_sp_triplet.previous.valid = false;
+		_pos_sp_triplet.current.valid = false;
+		_pos_sp_triplet.next.valid = false;
+		_pos_sp_triplet_updated = true;
+	}
 
-		if (_mission_result_updated) {
-			publish_mission_result();
-			_mission_result_updated = false;
-		}
+	if (_pos_sp_triplet_updated) {
+		publish_position_setpoint_triplet();
+		_pos_sp_triplet_updated = false;
+	}
 
-		perf_end(_loop_perf);
+	if (_mission_result_updated) {
+		publish_mission_result();
+		_mission_result_updated = false;
 	}
-	warnx("exiting.");
 
-	_navigator_task = -1;
-	return;
+	perf_end(_loop_perf);
 }
 
 int
@@ -525,6 +595,41 @@ Navigator::start()
 {
 	ASSERT(_navigator_task == -1);
 
+#ifdef __PX4_POSIX
+	/* run on the low priority work queue whenever one of our inputs changes,
+	 * position and sensors rate limited to 50 Hz like the task subscriptions */
+	static const struct {
+		const struct orb_metadata *meta;
+		unsigned interval_ms;
+	} triggers[] = {
+		{ ORB_ID(vehicle_global_position), 20 },
+		{ ORB_ID(home_position), 0 },
+		{ ORB_ID(navigation_capabilities), 0 },
+		{ ORB_ID(vehicle_status), 0 },
+		{ ORB_ID(vehicle_control_mode), 0 },
+		{ ORB_ID(parameter_update), 0 },
+		{ ORB_ID(sensor_combined), 20 },
+		{ ORB_ID(vehicle_gps_position), 0 },
+		{ ORB_ID(onboard_mission), 0 },
+		{ ORB_ID(offboard_mission), 0 },
+	};
+
+	for (unsigned i = 0; i < sizeof(triggers) / sizeof(triggers[0]); i++) {
+		int ret = ScheduleOnTopic(triggers[i].meta, 0, triggers[i].interval_ms);
+
+		if (ret != OK) {
+			warnx("trigger on %s failed", triggers[i].meta->o_name);
+			ScheduleClear();
+			return ret;
+		}
+	}
+
+	/* subscribe and load the geofence right away */
+	ScheduleNow();
+
+	return OK;
+#else
+
 	/* start the task */
 	_navigator_task = px4_task_spawn_cmd("navigator",
 					 SCHED_DEFAULT,
@@ -539,6 +644,7 @@ Navigator::start()
 	}
 
 	return OK;
+#endif
 }
 
 void
@@ -557,7 +663,8 @@ Navigator::status()
 	// }
 
 	if (_geofence.valid()) {
-		warnx("Geofence is valid");
+		warnx("Geofence is valid, %.1f m to the fence edge",
+		      (double)_geofence.distance_to_polygon(_global_pos.lat, _global_pos.lon));
 		/* TODO: needed? */
 //		warnx("Vertex longitude latitude");
 //		for (unsigned i = 0; i < _fence.count; i++)
@@ -566,6 +673,10 @@ Navigator::status()
 	} else {
 		warnx("Geofence not set (no /etc/geofence.txt on microsd) or not valid");
 	}
+
+#ifdef __PX4_POSIX
+	print_status();
+#endif
 }
 
 void
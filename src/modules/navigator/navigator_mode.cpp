@@ -39,14 +39,20 @@
  * @author Anton Babushkin <anton.babushkin@me.com>
  */
 
+#include <stdio.h>
+
 #include "navigator_mode.h"
 #include "navigator.h"
 
 NavigatorMode::NavigatorMode(Navigator *navigator, const char *name) :
 	SuperBlock(navigator, name),
 	_navigator(navigator),
-	_first_run(true)
+	_first_run(true),
+	_run_perf(nullptr)
 {
+	snprintf(_perf_name, sizeof(_perf_name), "navigator %s", name);
+	_run_perf = perf_alloc(PC_ELAPSED, _perf_name);
+
 	/* load initial params */
 	updateParams();
 	/* set initial mission items */
@@ -55,11 +61,21 @@ NavigatorMode::NavigatorMode(Navigator *navigator, const char *name) :
 
 NavigatorMode::~NavigatorMode()
 {
+	perf_free(_run_perf);
 }
 
 void
-NavigatorMode::run(bool active)
+NavigatorMode::run(bool active, unsigned updated)
 {
+	/* activation and deactivation always run, otherwise only re-plan on relevant inputs */
+	bool switching = (active == _first_run);
+
+	if (!switching && !(updated & get_update_topics())) {
+		return;
+	}
+
+	perf_begin(_run_perf);
+
 	if (active) {
 		if (_first_run) {
 			/* first run */
@@ -79,6 +95,8 @@ NavigatorMode::run(bool active)
 		_first_run = true;
 		on_inactive();
 	}
+
+	perf_end(_run_perf);
 }
 
 void
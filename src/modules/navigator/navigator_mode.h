@@ -43,6 +43,7 @@
 #define NAVIGATOR_MODE_H
 
 #include <drivers/drv_hrt.h>
+#include <systemlib/perf_counter.h>
 
 #include <controllib/blocks.hpp>
 #include <controllib/block/BlockParam.hpp>
@@ -53,6 +54,22 @@
 
 class Navigator;
 
+/**
+ * Navigator inputs a mode can depend on, one bit per subscription
+ */
+enum navigator_topic {
+	NAV_TOPIC_GLOBAL_POS = (1 << 0),	/**< vehicle_global_position */
+	NAV_TOPIC_GPS_POS = (1 << 1),		/**< vehicle_gps_position */
+	NAV_TOPIC_SENSOR_COMBINED = (1 << 2),	/**< sensor_combined, also the 50 Hz clock when position is lost */
+	NAV_TOPIC_HOME_POS = (1 << 3),		/**< home_position */
+	NAV_TOPIC_VSTATUS = (1 << 4),		/**< vehicle_status */
+	NAV_TOPIC_CONTROL_MODE = (1 << 5),	/**< vehicle_control_mode */
+	NAV_TOPIC_CAPABILITIES = (1 << 6),	/**< navigation_capabilities */
+	NAV_TOPIC_PARAMS = (1 << 7),		/**< parameter_update */
+	NAV_TOPIC_MISSION = (1 << 8),		/**< onboard_mission or offboard_mission */
+	NAV_TOPIC_ALL = 0xffff
+};
+
 class NavigatorMode : public control::SuperBlock
 {
 public:
@@ -66,7 +83,20 @@ public:
 	 */
 	virtual ~NavigatorMode();
 
-	void run(bool active);
+	/**
+	 * Activate, deactivate or update the mode. While the mode keeps its state
+	 * the handlers only run if one of the topics in get_update_topics() changed.
+	 *
+	 * @param active	true if this is the mode selected by the navigation state
+	 * @param updated	navigator_topic bits of the inputs updated in this cycle
+	 */
+	void run(bool active, unsigned updated);
+
+	/**
+	 * The inputs this mode plans with, a mask of navigator_topic bits.
+	 * Modes which are purely time driven should return NAV_TOPIC_ALL.
+	 */
+	virtual unsigned get_update_topics() { return NAV_TOPIC_ALL; }
 
 	/**
 	 * This function is called while the mode is inactive
@@ -89,6 +119,9 @@ protected:
 private:
 	bool _first_run;
 
+	char _perf_name[24];		/**< storage for the perf counter name */
+	perf_counter_t _run_perf;	/**< time spent in the mode handlers */
+
 	/* this class has ptr data members, so it should not be copied,
 	 * consequently the copy constructors are private.
 	 */
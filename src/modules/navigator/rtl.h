@@ -66,6 +66,8 @@ public:
 
 	virtual void on_active();
 
+	virtual unsigned get_update_topics() { return NAV_TOPIC_GLOBAL_POS | NAV_TOPIC_HOME_POS | NAV_TOPIC_VSTATUS; }
+
 private:
 	/**
 	 * Set the RTL item
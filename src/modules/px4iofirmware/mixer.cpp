@@ -44,6 +44,7 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <drivers/drv_pwm_output.h>
@@ -421,6 +422,55 @@ mixer_callback(uintptr_t handle,
 static char mixer_text[256];		/* large enough for one mixer */
 static unsigned mixer_text_length = 0;
 
+static uint8_t *mixer_binary = nullptr;	/* the whole binary definition */
+static unsigned mixer_binary_length = 0;
+static unsigned mixer_binary_received = 0;
+
+static void
+mixer_binary_discard()
+{
+	if (mixer_binary != nullptr) {
+		free(mixer_binary);
+	}
+
+	mixer_binary = nullptr;
+	mixer_binary_length = 0;
+	mixer_binary_received = 0;
+}
+
+static int
+mixer_binary_append(const uint8_t *data, unsigned length)
+{
+	/* no reset announced the definition, or its buffer could not be allocated */
+	if (mixer_binary == nullptr) {
+		return 1;
+	}
+
+	/* the last chunk may carry a pad byte */
+	if (length > mixer_binary_length - mixer_binary_received) {
+		length = mixer_binary_length - mixer_binary_received;
+	}
+
+	memcpy(&mixer_binary[mixer_binary_received], data, length);
+	mixer_binary_received += length;
+
+	if (mixer_binary_received < mixer_binary_length) {
+		return 0;
+	}
+
+	isr_debug(2, "binary %u", mixer_binary_length);
+
+	if (mixer_group.load_from_binary(mixer_binary, mixer_binary_length) == 0) {
+		r_status_flags |= PX4IO_P_STATUS_FLAGS_MIXER_OK;
+
+		/* update failsafe values */
+		mixer_set_failsafe();
+	}
+
+	mixer_binary_discard();
+	return 0;
+}
+
 int
 mixer_handle_text(const void *buffer, size_t length)
 {
@@ -449,12 +499,45 @@ mixer_handle_text(const void *buffer, size_t length)
 	unsigned text_length = length - sizeof(px4io_mixdata);
 
 	switch (msg->action) {
+	case F2I_MIXER_ACTION_BINARY_RESET:
+		isr_debug(2, "binary reset");
+
+		mixer_group.reset();
+		mixer_text_length = 0;
+		mixer_binary_discard();
+
+		if (text_length < 2) {
+			return 1;
+		}
+
+		mixer_binary_length = (uint8_t)msg->text[0] | ((uint8_t)msg->text[1] << 8);
+
+		/* refuse what does not fit, MIXER_OK stays clear */
+		if (mixer_binary_length == 0 || mixer_binary_length > PX4IO_MIXER_BINARY_MAX) {
+			mixer_binary_length = 0;
+			return 1;
+		}
+
+		mixer_binary = (uint8_t *)malloc(mixer_binary_length);
+
+		if (mixer_binary == nullptr) {
+			isr_debug(1, "binary alloc %u failed", mixer_binary_length);
+			mixer_binary_length = 0;
+			return 1;
+		}
+
+		return mixer_binary_append((const uint8_t *)&msg->text[2], text_length - 2);
+
+	case F2I_MIXER_ACTION_BINARY_APPEND:
+		return mixer_binary_append((const uint8_t *)&msg->text[0], text_length);
+
 	case F2I_MIXER_ACTION_RESET:
 		isr_debug(2, "reset");
 
 		/* THEN actually delete it */
 		mixer_group.reset();
 		mixer_text_length = 0;
+		mixer_binary_discard();
 
 	/* FALLTHROUGH */
 	case F2I_MIXER_ACTION_APPEND:
@@ -483,6 +566,13 @@ mixer_handle_text(const void *buffer, size_t length)
 			if (resid == 0) {
 				r_status_flags |= PX4IO_P_STATUS_FLAGS_MIXER_OK;
 
+				/*
+				 * Fold the linear mixers into the mixing matrix only once the
+				 * text is used up, not for every chunk. A chunk ending exactly
+				 * on a mixer boundary compiles early, the next add drops it.
+				 */
+				mixer_group.compile();
+
 			} else {
 				/* not yet reached the end of the mixer, set as not ok */
 				r_status_flags &= ~PX4IO_P_STATUS_FLAGS_MIXER_OK;
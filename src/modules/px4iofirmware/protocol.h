@@ -77,7 +77,7 @@
 #define REG_TO_FLOAT(_reg)	((float)REG_TO_SIGNED(_reg) / 10000.0f)
 #define FLOAT_TO_REG(_float)	SIGNED_TO_REG((int16_t)((_float) * 10000.0f))
 
-#define PX4IO_PROTOCOL_VERSION		4
+#define PX4IO_PROTOCOL_VERSION		5
 
 /* maximum allowable sizes on this protocol version */
 #define PX4IO_PROTOCOL_MAX_CONTROL_COUNT	8	/**< The protocol does not support more than set here, individual units might support less - see PX4IO_P_CONFIG_CONTROL_COUNT */
@@ -296,7 +296,16 @@ enum {							/* DSM bind states */
  *
  * This message adds text to the mixer text buffer; the text
  * buffer is drained as the definitions are consumed.
+ *
+ * Binary mixer definitions (see MixerGroup::load_from_binary()) are
+ * loaded as a whole: the BINARY_RESET message starts with the uint16
+ * length of the definition, and the mixers are loaded once that many
+ * bytes have been received. IO buffers the whole definition next to the
+ * mixers built from it, so it accepts at most PX4IO_MIXER_BINARY_MAX bytes
+ * and rejects the write if it cannot allocate the buffer.
  */
+#define PX4IO_MIXER_BINARY_MAX		512
+
 #pragma pack(push, 1)
 struct px4io_mixdata {
 	uint16_t	f2i_mixer_magic;
@@ -305,6 +314,8 @@ struct px4io_mixdata {
 	uint8_t		action;
 #define F2I_MIXER_ACTION_RESET			0
 #define F2I_MIXER_ACTION_APPEND			1
+#define F2I_MIXER_ACTION_BINARY_RESET		2
+#define F2I_MIXER_ACTION_BINARY_APPEND		3
 
 	char		text[0];	/* actual text size may vary */
 };
@@ -314,7 +325,7 @@ struct px4io_mixdata {
  * Serial protocol encapsulation.
  */
 
-#define PKT_MAX_REGS	32 // by agreement w/FMU
+#define PKT_MAX_REGS	48 // by agreement w/FMU, large enough for a full batched update
 
 #pragma pack(push, 1)
 struct IOPacket {
@@ -328,6 +339,7 @@ struct IOPacket {
 
 #define PKT_CODE_READ		0x00	/* FMU->IO read transaction */
 #define PKT_CODE_WRITE		0x40	/* FMU->IO write transaction */
+#define PKT_CODE_BATCH		0x80	/* FMU->IO batched transaction */
 #define PKT_CODE_SUCCESS	0x00	/* IO->FMU success reply */
 #define PKT_CODE_CORRUPT	0x40	/* IO->FMU bad packet reply */
 #define PKT_CODE_ERROR		0x80	/* IO->FMU register op error reply */
@@ -335,6 +347,25 @@ struct IOPacket {
 #define PKT_CODE_MASK		0xc0
 #define PKT_COUNT_MASK		0x3f
 
+/*
+ * Batched transactions.
+ *
+ * The registers of a PKT_CODE_BATCH packet hold a list of operations,
+ * page and offset of the packet header are unused. Each operation starts
+ * with its address and a count, writes are followed by count values:
+ *
+ *   PX4IO_BATCH_ADDRESS(page, offset), PX4IO_BATCH_WRITE | count, values...
+ *   PX4IO_BATCH_ADDRESS(page, offset), PX4IO_BATCH_READ | count
+ *
+ * IO executes the operations in order and replies with the values of all
+ * reads back to back. If any operation fails the reply is PKT_CODE_ERROR,
+ * writes preceding the failed operation have been applied.
+ */
+#define PX4IO_BATCH_ADDRESS(_page, _offset)	((uint16_t)(((_page) << 8) | (_offset)))
+#define PX4IO_BATCH_READ	0x0000
+#define PX4IO_BATCH_WRITE	0x8000
+#define PX4IO_BATCH_COUNT_MASK	0x00ff
+
 #define PKT_COUNT(_p)	((_p).count_code & PKT_COUNT_MASK)
 #define PKT_CODE(_p)	((_p).count_code & PKT_CODE_MASK)
 #define PKT_SIZE(_p)	((size_t)((uint8_t *)&((_p).regs[PKT_COUNT(_p)]) - ((uint8_t *)&(_p))))
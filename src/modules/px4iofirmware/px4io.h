@@ -208,6 +208,7 @@ extern void	interface_tick(void);
  */
 extern int	registers_set(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values);
 extern int	registers_get(uint8_t page, uint8_t offset, uint16_t **values, unsigned *num_values);
+extern int	registers_batch(const uint16_t *request, unsigned request_count, uint16_t *reply, unsigned max_reply);
 
 /**
  * Sensors/misc inputs
@@ -46,7 +46,6 @@
 #include <drivers/drv_hrt.h>
 #include <drivers/drv_pwm_output.h>
 #include <systemlib/systemlib.h>
-#include <stm32_pwr.h>
 
 #include "px4io.h"
 #include "protocol.h"
@@ -990,6 +989,62 @@ registers_get(uint8_t page, uint8_t offset, uint16_t **values, unsigned *num_val
 	return 0;
 }
 
+/**
+ * Execute the operations of a batched transaction.
+ *
+ * @param request		Operation list, see PKT_CODE_BATCH.
+ * @param request_count		Number of registers in the operation list.
+ * @param reply			Buffer for the values read, must not overlap
+ *				the request.
+ * @param max_reply		Size of the reply buffer in registers.
+ * @return			Number of values read, or -1 if an operation
+ *				failed or the list is malformed.
+ */
+int
+registers_batch(const uint16_t *request, unsigned request_count, uint16_t *reply, unsigned max_reply)
+{
+	unsigned reply_count = 0;
+
+	while (request_count >= 2) {
+		uint8_t page = request[0] >> 8;
+		uint8_t offset = request[0] & 0xff;
+		unsigned count = request[1] & PX4IO_BATCH_COUNT_MASK;
+		bool write = (request[1] & PX4IO_BATCH_WRITE) != 0;
+
+		request += 2;
+		request_count -= 2;
+
+		if (write) {
+			if ((count > request_count) || registers_set(page, offset, request, count)) {
+				return -1;
+			}
+
+			request += count;
+			request_count -= count;
+
+		} else {
+			uint16_t *values;
+			unsigned num_values;
+
+			if ((count > max_reply - reply_count) ||
+			    (registers_get(page, offset, &values, &num_values) < 0) ||
+			    (num_values < count)) {
+				return -1;
+			}
+
+			memcpy(&reply[reply_count], values, count * sizeof(uint16_t));
+			reply_count += count;
+		}
+	}
+
+	/* a trailing partial operation header means the list is broken */
+	if (request_count != 0) {
+		return -1;
+	}
+
+	return reply_count;
+}
+
 /*
  * Helper function to handle changes to the PWM rate control registers.
  */
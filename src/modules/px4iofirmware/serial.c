@@ -43,6 +43,7 @@
 #include <fcntl.h>
 #include <string.h>
 
+#ifndef PX4IO_SERIAL_UNIT_TEST
 #include <nuttx/arch.h>
 #include <arch/board/board.h>
 
@@ -51,6 +52,7 @@
 #include <up_internal.h>
 #include <up_arch.h>
 #include <stm32.h>
+#endif
 #include <systemlib/perf_counter.h>
 
 //#define DEBUG
@@ -67,15 +69,21 @@ static perf_counter_t	pc_regerr;
 static perf_counter_t	pc_crcerr;
 
 static void		rx_handle_packet(void);
+#ifndef PX4IO_SERIAL_UNIT_TEST
 static void		rx_dma_callback(DMA_HANDLE handle, uint8_t status, void *arg);
 static DMA_HANDLE	tx_dma;
 static DMA_HANDLE	rx_dma;
 
 static int		serial_interrupt(int irq, void *context);
 static void		dma_reset(void);
+#endif
 
 static struct IOPacket	dma_packet;
 
+/* operation list of a batched transaction, the reply is built in dma_packet */
+static uint16_t		batch_request[PKT_MAX_REGS];
+
+#ifndef PX4IO_SERIAL_UNIT_TEST
 /* serial register accessors */
 #define REG(_x)		(*(volatile uint32_t *)(PX4FMU_SERIAL_BASE + _x))
 #define rSR		REG(STM32_USART_SR_OFFSET)
@@ -151,6 +159,7 @@ interface_init(void)
 
 	debug("serial init");
 }
+#endif
 
 static void
 rx_handle_packet(void)
@@ -212,12 +221,52 @@ rx_handle_packet(void)
 		return;
 	}
 
+	if (PKT_CODE(dma_packet) == PKT_CODE_BATCH) {
+
+		/* reads are copied into the packet while the operations are parsed */
+		unsigned count = PKT_COUNT(dma_packet);
+		int ret = -1;
+
+		if (count <= PKT_MAX_REGS) {
+			memcpy(batch_request, (void *)&dma_packet.regs[0], count * 2);
+			ret = registers_batch(batch_request, count, &dma_packet.regs[0], PKT_MAX_REGS);
+		}
+
+		if (ret < 0) {
+			perf_count(pc_regerr);
+			dma_packet.count_code = PKT_CODE_ERROR;
+
+		} else {
+			dma_packet.count_code = ret | PKT_CODE_SUCCESS;
+		}
+
+		return;
+	}
+
 	/* send a bad-packet error reply */
 	dma_packet.count_code = PKT_CODE_CORRUPT;
 	dma_packet.page = 0xff;
 	dma_packet.offset = 0xfe;
 }
 
+#ifdef PX4IO_SERIAL_UNIT_TEST
+/**
+ * Handle a request the way rx_dma_callback() does and leave the reply,
+ * CRC included, in its place.
+ */
+void
+serial_unittest_transfer(struct IOPacket *pkt)
+{
+	memcpy(&dma_packet, pkt, sizeof(dma_packet));
+
+	rx_handle_packet();
+
+	dma_packet.crc = 0;
+	dma_packet.crc = crc_packet(&dma_packet);
+	memcpy(pkt, &dma_packet, sizeof(dma_packet));
+}
+
+#else
 static void
 rx_dma_callback(DMA_HANDLE handle, uint8_t status, void *arg)
 {
@@ -355,4 +404,4 @@ dma_reset(void)
 	stm32_dmastart(rx_dma, rx_dma_callback, NULL, false);
 	rCR3 |= USART_CR3_DMAR;
 }
-
+#endif
@@ -0,0 +1,522 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file replay.c
+ *
+ * Log replay: reads a log recorded with sdlog2 and republishes the
+ * recorded topics in timestamp order. By default the virtual HRT clock
+ * is driven with the recorded timestamps, so a replay only depends on
+ * the log and not on the speed of the machine.
+ *
+ * Only topics whose field layout in the log matches the layout of this
+ * build are published, so replaying an old log with changed msg files
+ * can't feed garbage into the estimators.
+ *
+ * The virtual clock can't go backwards, so if the system has been up
+ * longer than the log start, all samples are shifted by the difference:
+ * the clock and every uint64 field whose name contains "timestamp".
+ */
+
+#include <px4_config.h>
+#include <px4_defines.h>
+#include <px4_getopt.h>
+#include <px4_posix.h>
+#include <px4_tasks.h>
+#include <px4_time.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <systemlib/err.h>
+#include <drivers/drv_hrt.h>
+
+#include <uORB/uORB.h>
+#include <uORB/topics/sensor_combined.h>
+
+#include "replay_reader.h"
+
+/* maximum number of topic instances published */
+#define MAX_PUBLICATIONS 32
+
+/* maximum number of timestamp fields shifted per topic, arrays count once */
+#define MAX_TIMESTAMP_FIELDS 8
+
+/* time to wait for the output topic after each sensor_combined publication */
+#define WAIT_TIMEOUT_MS 100
+
+/* topics published by default, the inputs of the estimators */
+static const char *default_topics = "sensor_combined,vehicle_gps_position,airspeed,differential_pressure,"
+				    "distance_sensor,optical_flow,vision_position_estimate,att_pos_mocap";
+
+struct replay_publication_s {
+	const struct orb_metadata *meta;
+	uint8_t instance;
+	orb_advert_t pub;
+	uint8_t *shifted;		/**< sample with the timestamps shifted, NULL if not needed */
+	unsigned timestamps_count;
+	struct {
+		uint16_t offset;
+		uint16_t count;
+	} timestamps[MAX_TIMESTAMP_FIELDS];
+};
+
+static volatile bool thread_should_exit = false;
+static volatile bool thread_running = false;
+static int replay_task = -1;
+
+/* options */
+static char log_path[128];
+static char topic_list[256];
+static char wait_topic[64];
+static float speed = 0.0f;
+static bool apply_params = false;
+static bool virtual_time = true;
+
+/* statistics */
+static unsigned long msgs_published = 0;
+static unsigned long msgs_skipped = 0;
+static hrt_abstime replay_start_time = 0;
+static hrt_abstime replay_time = 0;
+static hrt_abstime time_offset = 0;
+
+static struct replay_publication_s publications[MAX_PUBLICATIONS];
+static unsigned publications_count = 0;
+static const struct orb_metadata *wait_meta = NULL;
+static void *wait_buf = NULL;
+
+__EXPORT int replay_main(int argc, char *argv[]);
+
+int replay_thread_main(int argc, char *argv[]);
+
+static void replay_usage(const char *reason);
+
+static const struct orb_metadata *find_topic(const char *name);
+
+/**
+ * Publish a sample, advancing the virtual clock to its timestamp.
+ */
+static void publish_record(const struct replay_record_s *record, int wait_sub);
+
+/**
+ * Find the timestamp fields of a topic, to shift them by time_offset.
+ */
+static void find_timestamps(struct replay_publication_s *publication);
+
+/**
+ * Shift the timestamps of a sample by time_offset.
+ *
+ * @return		The shifted sample, or the sample itself if it needs no shift
+ */
+static const void *shift_timestamps(struct replay_publication_s *publication, const struct replay_record_s *record);
+
+/**
+ * Real time, used to pace the replay independently of the virtual HRT.
+ */
+static hrt_abstime real_time(void);
+
+static void
+replay_usage(const char *reason)
+{
+	if (reason) {
+		fprintf(stderr, "%s\n", reason);
+	}
+
+	warnx("usage: replay {start|stop|status} -f <log file> [-t <topics>] [-s <speed>] [-w <topic>] [-p] [-r]\n"
+	      "\t-f\tLog recorded with sdlog2, with or without -g\n"
+	      "\t-t\tComma separated topics to publish, default are the sensor topics\n"
+	      "\t-s\tSpeed relative to real time, 0 (default) replays as fast as possible\n"
+	      "\t-w\tAfter each sensor_combined wait for this topic to be published\n"
+	      "\t-p\tApply the parameters recorded in the log\n"
+	      "\t-r\tKeep the real time HRT clock instead of the virtual log time");
+}
+
+int replay_main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		replay_usage("missing command");
+		return 1;
+	}
+
+	if (!strcmp(argv[1], "start")) {
+
+		if (thread_running) {
+			warnx("already running");
+			return 0;
+		}
+
+		thread_should_exit = false;
+		replay_task = px4_task_spawn_cmd("replay",
+						 SCHED_DEFAULT,
+						 SCHED_PRIORITY_DEFAULT,
+						 2000,
+						 replay_thread_main,
+						 (char * const *)argv);
+		return 0;
+	}
+
+	if (!strcmp(argv[1], "stop")) {
+		if (!thread_running) {
+			warnx("not started");
+		}
+
+		thread_should_exit = true;
+		return 0;
+	}
+
+	if (!strcmp(argv[1], "status")) {
+		if (thread_running) {
+			warnx("replaying %s", log_path);
+			warnx("published %lu msgs, skipped %lu msgs", msgs_published, msgs_skipped);
+			warnx("%s time", virtual_time ? "virtual" : "real");
+			warnx("log time %.3f s", (double)(replay_time - replay_start_time) / 1e6);
+
+			if (time_offset > 0) {
+				warnx("timestamps shifted by %.3f s", (double)time_offset / 1e6);
+			}
+
+		} else {
+			warnx("not started");
+		}
+
+		return 0;
+	}
+
+	replay_usage("unrecognized command");
+	return 1;
+}
+
+const struct orb_metadata *find_topic(const char *name)
+{
+	size_t count;
+	const struct orb_metadata *const *metas = orb_get_topics(&count);
+
+	for (size_t i = 0; i < count; i++) {
+		if (strcmp(metas[i]->o_name, name) == 0) {
+			return metas[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void add_timestamp(void *arg, const char *type, size_t type_len, const char *name, size_t name_len,
+			  unsigned count, unsigned offset)
+{
+	struct replay_publication_s *publication = (struct replay_publication_s *)arg;
+	static const char timestamp[] = "timestamp";
+	const size_t len = sizeof(timestamp) - 1;
+
+	if (type_len != strlen("uint64_t") || strncmp(type, "uint64_t", type_len) != 0) {
+		return;
+	}
+
+	for (size_t i = 0; i + len <= name_len; i++) {
+		if (strncmp(name + i, timestamp, len) == 0) {
+			if (publication->timestamps_count < MAX_TIMESTAMP_FIELDS) {
+				publication->timestamps[publication->timestamps_count].offset = offset;
+				publication->timestamps[publication->timestamps_count].count = count;
+				publication->timestamps_count++;
+
+			} else {
+				warnx("%s: too many timestamps", publication->meta->o_name);
+			}
+
+			return;
+		}
+	}
+}
+
+void find_timestamps(struct replay_publication_s *publication)
+{
+	publication->timestamps_count = 0;
+	publication->shifted = NULL;
+
+	/* the reader only returns topics with a layout, o_fields is set */
+	if (time_offset == 0 || publication->meta->o_fields == NULL) {
+		return;
+	}
+
+	orb_fields_walk(publication->meta->o_fields, add_timestamp, publication);
+
+	if (publication->timestamps_count > 0) {
+		publication->shifted = (uint8_t *)malloc(publication->meta->o_size);
+
+		if (publication->shifted == NULL) {
+			warnx("%s: timestamps not shifted, out of memory", publication->meta->o_name);
+		}
+	}
+}
+
+const void *shift_timestamps(struct replay_publication_s *publication, const struct replay_record_s *record)
+{
+	if (publication->shifted == NULL) {
+		return record->data;
+	}
+
+	memcpy(publication->shifted, record->data, record->meta->o_size);
+
+	for (unsigned i = 0; i < publication->timestamps_count; i++) {
+		for (unsigned j = 0; j < publication->timestamps[i].count; j++) {
+			uint8_t *field = publication->shifted + publication->timestamps[i].offset + j * sizeof(uint64_t);
+			uint64_t t;
+			memcpy(&t, field, sizeof(t));
+
+			/* zero means not set, e.g. a sensor that isn't present */
+			if (t != 0) {
+				t += time_offset;
+				memcpy(field, &t, sizeof(t));
+			}
+		}
+	}
+
+	return publication->shifted;
+}
+
+hrt_abstime real_time(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts_to_abstime(&ts);
+}
+
+void publish_record(const struct replay_record_s *record, int wait_sub)
+{
+	if (replay_start_time == 0) {
+		hrt_abstime now = hrt_absolute_time();
+		time_offset = (virtual_time && now > record->timestamp) ? now - record->timestamp : 0;
+	}
+
+	if (record->timestamp + time_offset > replay_time) {
+		replay_time = record->timestamp + time_offset;
+	}
+
+	if (replay_start_time == 0) {
+		replay_start_time = replay_time;
+	}
+
+	if (virtual_time) {
+		hrt_set_virtual_time(replay_time);
+	}
+
+	struct replay_publication_s *publication = NULL;
+
+	for (unsigned i = 0; i < publications_count; i++) {
+		if (publications[i].meta == record->meta && publications[i].instance == record->instance) {
+			publication = &publications[i];
+			break;
+		}
+	}
+
+	if (publication == NULL) {
+		if (publications_count >= MAX_PUBLICATIONS) {
+			msgs_skipped++;
+			return;
+		}
+
+		publication = &publications[publications_count++];
+		publication->meta = record->meta;
+		publication->instance = record->instance;
+		find_timestamps(publication);
+
+		/* instances are numbered in the order they first appear in the replay */
+		int instance;
+		publication->pub = orb_advertise_multi(record->meta, shift_timestamps(publication, record), &instance,
+						       ORB_PRIO_DEFAULT);
+
+		if (publication->pub == NULL) {
+			warnx("%s: advertise failed", record->meta->o_name);
+		}
+
+	} else if (publication->pub != NULL) {
+		orb_publish(record->meta, publication->pub, shift_timestamps(publication, record));
+	}
+
+	if (publication->pub == NULL) {
+		msgs_skipped++;
+		return;
+	}
+
+	msgs_published++;
+
+	/* lockstep: let the estimator process the sample before publishing the next one */
+	if (wait_sub >= 0 && record->meta == ORB_ID(sensor_combined)) {
+		px4_pollfd_struct_t fds[1];
+		fds[0].fd = wait_sub;
+		fds[0].events = POLLIN;
+
+		if (px4_poll(fds, 1, WAIT_TIMEOUT_MS) > 0) {
+			orb_copy(wait_meta, wait_sub, wait_buf);
+		}
+	}
+}
+
+int replay_thread_main(int argc, char *argv[])
+{
+	/* work around some stupidity in task_create's argv handling */
+	argc -= 2;
+	argv += 2;
+
+	log_path[0] = '\0';
+	strncpy(topic_list, default_topics, sizeof(topic_list) - 1);
+	wait_topic[0] = '\0';
+	speed = 0.0f;
+	apply_params = false;
+	virtual_time = true;
+
+	int ch;
+	bool err_flag = false;
+	int myoptind = 1;
+	const char *myoptarg = NULL;
+
+	while ((ch = px4_getopt(argc, argv, "f:t:s:w:pr", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'f':
+			strncpy(log_path, myoptarg, sizeof(log_path) - 1);
+			break;
+
+		case 't':
+			strncpy(topic_list, myoptarg, sizeof(topic_list) - 1);
+			break;
+
+		case 's':
+			speed = strtof(myoptarg, NULL);
+			break;
+
+		case 'w':
+			strncpy(wait_topic, myoptarg, sizeof(wait_topic) - 1);
+			break;
+
+		case 'p':
+			apply_params = true;
+			break;
+
+		case 'r':
+			virtual_time = false;
+			break;
+
+		default:
+			err_flag = true;
+			break;
+		}
+	}
+
+	if (err_flag || log_path[0] == '\0') {
+		replay_usage(NULL);
+		return 1;
+	}
+
+	int wait_sub = -1;
+
+	if (wait_topic[0] != '\0') {
+		wait_meta = find_topic(wait_topic);
+		wait_buf = (wait_meta != NULL) ? malloc(wait_meta->o_size) : NULL;
+
+		if (wait_buf == NULL) {
+			warnx("unknown topic %s", wait_topic);
+			return 1;
+		}
+
+		wait_sub = orb_subscribe(wait_meta);
+	}
+
+	if (replay_reader_open(log_path, topic_list, apply_params) != 0) {
+		if (wait_sub >= 0) {
+			orb_unsubscribe(wait_sub);
+			free(wait_buf);
+			wait_buf = NULL;
+		}
+
+		return 1;
+	}
+
+	memset(publications, 0, sizeof(publications));
+	publications_count = 0;
+	msgs_published = 0;
+	msgs_skipped = 0;
+	replay_start_time = 0;
+	replay_time = 0;
+	time_offset = 0;
+
+	hrt_abstime real_start_time = real_time();
+	int ret = 0;
+
+	thread_running = true;
+
+	while (!thread_should_exit) {
+		const struct replay_record_s *record;
+		int res = replay_reader_next(&record);
+
+		if (res == 0) {
+			/* end of log */
+			break;
+		}
+
+		if (res < 0) {
+			ret = 1;
+			break;
+		}
+
+		publish_record(record, wait_sub);
+
+		/* pace the replay to the requested speed */
+		if (speed > 0.0f && replay_start_time > 0) {
+			hrt_abstime due = real_start_time + (hrt_abstime)((replay_time - replay_start_time) / speed);
+			hrt_abstime now = real_time();
+
+			if (due > now) {
+				usleep(due - now);
+			}
+		}
+	}
+
+	warnx("done, published %lu msgs, skipped %lu msgs, %.3f s of log",
+	      msgs_published, msgs_skipped, (double)(replay_time - replay_start_time) / 1e6);
+
+	if (wait_sub >= 0) {
+		orb_unsubscribe(wait_sub);
+		free(wait_buf);
+		wait_buf = NULL;
+	}
+
+	replay_reader_close();
+
+	for (unsigned i = 0; i < publications_count; i++) {
+		free(publications[i].shifted);
+	}
+
+	thread_running = false;
+
+	return ret;
+}
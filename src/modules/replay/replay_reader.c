@@ -0,0 +1,650 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file replay_reader.c
+ *
+ * Log reader of the replay, see replay_reader.h.
+ */
+
+#include <px4_config.h>
+#include <px4_defines.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <systemlib/err.h>
+#include <systemlib/param/param.h>
+
+#include <uORB/uORB.h>
+#include <uORB/topics/airspeed.h>
+#include <uORB/topics/sensor_combined.h>
+#include <uORB/topics/vehicle_gps_position.h>
+
+#include <modules/sdlog2/sdlog2_format.h>
+#include <modules/sdlog2/sdlog2_messages.h>
+
+#include "replay_reader.h"
+
+/* maximum number of topics described in a log, TOPF ids are 8 bit */
+#define MAX_TOPICS 256
+
+/* number of samples read ahead to sort them by timestamp */
+#define REORDER_WINDOW 64
+
+struct reader_topic_s {
+	const struct orb_metadata *meta;	/**< NULL if the topic isn't read */
+	uint8_t instance;
+	uint16_t size;
+	bool has_timestamp;			/**< struct starts with a uint64_t timestamp field */
+};
+
+/* default sdlog2 messages that are converted back to topics */
+enum {
+	CONVERT_NONE = 0,
+	CONVERT_IMU,
+	CONVERT_SENS,
+	CONVERT_GPS,
+	CONVERT_AIRS
+};
+
+static const struct {
+	const char *name;
+	uint8_t convert;
+	uint8_t index;		/**< sensor index in sensor_combined */
+	uint8_t length;
+} conversions[] = {
+	{"IMU", CONVERT_IMU, 0, LOG_PACKET_SIZE(IMU)},
+	{"IMU1", CONVERT_IMU, 1, LOG_PACKET_SIZE(IMU)},
+	{"IMU2", CONVERT_IMU, 2, LOG_PACKET_SIZE(IMU)},
+	{"SENS", CONVERT_SENS, 0, LOG_PACKET_SIZE(SENS)},
+	{"AIR1", CONVERT_SENS, 1, LOG_PACKET_SIZE(SENS)},
+	{"GPS", CONVERT_GPS, 0, LOG_PACKET_SIZE(GPS)},
+	{"AIRS", CONVERT_AIRS, 0, LOG_PACKET_SIZE(AIRS)}
+};
+
+static FILE *_log = NULL;
+static char _topic_list[256];
+static bool _apply_params = false;
+
+static struct reader_topic_s _topics[MAX_TOPICS];
+static uint8_t _msg_lengths[256];
+static uint8_t _msg_convert[256];
+static uint8_t _msg_index[256];
+
+/* time of the last logger wakeup, used for samples without timestamp */
+static hrt_abstime _log_time = 0;
+static unsigned long _seq = 0;
+static bool _eof = false;
+
+/* sensor_combined rebuilt from the IMU and SENS messages of a logger wakeup */
+static struct sensor_combined_s _sensors;
+static bool _sensors_updated = false;
+
+/* samples read ahead, a binary min-heap ordered by timestamp and log position */
+static struct replay_record_s *_pending[REORDER_WINDOW];
+static unsigned _pending_count = 0;
+static struct replay_record_s *_current = NULL;
+
+static uint8_t _buf[UINT16_MAX];
+
+/**
+ * Check if a topic is in the comma separated list of topics to read.
+ */
+static bool topic_selected(const char *name);
+
+static const struct orb_metadata *find_topic(const char *name);
+
+static bool read_bytes(void *buf, size_t len);
+
+/**
+ * Queue a sample, sorted into the read ahead samples.
+ */
+static int push_record(const struct orb_metadata *meta, uint8_t instance, hrt_abstime timestamp,
+		       const void *data);
+
+static bool record_before(const struct replay_record_s *a, const struct replay_record_s *b);
+
+/**
+ * Read the next message of the log.
+ *
+ * @return		0 on success, 1 at the end of the log, -1 if the log is corrupt
+ */
+static int read_message(void);
+
+static int handle_format(const struct log_format_s *fmt);
+
+/**
+ * Set up the reading of a topic described by a TOPF message.
+ */
+static int handle_topic_format(void);
+
+static int handle_topic_data(void);
+
+static void handle_parameter(const struct log_PARM_s *parm);
+
+static int handle_converted(uint8_t msg_type);
+
+/**
+ * Queue the sensor_combined rebuilt from the messages of the last logger wakeup.
+ */
+static int flush_sensors(void);
+
+bool topic_selected(const char *name)
+{
+	size_t len = strlen(name);
+	const char *p = _topic_list;
+
+	while (p != NULL && *p != '\0') {
+		if (strncmp(p, name, len) == 0 && (p[len] == ',' || p[len] == '\0')) {
+			return true;
+		}
+
+		p = strchr(p, ',');
+
+		if (p != NULL) {
+			p++;
+		}
+	}
+
+	return false;
+}
+
+const struct orb_metadata *find_topic(const char *name)
+{
+	size_t count;
+	const struct orb_metadata *const *metas = orb_get_topics(&count);
+
+	for (size_t i = 0; i < count; i++) {
+		if (strcmp(metas[i]->o_name, name) == 0) {
+			return metas[i];
+		}
+	}
+
+	return NULL;
+}
+
+bool read_bytes(void *buf, size_t len)
+{
+	return fread(buf, 1, len, _log) == len;
+}
+
+bool record_before(const struct replay_record_s *a, const struct replay_record_s *b)
+{
+	return a->timestamp < b->timestamp || (a->timestamp == b->timestamp && a->seq < b->seq);
+}
+
+int push_record(const struct orb_metadata *meta, uint8_t instance, hrt_abstime timestamp, const void *data)
+{
+	struct replay_record_s *record = (struct replay_record_s *)malloc(sizeof(struct replay_record_s) + meta->o_size);
+
+	if (record == NULL) {
+		warnx("alloc failed");
+		return -1;
+	}
+
+	record->meta = meta;
+	record->instance = instance;
+	record->timestamp = timestamp;
+	record->seq = _seq++;
+	memcpy(record->data, data, meta->o_size);
+
+	/* the caller only reads ahead while the heap isn't full */
+	unsigned i = _pending_count++;
+
+	while (i > 0 && record_before(record, _pending[(i - 1) / 2])) {
+		_pending[i] = _pending[(i - 1) / 2];
+		i = (i - 1) / 2;
+	}
+
+	_pending[i] = record;
+	return 0;
+}
+
+int handle_format(const struct log_format_s *fmt)
+{
+	_msg_lengths[fmt->type] = fmt->length;
+	_msg_convert[fmt->type] = CONVERT_NONE;
+
+	for (unsigned i = 0; i < sizeof(conversions) / sizeof(conversions[0]); i++) {
+		size_t len = strlen(conversions[i].name);
+
+		if (strncmp(fmt->name, conversions[i].name, sizeof(fmt->name)) != 0 ||
+		    (len < sizeof(fmt->name) && fmt->name[len] != '\0')) {
+			continue;
+		}
+
+		if (fmt->length != conversions[i].length) {
+			warnx("%s: message changed since the log was recorded, skipped", conversions[i].name);
+
+		} else {
+			_msg_convert[fmt->type] = conversions[i].convert;
+			_msg_index[fmt->type] = conversions[i].index;
+		}
+
+		break;
+	}
+
+	return 0;
+}
+
+int handle_topic_format(void)
+{
+	struct log_TOPF_s topf;
+
+	if (!read_bytes(&topf, sizeof(topf))) {
+		return -1;
+	}
+
+	/* topic name, NUL, field layout */
+	char *layout = (char *)malloc(topf.layout_len + 1);
+
+	if (layout == NULL || !read_bytes(layout, topf.layout_len)) {
+		free(layout);
+		return -1;
+	}
+
+	layout[topf.layout_len] = '\0';
+	const char *name = layout;
+	size_t name_len = strlen(name);
+	const char *fields = (name_len < topf.layout_len) ? name + name_len + 1 : "";
+
+	struct reader_topic_s *topic = &_topics[topf.id];
+	topic->meta = NULL;
+	topic->instance = topf.instance;
+	topic->size = topf.size;
+	topic->has_timestamp = (strncmp(fields, "uint64_t timestamp", 18) == 0);
+
+	if (topic_selected(name)) {
+		const struct orb_metadata *meta = find_topic(name);
+
+		if (meta == NULL) {
+			warnx("%s: unknown topic", name);
+
+		} else if (meta->o_size != topf.size || meta->o_fields == NULL || strcmp(meta->o_fields, fields) != 0) {
+			warnx("%s: layout changed since the log was recorded, skipped", name);
+
+		} else {
+			topic->meta = meta;
+		}
+	}
+
+	free(layout);
+	return 0;
+}
+
+int handle_topic_data(void)
+{
+	struct log_TOPD_s topd;
+
+	if (!read_bytes(&topd, sizeof(topd)) || !read_bytes(_buf, topd.data_len)) {
+		return -1;
+	}
+
+	struct reader_topic_s *topic = &_topics[topd.id];
+
+	/* topics that are not replayed are skipped by their length */
+	if (topic->meta == NULL || topd.data_len != topic->size) {
+		return 0;
+	}
+
+	hrt_abstime timestamp = 0;
+
+	if (topic->has_timestamp) {
+		memcpy(&timestamp, _buf, sizeof(timestamp));
+	}
+
+	/* topics without timestamp are published at the time of the logger wakeup */
+	if (timestamp == 0) {
+		timestamp = _log_time;
+	}
+
+	return push_record(topic->meta, topic->instance, timestamp, _buf);
+}
+
+void handle_parameter(const struct log_PARM_s *parm)
+{
+	char name[sizeof(parm->name) + 1];
+	memcpy(name, parm->name, sizeof(parm->name));
+	name[sizeof(parm->name)] = '\0';
+
+	param_t param = param_find(name);
+
+	if (param == PARAM_INVALID) {
+		return;
+	}
+
+	switch (param_type(param)) {
+	case PARAM_TYPE_INT32: {
+			int32_t i = parm->value;
+			param_set(param, &i);
+			break;
+		}
+
+	case PARAM_TYPE_FLOAT:
+		param_set(param, &parm->value);
+		break;
+
+	default:
+		break;
+	}
+}
+
+int flush_sensors(void)
+{
+	if (!_sensors_updated) {
+		return 0;
+	}
+
+	_sensors_updated = false;
+	return push_record(ORB_ID(sensor_combined), 0, _sensors.timestamp, &_sensors);
+}
+
+int handle_converted(uint8_t msg_type)
+{
+	unsigned i = _msg_index[msg_type];
+
+	switch (_msg_convert[msg_type]) {
+	case CONVERT_IMU: {
+			const struct log_IMU_s *imu = (const struct log_IMU_s *)_buf;
+
+			if (!topic_selected("sensor_combined")) {
+				return 0;
+			}
+
+			_sensors.timestamp = _log_time;
+			_sensors.gyro_timestamp[i] = _log_time;
+			_sensors.accelerometer_timestamp[i] = _log_time;
+			_sensors.magnetometer_timestamp[i] = _log_time;
+			_sensors.gyro_rad_s[i * 3 + 0] = imu->gyro_x;
+			_sensors.gyro_rad_s[i * 3 + 1] = imu->gyro_y;
+			_sensors.gyro_rad_s[i * 3 + 2] = imu->gyro_z;
+			_sensors.accelerometer_m_s2[i * 3 + 0] = imu->acc_x;
+			_sensors.accelerometer_m_s2[i * 3 + 1] = imu->acc_y;
+			_sensors.accelerometer_m_s2[i * 3 + 2] = imu->acc_z;
+			_sensors.magnetometer_ga[i * 3 + 0] = imu->mag_x;
+			_sensors.magnetometer_ga[i * 3 + 1] = imu->mag_y;
+			_sensors.magnetometer_ga[i * 3 + 2] = imu->mag_z;
+			_sensors.gyro_temp[i] = imu->temp_gyro;
+			_sensors.accelerometer_temp[i] = imu->temp_acc;
+			_sensors.magnetometer_temp[i] = imu->temp_mag;
+			_sensors_updated = true;
+			return 0;
+		}
+
+	case CONVERT_SENS: {
+			const struct log_SENS_s *sens = (const struct log_SENS_s *)_buf;
+
+			if (!topic_selected("sensor_combined")) {
+				return 0;
+			}
+
+			_sensors.timestamp = _log_time;
+			_sensors.baro_timestamp[i] = _log_time;
+			_sensors.differential_pressure_timestamp[i] = _log_time;
+			_sensors.baro_pres_mbar[i] = sens->baro_pres;
+			_sensors.baro_alt_meter[i] = sens->baro_alt;
+			_sensors.baro_temp_celcius[i] = sens->baro_temp;
+			_sensors.differential_pressure_pa[i] = sens->diff_pres;
+			_sensors.differential_pressure_filtered_pa[i] = sens->diff_pres_filtered;
+			_sensors_updated = true;
+			return 0;
+		}
+
+	case CONVERT_GPS: {
+			const struct log_GPS_s *gps = (const struct log_GPS_s *)_buf;
+			struct vehicle_gps_position_s pos;
+
+			if (!topic_selected("vehicle_gps_position")) {
+				return 0;
+			}
+
+			memset(&pos, 0, sizeof(pos));
+			pos.timestamp_position = _log_time;
+			pos.timestamp_velocity = _log_time;
+			pos.timestamp_time = _log_time;
+			pos.time_utc_usec = gps->gps_time;
+			pos.fix_type = gps->fix_type;
+			pos.eph = gps->eph;
+			pos.epv = gps->epv;
+			pos.lat = gps->lat;
+			pos.lon = gps->lon;
+			pos.alt = (int32_t)(gps->alt * 1000.0f);
+			pos.vel_n_m_s = gps->vel_n;
+			pos.vel_e_m_s = gps->vel_e;
+			pos.vel_d_m_s = gps->vel_d;
+			pos.vel_m_s = sqrtf(gps->vel_n * gps->vel_n + gps->vel_e * gps->vel_e);
+			pos.vel_ned_valid = true;
+			pos.cog_rad = gps->cog;
+			pos.satellites_used = gps->sats;
+			pos.noise_per_ms = gps->noise_per_ms;
+			pos.jamming_indicator = gps->jamming_indicator;
+			return push_record(ORB_ID(vehicle_gps_position), 0, _log_time, &pos);
+		}
+
+	case CONVERT_AIRS: {
+			const struct log_AIRS_s *airs = (const struct log_AIRS_s *)_buf;
+			struct airspeed_s airspeed;
+
+			if (!topic_selected("airspeed")) {
+				return 0;
+			}
+
+			memset(&airspeed, 0, sizeof(airspeed));
+			airspeed.timestamp = _log_time;
+			airspeed.indicated_airspeed_m_s = airs->indicated_airspeed;
+			airspeed.true_airspeed_m_s = airs->true_airspeed;
+			airspeed.true_airspeed_unfiltered_m_s = airs->true_airspeed;
+			airspeed.air_temperature_celsius = airs->air_temperature_celsius;
+			return push_record(ORB_ID(airspeed), 0, _log_time, &airspeed);
+		}
+
+	default:
+		return 0;
+	}
+}
+
+int read_message(void)
+{
+	uint8_t header[LOG_PACKET_HEADER_LEN];
+
+	if (!read_bytes(header, sizeof(header))) {
+		return 1;
+	}
+
+	if (header[0] != HEAD_BYTE1 || header[1] != HEAD_BYTE2) {
+		warnx("corrupt log at offset %ld", ftell(_log) - LOG_PACKET_HEADER_LEN);
+		return -1;
+	}
+
+	int res = 0;
+
+	switch (header[2]) {
+	case LOG_FORMAT_MSG: {
+			struct log_format_s fmt;
+			res = read_bytes(&fmt, sizeof(fmt)) ? handle_format(&fmt) : -1;
+			break;
+		}
+
+	case LOG_TIME_MSG: {
+			struct log_TIME_s time;
+			res = read_bytes(&time, sizeof(time)) ? 0 : -1;
+
+			if (res == 0) {
+				/* a new logger wakeup, the messages of the last one are complete */
+				res = flush_sensors();
+
+				if (time.t > _log_time) {
+					_log_time = time.t;
+				}
+			}
+
+			break;
+		}
+
+	case LOG_PARM_MSG: {
+			struct log_PARM_s parm;
+			res = read_bytes(&parm, sizeof(parm)) ? 0 : -1;
+
+			if (res == 0 && _apply_params) {
+				handle_parameter(&parm);
+			}
+
+			break;
+		}
+
+	case LOG_TOPF_MSG:
+		res = handle_topic_format();
+		break;
+
+	case LOG_TOPD_MSG:
+		res = handle_topic_data();
+		break;
+
+	default:
+		/* other messages are skipped using the length from their format */
+		if (_msg_lengths[header[2]] < LOG_PACKET_HEADER_LEN) {
+			warnx("unknown message %u", header[2]);
+			return -1;
+		}
+
+		res = read_bytes(_buf, _msg_lengths[header[2]] - LOG_PACKET_HEADER_LEN) ? handle_converted(header[2]) : -1;
+		break;
+	}
+
+	if (res != 0) {
+		warnx("truncated log at offset %ld", ftell(_log));
+		return -1;
+	}
+
+	return 0;
+}
+
+int replay_reader_open(const char *path, const char *topics, bool apply_params)
+{
+	replay_reader_close();
+
+	_log = fopen(path, "rb");
+
+	if (_log == NULL) {
+		warn("can't open %s", path);
+		return -1;
+	}
+
+	strncpy(_topic_list, topics, sizeof(_topic_list) - 1);
+	_topic_list[sizeof(_topic_list) - 1] = '\0';
+	_apply_params = apply_params;
+
+	memset(_topics, 0, sizeof(_topics));
+	memset(_msg_lengths, 0, sizeof(_msg_lengths));
+	memset(_msg_convert, 0, sizeof(_msg_convert));
+	_msg_lengths[LOG_FORMAT_MSG] = LOG_PACKET_HEADER_LEN + sizeof(struct log_format_s);
+
+	memset(&_sensors, 0, sizeof(_sensors));
+	_sensors_updated = false;
+	_log_time = 0;
+	_seq = 0;
+	_eof = false;
+
+	return 0;
+}
+
+int replay_reader_next(const struct replay_record_s **record)
+{
+	free(_current);
+	_current = NULL;
+
+	while (!_eof && _pending_count < REORDER_WINDOW) {
+		int res = read_message();
+
+		if (res < 0) {
+			return -1;
+		}
+
+		if (res > 0) {
+			_eof = true;
+
+			if (flush_sensors() != 0) {
+				return -1;
+			}
+		}
+	}
+
+	if (_pending_count == 0) {
+		return 0;
+	}
+
+	/* pop the earliest sample */
+	_current = _pending[0];
+	struct replay_record_s *last = _pending[--_pending_count];
+	unsigned i = 0;
+
+	for (;;) {
+		unsigned child = 2 * i + 1;
+
+		if (child >= _pending_count) {
+			break;
+		}
+
+		if (child + 1 < _pending_count && record_before(_pending[child + 1], _pending[child])) {
+			child++;
+		}
+
+		if (!record_before(_pending[child], last)) {
+			break;
+		}
+
+		_pending[i] = _pending[child];
+		i = child;
+	}
+
+	_pending[i] = last;
+
+	*record = _current;
+	return 1;
+}
+
+void replay_reader_close(void)
+{
+	if (_log != NULL) {
+		fclose(_log);
+		_log = NULL;
+	}
+
+	while (_pending_count > 0) {
+		free(_pending[--_pending_count]);
+	}
+
+	free(_current);
+	_current = NULL;
+}
@@ -0,0 +1,95 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file replay_reader.h
+ *
+ * Reads the topic samples recorded in a sdlog2 log in timestamp order.
+ */
+
+#ifndef REPLAY_READER_H_
+#define REPLAY_READER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <drivers/drv_hrt.h>
+#include <uORB/uORB.h>
+
+__BEGIN_DECLS
+
+/**
+ * A topic sample read from the log.
+ */
+struct replay_record_s {
+	const struct orb_metadata *meta;	/**< topic */
+	uint8_t instance;			/**< multi-instance of the topic when it was logged */
+	hrt_abstime timestamp;			/**< time of the sample */
+	unsigned long seq;			/**< position in the log, orders samples with the same time */
+	uint8_t data[];				/**< topic struct */
+};
+
+/**
+ * Open a log.
+ *
+ * Logs of the generic topic logging (sdlog2 -g) contain the topic structs.
+ * From logs with the default sdlog2 messages sensor_combined,
+ * vehicle_gps_position and airspeed are rebuilt from the IMU, SENS, GPS
+ * and AIRS messages, with the fields sdlog2 doesn't log left zero.
+ *
+ * @param path		Log file
+ * @param topics	Comma separated list of the topics to read
+ * @param apply_params	Apply the parameters recorded in the log while reading it
+ * @return		0 on success, -1 if the log can't be opened
+ */
+int replay_reader_open(const char *path, const char *topics, bool apply_params);
+
+/**
+ * Read the next sample.
+ *
+ * Samples are returned ordered by timestamp, and in log order if the
+ * timestamps are equal. The log is read ahead by a fixed number of
+ * samples to sort them, so the order only depends on the log contents.
+ *
+ * @param record	Set to the sample, valid until the next call
+ * @return		1 if a sample was read, 0 at the end of the log, -1 if the log is corrupt
+ */
+int replay_reader_next(const struct replay_record_s **record);
+
+/**
+ * Close the log.
+ */
+void replay_reader_close(void);
+
+__END_DECLS
+
+#endif
@@ -108,6 +108,7 @@
 #include <uORB/topics/vtol_vehicle_status.h>
 #include <uORB/topics/time_offset.h>
 #include <uORB/topics/mc_att_ctrl_status.h>
+#include <uORB/topics/cpuload.h>
 
 #include <systemlib/systemlib.h>
 #include <systemlib/param/param.h>
@@ -121,6 +122,7 @@
 #include "logbuffer.h"
 #include "sdlog2_format.h"
 #include "sdlog2_messages.h"
+#include "sdlog2_generic.h"
 
 #define PX4_EPOCH_SECS 1234567890L
 
@@ -144,6 +146,7 @@ static const int MIN_BYTES_TO_WRITE = 512;
 
 static bool _extended_logging = false;
 static bool _gpstime_only = false;
+static bool _generic_logging = false;
 
 #define MOUNTPOINT PX4_ROOTFSDIR"/fs/microsd"
 static const char *mountpoint = MOUNTPOINT;
@@ -272,13 +275,14 @@ sdlog2_usage(const char *reason)
 		fprintf(stderr, "%s\n", reason);
 	}
 
-	warnx("usage: sdlog2 {start|stop|status|on|off} [-r <log rate>] [-b <buffer size>] -e -a -t -x\n"
+	warnx("usage: sdlog2 {start|stop|status|on|off} [-r <log rate>] [-b <buffer size>] -e -a -t -x [-g <topics file>]\n"
 		 "\t-r\tLog rate in Hz, 0 means unlimited rate\n"
 		 "\t-b\tLog buffer size in KiB, default is 8\n"
 		 "\t-e\tEnable logging by default (if not, can be started by command)\n"
 		 "\t-a\tLog only when armed (can be still overriden by command)\n"
 		 "\t-t\tUse date/time for naming log directories and files\n"
-		 "\t-x\tExtended logging");
+		 "\t-x\tExtended logging\n"
+		 "\t-g\tLog the raw topics listed in the file instead of the default messages");
 }
 
 /**
@@ -570,6 +574,10 @@ static void *logwriter_thread(void *arg)
 
 	log_bytes_written += write_parameters(log_fd);
 
+	if (_generic_logging) {
+		log_bytes_written += sdlog2_generic_write_formats(log_fd);
+	}
+
 	fsync(log_fd);
 
 	int poll_count = 0;
@@ -903,7 +911,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 
 	int myoptind = 1;
 	const char *myoptarg = NULL;
-	while ((ch = px4_getopt(argc, argv, "r:b:eatx", &myoptind, &myoptarg)) != EOF) {
+	while ((ch = px4_getopt(argc, argv, "r:b:eatxg:", &myoptind, &myoptarg)) != EOF) {
 		switch (ch) {
 		case 'r': {
 				unsigned long r = strtoul(myoptarg, NULL, 10);
@@ -943,6 +951,15 @@ int sdlog2_thread_main(int argc, char *argv[])
 			_extended_logging = true;
 			break;
 
+		case 'g':
+			_generic_logging = (sdlog2_generic_load(myoptarg) > 0);
+
+			if (!_generic_logging) {
+				warnx("no topics to log in %s", myoptarg);
+			}
+
+			break;
+
 		case '?':
 			if (optopt == 'c') {
 				warnx("option -%c requires an argument", optopt);
@@ -1089,6 +1106,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		struct vtol_vehicle_status_s vtol_status;
 		struct time_offset_s time_offset;
 		struct mc_att_ctrl_status_s mc_att_ctrl_status;
+		struct cpuload_s cpuload;
 	} buf;
 
 	memset(&buf, 0, sizeof(buf));
@@ -1137,6 +1155,8 @@ int sdlog2_thread_main(int argc, char *argv[])
 			struct log_ENCD_s log_ENCD;
 			struct log_TSYN_s log_TSYN;
 			struct log_MACS_s log_MACS;
+			struct log_TLOD_s log_TLOD;
+			struct log_LAT_s log_LAT;
 		} body;
 	} log_msg = {
 		LOG_PACKET_HEADER_INIT(0)
@@ -1179,6 +1199,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 		int encoders_sub;
 		int tsync_sub;
 		int mc_att_ctrl_status_sub;
+		int cpuload_sub;
 	} subs;
 
 	subs.cmd_sub = -1;
@@ -1213,6 +1234,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 	subs.tsync_sub = -1;
 	subs.mc_att_ctrl_status_sub = -1;
 	subs.encoders_sub = -1;
+	subs.cpuload_sub = -1;
 
 	/* add new topics HERE */
 
@@ -1247,6 +1269,9 @@ int sdlog2_thread_main(int argc, char *argv[])
 	/* initialize calculated mean SNR */
 	float snr_mean = 0.0f;
 
+	/* sample age of the last attitude controls, logged with the outputs */
+	uint32_t control_latency = 0;
+
 	/* enable logging on start if needed */
 	if (log_on_start) {
 		/* check GPS topic to get GPS time */
@@ -1263,7 +1288,13 @@ int sdlog2_thread_main(int argc, char *argv[])
 	thread_running = true;
 
 	while (!main_thread_should_exit) {
-		usleep(sleep_delay);
+		if (_generic_logging && logging_enabled) {
+			/* wake up on topic updates, the rate is limited by the intervals in the topics file */
+			sdlog2_generic_wait(sleep_delay / 1000);
+
+		} else {
+			usleep(sleep_delay);
+		}
 
 		/* --- VEHICLE COMMAND - LOG MANAGEMENT --- */
 		if (copy_if_updated(ORB_ID(vehicle_command), &subs.cmd_sub, &buf.cmd)) {
@@ -1298,6 +1329,18 @@ int sdlog2_thread_main(int argc, char *argv[])
 		log_msg.body.log_TIME.t = hrt_absolute_time();
 		LOGBUFFER_WRITE_AND_COUNT(TIME);
 
+		/* --- GENERIC TOPICS, replacing the default messages --- */
+		if (_generic_logging) {
+			sdlog2_generic_write(&lb, &log_msgs_written, &log_msgs_skipped);
+
+			if (logbuffer_count(&lb) > MIN_BYTES_TO_WRITE) {
+				pthread_cond_signal(&logbuffer_cond);
+			}
+
+			pthread_mutex_unlock(&logbuffer_mutex);
+			continue;
+		}
+
 		/* --- VEHICLE STATUS --- */
 		if (status_updated) {
 			log_msg.msg_type = LOG_STAT_MSG;
@@ -1519,10 +1562,22 @@ int sdlog2_thread_main(int argc, char *argv[])
 			log_msg.msg_type = LOG_OUT0_MSG;
 			memcpy(log_msg.body.log_OUT0.output, buf.act_outputs.output, sizeof(log_msg.body.log_OUT0.output));
 			LOGBUFFER_WRITE_AND_COUNT(OUT0);
+
+			/* --- CONTROL LATENCY --- */
+			if (buf.act_outputs.timestamp_sample != 0) {
+				log_msg.msg_type = LOG_LAT_MSG;
+				log_msg.body.log_LAT.control_latency = control_latency;
+				log_msg.body.log_LAT.output_latency = buf.act_outputs.timestamp - buf.act_outputs.timestamp_sample;
+				LOGBUFFER_WRITE_AND_COUNT(LAT);
+			}
 		}
 
 		/* --- ACTUATOR CONTROL --- */
 		if (copy_if_updated(ORB_ID_VEHICLE_ATTITUDE_CONTROLS, &subs.act_controls_sub, &buf.act_controls)) {
+			if (buf.act_controls.timestamp_sample != 0) {
+				control_latency = buf.act_controls.timestamp - buf.act_controls.timestamp_sample;
+			}
+
 			log_msg.msg_type = LOG_ATTC_MSG;
 			log_msg.body.log_ATTC.roll = buf.act_controls.control[0];
 			log_msg.body.log_ATTC.pitch = buf.act_controls.control[1];
@@ -1856,6 +1911,22 @@ int sdlog2_thread_main(int argc, char *argv[])
 			LOGBUFFER_WRITE_AND_COUNT(MACS);
 		}
 
+		/* --- TASK LOAD --- */
+		if (copy_if_updated(ORB_ID(cpuload), &subs.cpuload_sub, &buf.cpuload)) {
+			for (uint8_t i = 0; i < buf.cpuload.task_count; i++) {
+				log_msg.msg_type = LOG_TLOD_MSG;
+				log_msg.body.log_TLOD.task_count = buf.cpuload.task_count;
+				log_msg.body.log_TLOD.task_num = i;
+				memcpy(log_msg.body.log_TLOD.name, buf.cpuload.tasks[i].name, sizeof(log_msg.body.log_TLOD.name));
+				log_msg.body.log_TLOD.load = buf.cpuload.tasks[i].load;
+				log_msg.body.log_TLOD.ctx_switches_voluntary = buf.cpuload.tasks[i].ctx_switches_voluntary;
+				log_msg.body.log_TLOD.ctx_switches_involuntary = buf.cpuload.tasks[i].ctx_switches_involuntary;
+				memcpy(log_msg.body.log_TLOD.wakeup_latency, buf.cpuload.tasks[i].wakeup_latency,
+				       sizeof(log_msg.body.log_TLOD.wakeup_latency));
+				LOGBUFFER_WRITE_AND_COUNT(TLOD);
+			}
+		}
+
 		/* signal the other thread new data, but not yet unlock */
 		if (logbuffer_count(&lb) > MIN_BYTES_TO_WRITE) {
 			/* only request write if several packets can be written at once */
@@ -1875,6 +1946,9 @@ int sdlog2_thread_main(int argc, char *argv[])
 
 	free(lb.data);
 
+	sdlog2_generic_unload();
+	_generic_logging = false;
+
 	thread_running = false;
 
 	return 0;
@@ -61,6 +61,9 @@ Format characters in the format string for binary log messages
 
   q   : int64_t
   Q   : uint64_t
+
+  V   : uint16_t length followed by that many bytes, last field only; the
+        length in the FMT message includes the uint16_t but not the bytes
  */
 
 #ifndef SDLOG2_FORMAT_H_
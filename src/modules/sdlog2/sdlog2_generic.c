@@ -0,0 +1,280 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file sdlog2_generic.c
+ *
+ * Generic topic logging, see sdlog2_generic.h.
+ */
+
+#include <px4_config.h>
+#include <px4_defines.h>
+#include <px4_posix.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <systemlib/err.h>
+#include <unistd.h>
+
+#include <uORB/uORB.h>
+
+#include "sdlog2_generic.h"
+#include "sdlog2_format.h"
+#include "sdlog2_messages.h"
+
+/* header of a TOPD message preceding the raw struct */
+#define TOPD_HEADER_LEN (LOG_PACKET_HEADER_LEN + sizeof(struct log_TOPD_s))
+
+struct generic_topic_s {
+	const struct orb_metadata *meta;
+	uint8_t instance;
+	int handle;
+};
+
+static struct generic_topic_s _topics[SDLOG2_GENERIC_MAX_TOPICS];
+static px4_pollfd_struct_t _fds[SDLOG2_GENERIC_MAX_TOPICS];
+static unsigned _topics_count = 0;
+
+/* TOPD message buffer, large enough for the largest logged struct */
+static uint8_t *_record = NULL;
+
+/* finds the offset of the field named *arg */
+struct field_offset_s {
+	const char *name;
+	int offset;
+};
+
+static void find_field(void *arg, const char *type, size_t type_len, const char *name, size_t name_len,
+		       unsigned count, unsigned offset)
+{
+	struct field_offset_s *field = (struct field_offset_s *)arg;
+
+	if (strlen(field->name) == name_len && strncmp(field->name, name, name_len) == 0) {
+		field->offset = offset;
+	}
+}
+
+int sdlog2_generic_fields_size(const char *fields)
+{
+	return orb_fields_walk(fields, NULL, NULL);
+}
+
+int sdlog2_generic_field_offset(const char *fields, const char *name)
+{
+	struct field_offset_s field = { name, -1 };
+
+	if (orb_fields_walk(fields, find_field, &field) < 0) {
+		return -1;
+	}
+
+	return field.offset;
+}
+
+static const struct orb_metadata *find_topic(const char *name)
+{
+	size_t count;
+	const struct orb_metadata *const *topics = orb_get_topics(&count);
+
+	for (size_t i = 0; i < count; i++) {
+		if (strcmp(topics[i]->o_name, name) == 0) {
+			return topics[i];
+		}
+	}
+
+	return NULL;
+}
+
+int sdlog2_generic_load(const char *path)
+{
+#ifndef ORB_FIELDS_ENABLED
+	warnx("built without topic field layouts, see config_orb_fields");
+	return -1;
+#endif
+
+	FILE *f = fopen(path, "r");
+
+	if (f == NULL) {
+		warn("can't open %s", path);
+		return -1;
+	}
+
+	sdlog2_generic_unload();
+
+	size_t size_max = 0;
+	char line[80];
+
+	while (fgets(line, sizeof(line), f) != NULL) {
+		char *comment = strchr(line, '#');
+
+		if (comment != NULL) {
+			*comment = '\0';
+		}
+
+		char name[64];
+		unsigned interval = 0;
+		unsigned instance = 0;
+
+		if (sscanf(line, "%63s %u %u", name, &interval, &instance) < 1) {
+			continue;
+		}
+
+		if (_topics_count >= SDLOG2_GENERIC_MAX_TOPICS) {
+			warnx("too many topics, %s skipped", name);
+			continue;
+		}
+
+		const struct orb_metadata *meta = find_topic(name);
+
+		if (meta == NULL) {
+			warnx("unknown topic %s", name);
+			continue;
+		}
+
+		if (meta->o_fields == NULL || sdlog2_generic_fields_size(meta->o_fields) != (int)meta->o_size) {
+			warnx("%s: no matching field layout, skipped", name);
+			continue;
+		}
+
+		int handle = orb_subscribe_multi(meta, instance);
+
+		if (handle < 0) {
+			warnx("%s: subscribe failed", name);
+			continue;
+		}
+
+		if (interval > 0) {
+			orb_set_interval(handle, interval);
+		}
+
+		_topics[_topics_count].meta = meta;
+		_topics[_topics_count].instance = instance;
+		_topics[_topics_count].handle = handle;
+		_fds[_topics_count].fd = handle;
+		_fds[_topics_count].events = POLLIN;
+		_topics_count++;
+
+		if (meta->o_size > size_max) {
+			size_max = meta->o_size;
+		}
+	}
+
+	fclose(f);
+
+	if (_topics_count > 0) {
+		_record = (uint8_t *)malloc(TOPD_HEADER_LEN + size_max);
+
+		if (_record == NULL) {
+			warnx("can't allocate record buffer");
+			sdlog2_generic_unload();
+			return -1;
+		}
+
+		_record[0] = HEAD_BYTE1;
+		_record[1] = HEAD_BYTE2;
+		_record[2] = LOG_TOPD_MSG;
+	}
+
+	return _topics_count;
+}
+
+void sdlog2_generic_unload(void)
+{
+	for (unsigned i = 0; i < _topics_count; i++) {
+		orb_unsubscribe(_topics[i].handle);
+	}
+
+	_topics_count = 0;
+
+	free(_record);
+	_record = NULL;
+}
+
+int sdlog2_generic_write_formats(int fd)
+{
+	struct {
+		LOG_PACKET_HEADER;
+		struct log_TOPF_s body;
+	} log_msg_TOPF = {
+		LOG_PACKET_HEADER_INIT(LOG_TOPF_MSG),
+	};
+
+	int written = 0;
+
+	for (unsigned i = 0; i < _topics_count; i++) {
+		const struct orb_metadata *meta = _topics[i].meta;
+
+		log_msg_TOPF.body.id = i;
+		log_msg_TOPF.body.instance = _topics[i].instance;
+		log_msg_TOPF.body.size = meta->o_size;
+		log_msg_TOPF.body.layout_len = strlen(meta->o_name) + 1 + strlen(meta->o_fields);
+
+		written += write(fd, &log_msg_TOPF, sizeof(log_msg_TOPF));
+		written += write(fd, meta->o_name, strlen(meta->o_name) + 1);
+		written += write(fd, meta->o_fields, strlen(meta->o_fields));
+	}
+
+	return written;
+}
+
+void sdlog2_generic_write(struct logbuffer_s *lb, unsigned long *written, unsigned long *skipped)
+{
+	for (unsigned i = 0; i < _topics_count; i++) {
+		bool updated = false;
+		orb_check(_topics[i].handle, &updated);
+
+		if (!updated) {
+			continue;
+		}
+
+		struct log_TOPD_s topd = { .id = i, .data_len = _topics[i].meta->o_size };
+		memcpy(&_record[LOG_PACKET_HEADER_LEN], &topd, sizeof(topd));
+		orb_copy(_topics[i].meta, _topics[i].handle, &_record[TOPD_HEADER_LEN]);
+
+		if (logbuffer_write(lb, _record, TOPD_HEADER_LEN + _topics[i].meta->o_size)) {
+			(*written)++;
+
+		} else {
+			(*skipped)++;
+		}
+	}
+}
+
+bool sdlog2_generic_wait(int timeout_ms)
+{
+	if (_topics_count == 0) {
+		usleep(timeout_ms * 1000);
+		return false;
+	}
+
+	return px4_poll(_fds, _topics_count, timeout_ms) > 0;
+}
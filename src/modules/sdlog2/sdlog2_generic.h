@@ -0,0 +1,112 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file sdlog2_generic.h
+ *
+ * Generic topic logging: logs the raw structs of the topics listed in a
+ * config file, described by the field layouts of the uORB metadata.
+ */
+
+#ifndef SDLOG2_GENERIC_H_
+#define SDLOG2_GENERIC_H_
+
+#include <stdbool.h>
+
+#include "logbuffer.h"
+
+/* maximum number of topics in the config file */
+#define SDLOG2_GENERIC_MAX_TOPICS 32
+
+/**
+ * Load the list of topics to log and subscribe to them.
+ *
+ * Every line of the file has the format "<topic> [<interval ms>] [<instance>]",
+ * '#' starts a comment. Topics without a field layout or with a layout
+ * not matching the struct size are skipped.
+ *
+ * @param path		Config file
+ * @return		Number of topics to log, -1 on error
+ */
+int sdlog2_generic_load(const char *path);
+
+/**
+ * Size of the struct described by a field layout.
+ *
+ * @param fields	Field layout, see orb_metadata::o_fields
+ * @return		Size in bytes, -1 if the layout can't be parsed
+ */
+int sdlog2_generic_fields_size(const char *fields);
+
+/**
+ * Offset of a field in the struct described by a field layout.
+ *
+ * @param fields	Field layout, see orb_metadata::o_fields
+ * @param name		Name of a field of the outermost struct
+ * @return		Offset in bytes, -1 if there is no such field or the layout can't be parsed
+ */
+int sdlog2_generic_field_offset(const char *fields, const char *name);
+
+/**
+ * Unsubscribe from the topics and free the record buffer.
+ */
+void sdlog2_generic_unload(void);
+
+/**
+ * Write the TOPF messages describing the logged topics.
+ *
+ * @param fd		Log file
+ * @return		Number of bytes written
+ */
+int sdlog2_generic_write_formats(int fd);
+
+/**
+ * Copy the updated topics to the log buffer as TOPD messages.
+ *
+ * The log buffer mutex must be held by the caller.
+ *
+ * @param lb		Log buffer
+ * @param written	Incremented for every message written
+ * @param skipped	Incremented for every message that didn't fit into the buffer
+ */
+void sdlog2_generic_write(struct logbuffer_s *lb, unsigned long *written, unsigned long *skipped);
+
+/**
+ * Wait for an update of any of the logged topics.
+ *
+ * @param timeout_ms	Maximum time to wait
+ * @return		true if a topic was updated
+ */
+bool sdlog2_generic_wait(int timeout_ms);
+
+#endif
@@ -479,6 +479,25 @@ struct log_MACS_s {
 
 /* WARNING: ID 46 is already in use for ATTC1 */
 
+/* --- TLOD - TASK LOAD --- */
+#define LOG_TLOD_MSG 47
+struct log_TLOD_s {
+	uint8_t task_count;
+	uint8_t task_num;
+	char name[16];
+	float load;
+	uint32_t ctx_switches_voluntary;
+	uint32_t ctx_switches_involuntary;
+	uint32_t wakeup_latency[8];	/* timed wakeups <50us, <100us, <200us, <500us, <1ms, <2ms, <5ms late, above */
+};
+
+/* --- LAT - CONTROL LATENCY --- */
+#define LOG_LAT_MSG 48
+struct log_LAT_s {
+	uint32_t control_latency;	/* age of the sensor sample when the actuator controls were computed, us */
+	uint32_t output_latency;	/* age of the sensor sample when the actuator outputs were written, us */
+};
+
 /********** SYSTEM MESSAGES, ID > 0x80 **********/
 
 /* --- TIME - TIME STAMP --- */
@@ -501,6 +520,30 @@ struct log_PARM_s {
 	float value;
 };
 
+/*
+ * TOPF and TOPD are used by the generic topic logging (-g option) only.
+ * Both end in a variable length field (format char V), the FMT messages
+ * describe them up to its length.
+ */
+
+/* --- TOPF - GENERIC TOPIC FORMAT --- */
+#define LOG_TOPF_MSG 132
+struct log_TOPF_s {
+	uint8_t id;
+	uint8_t instance;
+	uint16_t size;
+	uint16_t layout_len;
+	/* followed by the topic name, a NUL and the field layout (orb_metadata::o_fields) */
+};
+
+/* --- TOPD - GENERIC TOPIC DATA --- */
+#define LOG_TOPD_MSG 133
+struct log_TOPD_s {
+	uint8_t id;
+	uint16_t data_len;
+	/* followed by the raw topic struct of the size announced by TOPF */
+};
+
 #pragma pack(pop)
 /* construct list of all message formats */
 static const struct log_format_s log_formats[] = {
@@ -550,12 +593,16 @@ static const struct log_format_s log_formats[] = {
 	LOG_FORMAT(ENCD, "qfqf",	"cnt0,vel0,cnt1,vel1"),
 	LOG_FORMAT(TSYN, "Q", 		"TimeOffset"),
 	LOG_FORMAT(MACS, "fff", "RRint,PRint,YRint"),
+	LOG_FORMAT(TLOD, "BBNfIIIIIIIIII",	"Cnt,N,Name,Load,VCSW,ICSW,W0,W1,W2,W3,W4,W5,W6,W7"),
+	LOG_FORMAT(LAT, "II",			"Ctrl,Out"),
 
 	/* system-level messages, ID >= 0x80 */
 	/* FMT: don't write format of format message, it's useless */
 	LOG_FORMAT(TIME, "Q", "StartTime"),
 	LOG_FORMAT(VER, "NZ", "Arch,FwGit"),
-	LOG_FORMAT(PARM, "Nf", "Name,Value")
+	LOG_FORMAT(PARM, "Nf", "Name,Value"),
+	LOG_FORMAT(TOPF, "BBHV", "Id,Inst,Size,Layout"),
+	LOG_FORMAT(TOPD, "BV", "Id,Data")
 };
 
 static const unsigned log_formats_num = sizeof(log_formats) / sizeof(log_formats[0]);
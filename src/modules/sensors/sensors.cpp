@@ -52,6 +52,7 @@
 #include <px4_tasks.h>
 #include <px4_posix.h>
 #include <px4_time.h>
+#include <px4_work_item.h>
 
 #include <fcntl.h>
 #include <poll.h>
@@ -82,6 +83,7 @@
 #include <systemlib/err.h>
 #include <systemlib/perf_counter.h>
 #include <conversion/rotation.h>
+#include <ecl/validation/data_validator_array.h>
 
 #include <systemlib/airspeed.h>
 
@@ -146,7 +148,7 @@ static const int ERROR = -1;
  */
 extern "C" __EXPORT int sensors_main(int argc, char *argv[]);
 
-class Sensors
+class Sensors : public px4::ScheduledWorkItem
 {
 public:
 	/**
@@ -160,12 +162,18 @@ public:
 	~Sensors();
 
 	/**
-	 * Start the sensors task.
+	 * Start the sensors task, on POSIX a high priority work item paced
+	 * by the gyro instead.
 	 *
 	 * @return		OK on success.
 	 */
 	int		start();
 
+	/**
+	 * Print the work item status.
+	 */
+	void		status();
+
 private:
 	static const unsigned _rc_max_chan_count =
 		input_rc_s::RC_INPUT_MAX_CHANNELS;	/**< maximum number of r/c channels we handle */
@@ -200,12 +208,14 @@ private:
 
 	bool 		_task_should_exit;		/**< if true, sensor task should exit */
 	int 		_sensors_task;			/**< task handle for sensor task */
+	bool		_init_failed;			/**< work item: sensor initialization failed */
 
 	bool		_hil_enabled;			/**< if true, HIL is active */
 	bool		_publishing;			/**< if true, we are publishing sensor data */
 	bool		_armed;				/**< arming status of the vehicle */
 
 	int		_gyro_sub[SENSOR_COUNT_MAX];	/**< raw gyro data subscription */
+	unsigned	_gyro_trigger;			/**< gyro instance pacing the output */
 	int		_accel_sub[SENSOR_COUNT_MAX];	/**< raw accel data subscription */
 	int		_mag_sub[SENSOR_COUNT_MAX];	/**< raw mag data subscription */
 	int		_baro_sub[SENSOR_COUNT_MAX];	/**< raw baro data subscription */
@@ -230,6 +240,23 @@ private:
 	orb_advert_t	_diff_pres_pub;			/**< differential_pressure */
 
 	perf_counter_t	_loop_perf;			/**< loop performance counter */
+	perf_counter_t	_voter_perf;			/**< sensor voting performance counter */
+
+	DataValidatorArray<SENSOR_COUNT_MAX> _voter_gyro;	/**< gyro voter */
+	DataValidatorArray<SENSOR_COUNT_MAX> _voter_accel;	/**< accel voter */
+	DataValidatorArray<SENSOR_COUNT_MAX> _voter_mag;	/**< mag voter */
+	DataValidatorArray<SENSOR_COUNT_MAX> _voter_baro;	/**< baro voter */
+	unsigned	_voter_failovers;		/**< failovers reported so far */
+
+	struct {
+		uint64_t gyro[SENSOR_COUNT_MAX];
+		uint64_t accel[SENSOR_COUNT_MAX];
+		uint64_t mag[SENSOR_COUNT_MAX];
+		uint64_t baro[SENSOR_COUNT_MAX];
+	}		_voted_timestamp;		/**< sample timestamps already fed to the voters */
+
+	struct sensor_combined_s _raw;			/**< combined sensor data being published */
+	hrt_abstime	_last_config_update;		/**< last time new sensors were looked for */
 
 	struct rc_channels_s _rc;			/**< r/c channel data */
 	struct battery_status_s _battery_status;	/**< battery status */
@@ -431,6 +458,15 @@ private:
 	 */
 	void		baro_poll(struct sensor_combined_s &raw);
 
+	/**
+	 * Feed the samples updated since the last call to the sensor voters
+	 * and move the gyro trigger to the best gyro.
+	 *
+	 * @param raw			Combined sensor data structure holding
+	 *				the latest samples.
+	 */
+	void		vote(struct sensor_combined_s &raw);
+
 	/**
 	 * Poll the differential pressure sensor for updated data.
 	 *
@@ -471,6 +507,18 @@ private:
 	 * Main sensor collection task.
 	 */
 	void		task_main();
+
+	/**
+	 * Initialize the sensors and subscribe on the running thread.
+	 *
+	 * @return		OK on success.
+	 */
+	int		init();
+
+	/**
+	 * Collect and publish one set of sensor data.
+	 */
+	void		Run();
 };
 
 namespace sensors
@@ -480,17 +528,20 @@ Sensors	*g_sensors = nullptr;
 }
 
 Sensors::Sensors() :
+	ScheduledWorkItem("sensors_wq", HPWORK),
 	_fd_adc(-1),
 	_last_adc(0),
 
 	_task_should_exit(true),
 	_sensors_task(-1),
+	_init_failed(false),
 	_hil_enabled(false),
 	_publishing(true),
 	_armed(false),
 
 	/* subscriptions */
 	_gyro_sub{ -1, -1, -1},
+	_gyro_trigger(0),
 	_accel_sub{ -1, -1, -1},
 	_mag_sub{ -1, -1, -1},
 	_baro_sub{ -1, -1, -1},
@@ -515,6 +566,11 @@ Sensors::Sensors() :
 
 	/* performance counters */
 	_loop_perf(perf_alloc(PC_ELAPSED, "sensor task update")),
+	_voter_perf(perf_alloc(PC_ELAPSED, "sensors voter")),
+	_voter_failovers(0),
+	_voted_timestamp{},
+	_raw{},
+	_last_config_update(0),
 
 	_param_rc_values{},
 	_board_rotation{},
@@ -531,6 +587,10 @@ Sensors::Sensors() :
 		_baro_sub[i] = -1;
 	}
 
+	/* mags and baros publish at lower rates than the inertial sensors */
+	_voter_mag.set_timeout(200000);
+	_voter_baro.set_timeout(300000);
+
 	memset(&_rc, 0, sizeof(_rc));
 	memset(&_diff_pres, 0, sizeof(_diff_pres));
 	memset(&_rc_parameter_map, 0, sizeof(_rc_parameter_map));
@@ -650,6 +710,8 @@ Sensors::Sensors() :
 
 Sensors::~Sensors()
 {
+	ScheduleClear();
+
 	if (_sensors_task != -1) {
 
 		/* task wakes up every 100ms or so at the longest */
@@ -670,6 +732,9 @@ Sensors::~Sensors()
 		} while (_sensors_task != -1);
 	}
 
+	perf_free(_loop_perf);
+	perf_free(_voter_perf);
+
 	sensors::g_sensors = nullptr;
 }
 
@@ -1163,6 +1228,79 @@ Sensors::baro_poll(struct sensor_combined_s &raw)
 	}
 }
 
+void
+Sensors::vote(struct sensor_combined_s &raw)
+{
+	perf_begin(_voter_perf);
+
+	for (unsigned i = 0; i < _gyro_count; i++) {
+		if (raw.gyro_timestamp[i] != _voted_timestamp.gyro[i]) {
+			_voter_gyro.put(i, raw.gyro_timestamp[i], &raw.gyro_rad_s[i * 3],
+					raw.gyro_errcount[i], raw.gyro_priority[i]);
+			_voted_timestamp.gyro[i] = raw.gyro_timestamp[i];
+		}
+	}
+
+	for (unsigned i = 0; i < _accel_count; i++) {
+		if (raw.accelerometer_timestamp[i] != _voted_timestamp.accel[i]) {
+			_voter_accel.put(i, raw.accelerometer_timestamp[i], &raw.accelerometer_m_s2[i * 3],
+					 raw.accelerometer_errcount[i], raw.accelerometer_priority[i]);
+			_voted_timestamp.accel[i] = raw.accelerometer_timestamp[i];
+		}
+	}
+
+	for (unsigned i = 0; i < _mag_count; i++) {
+		if (raw.magnetometer_timestamp[i] != _voted_timestamp.mag[i]) {
+			_voter_mag.put(i, raw.magnetometer_timestamp[i], &raw.magnetometer_ga[i * 3],
+				       raw.magnetometer_errcount[i], raw.magnetometer_priority[i]);
+			_voted_timestamp.mag[i] = raw.magnetometer_timestamp[i];
+		}
+	}
+
+	for (unsigned i = 0; i < _baro_count; i++) {
+		if (raw.baro_timestamp[i] != _voted_timestamp.baro[i]) {
+			/* pressure last, the stuck value check is decided by the last axis */
+			float baro[3] = { raw.baro_temp_celcius[i], raw.baro_alt_meter[i], raw.baro_pres_mbar[i] };
+			_voter_baro.put(i, raw.baro_timestamp[i], baro, raw.baro_errcount[i], raw.baro_priority[i]);
+			_voted_timestamp.baro[i] = raw.baro_timestamp[i];
+		}
+	}
+
+	hrt_abstime now = hrt_absolute_time();
+	int best;
+
+	_voter_accel.get_best(now, &best);
+	_voter_mag.get_best(now, &best);
+	_voter_baro.get_best(now, &best);
+	_voter_gyro.get_best(now, &best);
+
+	/* pace the output by the gyro the voter trusts most */
+	if (best >= 0 && (unsigned)best != _gyro_trigger) {
+		_gyro_trigger = best;
+
+#ifdef __PX4_POSIX
+		/* work item: move the trigger over as well */
+		ScheduleTopicClear();
+
+		/* the timeout keeps the output going if this fails */
+		if (ScheduleOnTopic(ORB_ID(sensor_gyro), _gyro_trigger) != OK) {
+			warnx("trigger on gyro %u failed", _gyro_trigger);
+		}
+#endif
+	}
+
+	unsigned failovers = _voter_gyro.failover_count() + _voter_accel.failover_count() +
+			     _voter_mag.failover_count() + _voter_baro.failover_count();
+
+	if (failovers != _voter_failovers) {
+		warnx("sensor failover: gyro %u accel %u mag %u baro %u", _voter_gyro.failover_count(),
+		      _voter_accel.failover_count(), _voter_mag.failover_count(), _voter_baro.failover_count());
+		_voter_failovers = failovers;
+	}
+
+	perf_end(_voter_perf);
+}
+
 void
 Sensors::diff_pres_poll(struct sensor_combined_s &raw)
 {
@@ -2007,10 +2145,9 @@ Sensors::init_sensor_class(const struct orb_metadata *meta, int *subs,
 	return group_count;
 }
 
-void
-Sensors::task_main()
+int
+Sensors::init()
 {
-
 	/* start individual sensors */
 	int ret = 0;
 
@@ -2040,17 +2177,16 @@ Sensors::task_main()
 
 	if (ret) {
 		warnx("sensor initialization failed");
-		_sensors_task = -1;
 
 		if (_fd_adc >= 0) {
 			px4_close(_fd_adc);
 			_fd_adc = -1;
 		}
 
-		return;
+		return ret;
 	}
 
-	struct sensor_combined_s raw = {};
+	struct sensor_combined_s &raw = _raw;
 
 	/* ensure no overflows can occur */
 	static_assert((sizeof(raw.gyro_timestamp) / sizeof(raw.gyro_timestamp[0])) >= SENSOR_COUNT_MAX,
@@ -2127,19 +2263,30 @@ Sensors::task_main()
 	/* advertise the sensor_combined topic and make the initial publication */
 	_sensor_pub = orb_advertise(ORB_ID(sensor_combined), &raw);
 
+	_task_should_exit = false;
+
+	raw.timestamp = 0;
+
+	_last_config_update = hrt_absolute_time();
+
+	return OK;
+}
+
+void
+Sensors::task_main()
+{
+	if (init() != OK) {
+		_sensors_task = -1;
+		return;
+	}
+
 	/* wakeup source(s) */
 	px4_pollfd_struct_t fds[1];
 
 	/* use the gyro to pace output */
-	fds[0].fd = _gyro_sub[0];
+	fds[0].fd = _gyro_sub[_gyro_trigger];
 	fds[0].events = POLLIN;
 
-	_task_should_exit = false;
-
-	raw.timestamp = 0;
-
-	uint64_t _last_config_update = hrt_absolute_time();
-
 	while (!_task_should_exit) {
 
 		/* wait for up to 50ms for data */
@@ -2153,76 +2300,91 @@ Sensors::task_main()
 			continue;
 		}
 
-		perf_begin(_loop_perf);
-
-		/* check vehicle status for changes to publication state */
-		vehicle_control_mode_poll();
+		Run();
 
-		/* the timestamp of the raw struct is updated by the gyro_poll() method */
-		/* copy most recent sensor data */
-		gyro_poll(raw);
-		accel_poll(raw);
-		mag_poll(raw);
-		baro_poll(raw);
+		/* the gyro may have failed over */
+		fds[0].fd = _gyro_sub[_gyro_trigger];
+	}
 
-		/* work out if main gyro timed out and fail over to alternate gyro */
-		if (hrt_elapsed_time(&raw.gyro_timestamp[0]) > 20 * 1000) {
+	warnx("exiting.");
+	_sensors_task = -1;
+	px4_task_exit(0);
+}
 
-			/* if the secondary failed as well, go to the tertiary */
-			if (hrt_elapsed_time(&raw.gyro_timestamp[1]) > 20 * 1000) {
-				fds[0].fd = _gyro_sub[2];
+void
+Sensors::Run()
+{
+	/* work item: set up on the worker thread on the first run */
+	if (_task_should_exit) {
+		if (_init_failed) {
+			return;
+		}
 
-			} else {
-				fds[0].fd = _gyro_sub[1];
-			}
+		if (init() != OK) {
+			_init_failed = true;
+			ScheduleTopicClear();
+			return;
 		}
+	}
 
-		/* check battery voltage */
-		adc_poll(raw);
+	struct sensor_combined_s &raw = _raw;
 
-		diff_pres_poll(raw);
+	perf_begin(_loop_perf);
 
-		/* Inform other processes that new data is available to copy */
-		if (_publishing && raw.timestamp > 0) {
-			orb_publish(ORB_ID(sensor_combined), _sensor_pub, &raw);
-		}
+	/* check vehicle status for changes to publication state */
+	vehicle_control_mode_poll();
 
-		/* keep adding sensors as long as we are not armed,
-		 * when not adding sensors poll for param updates
-		 */
-		if (!_armed && hrt_elapsed_time(&_last_config_update) > 500 * 1000) {
-			_gyro_count = init_sensor_class(ORB_ID(sensor_gyro), &_gyro_sub[0],
-							&raw.gyro_priority[0], &raw.gyro_errcount[0]);
+	/* the timestamp of the raw struct is updated by the gyro_poll() method */
+	/* copy most recent sensor data */
+	gyro_poll(raw);
+	accel_poll(raw);
+	mag_poll(raw);
+	baro_poll(raw);
 
-			_mag_count = init_sensor_class(ORB_ID(sensor_mag), &_mag_sub[0],
-						       &raw.magnetometer_priority[0], &raw.magnetometer_errcount[0]);
+	/* vote and fail over to an alternate gyro if the current one degraded */
+	vote(raw);
 
-			_accel_count = init_sensor_class(ORB_ID(sensor_accel), &_accel_sub[0],
-							 &raw.accelerometer_priority[0], &raw.accelerometer_errcount[0]);
+	/* check battery voltage */
+	adc_poll(raw);
 
-			_baro_count = init_sensor_class(ORB_ID(sensor_baro), &_baro_sub[0],
-							&raw.baro_priority[0], &raw.baro_errcount[0]);
+	diff_pres_poll(raw);
 
-			_last_config_update = hrt_absolute_time();
+	/* Inform other processes that new data is available to copy */
+	if (_publishing && raw.timestamp > 0) {
+		orb_publish(ORB_ID(sensor_combined), _sensor_pub, &raw);
+	}
 
-		} else {
+	/* keep adding sensors as long as we are not armed,
+	 * when not adding sensors poll for param updates
+	 */
+	if (!_armed && hrt_elapsed_time(&_last_config_update) > 500 * 1000) {
+		_gyro_count = init_sensor_class(ORB_ID(sensor_gyro), &_gyro_sub[0],
+						&raw.gyro_priority[0], &raw.gyro_errcount[0]);
 
-			/* check parameters for updates */
-			parameter_update_poll();
+		_mag_count = init_sensor_class(ORB_ID(sensor_mag), &_mag_sub[0],
+					       &raw.magnetometer_priority[0], &raw.magnetometer_errcount[0]);
 
-			/* check rc parameter map for updates */
-			rc_parameter_map_poll();
-		}
+		_accel_count = init_sensor_class(ORB_ID(sensor_accel), &_accel_sub[0],
+						 &raw.accelerometer_priority[0], &raw.accelerometer_errcount[0]);
+
+		_baro_count = init_sensor_class(ORB_ID(sensor_baro), &_baro_sub[0],
+						&raw.baro_priority[0], &raw.baro_errcount[0]);
 
-		/* Look for new r/c input data */
-		rc_poll();
+		_last_config_update = hrt_absolute_time();
+
+	} else {
 
-		perf_end(_loop_perf);
+		/* check parameters for updates */
+		parameter_update_poll();
+
+		/* check rc parameter map for updates */
+		rc_parameter_map_poll();
 	}
 
-	warnx("exiting.");
-	_sensors_task = -1;
-	px4_task_exit(ret);
+	/* Look for new r/c input data */
+	rc_poll();
+
+	perf_end(_loop_perf);
 }
 
 int
@@ -2230,6 +2392,41 @@ Sensors::start()
 {
 	ASSERT(_sensors_task == -1);
 
+#ifdef __PX4_POSIX
+	/* run on the high priority work queue whenever the gyro publishes */
+	int ret = ScheduleOnTopic(ORB_ID(sensor_gyro), _gyro_trigger);
+
+	if (ret != OK) {
+		warnx("trigger on gyro failed");
+		return ret;
+	}
+
+	/* keep publishing at 20 Hz without gyro data, like the task's poll timeout */
+	ScheduleTimeout(50000);
+
+	/* initialize right away */
+	ScheduleNow();
+
+	/* wait until the first run has set things up or has failed, for a second at most */
+	unsigned i = 0;
+
+	while (_task_should_exit && !_init_failed) {
+		usleep(100);
+
+		if (++i > 10000) {
+			warnx("init timed out");
+			break;
+		}
+	}
+
+	if (_task_should_exit) {
+		ScheduleClear();
+		return -ERROR;
+	}
+
+	return OK;
+#else
+
 	/* start the task */
 	_sensors_task = px4_task_spawn_cmd("sensors",
 					   SCHED_DEFAULT,
@@ -2248,6 +2445,28 @@ Sensors::start()
 	}
 
 	return OK;
+#endif
+}
+
+void
+Sensors::status()
+{
+	warnx("is running");
+
+#ifdef __PX4_POSIX
+	print_status();
+#endif
+	perf_print_counter(_loop_perf);
+	perf_print_counter(_voter_perf);
+
+	warnx("gyro voter:");
+	_voter_gyro.print();
+	warnx("accel voter:");
+	_voter_accel.print();
+	warnx("mag voter:");
+	_voter_mag.print();
+	warnx("baro voter:");
+	_voter_baro.print();
 }
 
 int sensors_main(int argc, char *argv[])
@@ -2294,7 +2513,7 @@ int sensors_main(int argc, char *argv[])
 
 	if (!strcmp(argv[1], "status")) {
 		if (sensors::g_sensors) {
-			warnx("is running");
+			sensors::g_sensors->status();
 			return 0;
 
 		} else {
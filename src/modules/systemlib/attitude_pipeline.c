@@ -0,0 +1,157 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file attitude_pipeline.c
+ *
+ * Single-thread sensor -> estimator -> rate controller pipeline.
+ */
+
+#include <px4_config.h>
+#include <px4_defines.h>
+#include <px4_posix.h>
+#include <errno.h>
+#include <stddef.h>
+
+#include "attitude_pipeline.h"
+
+static px4_sem_t pipeline_lock;
+static bool pipeline_lock_init = false;
+static volatile bool pipeline_hosted = false;
+static attitude_pipeline_stage_t pipeline_stage = NULL;
+static void *pipeline_arg = NULL;
+
+int
+attitude_pipeline_open(void)
+{
+	if (pipeline_hosted) {
+		return -EBUSY;
+	}
+
+	/* the semaphore outlives hosts, a restarted host reuses it */
+	if (!pipeline_lock_init) {
+		px4_sem_init(&pipeline_lock, 0, 1);
+		pipeline_lock_init = true;
+	}
+
+	pipeline_hosted = true;
+	return OK;
+}
+
+void
+attitude_pipeline_close(void)
+{
+	if (!pipeline_hosted) {
+		return;
+	}
+
+	px4_sem_wait(&pipeline_lock);
+
+	pipeline_hosted = false;
+
+	if (pipeline_stage != NULL) {
+		pipeline_stage(pipeline_arg, NULL);
+		pipeline_stage = NULL;
+		pipeline_arg = NULL;
+	}
+
+	px4_sem_post(&pipeline_lock);
+}
+
+int
+attitude_pipeline_attach(attitude_pipeline_stage_t stage, void *arg)
+{
+	int ret = OK;
+
+	if (!pipeline_hosted) {
+		return -ENODEV;
+	}
+
+	px4_sem_wait(&pipeline_lock);
+
+	if (!pipeline_hosted) {
+		ret = -ENODEV;
+
+	} else if (pipeline_stage != NULL) {
+		ret = -EBUSY;
+
+	} else {
+		pipeline_arg = arg;
+		pipeline_stage = stage;
+	}
+
+	px4_sem_post(&pipeline_lock);
+
+	return ret;
+}
+
+void
+attitude_pipeline_detach(attitude_pipeline_stage_t stage, void *arg)
+{
+	if (!pipeline_lock_init) {
+		return;
+	}
+
+	px4_sem_wait(&pipeline_lock);
+
+	if (pipeline_stage == stage && pipeline_arg == arg) {
+		pipeline_stage = NULL;
+		pipeline_arg = NULL;
+	}
+
+	px4_sem_post(&pipeline_lock);
+}
+
+bool
+attitude_pipeline_attached(attitude_pipeline_stage_t stage, void *arg)
+{
+	return pipeline_stage == stage && pipeline_arg == arg;
+}
+
+void
+attitude_pipeline_run(const struct vehicle_attitude_s *att)
+{
+	/* cheap unlocked check, nothing attached is the common case */
+	if (pipeline_stage == NULL) {
+		return;
+	}
+
+	px4_sem_wait(&pipeline_lock);
+
+	if (pipeline_stage != NULL && !pipeline_stage(pipeline_arg, att)) {
+		pipeline_stage = NULL;
+		pipeline_arg = NULL;
+	}
+
+	px4_sem_post(&pipeline_lock);
+}
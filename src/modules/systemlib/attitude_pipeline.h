@@ -0,0 +1,107 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file attitude_pipeline.h
+ *
+ * Single-thread sensor -> estimator -> rate controller pipeline.
+ *
+ * An attitude estimator may host the pipeline: after publishing
+ * vehicle_attitude it hands the same structure by reference to one
+ * attached downstream stage (the rate controller), which then runs on
+ * the estimator thread instead of waking its own task on the topic.
+ * Stages keep publishing their topics so logging is unaffected.
+ *
+ * Uncontended, hosting costs one semaphore take per sample.
+ */
+
+#pragma once
+
+#include <px4_config.h>
+#include <stdbool.h>
+#include <uORB/topics/vehicle_attitude.h>
+
+__BEGIN_DECLS
+
+/**
+ * Downstream pipeline stage.
+ *
+ * Runs on the host thread. A NULL attitude means the stage must release
+ * everything it acquired on the host thread (subscriptions, adverts);
+ * it is detached afterwards either way.
+ *
+ * @param arg		Opaque argument passed to attitude_pipeline_attach().
+ * @param att		Attitude just published by the host, or NULL on teardown.
+ * @return		true to stay attached, false to detach.
+ */
+typedef bool (*attitude_pipeline_stage_t)(void *arg, const struct vehicle_attitude_s *att);
+
+/**
+ * Announce that the calling task hosts the pipeline.
+ *
+ * @return		OK, or -EBUSY if another task already hosts it.
+ */
+__EXPORT int attitude_pipeline_open(void);
+
+/**
+ * Stop hosting. Any attached stage is torn down on the calling thread.
+ */
+__EXPORT void attitude_pipeline_close(void);
+
+/**
+ * Attach the downstream stage.
+ *
+ * @return		OK, -ENODEV if nothing hosts the pipeline or
+ *			-EBUSY if a stage is already attached.
+ */
+__EXPORT int attitude_pipeline_attach(attitude_pipeline_stage_t stage, void *arg);
+
+/**
+ * Forcibly detach a stage without running its teardown.
+ *
+ * Only meant for when the host stopped responding; once this returns
+ * the stage is guaranteed not to run again.
+ */
+__EXPORT void attitude_pipeline_detach(attitude_pipeline_stage_t stage, void *arg);
+
+/**
+ * @return		true while the stage is attached.
+ */
+__EXPORT bool attitude_pipeline_attached(attitude_pipeline_stage_t stage, void *arg);
+
+/**
+ * Run the attached stage, if any, on the calling (host) thread.
+ */
+__EXPORT void attitude_pipeline_run(const struct vehicle_attitude_s *att);
+
+__END_DECLS
@@ -175,6 +175,25 @@ NullMixer::groups_required(uint32_t &groups)
 
 }
 
+bool
+NullMixer::get_linear(unsigned row, mixer_linear_s &lin)
+{
+	if (row > 0) {
+		return false;
+	}
+
+	/* no controls, unity output scaler */
+	lin.term_count = 0;
+	lin.offset = 0.0f;
+	lin.output_scaler.negative_scale = 1.0f;
+	lin.output_scaler.positive_scale = 1.0f;
+	lin.output_scaler.offset = 0.0f;
+	lin.output_scaler.min_output = -1.0f;
+	lin.output_scaler.max_output = 1.0f;
+
+	return true;
+}
+
 NullMixer *
 NullMixer::from_text(const char *buf, unsigned &buflen)
 {
@@ -135,6 +135,26 @@
 
 #include "mixer_load.h"
 
+/**
+ * Linear form of a row of a mixer, see Mixer::get_linear().
+ *
+ * For controls within -1..1 the row sums to
+ *
+ *   offset + sum(weight[i] * control(control_group[i], control_index[i]))
+ *
+ * and the output of a single-row mixer is scale(output_scaler, <sum>).
+ */
+struct mixer_linear_s {
+	static const unsigned	max_terms = 16;
+
+	unsigned		term_count;			/**< number of control terms */
+	float			offset;				/**< constant part of the sum */
+	mixer_scaler_s		output_scaler;			/**< scaling applied to the sum of a single row */
+	uint8_t			control_group[max_terms];	/**< group of each term */
+	uint8_t			control_index[max_terms];	/**< index of each term */
+	float			weight[max_terms];		/**< weight of each term */
+};
+
 /**
  * Abstract class defining a mixer mixing zero or more inputs to
  * one or more outputs.
@@ -184,6 +204,32 @@ public:
 	 */
 	virtual void			groups_required(uint32_t &groups) = 0;
 
+	/**
+	 * Get the linear form of the mixer.
+	 *
+	 * Mixers whose outputs are computed from linear functions of their
+	 * controls over the control range of -1..1 describe each function as a
+	 * row here, so that MixerGroup can fold them into its mixing matrix.
+	 * The output of a single-row mixer is its scaled row, mixers with more
+	 * rows compute their outputs from the row sums in mix_rows().
+	 *
+	 * @param row			The row to get, starting at zero.
+	 * @param lin			Filled in with the linear form of the row.
+	 * @return			True if the mixer has the row; false for row
+	 *				zero if the mixer has no linear form.
+	 */
+	virtual bool			get_linear(unsigned, mixer_linear_s &) { return false; }
+
+	/**
+	 * Perform the mixing function of a mixer with more than one linear row.
+	 *
+	 * @param rows			The row sums of the linear form.
+	 * @param outputs		Array into which mixed output(s) should be placed.
+	 * @param space			The number of available entries in the output array;
+	 * @return			The number of entries in the output array that were populated.
+	 */
+	virtual unsigned		mix_rows(const float *, float *, unsigned, uint16_t *) { return 0; }
+
 protected:
 	/** client-supplied callback used when fetching control values */
 	ControlCallback			_control_cb;
@@ -270,6 +316,27 @@ public:
 	 */
 	unsigned			count();
 
+	/**
+	 * Compile the linear mixers of the group into a dense mixing matrix.
+	 *
+	 * The controls used by the linear mixers are fetched once per cycle into
+	 * a contiguous snapshot and their rows are computed with a single
+	 * matrix-vector product, the output scalers or the mix_rows() of
+	 * multi-row mixers are applied as a post-pass. Other mixers are still
+	 * invoked in turn. The compiled form is dropped when mixers are added
+	 * or removed. load_from_binary() compiles the group, after load_from_buf()
+	 * the caller compiles it once the whole description is loaded.
+	 *
+	 * @return			The number of rows in the matrix, or -1 if
+	 *				the matrix could not be built.
+	 */
+	int				compile();
+
+	/**
+	 * Drop the compiled form of the group, mixing through each mixer in turn.
+	 */
+	void				discard_compiled();
+
 	/**
 	 * Adds mixers to the group based on a text description in a buffer.
 	 *
@@ -312,9 +379,67 @@ public:
 	 */
 	int				load_from_buf(const char *buf, unsigned &buflen);
 
+	/**
+	 * Adds mixers to the group from a binary description in a buffer.
+	 *
+	 * The binary description holds the same mixers as the text description
+	 * with the values already parsed, so no scanning is needed. All mixers
+	 * of the buffer are placed in a single allocation. Tools/px_mixer_to_bin.py
+	 * converts text mixer files. All values are little-endian and unaligned.
+	 *
+	 * Header:
+	 *
+	 *   char[4] MIXER_BINARY_MAGIC, uint8 MIXER_BINARY_VERSION, uint8 reserved, uint16 mixer count
+	 *
+	 * followed by one record per mixer, starting with the mixer tag:
+	 *
+	 *   'Z'
+	 *   'M', uint8 <control count>, int32[5] <output scaler>,
+	 *        <control count> x (uint8 <group>, uint8 <index>, int32[5] <control scaler>)
+	 *   'R', char[8] <geometry>, int32 <roll scale>, int32 <pitch scale>, int32 <yaw scale>, int32 <deadband>
+	 *
+	 * Scaler values are in the order and units of the text description.
+	 *
+	 * @param buf			The binary mixer configuration.
+	 * @param buflen		The length of the buffer.
+	 * @return			Zero on successful load, nonzero otherwise.
+	 */
+	int				load_from_binary(const uint8_t *buf, unsigned buflen);
+
 private:
 	Mixer				*_first;	/**< linked list of mixers */
 
+	/**
+	 * Storage of the mixers loaded by load_from_binary(). Mixers in the
+	 * arena own no other resources and are released with it.
+	 */
+	uint8_t				*_arena;
+	unsigned			_arena_size;
+
+	/* compiled form of the group, all arrays live in the _compiled block */
+	void				*_compiled;
+	unsigned			_compiled_controls;	/**< number of distinct controls */
+	unsigned			_compiled_rows;		/**< number of rows */
+	float				*_matrix;		/**< rows x controls, row-major */
+	float				*_row_offset;		/**< constant part of each row */
+	float				*_row_out;		/**< row sums of the last cycle */
+	float				*_snapshot;		/**< controls of the last cycle */
+	mixer_scaler_s			*_row_scaler;		/**< output scaler of each row */
+	uint8_t				*_control_group;	/**< group of each control */
+	uint8_t				*_control_index;	/**< index of each control */
+	uint8_t				*_mixer_rows;		/**< rows per mixer in list order, 0 if not linear */
+
+	static const unsigned		_compiled_controls_max = 32;
+	static const unsigned		_mixer_rows_max = 32;
+
+	/**
+	 * Fetch the control snapshot and compute the row sums.
+	 *
+	 * @return			False if a control was outside -1..1, in
+	 *				which case the linear form does not apply.
+	 */
+	bool				mix_linear();
+
 	/* do not allow to copy due to pointer data members */
 	MixerGroup(const MixerGroup &);
 	MixerGroup operator=(const MixerGroup &);
@@ -348,6 +473,7 @@ public:
 
 	virtual unsigned		mix(float *outputs, unsigned space, uint16_t *status_reg);
 	virtual void			groups_required(uint32_t &groups);
+	virtual bool			get_linear(unsigned row, mixer_linear_s &lin);
 };
 
 /**
@@ -413,6 +539,7 @@ public:
 
 	virtual unsigned		mix(float *outputs, unsigned space, uint16_t *status_reg);
 	virtual void			groups_required(uint32_t &groups);
+	virtual bool			get_linear(unsigned row, mixer_linear_s &lin);
 
 	/**
 	 * Check that the mixer configuration as loaded is sensible.
@@ -515,9 +642,26 @@ public:
 			const char *buf,
 			unsigned &buflen);
 
+	/**
+	 * Look up a geometry by the name used in mixer definitions.
+	 *
+	 * @param name			The geometry name, e.g. "4x".
+	 * @param geometry		Set to the geometry if the name is known.
+	 * @return			Zero if the name is known, nonzero otherwise.
+	 */
+	static int			geometry_from_name(const char *name, MultirotorGeometry &geometry);
+
 	virtual unsigned		mix(float *outputs, unsigned space, uint16_t *status_reg);
 	virtual void			groups_required(uint32_t &groups);
 
+	/**
+	 * The linear form has a roll and pitch row for each rotor, followed by
+	 * a yaw and a thrust row. Desaturation and idle speed are applied by
+	 * mix_rows().
+	 */
+	virtual bool			get_linear(unsigned row, mixer_linear_s &lin);
+	virtual unsigned		mix_rows(const float *rows, float *outputs, unsigned space, uint16_t *status_reg);
+
 private:
 	float				_roll_scale;
 	float				_pitch_scale;
@@ -530,6 +674,17 @@ private:
 	unsigned			_rotor_count;
 	const Rotor			*_rotors;
 
+	/**
+	 * Mix the rotor outputs, desaturating them and applying the idle speed.
+	 *
+	 * @param roll_pitch		The roll and pitch part of each rotor, may
+	 *				be the same array as outputs.
+	 * @param yaw			The constrained and scaled yaw control.
+	 * @param thrust		The constrained thrust control.
+	 */
+	unsigned			mix_rotors(const float *roll_pitch, float yaw, float thrust,
+			float *outputs, uint16_t *status_reg);
+
 	/* do not allow to copy due to ptr data members */
 	MultirotorMixer(const MultirotorMixer &);
 	MultirotorMixer operator=(const MultirotorMixer &);
@@ -50,6 +50,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <unistd.h>
+#include <new>
 
 #include "mixer.h"
 
@@ -60,7 +61,20 @@
 
 MixerGroup::MixerGroup(ControlCallback control_cb, uintptr_t cb_handle) :
 	Mixer(control_cb, cb_handle),
-	_first(nullptr)
+	_first(nullptr),
+	_arena(nullptr),
+	_arena_size(0),
+	_compiled(nullptr),
+	_compiled_controls(0),
+	_compiled_rows(0),
+	_matrix(nullptr),
+	_row_offset(nullptr),
+	_row_out(nullptr),
+	_snapshot(nullptr),
+	_row_scaler(nullptr),
+	_control_group(nullptr),
+	_control_index(nullptr),
+	_mixer_rows(nullptr)
 {
 }
 
@@ -82,6 +96,8 @@ MixerGroup::add_mixer(Mixer *mixer)
 
 	*mpp = mixer;
 	mixer->_next = nullptr;
+
+	discard_compiled();
 }
 
 void
@@ -89,13 +105,26 @@ MixerGroup::reset()
 {
 	Mixer *mixer;
 
-	/* discard sub-mixers */
+	discard_compiled();
+
+	/* discard sub-mixers, the ones in the arena go with it */
 	while (_first != nullptr) {
 		mixer = _first;
 		_first = mixer->_next;
-		delete mixer;
+
+		if (((uint8_t *)mixer < _arena) || ((uint8_t *)mixer >= _arena + _arena_size)) {
+			delete mixer;
+		}
+
 		mixer = nullptr;
 	}
+
+	if (_arena != nullptr) {
+		free(_arena);
+	}
+
+	_arena = nullptr;
+	_arena_size = 0;
 }
 
 unsigned
@@ -104,6 +133,31 @@ MixerGroup::mix(float *outputs, unsigned space, uint16_t *status_reg)
 	Mixer	*mixer = _first;
 	unsigned index = 0;
 
+	if ((_compiled != nullptr) && mix_linear()) {
+		unsigned n = 0;
+		unsigned row = 0;
+
+		while ((mixer != nullptr) && (index < space)) {
+			if (_mixer_rows[n] == 1) {
+				/* saturate the precomputed sum */
+				outputs[index++] = scale(_row_scaler[row], _row_out[row]);
+
+			} else if (_mixer_rows[n] > 1) {
+				index += mixer->mix_rows(_row_out + row, outputs + index, space - index, status_reg);
+
+			} else {
+				index += mixer->mix(outputs + index, space - index, status_reg);
+			}
+
+			row += _mixer_rows[n];
+
+			mixer = mixer->_next;
+			n++;
+		}
+
+		return index;
+	}
+
 	while ((mixer != nullptr) && (index < space)) {
 		index += mixer->mix(outputs + index, space - index, status_reg);
 		mixer = mixer->_next;
@@ -112,6 +166,169 @@ MixerGroup::mix(float *outputs, unsigned space, uint16_t *status_reg)
 	return index;
 }
 
+bool
+MixerGroup::mix_linear()
+{
+	/* fetch each control once */
+	for (unsigned c = 0; c < _compiled_controls; c++) {
+		float value = 0.0f;
+
+		_control_cb(_cb_handle, _control_group[c], _control_index[c], value);
+
+		/* outside the control range the input scalers may clip, also catches NaN */
+		if (!(value >= -1.0f && value <= 1.0f)) {
+			return false;
+		}
+
+		_snapshot[c] = value;
+	}
+
+	const float *m = _matrix;
+
+	for (unsigned r = 0; r < _compiled_rows; r++) {
+		float sum = _row_offset[r];
+
+		for (unsigned c = 0; c < _compiled_controls; c++) {
+			sum += m[c] * _snapshot[c];
+		}
+
+		_row_out[r] = sum;
+		m += _compiled_controls;
+	}
+
+	return true;
+}
+
+int
+MixerGroup::compile()
+{
+	discard_compiled();
+
+	uint8_t control_group[_compiled_controls_max];
+	uint8_t control_index[_compiled_controls_max];
+	unsigned controls = 0;
+	unsigned rows = 0;
+	unsigned mixers = 0;
+	mixer_linear_s lin;
+
+	/* collect the distinct controls of the linear mixers */
+	for (Mixer *mixer = _first; mixer != nullptr; mixer = mixer->_next) {
+		mixers++;
+
+		for (unsigned r = 0; mixer->get_linear(r, lin); r++) {
+			if (r == _mixer_rows_max) {
+				debug("too many rows to compile");
+				return -1;
+			}
+
+			for (unsigned t = 0; t < lin.term_count; t++) {
+				unsigned c = 0;
+
+				while (c < controls && (control_group[c] != lin.control_group[t] ||
+							control_index[c] != lin.control_index[t])) {
+					c++;
+				}
+
+				if (c == controls) {
+					if (controls == _compiled_controls_max) {
+						debug("too many controls to compile");
+						return -1;
+					}
+
+					control_group[c] = lin.control_group[t];
+					control_index[c] = lin.control_index[t];
+					controls++;
+				}
+			}
+
+			rows++;
+		}
+	}
+
+	if (rows == 0) {
+		return 0;
+	}
+
+	/* allocate all arrays in one block, floats first to keep them aligned */
+	size_t size = (rows * controls + 2 * rows + controls) * sizeof(float) +
+		      rows * sizeof(mixer_scaler_s) +
+		      2 * controls * sizeof(uint8_t) +
+		      mixers * sizeof(uint8_t);
+
+	uint8_t *block = (uint8_t *)calloc(1, size);
+
+	if (block == nullptr) {
+		debug("could not allocate compiled mixer");
+		return -1;
+	}
+
+	_matrix = (float *)block;
+	_row_offset = _matrix + rows * controls;
+	_row_out = _row_offset + rows;
+	_snapshot = _row_out + rows;
+	_row_scaler = (mixer_scaler_s *)(_snapshot + controls);
+	_control_group = (uint8_t *)(_row_scaler + rows);
+	_control_index = _control_group + controls;
+	_mixer_rows = _control_index + controls;
+
+	memcpy(_control_group, control_group, controls);
+	memcpy(_control_index, control_index, controls);
+
+	/* fill the matrix, terms on the same control are summed */
+	unsigned row = 0;
+	unsigned n = 0;
+
+	for (Mixer *mixer = _first; mixer != nullptr; mixer = mixer->_next, n++) {
+		unsigned r;
+
+		for (r = 0; mixer->get_linear(r, lin); r++) {
+			float *m = _matrix + row * controls;
+
+			for (unsigned t = 0; t < lin.term_count; t++) {
+				for (unsigned c = 0; c < controls; c++) {
+					if (control_group[c] == lin.control_group[t] &&
+					    control_index[c] == lin.control_index[t]) {
+						m[c] += lin.weight[t];
+						break;
+					}
+				}
+			}
+
+			_row_offset[row] = lin.offset;
+			_row_scaler[row] = lin.output_scaler;
+			row++;
+		}
+
+		_mixer_rows[n] = r;
+	}
+
+	_compiled = block;
+	_compiled_controls = controls;
+	_compiled_rows = rows;
+
+	return rows;
+}
+
+void
+MixerGroup::discard_compiled()
+{
+	if (_compiled != nullptr) {
+		free(_compiled);
+	}
+
+	_compiled = nullptr;
+	_compiled_controls = 0;
+	_compiled_rows = 0;
+	_matrix = nullptr;
+	_row_offset = nullptr;
+	_row_out = nullptr;
+	_snapshot = nullptr;
+	_row_scaler = nullptr;
+	_control_group = nullptr;
+	_control_index = nullptr;
+	_mixer_rows = nullptr;
+}
+
 unsigned
 MixerGroup::count()
 {
@@ -200,3 +417,187 @@ MixerGroup::load_from_buf(const char *buf, unsigned &buflen)
 	/* nothing more in the buffer for us now */
 	return ret;
 }
+
+namespace
+{
+
+/* sizes of the binary records, see MixerGroup::load_from_binary() */
+const unsigned binary_header_size = 8;
+const unsigned binary_scaler_size = 5 * sizeof(int32_t);
+const unsigned binary_control_size = 2 + binary_scaler_size;
+const unsigned binary_simple_size = 1 + binary_scaler_size;
+const unsigned binary_geometry_size = 8;
+const unsigned binary_multirotor_size = binary_geometry_size + 4 * sizeof(int32_t);
+
+/* keep the objects in the arena aligned */
+unsigned arena_align(unsigned size)
+{
+	return (size + 7) & ~7u;
+}
+
+int32_t read_int32(const uint8_t *p)
+{
+	return (int32_t)((uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24));
+}
+
+void read_scaler(const uint8_t *p, mixer_scaler_s &scaler)
+{
+	scaler.negative_scale	= read_int32(p) / 10000.0f;
+	scaler.positive_scale	= read_int32(p + 4) / 10000.0f;
+	scaler.offset		= read_int32(p + 8) / 10000.0f;
+	scaler.min_output	= read_int32(p + 12) / 10000.0f;
+	scaler.max_output	= read_int32(p + 16) / 10000.0f;
+}
+
+} // anonymous namespace
+
+int
+MixerGroup::load_from_binary(const uint8_t *buf, unsigned buflen)
+{
+	if ((buflen < binary_header_size) ||
+	    (memcmp(buf, MIXER_BINARY_MAGIC, 4) != 0) ||
+	    (buf[4] != MIXER_BINARY_VERSION)) {
+		debug("not a binary mixer definition");
+		return -1;
+	}
+
+	/* mixers already loaded from a binary keep their arena */
+	if (_arena != nullptr) {
+		debug("binary mixers already loaded");
+		return -1;
+	}
+
+	const unsigned mixers = buf[6] | (buf[7] << 8);
+	const uint8_t *end = buf + buflen;
+
+	/* validate the records and size the arena */
+	const uint8_t *p = buf + binary_header_size;
+	unsigned size = 0;
+
+	for (unsigned i = 0; i < mixers; i++) {
+		if (p >= end) {
+			debug("binary mixer truncated");
+			return -1;
+		}
+
+		switch (*p++) {
+		case 'Z':
+			size += arena_align(sizeof(NullMixer));
+			break;
+
+		case 'M': {
+				if ((unsigned)(end - p) < binary_simple_size) {
+					return -1;
+				}
+
+				unsigned inputs = p[0];
+				p += binary_simple_size;
+
+				if ((unsigned)(end - p) < inputs * binary_control_size) {
+					return -1;
+				}
+
+				p += inputs * binary_control_size;
+				size += arena_align(sizeof(SimpleMixer)) + arena_align(MIXER_SIMPLE_SIZE(inputs));
+				break;
+			}
+
+		case 'R': {
+				MultirotorGeometry geometry;
+				char geomname[binary_geometry_size + 1] = {};
+
+				if ((unsigned)(end - p) < binary_multirotor_size) {
+					return -1;
+				}
+
+				memcpy(geomname, p, binary_geometry_size);
+
+				if (MultirotorMixer::geometry_from_name(geomname, geometry) != 0) {
+					debug("unrecognised geometry '%s'", geomname);
+					return -1;
+				}
+
+				p += binary_multirotor_size;
+				size += arena_align(sizeof(MultirotorMixer));
+				break;
+			}
+
+		default:
+			debug("unknown binary mixer tag 0x%02x", p[-1]);
+			return -1;
+		}
+	}
+
+	if (size == 0) {
+		return -1;
+	}
+
+	_arena = (uint8_t *)malloc(size);
+
+	if (_arena == nullptr) {
+		debug("could not allocate mixer arena");
+		return -1;
+	}
+
+	_arena_size = size;
+
+	/* construct the mixers in place */
+	uint8_t *storage = _arena;
+	p = buf + binary_header_size;
+
+	for (unsigned i = 0; i < mixers; i++) {
+		Mixer *m = nullptr;
+
+		switch (*p++) {
+		case 'Z':
+			m = new (storage) NullMixer;
+			storage += arena_align(sizeof(NullMixer));
+			break;
+
+		case 'M': {
+				unsigned inputs = p[0];
+				mixer_simple_s *mixinfo = (mixer_simple_s *)(storage + arena_align(sizeof(SimpleMixer)));
+
+				mixinfo->control_count = inputs;
+				read_scaler(p + 1, mixinfo->output_scaler);
+				p += binary_simple_size;
+
+				for (unsigned j = 0; j < inputs; j++) {
+					mixinfo->controls[j].control_group = p[0];
+					mixinfo->controls[j].control_index = p[1];
+					read_scaler(p + 2, mixinfo->controls[j].scaler);
+					p += binary_control_size;
+				}
+
+				m = new (storage) SimpleMixer(_control_cb, _cb_handle, mixinfo);
+				storage += arena_align(sizeof(SimpleMixer)) + arena_align(MIXER_SIMPLE_SIZE(inputs));
+				break;
+			}
+
+		case 'R': {
+				MultirotorGeometry geometry;
+				char geomname[binary_geometry_size + 1] = {};
+
+				memcpy(geomname, p, binary_geometry_size);
+				MultirotorMixer::geometry_from_name(geomname, geometry);
+				p += binary_geometry_size;
+
+				m = new (storage) MultirotorMixer(_control_cb, _cb_handle, geometry,
+								  read_int32(p) / 10000.0f,
+								  read_int32(p + 4) / 10000.0f,
+								  read_int32(p + 8) / 10000.0f,
+								  read_int32(p + 12) / 10000.0f);
+				p += 4 * sizeof(int32_t);
+				storage += arena_align(sizeof(MultirotorMixer));
+				break;
+			}
+		}
+
+		add_mixer(m);
+	}
+
+	/* fold the linear mixers into the mixing matrix */
+	compile();
+
+	return 0;
+}
@@ -43,21 +43,14 @@
 #include <ctype.h>
 #include <systemlib/err.h>
 
+#include <drivers/drv_mixer.h>
+
 #include "mixer_load.h"
 
-int load_mixer_file(const char *fname, char *buf, unsigned maxlen)
+static int read_mixer_text(FILE *fp, char *buf, unsigned maxlen)
 {
-	FILE		*fp;
 	char		line[120];
 
-	/* open the mixer definition file */
-	fp = fopen(fname, "r");
-
-	if (fp == NULL) {
-		warnx("file not found");
-		return -1;
-	}
-
 	/* read valid lines from the file into a buffer */
 	buf[0] = '\0';
 
@@ -101,7 +94,6 @@ int load_mixer_file(const char *fname, char *buf, unsigned maxlen)
 		/* if the line is too long to fit in the buffer, bail */
 		if ((strlen(line) + strlen(buf) + 1) >= maxlen) {
 			warnx("line too long");
-			fclose(fp);
 			return -1;
 		}
 
@@ -109,7 +101,60 @@ int load_mixer_file(const char *fname, char *buf, unsigned maxlen)
 		strcat(buf, line);
 	}
 
+	return strlen(buf);
+}
+
+int load_mixer_file(const char *fname, char *buf, unsigned maxlen)
+{
+	FILE		*fp;
+
+	/* open the mixer definition file */
+	fp = fopen(fname, "r");
+
+	if (fp == NULL) {
+		warnx("file not found");
+		return -1;
+	}
+
+	int ret = read_mixer_text(fp, buf, maxlen);
+
 	fclose(fp);
-	return 0;
+	return (ret < 0) ? -1 : 0;
 }
 
+int load_mixer_definition(const char *fname, char *buf, unsigned maxlen, bool *binary)
+{
+	FILE		*fp;
+	size_t		len;
+	int		ret;
+
+	/* open the mixer definition file */
+	fp = fopen(fname, "rb");
+
+	if (fp == NULL) {
+		warnx("file not found");
+		return -1;
+	}
+
+	len = fread(buf, 1, maxlen, fp);
+	*binary = (len >= 4) && (memcmp(buf, MIXER_BINARY_MAGIC, 4) == 0);
+
+	if (*binary) {
+		/* if the file is too long to fit in the buffer, bail */
+		if (len == maxlen && fgetc(fp) != EOF) {
+			warnx("file too long");
+			ret = -1;
+
+		} else {
+			ret = len;
+		}
+
+	} else {
+		/* parse the text from the start of the same file */
+		rewind(fp);
+		ret = read_mixer_text(fp, buf, maxlen);
+	}
+
+	fclose(fp);
+	return ret;
+}
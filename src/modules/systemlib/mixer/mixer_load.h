@@ -41,11 +41,23 @@
 #define _SYSTEMLIB_MIXER_LOAD_H value
 
 #include <px4_config.h>
+#include <stdbool.h>
 
 __BEGIN_DECLS
 
 __EXPORT int load_mixer_file(const char *fname, char *buf, unsigned maxlen);
 
+/**
+ * Read a text or binary mixer file.
+ *
+ * The file is opened once and dispatched on its header: binary definitions
+ * are read as they are, text definitions are read as by load_mixer_file().
+ *
+ * @param binary	Set to true if the file holds a binary definition.
+ * @return		The length of the definition in bytes, or -1 on error.
+ */
+__EXPORT int load_mixer_definition(const char *fname, char *buf, unsigned maxlen, bool *binary);
+
 __END_DECLS
 
 #endif
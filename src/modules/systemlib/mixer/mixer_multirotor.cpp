@@ -144,64 +144,145 @@ MultirotorMixer::from_text(Mixer::ControlCallback control_cb, uintptr_t cb_handl
 
 	debug("remaining in buf: %d, first char: %c", buflen, buf[0]);
 
-	if (!strcmp(geomname, "4+")) {
+	if (geometry_from_name(geomname, geometry) != 0) {
+		debug("unrecognised geometry '%s'", geomname);
+		return nullptr;
+	}
+
+	debug("adding multirotor mixer '%s'", geomname);
+
+	return new MultirotorMixer(
+		       control_cb,
+		       cb_handle,
+		       geometry,
+		       s[0] / 10000.0f,
+		       s[1] / 10000.0f,
+		       s[2] / 10000.0f,
+		       s[3] / 10000.0f);
+}
+
+int
+MultirotorMixer::geometry_from_name(const char *name, MultirotorGeometry &geometry)
+{
+	if (!strcmp(name, "4+")) {
 		geometry = MultirotorGeometry::QUAD_PLUS;
 
-	} else if (!strcmp(geomname, "4x")) {
+	} else if (!strcmp(name, "4x")) {
 		geometry = MultirotorGeometry::QUAD_X;
 
-	} else if (!strcmp(geomname, "4v")) {
+	} else if (!strcmp(name, "4v")) {
 		geometry = MultirotorGeometry::QUAD_V;
 
-	} else if (!strcmp(geomname, "4w")) {
+	} else if (!strcmp(name, "4w")) {
 		geometry = MultirotorGeometry::QUAD_WIDE;
 
-	} else if (!strcmp(geomname, "4dc")) {
+	} else if (!strcmp(name, "4dc")) {
 		geometry = MultirotorGeometry::QUAD_DEADCAT;
 
-	} else if (!strcmp(geomname, "6+")) {
+	} else if (!strcmp(name, "6+")) {
 		geometry = MultirotorGeometry::HEX_PLUS;
 
-	} else if (!strcmp(geomname, "6x")) {
+	} else if (!strcmp(name, "6x")) {
 		geometry = MultirotorGeometry::HEX_X;
 
-	} else if (!strcmp(geomname, "6c")) {
+	} else if (!strcmp(name, "6c")) {
 		geometry = MultirotorGeometry::HEX_COX;
 
-	} else if (!strcmp(geomname, "8+")) {
+	} else if (!strcmp(name, "8+")) {
 		geometry = MultirotorGeometry::OCTA_PLUS;
 
-	} else if (!strcmp(geomname, "8x")) {
+	} else if (!strcmp(name, "8x")) {
 		geometry = MultirotorGeometry::OCTA_X;
 
-	} else if (!strcmp(geomname, "8c")) {
+	} else if (!strcmp(name, "8c")) {
 		geometry = MultirotorGeometry::OCTA_COX;
 
-	} else if (!strcmp(geomname, "2-")) {
+	} else if (!strcmp(name, "2-")) {
 		geometry = MultirotorGeometry::TWIN_ENGINE;
 
-	} else if (!strcmp(geomname, "3y")) {
+	} else if (!strcmp(name, "3y")) {
 		geometry = MultirotorGeometry::TRI_Y;
 
 	} else {
-		debug("unrecognised geometry '%s'", geomname);
-		return nullptr;
+		return -1;
 	}
 
-	debug("adding multirotor mixer '%s'", geomname);
-
-	return new MultirotorMixer(
-		       control_cb,
-		       cb_handle,
-		       geometry,
-		       s[0] / 10000.0f,
-		       s[1] / 10000.0f,
-		       s[2] / 10000.0f,
-		       s[3] / 10000.0f);
+	return 0;
 }
 
 unsigned
 MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
+{
+	float		roll    = constrain(get_control(0, 0) * _roll_scale, -1.0f, 1.0f);
+	float		pitch   = constrain(get_control(0, 1) * _pitch_scale, -1.0f, 1.0f);
+	float		yaw     = constrain(get_control(0, 2) * _yaw_scale, -1.0f, 1.0f);
+	float		thrust  = constrain(get_control(0, 3), 0.0f, 1.0f);
+
+	/* the roll and pitch part of each rotor, mixed in place */
+	for (unsigned i = 0; i < _rotor_count; i++) {
+		outputs[i] = roll * _rotors[i].roll_scale +
+			     pitch * _rotors[i].pitch_scale;
+	}
+
+	return mix_rotors(outputs, yaw, thrust, outputs, status_reg);
+}
+
+bool
+MultirotorMixer::get_linear(unsigned row, mixer_linear_s &lin)
+{
+	/* the input constraints must not clip within the control range */
+	if ((row > _rotor_count + 1) ||
+	    (fabsf(_roll_scale) > 1.0f) ||
+	    (fabsf(_pitch_scale) > 1.0f) ||
+	    (fabsf(_yaw_scale) > 1.0f)) {
+		return false;
+	}
+
+	/* rows are passed to mix_rows() unscaled */
+	lin.offset = 0.0f;
+	lin.output_scaler.negative_scale = 1.0f;
+	lin.output_scaler.positive_scale = 1.0f;
+	lin.output_scaler.offset = 0.0f;
+	lin.output_scaler.min_output = -1.0f;
+	lin.output_scaler.max_output = 1.0f;
+
+	if (row < _rotor_count) {
+		lin.term_count = 2;
+		lin.control_group[0] = 0;
+		lin.control_index[0] = 0;
+		lin.weight[0] = _roll_scale * _rotors[row].roll_scale;
+		lin.control_group[1] = 0;
+		lin.control_index[1] = 1;
+		lin.weight[1] = _pitch_scale * _rotors[row].pitch_scale;
+
+	} else if (row == _rotor_count) {
+		lin.term_count = 1;
+		lin.control_group[0] = 0;
+		lin.control_index[0] = 2;
+		lin.weight[0] = _yaw_scale;
+
+	} else {
+		/* thrust is constrained to 0..1 by mix_rows() */
+		lin.term_count = 1;
+		lin.control_group[0] = 0;
+		lin.control_index[0] = 3;
+		lin.weight[0] = 1.0f;
+	}
+
+	return true;
+}
+
+unsigned
+MultirotorMixer::mix_rows(const float *rows, float *outputs, unsigned space, uint16_t *status_reg)
+{
+	float		yaw     = rows[_rotor_count];
+	float		thrust  = constrain(rows[_rotor_count + 1], 0.0f, 1.0f);
+
+	return mix_rotors(rows, yaw, thrust, outputs, status_reg);
+}
+
+unsigned
+MultirotorMixer::mix_rotors(const float *roll_pitch, float yaw, float thrust, float *outputs, uint16_t *status_reg)
 {
 	/* Summary of mixing strategy:
 	1) mix roll, pitch and thrust without yaw.
@@ -214,10 +295,6 @@ MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
 	4) scale all outputs to range [idle_speed,1]
 	*/
 
-	float		roll    = constrain(get_control(0, 0) * _roll_scale, -1.0f, 1.0f);
-	float		pitch   = constrain(get_control(0, 1) * _pitch_scale, -1.0f, 1.0f);
-	float		yaw     = constrain(get_control(0, 2) * _yaw_scale, -1.0f, 1.0f);
-	float		thrust  = constrain(get_control(0, 3), 0.0f, 1.0f);
 	float		min_out = 0.0f;
 	float		max_out = 0.0f;
 
@@ -232,9 +309,7 @@ MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
 
 	/* perform initial mix pass yielding unbounded outputs, ignore yaw */
 	for (unsigned i = 0; i < _rotor_count; i++) {
-		float out = roll * _rotors[i].roll_scale +
-			    pitch * _rotors[i].pitch_scale +
-			    thrust;
+		float out = roll_pitch[i] + thrust;
 
 		out *= _rotors[i].out_scale;
 
@@ -246,8 +321,6 @@ MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
 		if (out > max_out) {
 			max_out = out;
 		}
-
-		outputs[i] = out;
 	}
 
 	float boost = 0.0f;				// value added to demanded thrust (can also be negative)
@@ -306,8 +379,7 @@ MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
 
 	// mix again but now with thrust boost, scale roll/pitch and also add yaw
 	for (unsigned i = 0; i < _rotor_count; i++) {
-		float out = (roll * _rotors[i].roll_scale +
-			     pitch * _rotors[i].pitch_scale) * roll_pitch_scale +
+		float out = roll_pitch[i] * roll_pitch_scale +
 			    yaw * _rotors[i].yaw_scale +
 			    thrust + boost;
 
@@ -319,8 +391,7 @@ MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
 				yaw = 0.0f;
 
 			} else {
-				yaw = -((roll * _rotors[i].roll_scale + pitch * _rotors[i].pitch_scale) *
-					roll_pitch_scale + thrust + boost) / _rotors[i].yaw_scale;
+				yaw = -(roll_pitch[i] * roll_pitch_scale + thrust + boost) / _rotors[i].yaw_scale;
 			}
 
 			if (status_reg != NULL) {
@@ -336,8 +407,7 @@ MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
 				yaw = 0.0f;
 
 			} else {
-				yaw = (1.0f - ((roll * _rotors[i].roll_scale + pitch * _rotors[i].pitch_scale) *
-					       roll_pitch_scale + thrust + boost)) / _rotors[i].yaw_scale;
+				yaw = (1.0f - (roll_pitch[i] * roll_pitch_scale + thrust + boost)) / _rotors[i].yaw_scale;
 			}
 
 			if (status_reg != NULL) {
@@ -348,8 +418,7 @@ MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
 
 	/* add yaw and scale outputs to range idle_speed...1 */
 	for (unsigned i = 0; i < _rotor_count; i++) {
-		outputs[i] = (roll * _rotors[i].roll_scale +
-			      pitch * _rotors[i].pitch_scale) * roll_pitch_scale +
+		outputs[i] = roll_pitch[i] * roll_pitch_scale +
 			     yaw * _rotors[i].yaw_scale +
 			     thrust + boost;
 
@@ -310,6 +310,42 @@ SimpleMixer::groups_required(uint32_t &groups)
 	}
 }
 
+bool
+SimpleMixer::get_linear(unsigned row, mixer_linear_s &lin)
+{
+	if ((row > 0) || (_info == nullptr) || (_info->control_count > mixer_linear_s::max_terms)) {
+		return false;
+	}
+
+	lin.term_count = _info->control_count;
+	lin.offset = 0.0f;
+	lin.output_scaler = _info->output_scaler;
+
+	for (unsigned i = 0; i < _info->control_count; i++) {
+		const mixer_scaler_s &scaler = _info->controls[i].scaler;
+
+		/* a different scale for each sign is not linear */
+		if (scaler.negative_scale != scaler.positive_scale) {
+			return false;
+		}
+
+		/* neither is an input scaler that clips within the control range */
+		float span = fabsf(scaler.positive_scale);
+
+		if ((scaler.offset - span < scaler.min_output) ||
+		    (scaler.offset + span > scaler.max_output)) {
+			return false;
+		}
+
+		lin.control_group[i] = _info->controls[i].control_group;
+		lin.control_index[i] = _info->controls[i].control_index;
+		lin.weight[i] = scaler.positive_scale;
+		lin.offset += scaler.offset;
+	}
+
+	return true;
+}
+
 int
 SimpleMixer::check()
 {
@@ -52,10 +52,13 @@
 #include <systemlib/err.h>
 #include <errno.h>
 #include <semaphore.h>
+#include <pthread.h>
+#include <stdio.h>
 
 #include <sys/stat.h>
 
 #include <drivers/drv_hrt.h>
+#include <px4_workqueue.h>
 
 #include "systemlib/param/param.h"
 #include "systemlib/uthash/utarray.h"
@@ -81,6 +84,25 @@
 #define PARAM_CLOSE	close
 #endif
 
+#ifndef __PX4_QURT
+/*
+ * The default parameter file is kept as a journal: a snapshot document
+ * holding all changed parameters, followed by records holding the
+ * parameters changed since. Each record is a complete BSON document with
+ * its length filled in, appended with a single write. A record cut short
+ * by a reset or power loss fails the length check and is dropped on load,
+ * so a save is either applied completely or not at all.
+ *
+ * Saves only append a record. Once the records grow beyond
+ * PARAM_JOURNAL_COMPACT_SIZE the file is rewritten as a new snapshot from
+ * the low priority work queue; resetting a parameter can't be expressed as
+ * a record and forces a snapshot on the next save.
+ */
+#define PARAM_JOURNAL
+#define PARAM_JOURNAL_COMPACT_SIZE	2048	/**< record bytes that trigger a background compaction */
+#define PARAM_JOURNAL_MAX_SIZE		8192	/**< record bytes that force a compaction on save */
+#endif
+
 /**
  * Array of static parameter info.
  */
@@ -102,8 +124,31 @@ struct param_wbuf_s {
 	param_t			param;
 	union param_value_u	val;
 	bool			unsaved;
+	uint32_t		seq;
 };
 
+/**
+ * Change sequence numbers.
+ *
+ * Every change to the parameter store takes the next number from
+ * param_seq. Changed parameters carry the number of their last write,
+ * all parameters at their default value share param_default_seq, which
+ * is bumped whenever a parameter is reset. Zero is never handed out so
+ * callers can use it to force an initial fetch.
+ */
+static uint32_t param_seq = 1;
+static uint32_t param_default_seq = 1;
+
+#ifdef PARAM_JOURNAL
+static pthread_mutex_t param_file_mutex = PTHREAD_MUTEX_INITIALIZER;
+static bool param_journal_valid = false;	/**< default file holds the saved values, records can be appended */
+static unsigned param_journal_size = 0;		/**< bytes of records following the snapshot */
+#ifndef _UNIT_TEST
+static struct work_s param_compact_work;
+static volatile bool param_compact_queued = false;
+#endif
+#endif
+
 
 uint8_t  *param_changed_storage = 0;
 int size_param_changed_storage_bytes = 0;
@@ -143,6 +188,9 @@ static orb_advert_t param_topic = NULL;
 
 static void param_set_used_internal(param_t param);
 
+static int param_export_internal(bson_encoder_t encoder, bool only_unsaved);
+static int param_import_internal(int fd, bool mark_saved, int *journal_size);
+
 static param_t param_find_internal(const char *name, bool notification);
 
 /** lock the parameter store */
@@ -160,6 +208,20 @@ param_unlock(void)
 }
 
 /** assert that the parameter store is locked */
+/**
+ * The default file no longer matches the saved values, the next save
+ * has to write a snapshot.
+ */
+static void
+param_journal_invalidate(void)
+{
+#ifdef PARAM_JOURNAL
+	pthread_mutex_lock(&param_file_mutex);
+	param_journal_valid = false;
+	pthread_mutex_unlock(&param_file_mutex);
+#endif
+}
+
 static void
 param_assert_locked(void)
 {
@@ -477,6 +539,27 @@ param_get_value_ptr(param_t param)
 	return result;
 }
 
+/**
+ * Obtain the change sequence number of a parameter.
+ *
+ * @param param			The parameter whose sequence number is sought.
+ * @return			The sequence number, zero if the parameter
+ *				does not exist.
+ */
+static uint32_t
+param_get_seq_internal(param_t param)
+{
+	param_assert_locked();
+
+	if (!handle_in_range(param)) {
+		return 0;
+	}
+
+	struct param_wbuf_s *s = param_find_changed(param);
+
+	return (s != NULL) ? s->seq : param_default_seq;
+}
+
 int
 param_get(param_t param, void *val)
 {
@@ -496,6 +579,53 @@ param_get(param_t param, void *val)
 	return result;
 }
 
+uint32_t
+param_get_seq(param_t param)
+{
+	param_lock();
+
+	uint32_t seq = param_get_seq_internal(param);
+
+	param_unlock();
+
+	return seq;
+}
+
+int
+param_get_many(const param_t *params, void *const *vals, uint32_t *seqs, unsigned count)
+{
+	int updated = 0;
+
+	param_lock();
+
+	for (unsigned i = 0; i < count; i++) {
+		uint32_t seq = param_get_seq_internal(params[i]);
+
+		/* invalid handle, or the caller already has this value */
+		if (seq == 0 || (seqs != NULL && seqs[i] == seq)) {
+			continue;
+		}
+
+		const void *v = param_get_value_ptr(params[i]);
+
+		if (v == NULL || vals[i] == NULL) {
+			continue;
+		}
+
+		memcpy(vals[i], v, param_size(params[i]));
+
+		if (seqs != NULL) {
+			seqs[i] = seq;
+		}
+
+		updated++;
+	}
+
+	param_unlock();
+
+	return updated;
+}
+
 static int
 param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_changes)
 {
@@ -523,7 +653,8 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 			struct param_wbuf_s buf = {
 				.param = param,
 				.val.p = NULL,
-				.unsaved = false
+				.unsaved = false,
+				.seq = 0
 			};
 
 			/* add it to the array and sort */
@@ -563,6 +694,7 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 		}
 
 		s->unsaved = !mark_saved;
+		s->seq = ++param_seq;
 		params_changed = true;
 		result = 0;
 	}
@@ -635,6 +767,9 @@ param_reset(param_t param)
 		if (s != NULL) {
 			int pos = utarray_eltidx(param_values, s);
 			utarray_erase(param_values, pos, 1);
+
+			/* the parameter now reports the default sequence */
+			param_default_seq = ++param_seq;
 		}
 
 		param_found = true;
@@ -642,6 +777,11 @@ param_reset(param_t param)
 
 	param_unlock();
 
+	/* not under the param lock, param_save_default() takes the file mutex first */
+	if (s != NULL) {
+		param_journal_invalidate();
+	}
+
 	if (s != NULL) {
 		param_notify_changes();
 	}
@@ -660,9 +800,12 @@ param_reset_all(void)
 
 	/* mark as reset / deleted */
 	param_values = NULL;
+	param_default_seq = ++param_seq;
 
 	param_unlock();
 
+	param_journal_invalidate();
+
 	param_notify_changes();
 }
 
@@ -713,6 +856,8 @@ param_set_default_file(const char *filename)
 		param_user_file = strdup(filename);
 	}
 
+	param_journal_invalidate();
+
 	return 0;
 }
 
@@ -722,14 +867,171 @@ param_get_default_file(void)
 	return (param_user_file != NULL) ? param_user_file : param_default_file;
 }
 
-int
-param_save_default(void)
+#ifdef PARAM_JOURNAL
+/**
+ * Write all changed parameters as a new snapshot, replacing the
+ * default file and its records. Called with param_file_mutex held.
+ *
+ * The snapshot is written to a temporary file first, an interrupted
+ * compaction leaves the old file in place.
+ */
+static int
+param_journal_snapshot(const char *filename)
+{
+	char tmpname[strlen(filename) + 5];
+	int res;
+	int fd;
+
+	snprintf(tmpname, sizeof(tmpname), "%s.tmp", filename);
+
+	fd = PARAM_OPEN(tmpname, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		warn("failed to open param file: %s", tmpname);
+		return ERROR;
+	}
+
+	res = param_export(fd, false);
+	PARAM_CLOSE(fd);
+
+	if (res != OK) {
+		warnx("failed to write parameters to file: %s", tmpname);
+		unlink(tmpname);
+		return res;
+	}
+
+#ifdef __PX4_NUTTX
+	/* FAT can't rename over an existing file, param_load_default recovers the window */
+	unlink(filename);
+#endif
+
+	if (rename(tmpname, filename) != 0) {
+		warn("failed to rename %s", tmpname);
+		return ERROR;
+	}
+
+	param_journal_size = 0;
+	param_journal_valid = true;
+
+	return OK;
+}
+
+/**
+ * Append the parameters changed since the last save as one record.
+ * Called with param_file_mutex held.
+ */
+static int
+param_journal_append(const char *filename)
 {
+	struct bson_encoder_s encoder;
 	int res;
 	int fd;
 
+	if (bson_encoder_init_buf(&encoder, NULL, 0)) {
+		return ERROR;
+	}
+
+	res = param_export_internal(&encoder, true);
+
+	if (res == 0) {
+		res = bson_encoder_fini(&encoder);
+	}
+
+	uint8_t *buf = bson_encoder_buf_data(&encoder);
+	int len = bson_encoder_buf_size(&encoder);
+
+	/* an empty document has only the length and terminator, nothing to save */
+	if (res == 0 && len > 5) {
+		fd = PARAM_OPEN(filename, O_WRONLY | O_APPEND);
+
+		if (fd < 0) {
+			res = ERROR;
+
+		} else {
+			/* the record is only valid once written completely */
+			if (write(fd, buf, len) != len || fsync(fd) != 0) {
+				res = ERROR;
+			}
+
+			PARAM_CLOSE(fd);
+		}
+
+		if (res == 0) {
+			param_journal_size += len;
+		}
+
+	} else if (res == 0 && len < 0) {
+		res = ERROR;
+	}
+
+	free(buf);
+
+	return res;
+}
+
+static void
+param_journal_compact(void *arg)
+{
+	pthread_mutex_lock(&param_file_mutex);
+
+	/* a save may have written a snapshot in the meantime */
+	if (param_journal_valid && param_journal_size >= PARAM_JOURNAL_COMPACT_SIZE) {
+		param_journal_snapshot(param_get_default_file());
+	}
+
+#ifndef _UNIT_TEST
+	param_compact_queued = false;
+#endif
+
+	pthread_mutex_unlock(&param_file_mutex);
+}
+#endif
+
+int
+param_save_default(void)
+{
+	int res;
 	const char *filename = param_get_default_file();
 
+#ifdef PARAM_JOURNAL
+	pthread_mutex_lock(&param_file_mutex);
+
+	res = ERROR;
+
+	if (param_journal_valid && param_journal_size < PARAM_JOURNAL_MAX_SIZE) {
+		res = param_journal_append(filename);
+
+		if (res != OK) {
+			/* a failed append may have left a partial record, start over */
+			warnx("failed to append parameters to file: %s", filename);
+			param_journal_valid = false;
+		}
+	}
+
+	if (res != OK) {
+		res = param_journal_snapshot(filename);
+	}
+
+	bool compact = (res == OK && param_journal_size >= PARAM_JOURNAL_COMPACT_SIZE);
+
+	pthread_mutex_unlock(&param_file_mutex);
+
+	if (compact) {
+#ifdef _UNIT_TEST
+		param_journal_compact(NULL);
+#else
+
+		if (!param_compact_queued) {
+			param_compact_queued = true;
+			work_queue(LPWORK, &param_compact_work, param_journal_compact, NULL, 0);
+		}
+
+#endif
+	}
+
+#else
+	int fd;
+
 	/* write parameters to temp file */
 	fd = PARAM_OPEN(filename, O_WRONLY | O_CREAT, PX4_O_MODE_666);
 
@@ -745,6 +1047,7 @@ param_save_default(void)
 	}
 
 	PARAM_CLOSE(fd);
+#endif
 
 	return res;
 }
@@ -756,40 +1059,71 @@ int
 param_load_default(void)
 {
 	warnx("param_load_default\n");
-	int fd_load = PARAM_OPEN(param_get_default_file(), O_RDONLY);
+	const char *filename = param_get_default_file();
+	int fd_load = PARAM_OPEN(filename, O_RDONLY);
+
+#ifdef PARAM_JOURNAL
+
+	if (fd_load < 0 && errno == ENOENT) {
+		/* power lost between removing the old file and renaming the new snapshot */
+		char tmpname[strlen(filename) + 5];
+		snprintf(tmpname, sizeof(tmpname), "%s.tmp", filename);
+
+		if (rename(tmpname, filename) == 0) {
+			warnx("recovered parameters from %s", tmpname);
+			fd_load = PARAM_OPEN(filename, O_RDONLY);
+
+		} else {
+			errno = ENOENT;
+		}
+	}
+
+#endif
 
 	if (fd_load < 0) {
 		/* no parameter file is OK, otherwise this is an error */
 		if (errno != ENOENT) {
-			warn("open '%s' for reading failed", param_get_default_file());
+			warn("open '%s' for reading failed", filename);
 			return -1;
 		}
 
 		return 1;
 	}
 
+#ifdef PARAM_JOURNAL
+	param_reset_all();
+
+	pthread_mutex_lock(&param_file_mutex);
+
+	int journal_size;
+	int result = param_import_internal(fd_load, true, &journal_size);
+
+	/* a torn record is dropped, the next save writes a clean snapshot */
+	param_journal_valid = (result == 0 && journal_size >= 0);
+	param_journal_size = (journal_size > 0) ? journal_size : 0;
+
+	pthread_mutex_unlock(&param_file_mutex);
+#else
 	int result = param_load(fd_load);
+#endif
 	PARAM_CLOSE(fd_load);
 
 	if (result != 0) {
-		warn("error reading parameters from '%s'", param_get_default_file());
+		warn("error reading parameters from '%s'", filename);
 		return -2;
 	}
 
 	return 0;
 }
 
-int
-param_export(int fd, bool only_unsaved)
+static int
+param_export_internal(bson_encoder_t encoder, bool only_unsaved)
 {
 	struct param_wbuf_s *s = NULL;
-	struct bson_encoder_s encoder;
 	int	result = -1;
 
 	param_lock();
 
-	bson_encoder_init_file(&encoder, fd);
-
 	/* no modified parameters -> we are done */
 	if (param_values == NULL) {
 		result = 0;
@@ -818,7 +1152,7 @@ param_export(int fd, bool only_unsaved)
 		case PARAM_TYPE_INT32:
 			param_get(s->param, &i);
 
-			if (bson_encoder_append_int(&encoder, param_name(s->param), i)) {
+			if (bson_encoder_append_int(encoder, param_name(s->param), i)) {
 				debug("BSON append failed for '%s'", param_name(s->param));
 				goto out;
 			}
@@ -828,7 +1162,7 @@ param_export(int fd, bool only_unsaved)
 		case PARAM_TYPE_FLOAT:
 			param_get(s->param, &f);
 
-			if (bson_encoder_append_double(&encoder, param_name(s->param), f)) {
+			if (bson_encoder_append_double(encoder, param_name(s->param), f)) {
 				debug("BSON append failed for '%s'", param_name(s->param));
 				goto out;
 			}
@@ -836,7 +1170,7 @@ param_export(int fd, bool only_unsaved)
 			break;
 
 		case PARAM_TYPE_STRUCT ... PARAM_TYPE_STRUCT_MAX:
-			if (bson_encoder_append_binary(&encoder,
+			if (bson_encoder_append_binary(encoder,
 						       param_name(s->param),
 						       BSON_BIN_BINARY,
 						       param_size(s->param),
@@ -858,6 +1192,19 @@ param_export(int fd, bool only_unsaved)
 out:
 	param_unlock();
 
+	return result;
+}
+
+int
+param_export(int fd, bool only_unsaved)
+{
+	struct bson_encoder_s encoder;
+	int	result;
+
+	bson_encoder_init_file(&encoder, fd);
+
+	result = param_export_internal(&encoder, only_unsaved);
+
 	if (result == 0) {
 		result = bson_encoder_fini(&encoder);
 	}
@@ -867,6 +1214,7 @@ out:
 
 struct param_import_state {
 	bool mark_saved;
+	bool dry_run;	/**< only check the document decodes */
 };
 
 static int
@@ -955,7 +1303,7 @@ param_import_callback(bson_decoder_t decoder, void *private, bson_node_t node)
 		goto out;
 	}
 
-	if (param_set_internal(param, v, state->mark_saved, true)) {
+	if (!state->dry_run && param_set_internal(param, v, state->mark_saved, true)) {
 		debug("error setting value for '%s'", node->name);
 		goto out;
 	}
@@ -977,25 +1325,119 @@ out:
 	return result;
 }
 
+#ifdef PARAM_JOURNAL
+/**
+ * Apply the journal records following the snapshot document.
+ *
+ * Every record is decoded once without applying it, a damaged record
+ * leaves the parameters untouched.
+ *
+ * @return		Size of the applied records, or -1 if the journal ends
+ *			in a truncated or damaged record, which is dropped.
+ */
+static int
+param_journal_replay(int fd, bool mark_saved)
+{
+	off_t start = lseek(fd, 0, SEEK_CUR);
+	off_t end = lseek(fd, 0, SEEK_END);
+	off_t pos = start;
+	int result = 0;
+
+	if (start < 0 || end < 0) {
+		return -1;
+	}
+
+	while (pos < end && result == 0) {
+		int32_t len;
+
+		if (lseek(fd, pos, SEEK_SET) != pos ||
+		    read(fd, &len, sizeof(len)) != sizeof(len) ||
+		    len <= 5 || len > end - pos) {
+			debug("torn journal record at %d", (int)pos);
+			return -1;
+		}
+
+		uint8_t *buf = malloc(len);
+
+		if (buf == NULL) {
+			return -1;
+		}
+
+		memcpy(buf, &len, sizeof(len));
+
+		if (read(fd, buf + sizeof(len), len - sizeof(len)) != (ssize_t)(len - sizeof(len))) {
+			free(buf);
+			return -1;
+		}
+
+		/* first pass checks the record, second pass applies it */
+		for (int pass = 0; pass < 2 && result == 0; pass++) {
+			struct bson_decoder_s decoder;
+			struct param_import_state state = { .mark_saved = mark_saved, .dry_run = (pass == 0) };
+
+			if (bson_decoder_init_buf(&decoder, buf, len, param_import_callback, &state)) {
+				result = -1;
+				break;
+			}
+
+			do {
+				result = bson_decoder_next(&decoder);
+
+			} while (result > 0);
+		}
+
+		free(buf);
+
+		pos += len;
+	}
+
+	return (result == 0) ? (int)(pos - start) : -1;
+}
+#endif
+
+/**
+ * The journal records following the first document are applied too, so
+ * that a copy of the default file loads like the default file itself.
+ *
+ * @param journal_size	If not NULL, set to the size of the records or -1
+ *			if the last one was torn.
+ */
 static int
-param_import_internal(int fd, bool mark_saved)
+param_import_internal(int fd, bool mark_saved, int *journal_size)
 {
 	struct bson_decoder_s decoder;
 	int result = -1;
 	struct param_import_state state;
 
+	if (journal_size != NULL) {
+		*journal_size = 0;
+	}
+
 	if (bson_decoder_init_file(&decoder, fd, param_import_callback, &state)) {
 		debug("decoder init failed");
 		goto out;
 	}
 
 	state.mark_saved = mark_saved;
+	state.dry_run = false;
 
 	do {
 		result = bson_decoder_next(&decoder);
 
 	} while (result > 0);
 
+#ifdef PARAM_JOURNAL
+
+	if (result == 0) {
+		int size = param_journal_replay(fd, mark_saved);
+
+		if (journal_size != NULL) {
+			*journal_size = size;
+		}
+	}
+
+#endif
+
 out:
 
 	if (result < 0) {
@@ -1008,14 +1450,14 @@ out:
 int
 param_import(int fd)
 {
-	return param_import_internal(fd, false);
+	return param_import_internal(fd, false, NULL);
 }
 
 int
 param_load(int fd)
 {
 	param_reset_all();
-	return param_import_internal(fd, true);
+	return param_import_internal(fd, true, NULL);
 }
 
 void
@@ -201,6 +201,34 @@ __EXPORT size_t		param_size(param_t param);
  */
 __EXPORT int		param_get(param_t param, void *val);
 
+/**
+ * Get the change sequence number of a parameter.
+ *
+ * The sequence number changes whenever the value of the parameter may have
+ * changed (set, reset or import), so a caller holding a cached copy only needs
+ * to fetch the value again when the number differs from the one it last saw.
+ *
+ * @param param		A handle returned by param_find or passed by param_foreach.
+ * @return		The sequence number, never zero for a valid handle; zero if the
+ *			handle is invalid.
+ */
+__EXPORT uint32_t	param_get_seq(param_t param);
+
+/**
+ * Copy the values of several parameters under a single lock of the parameter store.
+ *
+ * If seqs is not NULL, it holds the sequence number of the cached value for each
+ * parameter (zero to force a fetch). Only values whose sequence number differs are
+ * copied, and the array is updated with the new sequence numbers.
+ *
+ * @param params	Array of count handles returned by param_find.
+ * @param vals		Array of count pointers to suitable storage for each parameter.
+ * @param seqs		Array of count sequence numbers, or NULL to copy all values.
+ * @param count		The number of parameters.
+ * @return		The number of values copied.
+ */
+__EXPORT int		param_get_many(const param_t *params, void *const *vals, uint32_t *seqs, unsigned count);
+
 /**
  * Set the value of a parameter.
  *
@@ -276,6 +304,8 @@ __EXPORT int		param_import(int fd);
  *
  * This function resets all parameters to their default values, then loads new
  * values from a file.
+ * The journal records appended to the default file by param_save_default()
+ * are applied as well, as they are by param_import().
  *
  * @param fd		File descriptor to import from.  (Currently expected to be a file.)
  * @return		Zero on success, nonzero if an error occurred during import.
@@ -99,6 +99,24 @@ struct perf_ctr_interval {
 	float			M2;
 };
 
+/**
+ * PC_LATENCY bucket upper limits in microseconds.
+ */
+#define PERF_LATENCY_BUCKET_COUNT 10
+static const uint16_t perf_latency_buckets[PERF_LATENCY_BUCKET_COUNT] = { 250, 500, 1000, 2000, 3000, 4000, 5000, 7500, 10000, 20000 };
+
+/**
+ * PC_LATENCY counter.
+ */
+struct perf_ctr_latency {
+	struct perf_ctr_header	hdr;
+	uint64_t		event_count;
+	uint64_t		event_overruns;
+	uint64_t		time_total;
+	uint64_t		time_most;
+	uint32_t		buckets[PERF_LATENCY_BUCKET_COUNT + 1];	/**< last one counts the latencies above all limits */
+};
+
 /**
  * List of all known counters.
  */
@@ -124,6 +142,10 @@ perf_alloc(enum perf_counter_type type, const char *name)
 
 		break;
 
+	case PC_LATENCY:
+		ctr = (perf_counter_t)calloc(sizeof(struct perf_ctr_latency), 1);
+		break;
+
 	default:
 		break;
 	}
@@ -337,6 +359,30 @@ perf_set(perf_counter_t handle, int64_t elapsed)
 		}
 		break;
 
+	case PC_LATENCY: {
+			struct perf_ctr_latency *pcl = (struct perf_ctr_latency *)handle;
+
+			if (elapsed < 0) {
+				pcl->event_overruns++;
+
+			} else {
+				unsigned index = 0;
+
+				while (index < PERF_LATENCY_BUCKET_COUNT && (uint64_t)elapsed > perf_latency_buckets[index]) {
+					index++;
+				}
+
+				pcl->buckets[index]++;
+				pcl->event_count++;
+				pcl->time_total += elapsed;
+
+				if (pcl->time_most < (uint64_t)elapsed) {
+					pcl->time_most = elapsed;
+				}
+			}
+		}
+		break;
+
 	default:
 		break;
 	}
@@ -396,6 +442,16 @@ perf_reset(perf_counter_t handle)
 			pci->time_most = 0;
 			break;
 		}
+
+	case PC_LATENCY: {
+			struct perf_ctr_latency *pcl = (struct perf_ctr_latency *)handle;
+			pcl->event_count = 0;
+			pcl->event_overruns = 0;
+			pcl->time_total = 0;
+			pcl->time_most = 0;
+			memset(pcl->buckets, 0, sizeof(pcl->buckets));
+			break;
+		}
 	}
 }
 
@@ -448,6 +504,25 @@ perf_print_counter_fd(int fd, perf_counter_t handle)
 			break;
 		}
 
+	case PC_LATENCY: {
+			ddeclare(struct perf_ctr_latency *pcl = (struct perf_ctr_latency *)handle;)
+
+			dprintf(fd, "%s: %llu events, %llu overruns, %lluus avg, max %lluus\n",
+				handle->name,
+				(unsigned long long)pcl->event_count,
+				(unsigned long long)pcl->event_overruns,
+				pcl->event_count == 0 ? 0 : (unsigned long long)pcl->time_total / pcl->event_count,
+				(unsigned long long)pcl->time_most);
+
+			for (int i = 0; i < PERF_LATENCY_BUCKET_COUNT; i++) {
+				dprintf(fd, "  <=%5uus : %lu\n", perf_latency_buckets[i], (unsigned long)pcl->buckets[i]);
+			}
+
+			dprintf(fd, "   >%5uus : %lu\n", perf_latency_buckets[PERF_LATENCY_BUCKET_COUNT - 1],
+				(unsigned long)pcl->buckets[PERF_LATENCY_BUCKET_COUNT]);
+			break;
+		}
+
 	default:
 		break;
 	}
@@ -474,6 +549,11 @@ perf_event_count(perf_counter_t handle)
 			return pci->event_count;
 		}
 
+	case PC_LATENCY: {
+			struct perf_ctr_latency *pcl = (struct perf_ctr_latency *)handle;
+			return pcl->event_count;
+		}
+
 	default:
 		break;
 	}
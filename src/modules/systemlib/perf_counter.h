@@ -48,7 +48,8 @@
 enum perf_counter_type {
 	PC_COUNT,		/**< count the number of times an event occurs */
 	PC_ELAPSED,		/**< measure the time elapsed performing an event */
-	PC_INTERVAL		/**< measure the interval between instances of an event */
+	PC_INTERVAL,		/**< measure the interval between instances of an event */
+	PC_LATENCY		/**< histogram of latencies registered with perf_set */
 };
 
 struct perf_ctr_header;
@@ -117,7 +118,8 @@ __EXPORT extern void		perf_end(perf_counter_t handle);
  *
  * This call applies to counters that operate over ranges of time; PC_ELAPSED etc.
  * If a call is made without a corresponding perf_begin call. It sets the
- * value provided as argument as a new measurement.
+ * value provided as argument as a new measurement. PC_LATENCY counters
+ * only take their measurements from this call.
  *
  * @param handle		The handle returned from perf_alloc.
  * @param elapsed		The time elapsed. Negative values lead to incrementing the overrun counter.
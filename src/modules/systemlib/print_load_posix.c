@@ -39,14 +39,15 @@
  * @author Lorenz Meier <lorenz@px4.io>
  */
 
+#include <px4_tasks.h>
 #include <string.h>
 #include <stdio.h>
+#include <unistd.h>
 
 #include <systemlib/cpuload.h>
 #include <systemlib/printload.h>
 #include <drivers/drv_hrt.h>
-
-extern struct system_load_s system_load;
+#include <uORB/topics/cpuload.h>
 
 #define CL "\033[K" // clear line
 
@@ -68,7 +69,167 @@ void init_print_load_s(uint64_t t, struct print_load_s *s)
 	s->interval_time_ms_inv = 0.f;
 }
 
+/**
+ * Read the task accounting and update the interval loads.
+ *
+ * @return number of tasks in stats
+ */
+static int sample_tasks(uint64_t t, struct print_load_s *s, px4_task_stats_t *stats)
+{
+	int count = px4_task_stats(stats, CONFIG_MAX_TASKS);
+
+	s->new_time = t;
+
+	/* in float, an interval below 1ms must not truncate to zero */
+	if (s->new_time > s->interval_start_time) {
+		s->interval_time_ms_inv = 1000.f / (float)(s->new_time - s->interval_start_time);
+	}
+
+	s->running_count = count;
+	s->blocked_count = 0;
+	s->total_user_time = 0;
+
+	for (int i = 0; i < count; i++) {
+		int id = stats[i].id;
+
+		if (id < 0 || id >= CONFIG_MAX_TASKS) {
+			continue;
+		}
+
+		/* a task slot can be reused by a new task, whose CPU time starts over */
+		uint64_t interval_runtime = (s->last_times[id] > 0 && stats[i].cpu_time > s->last_times[id])
+					    ? (stats[i].cpu_time - s->last_times[id]) / 1000
+					    : 0;
+
+		s->last_times[id] = stats[i].cpu_time;
+
+		if (s->new_time > s->interval_start_time) {
+			s->curr_loads[id] = interval_runtime * s->interval_time_ms_inv;
+			s->total_user_time += interval_runtime;
+
+		} else {
+			s->curr_loads[id] = 0;
+		}
+	}
+
+	s->interval_start_time = s->new_time;
+
+	return count;
+}
+
+static float task_load(const struct print_load_s *s, const px4_task_stats_t *stats)
+{
+	return (stats->id >= 0 && stats->id < CONFIG_MAX_TASKS) ? s->curr_loads[stats->id] : 0.f;
+}
+
+static uint32_t late_wakeups(const px4_task_stats_t *stats)
+{
+	/* wakeups 1ms or more after the requested time */
+	uint32_t late = 0;
+
+	for (int k = 4; k < PX4_TASK_WAKEUP_BUCKETS; k++) {
+		late += stats->wakeup_latency[k];
+	}
+
+	return late;
+}
+
 void print_load(uint64_t t, int fd, struct print_load_s *print_state)
 {
+	px4_task_stats_t stats[CONFIG_MAX_TASKS];
+	char *clear_line = "";
+
+	/* print system information */
+	if (fd == 1) {
+		dprintf(fd, "\033[H"); /* move cursor home and clear screen */
+		clear_line = CL;
+	}
+
+	int count = sample_tasks(t, print_state, stats);
+	long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if (ncpus < 1) {
+		ncpus = 1;
+	}
+
+	dprintf(fd, "%sProcesses: %d total\n", clear_line, count);
+	dprintf(fd, "%sCPU usage: %.2f%% tasks (%ld CPUs)\n",
+		clear_line,
+		(double)((float)print_state->total_user_time * print_state->interval_time_ms_inv * 100.f / ncpus),
+		ncpus);
+	dprintf(fd, "%sUptime: %.3fs total\n%s\n",
+		clear_line,
+		(double)t / 1000000.d,
+		clear_line);
+
+	/* header for task list */
+	dprintf(fd, "%s%4s %-16s %8s %7s %8s %8s %8s\n",
+		clear_line,
+		"ID",
+		"COMMAND",
+		"CPU(ms)",
+		"CPU(%)",
+		"VCSW",
+		"ICSW",
+		"LATE>1ms");
+
+	for (int i = 0; i < count; i++) {
+		float load = task_load(print_state, &stats[i]);
+
+		dprintf(fd, "%s%4d %-16.16s %8llu %3d.%03d %8u %8u %8u\n",
+			clear_line,
+			stats[i].id,
+			stats[i].name,
+			(unsigned long long)(stats[i].cpu_time / 1000),
+			(int)(load * 100.0f),
+			(int)((load * 100.0f - (int)(load * 100.0f)) * 1000),
+			stats[i].ctx_switches_voluntary,
+			stats[i].ctx_switches_involuntary,
+			late_wakeups(&stats[i]));
+	}
+
+	dprintf(fd, "%s\n", clear_line);
+}
+
+void cpuload_sample(uint64_t t, struct print_load_s *print_state, struct cpuload_s *report)
+{
+	px4_task_stats_t stats[CONFIG_MAX_TASKS];
+	const int report_max = sizeof(report->tasks) / sizeof(report->tasks[0]);
+
+	int count = sample_tasks(t, print_state, stats);
+	long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if (ncpus < 1) {
+		ncpus = 1;
+	}
+
+	memset(report, 0, sizeof(*report));
+	report->timestamp = t;
+	report->load = (float)print_state->total_user_time * print_state->interval_time_ms_inv / ncpus;
+
+	/* report the busiest tasks, selection sort over the few that fit */
+	for (int n = 0; n < report_max && n < count; n++) {
+		int busiest = n;
+
+		for (int i = n + 1; i < count; i++) {
+			if (task_load(print_state, &stats[i]) > task_load(print_state, &stats[busiest])) {
+				busiest = i;
+			}
+		}
+
+		px4_task_stats_t tmp = stats[n];
+		stats[n] = stats[busiest];
+		stats[busiest] = tmp;
+
+		struct task_load_s *task = &report->tasks[n];
+		memcpy(task->name, stats[n].name, sizeof(task->name));
+		task->name[sizeof(task->name) - 1] = '\0';
+		task->cpu_time = stats[n].cpu_time;
+		task->load = task_load(print_state, &stats[n]);
+		task->ctx_switches_voluntary = stats[n].ctx_switches_voluntary;
+		task->ctx_switches_involuntary = stats[n].ctx_switches_involuntary;
+		memcpy(task->wakeup_latency, stats[n].wakeup_latency, sizeof(task->wakeup_latency));
+		report->task_count = n + 1;
+	}
 }
 
@@ -67,4 +67,20 @@ __EXPORT void init_print_load_s(uint64_t t, struct print_load_s *s);
 
 __EXPORT void print_load(uint64_t t, int fd, struct print_load_s *print_state);
 
+#if defined(__PX4_POSIX)
+struct cpuload_s;
+
+/**
+ * Sample the per-task CPU accounting into a cpuload report.
+ *
+ * Uses the same interval state as print_load(), so a print_load_s
+ * should be either printed or sampled, not both.
+ *
+ * @param t		Current time.
+ * @param print_state	Interval state, see init_print_load_s().
+ * @param report	Report to fill with the busiest tasks of the interval.
+ */
+__EXPORT void cpuload_sample(uint64_t t, struct print_load_s *print_state, struct cpuload_s *report);
+#endif
+
 __END_DECLS
@@ -100,12 +100,17 @@ bool SubscriptionBase::updated()
 void SubscriptionBase::update(void *data)
 {
 	if (updated()) {
-		int ret = orb_copy(_meta, _handle, data);
-
-		if (ret != PX4_OK) { warnx("orb copy failed"); }
+		copy(data);
 	}
 }
 
+void SubscriptionBase::copy(void *data)
+{
+	int ret = orb_copy(_meta, _handle, data);
+
+	if (ret != PX4_OK) { warnx("orb copy failed"); }
+}
+
 SubscriptionBase::~SubscriptionBase()
 {
 	int ret = orb_unsubscribe(_handle);
@@ -134,6 +139,12 @@ void Subscription<T>::update()
 	SubscriptionBase::update((void *)(&_data));
 }
 
+template <class T>
+void Subscription<T>::copy()
+{
+	SubscriptionBase::copy((void *)(&_data));
+}
+
 template <class T>
 const T &Subscription<T>::get() { return _data; }
 
@@ -79,6 +79,13 @@ public:
 	 */
 	void update(void *data);
 
+	/**
+	 * Copy the struct without checking for an update first,
+	 * for callers that already checked the handle.
+	 * @param data The uORB message struct we are updating.
+	 */
+	void copy(void *data);
+
 	/**
 	 * Deconstructor
 	 */
@@ -141,6 +148,14 @@ public:
 	 * updates, a child class must implement it.
 	 */
 	virtual void update() = 0;
+
+	/**
+	 * This function is the callback for batched list
+	 * updates, where the update check for all nodes
+	 * was done in a single orb_check_multi, a child class must
+	 * implement it.
+	 */
+	virtual void copy() = 0;
 // accessors
 	unsigned getInterval() { return _interval; }
 protected:
@@ -183,6 +198,11 @@ public:
 	 */
 	void update();
 
+	/**
+	 * Create a copy function that uses the embedded struct.
+	 */
+	void copy();
+
 	/*
 	 * This function gets the T struct data
 	 * */
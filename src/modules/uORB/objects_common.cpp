@@ -263,3 +263,9 @@ ORB_DEFINE(distance_sensor, struct distance_sensor_s);
 
 #include "topics/camera_trigger.h"
 ORB_DEFINE(camera_trigger, struct camera_trigger_s);
+
+#include "topics/task_load.h"
+ORB_DEFINE(task_load, struct task_load_s);
+
+#include "topics/cpuload.h"
+ORB_DEFINE(cpuload, struct cpuload_s);
@@ -235,6 +235,20 @@ int  orb_check(int handle, bool *updated)
 	return uORB::Manager::get_instance()->orb_check(handle, updated);
 }
 
+/**
+ * Check a set of subscriptions for updates in one call.
+ *
+ * @param handles A set of handles returned from orb_subscribe.
+ * @param updated Set per handle like orb_check.
+ * @param n       Number of handles.
+ * @return    OK if the check was successful for all handles, ERROR
+ *      otherwise with errno set accordingly.
+ */
+int  orb_check_multi(const int *handles, bool *updated, unsigned n)
+{
+	return uORB::Manager::get_instance()->orb_check_multi(handles, updated, n);
+}
+
 /**
  * Return the last time that the topic was updated.
  *
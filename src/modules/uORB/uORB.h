@@ -40,6 +40,7 @@
  */
 
 #include <sys/types.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -48,10 +49,24 @@
 
 /**
  * Object metadata.
+ *
+ * o_fields describes the memory layout of the topic struct, so its raw
+ * bytes can be decoded without the struct definition. It is a list of
+ * "<type>[<count>] <name>;" entries in struct order, count omitted for
+ * scalars. Types are int8_t..uint64_t, float, double, bool, char or the
+ * name of a nested message. Compiler padding is listed as uint8_t fields
+ * named _padding<n>, so the entry sizes add up to o_size. The layouts of
+ * nested messages follow, each as "\n<name>:<fields>".
+ *
+ * Topics generated from msg files and defined from C++ carry the layout,
+ * others have o_fields set to NULL. The layouts take about 18 kB, so they
+ * are only built with ORB_FIELDS_ENABLED (the default on POSIX, NuttX
+ * boards opt in with config_orb_fields); without it o_fields is always NULL.
  */
 struct orb_metadata {
 	const char *o_name;		/**< unique object name */
 	const size_t o_size;		/**< object size */
+	const char *o_fields;		/**< field layout of the struct, NULL if unknown */
 };
 
 typedef const struct orb_metadata *orb_id_t;
@@ -99,6 +114,23 @@ enum ORB_PRIO {
 # define ORB_DECLARE_OPTIONAL(_name)	extern const struct orb_metadata __orb_##_name __EXPORT
 #endif
 
+#if defined(__cplusplus) && defined(ORB_FIELDS_ENABLED)
+extern "C++" {
+/**
+ * Field layout of a topic struct, see orb_metadata::o_fields.
+ *
+ * Specialized by the generated topic headers.
+ */
+template<typename T>
+struct orb_fields {
+	static constexpr const char *value = nullptr;
+};
+}
+# define ORB_FIELDS(_struct)		orb_fields<_struct>::value
+#else
+# define ORB_FIELDS(_struct)		NULL
+#endif
+
 /**
  * Define (instantiate) the uORB metadata for a topic.
  *
@@ -114,7 +146,8 @@ enum ORB_PRIO {
 #define ORB_DEFINE(_name, _struct)			\
 	const struct orb_metadata __orb_##_name = {	\
 		#_name,					\
-		sizeof(_struct)				\
+		sizeof(_struct),			\
+		ORB_FIELDS(_struct)			\
 	}; struct hack
 
 __BEGIN_DECLS
@@ -303,6 +336,22 @@ extern int	orb_copy(const struct orb_metadata *meta, int handle, void *buffer) _
  */
 extern int	orb_check(int handle, bool *updated) __EXPORT;
 
+/**
+ * Check a set of subscriptions for updates in one call.
+ *
+ * Same result as orb_check on each handle. On POSIX the handles are
+ * checked in one pass without a driver round trip each. On NuttX the
+ * descriptors can only be resolved by the kernel, there it costs one
+ * ioctl per handle, the same as calling orb_check on each.
+ *
+ * @param handles	Handles returned from orb_subscribe.
+ * @param updated	Set per handle like orb_check.
+ * @param n		Number of handles.
+ * @return		OK if the check was successful for all handles, ERROR
+ *			otherwise with errno set accordingly.
+ */
+extern int	orb_check_multi(const int *handles, bool *updated, unsigned n) __EXPORT;
+
 /**
  * Return the last time that the topic was updated.
  *
@@ -362,6 +411,39 @@ extern int	orb_priority(int handle, int32_t *priority) __EXPORT;
  */
 extern int	orb_set_interval(int handle, unsigned interval) __EXPORT;
 
+/**
+ * Get the metadata of all topics generated from msg files.
+ *
+ * The table is generated at build time, it allows looking up topics
+ * by name, e.g. for generic loggers.
+ *
+ * @param count		Returns the number of entries in the table.
+ * @return		The topic table.
+ */
+extern const struct orb_metadata *const *orb_get_topics(size_t *count) __EXPORT;
+
+/**
+ * Callback of orb_fields_walk(), called for each top-level field.
+ *
+ * The type and the name point into the layout and are not NUL terminated.
+ *
+ * @param arg		The argument passed to orb_fields_walk().
+ * @param count		Number of array elements, 1 for scalars.
+ * @param offset	Offset of the field in the struct.
+ */
+typedef void (*orb_field_visitor)(void *arg, const char *type, size_t type_len, const char *name, size_t name_len,
+				  unsigned count, unsigned offset);
+
+/**
+ * Parse a field layout as found in orb_metadata::o_fields.
+ *
+ * @param fields	The field layout.
+ * @param visitor	Called for each top-level field, may be NULL.
+ * @param arg		Passed to the visitor.
+ * @return		Size of the struct described, -1 if the layout can't be parsed.
+ */
+extern int orb_fields_walk(const char *fields, orb_field_visitor visitor, void *arg) __EXPORT;
+
 __END_DECLS
 
 /* Diverse uORB header defines */ //XXX: move to better location
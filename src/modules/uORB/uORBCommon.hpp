@@ -61,5 +61,27 @@ struct orb_advertdata {
 	int *instance;
 	int priority;
 };
+
+/**
+ * Hook into the publications of a topic, registered with
+ * DeviceNode::register_callback().
+ */
+class SubscriptionCallback
+{
+public:
+	SubscriptionCallback() : _next_callback(nullptr) {}
+	virtual ~SubscriptionCallback() {}
+
+	/**
+	 * Called after every publication, in the context of the publisher,
+	 * which may be an interrupt handler on NuttX. Must not block.
+	 */
+	virtual void call() = 0;
+
+private:
+	friend class DeviceNode;
+
+	SubscriptionCallback *_next_callback;
+};
 }
 #endif // _uORBCommon_hpp_
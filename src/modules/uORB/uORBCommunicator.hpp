@@ -65,6 +65,7 @@ public:
 	 * 	globally unique.
 	 * @param msgRate
 	 * 	The max rate at which the subscriber can accept the messages.
+	 * 	Publications above it are dropped by the publisher, 0 for no limit.
 	 * @return
 	 * 	0 = success; This means the messages is successfully sent to the receiver
 	 * 		Note: This does not mean that the receiver as received it.
@@ -134,13 +135,19 @@ public:
 	 * 	globally unique.
 	 * @param msgRate
 	 * 	The max rate at which the subscriber can accept the messages.
+	 * 	Publications above it are dropped by the publisher, 0 for no limit.
+	 * @param subscriber
+	 * 	Identifies the remote subscriber for channels that connect several,
+	 * 	each gets its own rate. Adding the same subscriber again changes its
+	 * 	rate. 0 for channels with a single remote.
 	 * @return
 	 *  0 = success; This means the messages is successfully handled in the
 	 *  	handler.
 	 *  otherwise = failure.
 	 */
 
-	virtual int16_t process_add_subscription(const char *messageName, int32_t msgRateInHz) = 0;
+	virtual int16_t process_add_subscription(const char *messageName, int32_t msgRateInHz,
+			uint32_t subscriber) = 0;
 
 
 	/**
@@ -148,13 +155,15 @@ public:
 	 * @param messageName
 	 * 	This represents the uORB message Name; This message Name should be
 	 * 	globally unique.
+	 * @param subscriber
+	 * 	The remote subscriber, as passed to process_add_subscription.
 	 * @return
 	 *  0 = success; This means the messages is successfully handled in the
 	 *  	handler.
 	 *  otherwise = failure.
 	 */
 
-	virtual int16_t process_remove_subscription(const char *messageName) = 0;
+	virtual int16_t process_remove_subscription(const char *messageName, uint32_t subscriber) = 0;
 
 
 	/**
@@ -40,6 +40,7 @@
 #include "uORBUtils.hpp"
 #include "uORBManager.hpp"
 #include "uORBCommunicator.hpp"
+#include "uORBTrace.hpp"
 #include <stdlib.h>
 
 uORB::ORBMap uORB::DeviceMaster::_node_map;
@@ -59,8 +60,11 @@ uORB::DeviceNode::DeviceNode
 	_publisher(0),
 	_priority(priority),
 	_published(false),
+	_instance(path[strlen(path) - 1] - '0'),
 	_IsRemoteSubscriberPresent(false),
-	_subscriber_count(0)
+	_subscriber_count(0),
+	_callbacks(nullptr),
+	_remote(nullptr)
 {
 	// enable debug() calls
 	_debug_enabled = true;
@@ -68,6 +72,11 @@ uORB::DeviceNode::DeviceNode
 
 uORB::DeviceNode::~DeviceNode()
 {
+	if (_remote != nullptr) {
+		work_cancel(LPWORK, &_remote->work);
+		delete _remote;
+	}
+
 	if (_data != nullptr) {
 		delete[] _data;
 	}
@@ -203,6 +212,8 @@ uORB::DeviceNode::read(struct file *filp, char *buffer, size_t buflen)
 
 	irqrestore(flags);
 
+	uORB::Trace::record(uORB::Trace::COPY, _meta, _instance, sd->generation);
+
 	return _meta->o_size;
 }
 
@@ -251,9 +262,22 @@ uORB::DeviceNode::write(struct file *filp, const char *buffer, size_t buflen)
 	_last_update = hrt_absolute_time();
 	_generation++;
 
+	uORB::Trace::record(uORB::Trace::PUBLISH, _meta, _instance, _generation);
+
 	/* notify any poll waiters */
 	poll_notify(POLLIN);
 
+	/* and queue the work items triggered by this topic */
+	if (_callbacks != nullptr) {
+		flags = irqsave();
+
+		for (uORB::SubscriptionCallback *cb = _callbacks; cb != nullptr; cb = cb->_next_callback) {
+			cb->call();
+		}
+
+		irqrestore(flags);
+	}
+
 	_published = true;
 
 	return _meta->o_size;
@@ -326,7 +350,22 @@ uORB::DeviceNode::publish
 	uORBCommunicator::IChannel *ch = uORB::Manager::get_instance()->get_uorb_communicator();
 
 	if (ch != nullptr) {
-		if (ch->send_message(meta->o_name, meta->o_size, (uint8_t *)data) != 0) {
+		/* without remote subscribers there is no limit */
+		hrt_abstime trailing_delay = 0;
+		bool forward = true;
+		irqstate_t flags = irqsave();
+
+		if (devnode->_remote != nullptr) {
+			forward = devnode->_remote->forwarder.should_forward(data, false, &trailing_delay);
+		}
+
+		irqrestore(flags);
+
+		if (trailing_delay != 0) {
+			devnode->schedule_remote_trailing(trailing_delay);
+		}
+
+		if (forward && ch->send_message(meta->o_name, meta->o_size, (uint8_t *)data) != 0) {
 			warnx("[uORB::DeviceNode::publish(%d)]: Error Sending [%s] topic data over comm_channel",
 			      __LINE__, meta->o_name);
 			return ERROR;
@@ -360,6 +399,7 @@ uORB::DeviceNode::poll_notify_one(struct pollfd *fds, pollevent_t events)
 	 * If the topic looks updated to the subscriber, go ahead and notify them.
 	 */
 	if (appears_updated(sd)) {
+		uORB::Trace::record(uORB::Trace::NOTIFY, _meta, _instance, _generation);
 		CDev::poll_notify_one(fds, events);
 	}
 }
@@ -461,6 +501,77 @@ uORB::DeviceNode::update_deferred_trampoline(void *arg)
 	node->update_deferred();
 }
 
+void
+uORB::DeviceNode::schedule_remote_trailing(hrt_abstime delay)
+{
+	/* at least one tick, the trailing check reschedules if it's early */
+	uint32_t ticks = USEC2TICK(delay);
+	work_queue(LPWORK, &_remote->work, &uORB::DeviceNode::remote_trailing_trampoline, this, (ticks > 0) ? ticks : 1);
+}
+
+void
+uORB::DeviceNode::remote_trailing_trampoline(void *arg)
+{
+	uORB::DeviceNode *node = (uORB::DeviceNode *)arg;
+	uORBCommunicator::IChannel *ch = uORB::Manager::get_instance()->get_uorb_communicator();
+	hrt_abstime trailing_delay;
+
+	irqstate_t flags = irqsave();
+	bool send = node->_remote->forwarder.trailing_due(node->_data, &trailing_delay);
+
+	/* a publication may land while sending, don't send a torn sample */
+	if (send) {
+		memcpy(node->_remote->data, node->_data, node->_meta->o_size);
+	}
+
+	irqrestore(flags);
+
+	if (trailing_delay != 0) {
+		node->schedule_remote_trailing(trailing_delay);
+	}
+
+	if (send && ch != nullptr) {
+		ch->send_message(node->_meta->o_name, node->_meta->o_size, node->_remote->data);
+	}
+}
+
+uORB::DeviceNode::Remote *
+uORB::DeviceNode::init_remote()
+{
+	if (_remote != nullptr) {
+		return _remote;
+	}
+
+	Remote *remote = new Remote(_meta, _instance);
+
+	if (remote == nullptr) {
+		return nullptr;
+	}
+
+	remote->data = new uint8_t[_meta->o_size];
+
+	if (remote->data == nullptr) {
+		delete remote;
+		return nullptr;
+	}
+
+	memset(&remote->work, 0, sizeof(remote->work));
+
+	/* the communicator and the shell may race here */
+	irqstate_t flags = irqsave();
+
+	if (_remote == nullptr) {
+		_remote = remote;
+		remote = nullptr;
+	}
+
+	irqrestore(flags);
+
+	delete remote;
+
+	return _remote;
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 void uORB::DeviceNode::add_internal_subscriber()
@@ -469,7 +580,7 @@ void uORB::DeviceNode::add_internal_subscriber()
 	uORBCommunicator::IChannel *ch = uORB::Manager::get_instance()->get_uorb_communicator();
 
 	if (ch != nullptr && _subscriber_count > 0) {
-		ch->add_subscription(_meta->o_name, 1);
+		ch->add_subscription(_meta->o_name, 0);
 	}
 }
 
@@ -495,24 +606,113 @@ bool uORB::DeviceNode::is_published()
 
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
-int16_t uORB::DeviceNode::process_add_subscription(int32_t rateInHz)
+void uORB::DeviceNode::register_callback(uORB::SubscriptionCallback *cb)
+{
+	irqstate_t flags = irqsave();
+	cb->_next_callback = _callbacks;
+	_callbacks = cb;
+	irqrestore(flags);
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+void uORB::DeviceNode::unregister_callback(uORB::SubscriptionCallback *cb)
+{
+	irqstate_t flags = irqsave();
+
+	for (uORB::SubscriptionCallback **prev = &_callbacks; *prev != nullptr; prev = &(*prev)->_next_callback) {
+		if (*prev == cb) {
+			*prev = cb->_next_callback;
+			cb->_next_callback = nullptr;
+			break;
+		}
+	}
+
+	irqrestore(flags);
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+int16_t uORB::DeviceNode::process_add_subscription(int32_t rateInHz, uint32_t subscriber)
 {
 	// if there is already data in the node, send this out to
 	// the remote entity.
 	// send the data to the remote entity.
 	uORBCommunicator::IChannel *ch = uORB::Manager::get_instance()->get_uorb_communicator();
+	Remote *remote = init_remote();
+
+	if (remote == nullptr) {
+		warnx("[uORB::DeviceNode::process_add_subscription(%d)]: out of memory for [%s]", __LINE__, _meta->o_name);
+		return -ENOMEM;
+	}
+
+	/* copy of the current data, sent without the lock held */
+	uint8_t *data = (ch != nullptr) ? new uint8_t[_meta->o_size] : nullptr;
+	bool send = false;
+
+	irqstate_t flags = irqsave();
+	remote->forwarder.add_subscriber(subscriber, rateInHz);
+
+	if (_data != nullptr && data != nullptr) { // _data will not be null if there is a publisher.
+		hrt_abstime trailing_delay;
+		remote->forwarder.should_forward(_data, true, &trailing_delay);
+		memcpy(data, _data, _meta->o_size);
+		send = true;
+	}
+
+	irqrestore(flags);
+
+	if (send) {
+		ch->send_message(_meta->o_name, _meta->o_size, data);
+	}
+
+	delete[] data;
+
+	return OK;
+}
 
-	if (_data != nullptr && ch != nullptr) { // _data will not be null if there is a publisher.
-		ch->send_message(_meta->o_name, _meta->o_size, _data);
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+int16_t uORB::DeviceNode::process_remove_subscription(uint32_t subscriber)
+{
+	irqstate_t flags = irqsave();
+
+	if (_remote != nullptr) {
+		_remote->forwarder.remove_subscriber(subscriber);
 	}
 
+	irqrestore(flags);
+
 	return OK;
 }
 
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
-int16_t uORB::DeviceNode::process_remove_subscription()
+int uORB::DeviceNode::set_remote_only_changed(bool enable)
 {
+	uint8_t *buffer = nullptr;
+	Remote *remote = init_remote();
+
+	if (remote == nullptr) {
+		return -ENOMEM;
+	}
+
+	if (enable) {
+		buffer = new uint8_t[_meta->o_size];
+
+		if (buffer == nullptr) {
+			return -ENOMEM;
+		}
+	}
+
+	irqstate_t flags = irqsave();
+	buffer = remote->forwarder.set_last_data_buffer(buffer);
+	irqrestore(flags);
+
+	if (buffer != nullptr) {
+		delete[] buffer;
+	}
+
 	return OK;
 }
 
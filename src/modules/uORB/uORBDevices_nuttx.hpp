@@ -39,6 +39,8 @@
 #include <stdlib.h>
 #include "ORBMap.hpp"
 #include "uORBCommon.hpp"
+#include "uORBRemoteForwarder.hpp"
+#include <px4_workqueue.h>
 
 
 namespace uORB
@@ -126,16 +128,18 @@ public:
 	 * processes a request for add subscription from remote
 	 * @param rateInHz
 	 *   Specifies the desired rate for the message.
+	 * @param subscriber
+	 *   Identifies the remote subscriber within the channel.
 	 * @return
 	 *   0 = success
 	 *   otherwise failure.
 	 */
-	int16_t process_add_subscription(int32_t rateInHz);
+	int16_t process_add_subscription(int32_t rateInHz, uint32_t subscriber);
 
 	/**
 	 * processes a request to remove a subscription from remote.
 	 */
-	int16_t process_remove_subscription();
+	int16_t process_remove_subscription(uint32_t subscriber);
 
 	/**
 	 * processed the received data message from remote.
@@ -166,6 +170,30 @@ public:
 	 * and publish to this node or if another node should be tried. */
 	bool is_published();
 
+	/**
+	 * Only forward publications to the remote subscribers if they differ
+	 * from the last one sent.
+	 * @return
+	 *   OK on success, -ENOMEM if out of memory.
+	 */
+	int set_remote_only_changed(bool enable);
+
+	/**
+	 * Call cb after every publication until it is unregistered.
+	 */
+	void register_callback(uORB::SubscriptionCallback *cb);
+
+	/**
+	 * Stop calling cb. Once this returns cb is not called any more.
+	 */
+	void unregister_callback(uORB::SubscriptionCallback *cb);
+
+	/**
+	 * The filter of the publications forwarded to the remote subscribers,
+	 * nullptr if there never was a remote subscriber.
+	 */
+	const uORB::RemoteForwarder *remote_forwarder() const { return (_remote != nullptr) ? &_remote->forwarder : nullptr; }
+
 protected:
 	virtual pollevent_t poll_state(struct file *filp);
 	virtual void poll_notify_one(struct pollfd *fds, pollevent_t events);
@@ -187,6 +215,7 @@ private:
 	pid_t     _publisher; /**< if nonzero, current publisher */
 	const int   _priority;  /**< priority of topic */
 	bool _published;  /**< has ever data been published */
+	const uint8_t _instance; /**< multi-instance index of the topic */
 
 private: // private class methods.
 
@@ -199,6 +228,30 @@ private: // private class methods.
 	bool    _IsRemoteSubscriberPresent;
 	int32_t _subscriber_count;
 
+	uORB::SubscriptionCallback *_callbacks; /**< called after every publication */
+
+	/**
+	 * Forwarding to the remote subscribers. Most nodes never have one,
+	 * so this is only allocated with the first remote subscription.
+	 */
+	struct Remote {
+		Remote(const struct orb_metadata *meta, uint8_t instance) : forwarder(meta, instance), data(nullptr) {}
+		~Remote() { delete[] data; }
+
+		uORB::RemoteForwarder forwarder; /**< filter of the publications sent to remote subscribers */
+		struct work_s work; /**< sends the publication held back by the rate limit */
+		uint8_t *data; /**< copy of the held back publication, sent without the lock held */
+	};
+
+	Remote *_remote;
+
+	/**
+	 * Allocate the remote forwarding state if not done yet.
+	 * @return
+	 *   The state, nullptr if out of memory.
+	 */
+	Remote    *init_remote();
+
 	/**
 	 * Perform a deferred update for a rate-limited subscriber.
 	 */
@@ -211,6 +264,19 @@ private: // private class methods.
 	 */
 	static void   update_deferred_trampoline(void *arg);
 
+	/**
+	 * Send the publication held back by the remote rate limit after
+	 * the given delay.
+	 */
+	void      schedule_remote_trailing(hrt_abstime delay);
+
+	/**
+	 * Bridge from the work queue to the trailing send.
+	 *
+	 * void *arg    ORBDevNode pointer of which the held back publication is sent.
+	 */
+	static void   remote_trailing_trampoline(void *arg);
+
 	/**
 	 * Check whether a topic appears updated to a subscriber.
 	 *
@@ -41,6 +41,7 @@
 #include "uORBUtils.hpp"
 #include "uORBManager.hpp"
 #include "uORBCommunicator.hpp"
+#include "uORBTrace.hpp"
 #include <stdlib.h>
 
 std::map<std::string, uORB::DeviceNode *> uORB::DeviceMaster::_node_map;
@@ -69,7 +70,10 @@ uORB::DeviceNode::DeviceNode(const struct orb_metadata *meta, const char *name,
 	_publisher(0),
 	_priority(priority),
 	_published(false),
-	_subscriber_count(0)
+	_instance(path[strlen(path) - 1] - '0'),
+	_subscriber_count(0),
+	_callbacks(nullptr),
+	_remote(nullptr)
 {
 	// enable debug() calls
 	//_debug_enabled = true;
@@ -77,6 +81,11 @@ uORB::DeviceNode::DeviceNode(const struct orb_metadata *meta, const char *name,
 
 uORB::DeviceNode::~DeviceNode()
 {
+	if (_remote != nullptr) {
+		work_cancel(LPWORK, &_remote->work);
+		delete _remote;
+	}
+
 	if (_data != nullptr) {
 		delete[] _data;
 	}
@@ -216,6 +225,8 @@ uORB::DeviceNode::read(device::file_t *filp, char *buffer, size_t buflen)
 
 	unlock();
 
+	uORB::Trace::record(uORB::Trace::COPY, _meta, _instance, sd->generation);
+
 	return _meta->o_size;
 }
 
@@ -262,9 +273,22 @@ uORB::DeviceNode::write(device::file_t *filp, const char *buffer, size_t buflen)
 	_last_update = hrt_absolute_time();
 	_generation++;
 
+	uORB::Trace::record(uORB::Trace::PUBLISH, _meta, _instance, _generation);
+
 	/* notify any poll waiters */
 	poll_notify(POLLIN);
 
+	/* and queue the work items triggered by this topic */
+	if (_callbacks != nullptr) {
+		lock();
+
+		for (uORB::SubscriptionCallback *cb = _callbacks; cb != nullptr; cb = cb->_next_callback) {
+			cb->call();
+		}
+
+		unlock();
+	}
+
 	_published = true;
 
 	return _meta->o_size;
@@ -341,7 +365,22 @@ uORB::DeviceNode::publish(const orb_metadata *meta, orb_advert_t handle, const v
 	uORBCommunicator::IChannel *ch = uORB::Manager::get_instance()->get_uorb_communicator();
 
 	if (ch != nullptr) {
-		if (ch->send_message(meta->o_name, meta->o_size, (uint8_t *)data) != 0) {
+		/* without remote subscribers there is no limit */
+		hrt_abstime trailing_delay = 0;
+		bool forward = true;
+		devnode->lock();
+
+		if (devnode->_remote != nullptr) {
+			forward = devnode->_remote->forwarder.should_forward(data, false, &trailing_delay);
+		}
+
+		devnode->unlock();
+
+		if (trailing_delay != 0) {
+			devnode->schedule_remote_trailing(trailing_delay);
+		}
+
+		if (forward && ch->send_message(meta->o_name, meta->o_size, (uint8_t *)data) != 0) {
 			warnx("[uORB::DeviceNode::publish(%d)]: Error Sending [%s] topic data over comm_channel",
 			      __LINE__, meta->o_name);
 			return ERROR;
@@ -377,10 +416,33 @@ uORB::DeviceNode::poll_notify_one(px4_pollfd_struct_t *fds, pollevent_t events)
 	 * If the topic looks updated to the subscriber, go ahead and notify them.
 	 */
 	if (appears_updated(sd)) {
+		uORB::Trace::record(uORB::Trace::NOTIFY, _meta, _instance, _generation);
 		VDev::poll_notify_one(fds, events);
 	}
 }
 
+int
+uORB::DeviceNode::check_updated(const int *handles, bool *updated, unsigned n)
+{
+	int ret = PX4_OK;
+
+	for (unsigned i = 0; i < n; i++) {
+		device::file_t *filp = device::VDev::getFile(handles[i]);
+
+		if (filp == nullptr) {
+			updated[i] = false;
+			ret = PX4_ERROR;
+			continue;
+		}
+
+		/* orb_subscribe handles always refer to a DeviceNode */
+		DeviceNode *node = static_cast<DeviceNode *>((device::VDev *)filp->vdev);
+		updated[i] = node->appears_updated(node->filp_to_sd(filp));
+	}
+
+	return ret;
+}
+
 bool
 uORB::DeviceNode::appears_updated(SubscriberData *sd)
 {
@@ -474,6 +536,77 @@ uORB::DeviceNode::update_deferred_trampoline(void *arg)
 	node->update_deferred();
 }
 
+void
+uORB::DeviceNode::schedule_remote_trailing(hrt_abstime delay)
+{
+	/* at least one tick, the trailing check reschedules if it's early */
+	uint32_t ticks = USEC2TICK(delay);
+	work_queue(LPWORK, &_remote->work, &uORB::DeviceNode::remote_trailing_trampoline, this, (ticks > 0) ? ticks : 1);
+}
+
+void
+uORB::DeviceNode::remote_trailing_trampoline(void *arg)
+{
+	uORB::DeviceNode *node = (uORB::DeviceNode *)arg;
+	uORBCommunicator::IChannel *ch = uORB::Manager::get_instance()->get_uorb_communicator();
+	hrt_abstime trailing_delay;
+
+	node->lock();
+	bool send = node->_remote->forwarder.trailing_due(node->_data, &trailing_delay);
+
+	/* a publication may land while sending, don't send a torn sample */
+	if (send) {
+		memcpy(node->_remote->data, node->_data, node->_meta->o_size);
+	}
+
+	node->unlock();
+
+	if (trailing_delay != 0) {
+		node->schedule_remote_trailing(trailing_delay);
+	}
+
+	if (send && ch != nullptr) {
+		ch->send_message(node->_meta->o_name, node->_meta->o_size, node->_remote->data);
+	}
+}
+
+uORB::DeviceNode::Remote *
+uORB::DeviceNode::init_remote()
+{
+	if (_remote != nullptr) {
+		return _remote;
+	}
+
+	Remote *remote = new Remote(_meta, _instance);
+
+	if (remote == nullptr) {
+		return nullptr;
+	}
+
+	remote->data = new uint8_t[_meta->o_size];
+
+	if (remote->data == nullptr) {
+		delete remote;
+		return nullptr;
+	}
+
+	memset(&remote->work, 0, sizeof(remote->work));
+
+	/* the communicator and the shell may race here */
+	lock();
+
+	if (_remote == nullptr) {
+		_remote = remote;
+		remote = nullptr;
+	}
+
+	unlock();
+
+	delete remote;
+
+	return _remote;
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 void uORB::DeviceNode::add_internal_subscriber()
@@ -482,7 +615,7 @@ void uORB::DeviceNode::add_internal_subscriber()
 	uORBCommunicator::IChannel *ch = uORB::Manager::get_instance()->get_uorb_communicator();
 
 	if (ch != nullptr && _subscriber_count > 0) {
-		ch->add_subscription(_meta->o_name, 1);
+		ch->add_subscription(_meta->o_name, 0);
 	}
 }
 
@@ -508,27 +641,116 @@ bool uORB::DeviceNode::is_published()
 
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
-int16_t uORB::DeviceNode::process_add_subscription(int32_t rateInHz)
+void uORB::DeviceNode::register_callback(uORB::SubscriptionCallback *cb)
+{
+	lock();
+	cb->_next_callback = _callbacks;
+	_callbacks = cb;
+	unlock();
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+void uORB::DeviceNode::unregister_callback(uORB::SubscriptionCallback *cb)
+{
+	lock();
+
+	for (uORB::SubscriptionCallback **prev = &_callbacks; *prev != nullptr; prev = &(*prev)->_next_callback) {
+		if (*prev == cb) {
+			*prev = cb->_next_callback;
+			cb->_next_callback = nullptr;
+			break;
+		}
+	}
+
+	unlock();
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+int16_t uORB::DeviceNode::process_add_subscription(int32_t rateInHz, uint32_t subscriber)
 {
 	// if there is already data in the node, send this out to
 	// the remote entity.
 	// send the data to the remote entity.
 	uORBCommunicator::IChannel *ch = uORB::Manager::get_instance()->get_uorb_communicator();
+	Remote *remote = init_remote();
+
+	if (remote == nullptr) {
+		warnx("[uORB::DeviceNode::process_add_subscription(%d)]: out of memory for [%s]", __LINE__, _meta->o_name);
+		return -ENOMEM;
+	}
+
+	/* copy of the current data, sent without the lock held */
+	uint8_t *data = (ch != nullptr) ? new uint8_t[_meta->o_size] : nullptr;
+	bool send = false;
+
+	lock();
+	remote->forwarder.add_subscriber(subscriber, rateInHz);
 
-	if (_data != nullptr && ch != nullptr) { // _data will not be null if there is a publisher.
-		ch->send_message(_meta->o_name, _meta->o_size, _data);
+	if (_data != nullptr && data != nullptr) { // _data will not be null if there is a publisher.
+		hrt_abstime trailing_delay;
+		remote->forwarder.should_forward(_data, true, &trailing_delay);
+		memcpy(data, _data, _meta->o_size);
+		send = true;
 	}
 
+	unlock();
+
+	if (send) {
+		ch->send_message(_meta->o_name, _meta->o_size, data);
+	}
+
+	delete[] data;
+
 	return 0;
 }
 
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
-int16_t uORB::DeviceNode::process_remove_subscription()
+int16_t uORB::DeviceNode::process_remove_subscription(uint32_t subscriber)
 {
+	lock();
+
+	if (_remote != nullptr) {
+		_remote->forwarder.remove_subscriber(subscriber);
+	}
+
+	unlock();
+
 	return 0;
 }
 
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+int uORB::DeviceNode::set_remote_only_changed(bool enable)
+{
+	uint8_t *buffer = nullptr;
+	Remote *remote = init_remote();
+
+	if (remote == nullptr) {
+		return -ENOMEM;
+	}
+
+	if (enable) {
+		buffer = new uint8_t[_meta->o_size];
+
+		if (buffer == nullptr) {
+			return -ENOMEM;
+		}
+	}
+
+	lock();
+	buffer = remote->forwarder.set_last_data_buffer(buffer);
+	unlock();
+
+	if (buffer != nullptr) {
+		delete[] buffer;
+	}
+
+	return OK;
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 int16_t uORB::DeviceNode::process_received_message(int32_t length, uint8_t *data)
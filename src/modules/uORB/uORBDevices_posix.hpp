@@ -38,6 +38,8 @@
 #include <string>
 #include <map>
 #include "uORBCommon.hpp"
+#include "uORBRemoteForwarder.hpp"
+#include <px4_workqueue.h>
 
 namespace uORB
 {
@@ -59,20 +61,33 @@ public:
 
 	static ssize_t    publish(const orb_metadata *meta, orb_advert_t handle, const void *data);
 
+	/**
+	 * Check a batch of subscriptions for updates, with the same result as
+	 * ORBIOCUPDATED on each of them but without an ioctl per handle.
+	 *
+	 * @param handles Handles returned from orb_subscribe.
+	 * @param updated Set per handle like orb_check.
+	 * @param n       Number of handles.
+	 * @return        OK if all handles were valid, ERROR otherwise.
+	 */
+	static int    check_updated(const int *handles, bool *updated, unsigned n);
+
 	/**
 	 * processes a request for add subscription from remote
 	 * @param rateInHz
 	 *   Specifies the desired rate for the message.
+	 * @param subscriber
+	 *   Identifies the remote subscriber within the channel.
 	 * @return
 	 *   0 = success
 	 *   otherwise failure.
 	 */
-	int16_t process_add_subscription(int32_t rateInHz);
+	int16_t process_add_subscription(int32_t rateInHz, uint32_t subscriber);
 
 	/**
 	 * processes a request to remove a subscription from remote.
 	 */
-	int16_t process_remove_subscription();
+	int16_t process_remove_subscription(uint32_t subscriber);
 
 	/**
 	 * processed the received data message from remote.
@@ -103,6 +118,30 @@ public:
 	 * and publish to this node or if another node should be tried. */
 	bool is_published();
 
+	/**
+	 * Only forward publications to the remote subscribers if they differ
+	 * from the last one sent.
+	 * @return
+	 *   OK on success, -ENOMEM if out of memory.
+	 */
+	int set_remote_only_changed(bool enable);
+
+	/**
+	 * Call cb after every publication until it is unregistered.
+	 */
+	void register_callback(uORB::SubscriptionCallback *cb);
+
+	/**
+	 * Stop calling cb. Once this returns cb is not called any more.
+	 */
+	void unregister_callback(uORB::SubscriptionCallback *cb);
+
+	/**
+	 * The filter of the publications forwarded to the remote subscribers,
+	 * nullptr if there never was a remote subscriber.
+	 */
+	const uORB::RemoteForwarder *remote_forwarder() const { return (_remote != nullptr) ? &_remote->forwarder : nullptr; }
+
 protected:
 	virtual pollevent_t poll_state(device::file_t *filp);
 	virtual void    poll_notify_one(px4_pollfd_struct_t *fds, pollevent_t events);
@@ -124,11 +163,36 @@ private:
 	unsigned long     _publisher; /**< if nonzero, current publisher */
 	const int   _priority;  /**< priority of topic */
 	bool _published;  /**< has ever data been published */
+	const uint8_t _instance; /**< multi-instance index of the topic */
 
 	SubscriberData    *filp_to_sd(device::file_t *filp);
 
 	int32_t _subscriber_count;
 
+	uORB::SubscriptionCallback *_callbacks; /**< called after every publication */
+
+	/**
+	 * Forwarding to the remote subscribers. Most nodes never have one,
+	 * so this is only allocated with the first remote subscription.
+	 */
+	struct Remote {
+		Remote(const struct orb_metadata *meta, uint8_t instance) : forwarder(meta, instance), data(nullptr) {}
+		~Remote() { delete[] data; }
+
+		uORB::RemoteForwarder forwarder; /**< filter of the publications sent to remote subscribers */
+		struct work_s work; /**< sends the publication held back by the rate limit */
+		uint8_t *data; /**< copy of the held back publication, sent without the lock held */
+	};
+
+	Remote *_remote;
+
+	/**
+	 * Allocate the remote forwarding state if not done yet.
+	 * @return
+	 *   The state, nullptr if out of memory.
+	 */
+	Remote    *init_remote();
+
 	/**
 	 * Perform a deferred update for a rate-limited subscriber.
 	 */
@@ -141,6 +205,19 @@ private:
 	 */
 	static void   update_deferred_trampoline(void *arg);
 
+	/**
+	 * Send the publication held back by the remote rate limit after
+	 * the given delay.
+	 */
+	void      schedule_remote_trailing(hrt_abstime delay);
+
+	/**
+	 * Bridge from the work queue to the trailing send.
+	 *
+	 * void *arg    ORBDevNode pointer of which the held back publication is sent.
+	 */
+	static void   remote_trailing_trampoline(void *arg);
+
 	/**
 	 * Check whether a topic appears updated to a subscriber.
 	 *
@@ -0,0 +1,166 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file uORBFields.cpp
+ *
+ * Parser of the topic field layouts, see orb_metadata::o_fields.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "uORB.h"
+
+/* maximum nesting depth of messages in a field layout */
+#define MAX_NESTING_DEPTH 4
+
+static const struct {
+	const char *name;
+	int size;
+} builtin_types[] = {
+	{"int8_t", 1},
+	{"uint8_t", 1},
+	{"bool", 1},
+	{"char", 1},
+	{"int16_t", 2},
+	{"uint16_t", 2},
+	{"int32_t", 4},
+	{"uint32_t", 4},
+	{"float", 4},
+	{"int64_t", 8},
+	{"uint64_t", 8},
+	{"double", 8}
+};
+
+static int builtin_type_size(const char *type, size_t len)
+{
+	for (unsigned i = 0; i < sizeof(builtin_types) / sizeof(builtin_types[0]); i++) {
+		if (strlen(builtin_types[i].name) == len && strncmp(builtin_types[i].name, type, len) == 0) {
+			return builtin_types[i].size;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * Find the fields of a nested message, listed as "\n<type>:<fields>".
+ */
+static const char *find_nested_fields(const char *layout, const char *type, size_t len)
+{
+	const char *p = layout;
+
+	while ((p = strchr(p, '\n')) != nullptr) {
+		p++;
+
+		if (strncmp(p, type, len) == 0 && p[len] == ':') {
+			return p + len + 1;
+		}
+	}
+
+	return nullptr;
+}
+
+/**
+ * Size of the struct described by the fields, which end at '\n' or the end
+ * of the layout.
+ *
+ * @return		Size in bytes, -1 if the fields can't be parsed
+ */
+static int fields_size(const char *layout, const char *fields, int depth, orb_field_visitor visitor, void *arg)
+{
+	const char *p = fields;
+	int size = 0;
+
+	while (*p != '\0' && *p != '\n') {
+		const char *type = p;
+		size_t type_len = strcspn(p, "[ ;\n");
+		unsigned long count = 1;
+		p += type_len;
+
+		if (*p == '[') {
+			char *end;
+			count = strtoul(p + 1, &end, 10);
+
+			if (*end != ']') {
+				return -1;
+			}
+
+			p = end + 1;
+		}
+
+		if (*p != ' ' || type_len == 0) {
+			return -1;
+		}
+
+		const char *name = p + 1;
+		p = strchr(p, ';');
+
+		if (p == nullptr) {
+			return -1;
+		}
+
+		size_t name_len = p - name;
+		p++;
+
+		int type_size = builtin_type_size(type, type_len);
+
+		if (type_size < 0) {
+			const char *nested = find_nested_fields(layout, type, type_len);
+
+			if (nested == nullptr || depth >= MAX_NESTING_DEPTH) {
+				return -1;
+			}
+
+			type_size = fields_size(layout, nested, depth + 1, nullptr, nullptr);
+
+			if (type_size < 0) {
+				return -1;
+			}
+		}
+
+		if (visitor != nullptr) {
+			visitor(arg, type, type_len, name, name_len, count, size);
+		}
+
+		size += type_size * count;
+	}
+
+	return size;
+}
+
+int orb_fields_walk(const char *fields, orb_field_visitor visitor, void *arg)
+{
+	return fields_size(fields, fields, 0, visitor, arg);
+}
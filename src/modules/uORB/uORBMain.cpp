@@ -35,6 +35,9 @@
 #include "uORBDevices.hpp"
 #include "uORB.h"
 #include "uORBCommon.hpp"
+#include "uORBUtils.hpp"
+#include "uORBTrace.hpp"
+#include <stdlib.h>
 
 #ifndef __PX4_QURT
 #include "uORBTest_UnitTest.hpp"
@@ -45,7 +48,19 @@ extern "C" { __EXPORT int uorb_main(int argc, char *argv[]); }
 static uORB::DeviceMaster *g_dev = nullptr;
 static void usage()
 {
-	warnx("Usage: uorb 'start', 'test', 'latency_test' or 'status'");
+	warnx("Usage: uorb 'start', 'test', 'latency_test', 'status', 'forward <topic> changed|all' or\n"
+	      "\t'trace start [entries]|stop|status|dump [file]'");
+}
+
+static uORB::DeviceNode *remote_node(const char *name, int instance)
+{
+	char nodepath[uORB::orb_maxpath];
+
+	if (uORB::Utils::node_mkpath(nodepath, uORB::PUBSUB, name, instance) != OK) {
+		return nullptr;
+	}
+
+	return uORB::DeviceMaster::GetDeviceNode(nodepath);
 }
 
 
@@ -122,9 +137,74 @@ uorb_main(int argc, char *argv[])
 	 * Print driver information.
 	 */
 	if (!strcmp(argv[1], "status")) {
+		size_t count;
+		const struct orb_metadata *const *topics = orb_get_topics(&count);
+
+		/* forwarding to remote subscribers, a max rate of 0 means no limit */
+		for (size_t i = 0; i < count; i++) {
+			for (int instance = 0; instance < ORB_MULTI_MAX_INSTANCES; instance++) {
+				uORB::DeviceNode *node = remote_node(topics[i]->o_name, instance);
+
+				if (node != nullptr && node->remote_forwarder() != nullptr) {
+					node->remote_forwarder()->print_status();
+				}
+			}
+		}
+
 		return OK;
 	}
 
+	/*
+	 * Only forward the publications of a topic to remote subscribers if they changed.
+	 */
+	if (!strcmp(argv[1], "forward")) {
+		if (argc < 4 || (strcmp(argv[3], "changed") && strcmp(argv[3], "all"))) {
+			usage();
+			return -EINVAL;
+		}
+
+		int ret = -ENOENT;
+
+		for (int instance = 0; instance < ORB_MULTI_MAX_INSTANCES; instance++) {
+			uORB::DeviceNode *node = remote_node(argv[2], instance);
+
+			if (node != nullptr) {
+				ret = node->set_remote_only_changed(!strcmp(argv[3], "changed"));
+
+				if (ret != OK) {
+					break;
+				}
+			}
+		}
+
+		if (ret == -ENOENT) {
+			warnx("topic %s not advertised", argv[2]);
+		}
+
+		return ret;
+	}
+
+	/*
+	 * Record the topic publications, copies and poll wakeups.
+	 */
+	if (!strcmp(argv[1], "trace")) {
+		if (argc > 2 && !strcmp(argv[2], "start")) {
+			unsigned entries = (argc > 3) ? strtoul(argv[3], nullptr, 0) : uORB::Trace::DEFAULT_ENTRIES;
+			return uORB::Trace::start(entries);
+
+		} else if (argc > 2 && !strcmp(argv[2], "stop")) {
+			uORB::Trace::stop();
+			return OK;
+
+		} else if (argc > 2 && !strcmp(argv[2], "status")) {
+			uORB::Trace::print_status();
+			return OK;
+
+		} else if (argc > 2 && !strcmp(argv[2], "dump")) {
+			return uORB::Trace::dump((argc > 3) ? argv[3] : PX4_ROOTFSDIR"/fs/microsd/uorb_trace.json");
+		}
+	}
+
 	usage();
 	return -EINVAL;
 }
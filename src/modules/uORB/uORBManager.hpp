@@ -240,6 +240,21 @@ public:
 	 */
 	int  orb_check(int handle, bool *updated) ;
 
+	/**
+	 * Check a set of subscriptions for updates in one call.
+	 *
+	 * Equivalent to calling orb_check on each handle. On POSIX the
+	 * subscriptions are inspected directly instead of going through the
+	 * driver once per handle. On NuttX it is one ioctl per handle.
+	 *
+	 * @param handles Handles returned from orb_subscribe.
+	 * @param updated Set per handle like orb_check.
+	 * @param n       Number of handles.
+	 * @return    OK if the check was successful for all handles, ERROR
+	 *      otherwise with errno set accordingly.
+	 */
+	int  orb_check_multi(const int *handles, bool *updated, unsigned n) ;
+
 	/**
 	 * Return the last time that the topic was updated.
 	 *
@@ -361,25 +376,29 @@ private: //class methods
 	   *  globally unique.
 	   * @param msgRate
 	   *  The max rate at which the subscriber can accept the messages.
+	   * @param subscriber
+	   *  Identifies the remote subscriber within the channel.
 	   * @return
 	   *  0 = success; This means the messages is successfully handled in the
 	   *    handler.
 	   *  otherwise = failure.
 	   */
 	virtual int16_t process_add_subscription(const char *messageName,
-			int32_t msgRateInHz);
+			int32_t msgRateInHz, uint32_t subscriber);
 
 	/**
 	 * Interface to process a received control msg to remove subscription
 	 * @param messageName
 	 *  This represents the uORB message Name; This message Name should be
 	 *  globally unique.
+	 * @param subscriber
+	 *  The remote subscriber, as passed to process_add_subscription.
 	 * @return
 	 *  0 = success; This means the messages is successfully handled in the
 	 *    handler.
 	 *  otherwise = failure.
 	 */
-	virtual int16_t process_remove_subscription(const char *messageName);
+	virtual int16_t process_remove_subscription(const char *messageName, uint32_t subscriber);
 
 	/**
 	 * Interface to process the received data message.
@@ -167,6 +167,16 @@ int uORB::Manager::orb_check(int handle, bool *updated)
 	return px4_ioctl(handle, ORBIOCUPDATED, (unsigned long)(uintptr_t)updated);
 }
 
+int uORB::Manager::orb_check_multi(const int *handles, bool *updated, unsigned n)
+{
+	if (uORB::DeviceNode::check_updated(handles, updated, n) != PX4_OK) {
+		errno = EBADF;
+		return PX4_ERROR;
+	}
+
+	return PX4_OK;
+}
+
 int uORB::Manager::orb_stat(int handle, uint64_t *time)
 {
 	return px4_ioctl(handle, ORBIOCLASTUPDATE, (unsigned long)(uintptr_t)time);
@@ -325,30 +335,34 @@ uORBCommunicator::IChannel *uORB::Manager::get_uorb_communicator(void)
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 int16_t uORB::Manager::process_add_subscription(const char *messageName,
-		int32_t msgRateInHz)
+		int32_t msgRateInHz, uint32_t subscriber)
 {
 	warnx("[posix-uORB::Manager::process_add_subscription(%d)] entering Manager_process_add_subscription: name: %s",
 	      __LINE__, messageName);
 	int16_t rc = 0;
 	_remote_subscriber_topics.insert(messageName);
-	char nodepath[orb_maxpath];
-	int ret = uORB::Utils::node_mkpath(nodepath, PUBSUB, messageName);
+	bool found = false;
 
-	if (ret == OK) {
-		// get the node name.
-		uORB::DeviceNode *node = uORB::DeviceMaster::GetDeviceNode(nodepath);
+	// every instance has its own forwarding state
+	for (int instance = 0; instance < ORB_MULTI_MAX_INSTANCES; instance++) {
+		char nodepath[orb_maxpath];
 
-		if (node == nullptr) {
-			warnx("[posix-uORB::Manager::process_add_subscription(%d)]DeviceNode(%s) not created yet",
-			      __LINE__, messageName);
+		if (uORB::Utils::node_mkpath(nodepath, PUBSUB, messageName, instance) != OK) {
+			rc = -1;
+			break;
+		}
 
-		} else {
-			// node is present.
-			node->process_add_subscription(msgRateInHz);
+		uORB::DeviceNode *node = uORB::DeviceMaster::GetDeviceNode(nodepath);
+
+		if (node != nullptr) {
+			node->process_add_subscription(msgRateInHz, subscriber);
+			found = true;
 		}
+	}
 
-	} else {
-		rc = -1;
+	if (rc == 0 && !found) {
+		warnx("[posix-uORB::Manager::process_add_subscription(%d)]DeviceNode(%s) not created yet",
+		      __LINE__, messageName);
 	}
 
 	return rc;
@@ -357,30 +371,33 @@ int16_t uORB::Manager::process_add_subscription(const char *messageName,
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 int16_t uORB::Manager::process_remove_subscription(
-	const char *messageName)
+	const char *messageName, uint32_t subscriber)
 {
 	warnx("[posix-uORB::Manager::process_remove_subscription(%d)] Enter: name: %s",
 	      __LINE__, messageName);
 	int16_t rc = -1;
 	_remote_subscriber_topics.erase(messageName);
-	char nodepath[orb_maxpath];
-	int ret = uORB::Utils::node_mkpath(nodepath, PUBSUB, messageName);
 
-	if (ret == OK) {
-		uORB::DeviceNode *node = uORB::DeviceMaster::GetDeviceNode(nodepath);
+	for (int instance = 0; instance < ORB_MULTI_MAX_INSTANCES; instance++) {
+		char nodepath[orb_maxpath];
 
-		// get the node name.
-		if (node == nullptr) {
-			warnx("[posix-uORB::Manager::process_remove_subscription(%d)]Error No existing subscriber found for message: [%s]",
-			      __LINE__, messageName);
+		if (uORB::Utils::node_mkpath(nodepath, PUBSUB, messageName, instance) != OK) {
+			break;
+		}
 
-		} else {
-			// node is present.
-			node->process_remove_subscription();
+		uORB::DeviceNode *node = uORB::DeviceMaster::GetDeviceNode(nodepath);
+
+		if (node != nullptr) {
+			node->process_remove_subscription(subscriber);
 			rc = 0;
 		}
 	}
 
+	if (rc != 0) {
+		warnx("[posix-uORB::Manager::process_remove_subscription(%d)]Error No existing subscriber found for message: [%s]",
+		      __LINE__, messageName);
+	}
+
 	return rc;
 }
 
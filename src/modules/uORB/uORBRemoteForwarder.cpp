@@ -0,0 +1,243 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "uORBRemoteForwarder.hpp"
+#include <string.h>
+
+uORB::RemoteForwarder::RemoteForwarder(const struct orb_metadata *meta, uint8_t instance) :
+	_meta(meta),
+	_instance(instance),
+	_subscriber_count(0),
+	_overflow(false),
+	_trailing(false),
+	_trailing_scheduled(false),
+	_last_data(nullptr),
+	_last_data_valid(false),
+	_compare_offset(0),
+	_sent(0),
+	_sent_trailing(0),
+	_suppressed_rate(0),
+	_suppressed_unchanged(0)
+{
+	static const char timestamp_field[] = "uint64_t timestamp;";
+
+	if (_meta->o_fields != nullptr && _meta->o_size > sizeof(uint64_t) &&
+	    strncmp(_meta->o_fields, timestamp_field, sizeof(timestamp_field) - 1) == 0) {
+		_compare_offset = sizeof(uint64_t);
+	}
+}
+
+uORB::RemoteForwarder::~RemoteForwarder()
+{
+	if (_last_data != nullptr) {
+		delete[] _last_data;
+	}
+}
+
+int uORB::RemoteForwarder::add_subscriber(uint32_t subscriber, int32_t rateInHz)
+{
+	const hrt_abstime interval = (rateInHz > 0) ? 1000000 / rateInHz : 0;
+
+	for (int i = 0; i < _subscriber_count; i++) {
+		if (_subscribers[i].id == subscriber) {
+			_subscribers[i].interval = interval;
+			return OK;
+		}
+	}
+
+	if (_subscriber_count >= MAX_SUBSCRIBERS) {
+		_overflow = true;
+		return -ENOSPC;
+	}
+
+	_subscribers[_subscriber_count].id = subscriber;
+	_subscribers[_subscriber_count].interval = interval;
+	_subscribers[_subscriber_count].last_send = 0;
+	_subscriber_count++;
+
+	return OK;
+}
+
+void uORB::RemoteForwarder::remove_subscriber(uint32_t subscriber)
+{
+	for (int i = 0; i < _subscriber_count; i++) {
+		if (_subscribers[i].id == subscriber) {
+			_subscribers[i] = _subscribers[--_subscriber_count];
+			break;
+		}
+	}
+
+	if (_subscriber_count == 0) {
+		_overflow = false;
+		_trailing = false;
+	}
+}
+
+uint8_t *uORB::RemoteForwarder::set_last_data_buffer(uint8_t *buffer)
+{
+	uint8_t *previous = _last_data;
+	_last_data = buffer;
+
+	/* the next publication is sent in any case */
+	_last_data_valid = false;
+
+	return previous;
+}
+
+hrt_abstime uORB::RemoteForwarder::next_due(hrt_abstime now) const
+{
+	if (_subscriber_count == 0 || _overflow) {
+		return 0;
+	}
+
+	hrt_abstime wait = UINT64_MAX;
+
+	for (int i = 0; i < _subscriber_count; i++) {
+		const Subscriber &s = _subscribers[i];
+
+		if (s.interval == 0 || s.last_send == 0 || now - s.last_send >= s.interval) {
+			return 0;
+		}
+
+		if (s.interval - (now - s.last_send) < wait) {
+			wait = s.interval - (now - s.last_send);
+		}
+	}
+
+	return wait;
+}
+
+bool uORB::RemoteForwarder::forward(const void *data, bool force, hrt_abstime now)
+{
+	if (!force && _last_data != nullptr && _last_data_valid &&
+	    memcmp(_last_data + _compare_offset, (const uint8_t *)data + _compare_offset,
+		   _meta->o_size - _compare_offset) == 0) {
+		_suppressed_unchanged++;
+		return false;
+	}
+
+	if (_last_data != nullptr) {
+		memcpy(_last_data, data, _meta->o_size);
+		_last_data_valid = true;
+	}
+
+	/* the subscribers that were due start a new interval, the others get the data anyway */
+	for (int i = 0; i < _subscriber_count; i++) {
+		Subscriber &s = _subscribers[i];
+
+		if (s.interval == 0 || s.last_send == 0 || now - s.last_send >= s.interval) {
+			s.last_send = now;
+		}
+	}
+
+	/* this supersedes a held back publication */
+	_trailing = false;
+	_sent++;
+	return true;
+}
+
+bool uORB::RemoteForwarder::should_forward(const void *data, bool force, hrt_abstime *trailing_delay)
+{
+	const hrt_abstime now = hrt_absolute_time();
+
+	*trailing_delay = 0;
+
+	if (!force) {
+		const hrt_abstime wait = next_due(now);
+
+		if (wait != 0) {
+			_suppressed_rate++;
+			_trailing = true;
+
+			if (!_trailing_scheduled) {
+				_trailing_scheduled = true;
+				*trailing_delay = wait;
+			}
+
+			return false;
+		}
+	}
+
+	return forward(data, force, now);
+}
+
+bool uORB::RemoteForwarder::trailing_due(const void *data, hrt_abstime *trailing_delay)
+{
+	const hrt_abstime now = hrt_absolute_time();
+
+	_trailing_scheduled = false;
+	*trailing_delay = 0;
+
+	if (!_trailing) {
+		return false;
+	}
+
+	/* a later publication was sent in the meantime and started a new interval */
+	const hrt_abstime wait = next_due(now);
+
+	if (wait != 0) {
+		_trailing_scheduled = true;
+		*trailing_delay = wait;
+		return false;
+	}
+
+	if (!forward(data, false, now)) {
+		_trailing = false;
+		return false;
+	}
+
+	_sent_trailing++;
+	return true;
+}
+
+void uORB::RemoteForwarder::print_status() const
+{
+	if (_sent == 0 && _suppressed_rate == 0 && _suppressed_unchanged == 0) {
+		return;
+	}
+
+	/* the highest rate applies, 0 for no limit */
+	hrt_abstime interval = (_subscriber_count > 0 && !_overflow) ? UINT64_MAX : 0;
+
+	for (int i = 0; i < _subscriber_count; i++) {
+		if (_subscribers[i].interval < interval) {
+			interval = _subscribers[i].interval;
+		}
+	}
+
+	warnx("%s%u: %d subscribers, max rate %u Hz%s, sent %u (%u trailing), rate limited %u, unchanged %u",
+	      _meta->o_name, (unsigned)_instance, _subscriber_count,
+	      (interval != 0) ? (unsigned)(1000000 / interval) : 0,
+	      (_last_data != nullptr) ? ", if changed" : "",
+	      (unsigned)_sent, (unsigned)_sent_trailing, (unsigned)_suppressed_rate, (unsigned)_suppressed_unchanged);
+}
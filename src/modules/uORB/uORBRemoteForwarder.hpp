@@ -0,0 +1,167 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef _uORBRemoteForwarder_hpp_
+#define _uORBRemoteForwarder_hpp_
+
+#include "uORBCommon.hpp"
+
+namespace uORB
+{
+class RemoteForwarder;
+}
+
+/**
+ * Decides which publications of a topic instance are forwarded to the
+ * remote subscribers over the uORBCommunicator::IChannel.
+ *
+ * Every remote subscriber, as identified by the channel, is limited to the
+ * rate it asked for in its add_subscription. The channel broadcasts, so a
+ * publication is forwarded as soon as one subscriber is due for it. The
+ * last publication held back by the rate limit is sent once the interval
+ * has passed, so that a burst doesn't leave the remote side with stale
+ * data. In send-if-changed mode publications equal to the last one sent
+ * are dropped, a leading timestamp field is ignored for that comparison.
+ *
+ * Without any remote subscriber registered everything is forwarded.
+ *
+ * Not thread safe, the owning DeviceNode calls it with its lock held.
+ */
+class uORB::RemoteForwarder
+{
+public:
+	static const int MAX_SUBSCRIBERS = 8;	/**< remote subscribers with their own rate per topic instance */
+
+	RemoteForwarder(const struct orb_metadata *meta, uint8_t instance);
+	~RemoteForwarder();
+
+	/**
+	 * Add a remote subscriber, or change its rate.
+	 * @param subscriber
+	 *   Identifier of the subscriber, unique per channel.
+	 * @param rateInHz
+	 *   Maximum rate of the forwarded publications, 0 or less for no limit.
+	 * @return
+	 *   OK, or -ENOSPC if there are MAX_SUBSCRIBERS already. The topic
+	 *   is forwarded without limit then.
+	 */
+	int add_subscriber(uint32_t subscriber, int32_t rateInHz);
+
+	/**
+	 * Remove a remote subscriber.
+	 */
+	void remove_subscriber(uint32_t subscriber);
+
+	/**
+	 * Set the buffer holding the last data sent, which enables the
+	 * send-if-changed mode. It is allocated by the caller so that the
+	 * swap can be done with the node locked.
+	 * @param buffer
+	 *   o_size bytes allocated with new[], or nullptr to disable the mode.
+	 * @return
+	 *   The previous buffer, to be deleted by the caller.
+	 */
+	uint8_t *set_last_data_buffer(uint8_t *buffer);
+
+	/**
+	 * Check whether a publication is to be forwarded, and account for it.
+	 * @param data
+	 *   The published data, o_size bytes.
+	 * @param force
+	 *   Forward regardless of rate and content, used for the current data
+	 *   sent to a new remote subscriber.
+	 * @param trailing_delay
+	 *   Set to the time after which the held back publication is to be
+	 *   sent with trailing_due(), if the caller has to schedule that now.
+	 *   0 otherwise.
+	 * @return
+	 *   true if the data is to be sent to the remote.
+	 */
+	bool should_forward(const void *data, bool force, hrt_abstime *trailing_delay);
+
+	/**
+	 * Called once the trailing delay has passed. Check whether the
+	 * publication held back by the rate limit is still to be sent, and
+	 * account for it.
+	 * @param data
+	 *   The current data of the topic, o_size bytes.
+	 * @param trailing_delay
+	 *   Set like in should_forward() if it is to be checked again later.
+	 * @return
+	 *   true if the data is to be sent to the remote.
+	 */
+	bool trailing_due(const void *data, hrt_abstime *trailing_delay);
+
+	/**
+	 * Print the forwarding counters, nothing if the topic was never forwarded.
+	 */
+	void print_status() const;
+
+private:
+	struct Subscriber {
+		uint32_t	id;
+		hrt_abstime	interval;	/**< minimum time between two sends, 0 if not limited */
+		hrt_abstime	last_send;	/**< time of the last send to this subscriber */
+	};
+
+	const struct orb_metadata *_meta;
+	const uint8_t	_instance;
+	Subscriber	_subscribers[MAX_SUBSCRIBERS];
+	int		_subscriber_count;
+	bool		_overflow;		/**< a subscriber didn't fit, no rate limit */
+	bool		_trailing;		/**< a publication was held back by the rate limit */
+	bool		_trailing_scheduled;	/**< the owner will call trailing_due() */
+	uint8_t		*_last_data;		/**< last data sent, only allocated in send-if-changed mode */
+	bool		_last_data_valid;
+	size_t		_compare_offset;	/**< start of the compared bytes, skips the timestamp */
+	uint32_t	_sent;			/**< publications forwarded */
+	uint32_t	_sent_trailing;		/**< held back publications sent after the interval */
+	uint32_t	_suppressed_rate;	/**< publications dropped by the rate limit */
+	uint32_t	_suppressed_unchanged;	/**< publications dropped in send-if-changed mode */
+
+	/**
+	 * Time until the next subscriber is due, 0 if one is due now.
+	 */
+	hrt_abstime next_due(hrt_abstime now) const;
+
+	/**
+	 * Apply the send-if-changed filter and account for a send.
+	 */
+	bool forward(const void *data, bool force, hrt_abstime now);
+
+	// disable copy and assignment operators
+	RemoteForwarder(const RemoteForwarder &);
+	RemoteForwarder &operator=(const RemoteForwarder &);
+};
+
+#endif // _uORBRemoteForwarder_hpp_
@@ -0,0 +1,191 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "uORBTrace.hpp"
+#include <px4_posix.h>
+#include <stdio.h>
+#include <errno.h>
+#ifdef __PX4_LINUX
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+volatile bool uORB::Trace::_enabled = false;
+uORB::Trace::Ring *volatile uORB::Trace::_ring = nullptr;
+uORB::Trace::Ring *uORB::Trace::_retired = nullptr;
+volatile unsigned uORB::Trace::_head = 0;
+
+static const char *const event_names[] = { "publish", "copy", "notify" };
+
+uint64_t uORB::Trace::thread_id()
+{
+#ifdef __PX4_LINUX
+	/* px4_getpid() is pthread_self() here, the kernel id is what top and perf show */
+	return (uint64_t)syscall(SYS_gettid);
+#else
+	return (uint64_t)px4_getpid();
+#endif
+}
+
+void uORB::Trace::record_event(EventType type, const struct orb_metadata *meta, uint8_t instance, unsigned generation)
+{
+	Ring *ring = _ring;
+	unsigned index = __sync_fetch_and_add(&_head, 1);
+	Event &e = ring->events[index & ring->mask];
+
+	e.timestamp = hrt_absolute_time();
+	e.meta = meta;
+	e.generation = generation;
+	e.thread = thread_id();
+	e.instance = instance;
+	e.type = type;
+}
+
+int uORB::Trace::start(unsigned entries)
+{
+	if (_enabled) {
+		return -EBUSY;
+	}
+
+	if (entries == 0) {
+		return -EINVAL;
+	}
+
+	unsigned size = 1;
+
+	while (size * 2 <= entries) {
+		size *= 2;
+	}
+
+	if (_ring == nullptr || _ring->mask != size - 1) {
+		Ring *ring = new Ring;
+
+		if (ring == nullptr) {
+			return -ENOMEM;
+		}
+
+		ring->events = new Event[size];
+
+		if (ring->events == nullptr) {
+			delete ring;
+			return -ENOMEM;
+		}
+
+		ring->mask = size - 1;
+
+		/*
+		 * A writer that saw _enabled just before the last stop may still
+		 * be recording into the current ring, so it's only freed on the
+		 * next resize.
+		 */
+		if (_retired != nullptr) {
+			delete[] _retired->events;
+			delete _retired;
+		}
+
+		_retired = _ring;
+		_ring = ring;
+	}
+
+	for (unsigned i = 0; i <= _ring->mask; i++) {
+		_ring->events[i].meta = nullptr;
+	}
+
+	_head = 0;
+	__sync_synchronize();
+	_enabled = true;
+
+	return OK;
+}
+
+void uORB::Trace::stop()
+{
+	_enabled = false;
+	__sync_synchronize();
+}
+
+int uORB::Trace::dump(const char *path)
+{
+	if (_ring == nullptr) {
+		return -ENODATA;
+	}
+
+	stop();
+
+	const Ring *ring = _ring;
+
+	FILE *f = fopen(path, "w");
+
+	if (f == nullptr) {
+		return -errno;
+	}
+
+	unsigned head = _head;
+	unsigned count = (head > ring->mask) ? ring->mask + 1 : head;
+	bool first = true;
+
+	fprintf(f, "{\"traceEvents\":[\n");
+
+	for (unsigned i = head - count; i != head; i++) {
+		const Event &e = ring->events[i & ring->mask];
+
+		if (e.meta == nullptr) {
+			continue;
+		}
+
+		fprintf(f, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%llu,\"pid\":0,\"tid\":%llu,"
+			"\"args\":{\"instance\":%u,\"generation\":%u}}",
+			first ? "" : ",\n", e.meta->o_name, event_names[e.type], (unsigned long long)e.timestamp,
+			(unsigned long long)e.thread, (unsigned)e.instance, (unsigned)e.generation);
+		first = false;
+	}
+
+	fprintf(f, "\n]}\n");
+
+	int ret = ferror(f) ? -EIO : OK;
+	fclose(f);
+
+	warnx("%u events written to %s", count, path);
+	return ret;
+}
+
+void uORB::Trace::print_status()
+{
+	if (_ring == nullptr) {
+		warnx("tracing not started");
+		return;
+	}
+
+	warnx("tracing %s, %u events recorded, ring of %u", _enabled ? "running" : "stopped", (unsigned)_head,
+	      _ring->mask + 1);
+}
@@ -0,0 +1,141 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef _uORBTrace_hpp_
+#define _uORBTrace_hpp_
+
+#include "uORBCommon.hpp"
+
+namespace uORB
+{
+class Trace;
+}
+
+/**
+ * Records the publications, copies and poll wakeups of all topics into a
+ * ring of events, to measure the message flow timing between modules.
+ *
+ * Recording is lock-free: writers reserve a slot with an atomic increment,
+ * so it can be used from any thread and from interrupt context. When
+ * tracing is off the cost is a single branch on a global flag.
+ *
+ * The ring can be dumped in the Chrome trace event format, which
+ * chrome://tracing and most trace viewers load.
+ */
+class uORB::Trace
+{
+public:
+	enum EventType {
+		PUBLISH = 0,	/**< topic written by a publisher */
+		COPY,		/**< topic read by a subscriber */
+		NOTIFY		/**< poll waiter woken up by a publication */
+	};
+
+	/* default ring size of 'uorb trace start', 32 bytes per event */
+#ifdef __PX4_NUTTX
+	static const unsigned DEFAULT_ENTRIES = 128;
+#else
+	static const unsigned DEFAULT_ENTRIES = 1024;
+#endif
+
+	/**
+	 * Record an event if tracing is enabled.
+	 * @param type
+	 *   The event type.
+	 * @param meta
+	 *   The topic.
+	 * @param instance
+	 *   Multi-instance index of the topic.
+	 * @param generation
+	 *   Generation count of the data written, read or notified.
+	 */
+	static inline void record(EventType type, const struct orb_metadata *meta, uint8_t instance, unsigned generation)
+	{
+		if (__builtin_expect(_enabled, false)) {
+			record_event(type, meta, instance, generation);
+		}
+	}
+
+	/**
+	 * Allocate the ring and start recording. The ring of the previous
+	 * recording is reused if it has the same size, and replaced otherwise.
+	 * @param entries
+	 *   Number of events kept, rounded down to a power of two.
+	 * @return
+	 *   OK on success, -ENOMEM if the ring can't be allocated, -EBUSY if
+	 *   tracing is running, -EINVAL if entries is 0.
+	 */
+	static int start(unsigned entries);
+
+	/**
+	 * Stop recording, the ring is kept until the next start.
+	 */
+	static void stop();
+
+	/**
+	 * Write the recorded events to a Chrome trace JSON file.
+	 * Recording is stopped first.
+	 * @return
+	 *   OK on success, -errno on failure.
+	 */
+	static int dump(const char *path);
+
+	static void print_status();
+
+private:
+	struct Event {
+		hrt_abstime	timestamp;
+		const struct orb_metadata *meta;
+		uint64_t	thread;		/**< publisher or subscriber thread */
+		uint32_t	generation;
+		uint8_t		instance;
+		uint8_t		type;
+	};
+
+	/* the events and their count are swapped together when the ring is resized */
+	struct Ring {
+		Event		*events;
+		unsigned	mask;		/**< ring size - 1 */
+	};
+
+	static volatile bool _enabled;
+	static Ring *volatile _ring;
+	static Ring *_retired;		/**< previous ring, a writer racing the last stop may still use it */
+	static volatile unsigned _head;	/**< total number of events recorded */
+
+	static uint64_t thread_id();
+
+	static void record_event(EventType type, const struct orb_metadata *meta, uint8_t instance, unsigned generation);
+};
+
+#endif // _uORBTrace_hpp_
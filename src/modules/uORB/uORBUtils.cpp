@@ -65,14 +65,12 @@ int uORB::Utils::node_mkpath
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 int uORB::Utils::node_mkpath(char *buf, Flavor f,
-			     const char *orbMsgName)
+			     const char *orbMsgName, int instance)
 {
 	unsigned len;
 
-	unsigned index = 0;
-
 	len = snprintf(buf, orb_maxpath, "/%s/%s%d", (f == PUBSUB) ? "obj" : "param",
-		       orbMsgName, index);
+		       orbMsgName, instance);
 
 	if (len >= orb_maxpath) {
 		return -ENAMETOOLONG;
@@ -1080,6 +1080,38 @@ UavcanNode::ioctl(file *filp, int cmd, unsigned long arg)
 
 				ret = _mixers->load_from_buf(buf, buflen);
 
+				if (ret != 0) {
+					warnx("mixer load failed with %d", ret);
+					delete _mixers;
+					_mixers = nullptr;
+					_groups_required = 0;
+					ret = -EINVAL;
+
+				} else {
+
+					_mixers->compile();
+					_mixers->groups_required(_groups_required);
+				}
+			}
+
+			break;
+		}
+
+	case MIXERIOCLOADBIN: {
+			const struct mixer_binary_s *bin = (const struct mixer_binary_s *)arg;
+
+			if (_mixers == nullptr) {
+				_mixers = new MixerGroup(control_callback, (uintptr_t)_controls);
+			}
+
+			if (_mixers == nullptr) {
+				_groups_required = 0;
+				ret = -ENOMEM;
+
+			} else {
+
+				ret = _mixers->load_from_binary(bin->buf, bin->buflen);
+
 				if (ret != 0) {
 					warnx("mixer load failed with %d", ret);
 					delete _mixers;
@@ -2,5 +2,6 @@
 # Common OS porting APIs
 #
 
-SRCS		 = px4_getopt.c
+SRCS		 = px4_getopt.c \
+		   px4_work_item.cpp
 
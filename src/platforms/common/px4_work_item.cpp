@@ -0,0 +1,338 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file px4_work_item.cpp
+ *
+ * Periodic and topic-triggered module execution on the shared work queues.
+ */
+
+#include <px4_config.h>
+#include <px4_defines.h>
+#include <px4_log.h>
+#include <px4_posix.h>
+#include <px4_work_item.h>
+#include <drivers/drv_orb_dev.h>
+#include <uORB/uORBDevices.hpp>
+#include <errno.h>
+#include <unistd.h>
+
+namespace px4
+{
+
+/**
+ * Queues the owning item whenever the topic is published, called by the
+ * uORB node in the context of the publisher.
+ */
+class ScheduledWorkItem::TopicTrigger : public uORB::SubscriptionCallback
+{
+public:
+	TopicTrigger(ScheduledWorkItem *item, uORB::DeviceNode *node, unsigned interval_ms) :
+		item(item),
+		node(node),
+		interval_us(interval_ms * 1000),
+		last(0),
+		next(nullptr)
+	{}
+
+	void call()
+	{
+		hrt_abstime now = hrt_absolute_time();
+
+		if (interval_us > 0 && now < last + interval_us) {
+			/* too early, run once the interval is over like a subscription with orb_set_interval() */
+			if (item->trigger(last + interval_us - now)) {
+				last += interval_us;
+			}
+
+			return;
+		}
+
+		last = now;
+		item->trigger();
+	}
+
+	ScheduledWorkItem	*item;
+	uORB::DeviceNode	*node;
+	uint32_t		interval_us;
+	hrt_abstime		last;		/**< time of the last trigger */
+	TopicTrigger		*next;
+};
+
+ScheduledWorkItem::ScheduledWorkItem(const char *name, int queue) :
+	_name(name),
+	_queue(queue),
+	_work{},
+	_timeout_work{},
+	_triggers(nullptr),
+	_queued(false),
+	_running(false),
+	_cleared(false),
+	_timeout_queued(false),
+	_timeout_running(false),
+	_interval_us(0),
+	_next_run(0),
+	_timeout_us(0),
+	_last_trigger(0),
+	_trigger_count(0),
+	_coalesced(0),
+	_run_perf(perf_alloc(PC_ELAPSED, name))
+{
+	px4_sem_init(&_lock, 0, 1);
+}
+
+ScheduledWorkItem::~ScheduledWorkItem()
+{
+	ScheduleClear();
+	perf_free(_run_perf);
+	px4_sem_destroy(&_lock);
+}
+
+int
+ScheduledWorkItem::ScheduleOnInterval(uint32_t interval_us, uint32_t delay_us)
+{
+	_cleared = false;
+	_interval_us = interval_us;
+	_next_run = hrt_absolute_time() + delay_us;
+
+	if (__sync_bool_compare_and_swap(&_queued, false, true)) {
+		return work_queue(_queue, &_work, (worker_t)&ScheduledWorkItem::run_trampoline, this, USEC2TICK(delay_us));
+	}
+
+	/* the pending run picks up the new interval */
+	return OK;
+}
+
+int
+ScheduledWorkItem::ScheduleOnTopic(const struct orb_metadata *meta, unsigned instance, unsigned interval_ms)
+{
+	/* subscribing creates the node if nobody advertised the topic yet */
+	int sub = orb_subscribe_multi(meta, instance);
+
+	if (sub < 0) {
+		return -errno;
+	}
+
+	uintptr_t node = 0;
+	int ret = px4_ioctl(sub, ORBIOCGADVERTISER, (unsigned long)&node);
+	orb_unsubscribe(sub);
+
+	if (ret != OK || node == 0) {
+		return -EIO;
+	}
+
+	TopicTrigger *t = new TopicTrigger(this, (uORB::DeviceNode *)node, interval_ms);
+
+	if (t == nullptr) {
+		return -ENOMEM;
+	}
+
+	_cleared = false;
+	_last_trigger = hrt_absolute_time();
+
+	px4_sem_wait(&_lock);
+	t->next = _triggers;
+	_triggers = t;
+	px4_sem_post(&_lock);
+
+	t->node->register_callback(t);
+
+	timeout_start();
+
+	return OK;
+}
+
+void
+ScheduledWorkItem::ScheduleTimeout(uint32_t timeout_us)
+{
+	_timeout_us = timeout_us;
+
+	timeout_start();
+}
+
+void
+ScheduledWorkItem::ScheduleTopicClear()
+{
+	px4_sem_wait(&_lock);
+	TopicTrigger *t = _triggers;
+	_triggers = nullptr;
+	px4_sem_post(&_lock);
+
+	while (t != nullptr) {
+		TopicTrigger *next = t->next;
+
+		/* no publisher calls it any more once this returns */
+		t->node->unregister_callback(t);
+		delete t;
+
+		t = next;
+	}
+}
+
+void
+ScheduledWorkItem::ScheduleNow()
+{
+	_cleared = false;
+
+	if (__sync_bool_compare_and_swap(&_queued, false, true)) {
+		work_queue(_queue, &_work, (worker_t)&ScheduledWorkItem::run_trampoline, this, 0);
+	}
+}
+
+void
+ScheduledWorkItem::ScheduleClear()
+{
+	_cleared = true;
+
+	ScheduleTopicClear();
+	work_cancel(_queue, &_work);
+	work_cancel(_queue, &_timeout_work);
+
+	/* a run in progress may have queued itself again before it saw _cleared */
+	while (_running || _timeout_running) {
+		usleep(1000);
+	}
+
+	work_cancel(_queue, &_work);
+	work_cancel(_queue, &_timeout_work);
+	_queued = false;
+	_timeout_queued = false;
+}
+
+bool
+ScheduledWorkItem::trigger(uint32_t delay_us)
+{
+	_last_trigger = hrt_absolute_time();
+	_trigger_count++;
+
+	if (_cleared) {
+		return false;
+	}
+
+	if (__sync_bool_compare_and_swap(&_queued, false, true)) {
+		work_queue(_queue, &_work, (worker_t)&ScheduledWorkItem::run_trampoline, this, USEC2TICK(delay_us));
+		return true;
+	}
+
+	_coalesced++;
+	return false;
+}
+
+void
+ScheduledWorkItem::timeout_start()
+{
+	if (_timeout_us > 0 && _triggers != nullptr && !_cleared &&
+	    __sync_bool_compare_and_swap(&_timeout_queued, false, true)) {
+		work_queue(_queue, &_timeout_work, (worker_t)&ScheduledWorkItem::timeout_trampoline, this,
+			   USEC2TICK(_timeout_us));
+	}
+}
+
+void
+ScheduledWorkItem::run_trampoline(void *arg)
+{
+	ScheduledWorkItem *item = reinterpret_cast<ScheduledWorkItem *>(arg);
+
+	item->_running = true;
+	__sync_synchronize();
+	item->_queued = false;
+
+	if (!item->_cleared) {
+		perf_begin(item->_run_perf);
+		item->Run();
+		perf_end(item->_run_perf);
+	}
+
+	if (item->_interval_us > 0 && !item->_cleared) {
+		hrt_abstime now = hrt_absolute_time();
+
+		/* keep the phase of the interval instead of drifting by the run time */
+		item->_next_run += item->_interval_us;
+
+		if (item->_next_run < now) {
+			/* overran, skip the missed runs */
+			item->_next_run = now;
+		}
+
+		if (__sync_bool_compare_and_swap(&item->_queued, false, true)) {
+			work_queue(item->_queue, &item->_work, (worker_t)&ScheduledWorkItem::run_trampoline, item,
+				   USEC2TICK(item->_next_run - now));
+		}
+	}
+
+	__sync_synchronize();
+	item->_running = false;
+}
+
+void
+ScheduledWorkItem::timeout_trampoline(void *arg)
+{
+	ScheduledWorkItem *item = reinterpret_cast<ScheduledWorkItem *>(arg);
+
+	item->_timeout_running = true;
+	__sync_synchronize();
+
+	if (item->_timeout_us > 0 && item->_triggers != nullptr && !item->_cleared) {
+		hrt_abstime now = hrt_absolute_time();
+		hrt_abstime deadline = item->_last_trigger + item->_timeout_us;
+
+		if (now >= deadline) {
+			item->trigger();
+			deadline = now + item->_timeout_us;
+		}
+
+		/* check again when the timeout of the latest trigger runs out */
+		work_queue(item->_queue, &item->_timeout_work, (worker_t)&ScheduledWorkItem::timeout_trampoline, item,
+			   USEC2TICK(deadline - now));
+
+	} else {
+		item->_timeout_queued = false;
+		__sync_synchronize();
+
+		/* a trigger or timeout may have been set up meanwhile */
+		item->timeout_start();
+	}
+
+	__sync_synchronize();
+	item->_timeout_running = false;
+}
+
+void
+ScheduledWorkItem::print_status()
+{
+	PX4_INFO("%s: %s, %u triggers, %u coalesced", _name, (_queue == HPWORK) ? "hpwork" : "lpwork",
+		 (unsigned)_trigger_count, (unsigned)_coalesced);
+	perf_print_counter(_run_perf);
+}
+
+} // namespace px4
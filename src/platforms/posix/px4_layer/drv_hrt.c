@@ -66,6 +66,13 @@ static px4_sem_t 	_hrt_lock;
 static struct work_s	_hrt_work;
 static hrt_abstime px4_timestart = 0;
 
+/*
+ * virtual time, only advanced by hrt_set_virtual_time(). It is read from
+ * any thread, so it is accessed atomically to avoid torn 64 bit reads.
+ */
+static bool _virtual_time_enabled = false;
+static hrt_abstime _virtual_time = 0;
+
 static void
 hrt_call_invoke(void);
 
@@ -128,6 +135,10 @@ hrt_abstime hrt_absolute_time(void)
 {
 	struct timespec ts;
 
+	if (__atomic_load_n(&_virtual_time_enabled, __ATOMIC_ACQUIRE)) {
+		return __atomic_load_n(&_virtual_time, __ATOMIC_ACQUIRE);
+	}
+
 	if (!px4_timestart) {
 		px4_clock_gettime(CLOCK_MONOTONIC, &ts);
 		px4_timestart = ts_to_abstime(&ts);
@@ -143,6 +154,15 @@ __EXPORT hrt_abstime hrt_reset(void)
 	return hrt_absolute_time();
 }
 
+void hrt_set_virtual_time(hrt_abstime now)
+{
+	__atomic_store_n(&_virtual_time, now, __ATOMIC_RELEASE);
+	__atomic_store_n(&_virtual_time_enabled, true, __ATOMIC_RELEASE);
+
+	/* run the callouts that became due, the timer work only sees real time */
+	hrt_call_invoke();
+}
+
 /*
  * Convert a timespec to absolute time.
  */
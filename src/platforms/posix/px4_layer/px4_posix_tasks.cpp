@@ -52,6 +52,11 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <string>
+#include <time.h>
+
+#ifdef __PX4_LINUX
+#include <sys/syscall.h>
+#endif
 
 #include <px4_tasks.h>
 #include <px4_posix.h>
@@ -65,15 +70,24 @@ pthread_t _shell_task_id = 0;
 
 struct task_entry {
 	pthread_t pid;
+	pid_t tid;		// kernel thread id, for the context switch counts
 	std::string name;
 	bool isused;
-	task_entry() : isused(false) {}
+	uint32_t wakeup_latency[PX4_TASK_WAKEUP_BUCKETS];
+	task_entry() : pid(0), tid(0), isused(false), wakeup_latency{} {}
 };
 
 static task_entry taskmap[PX4_MAX_TASKS];
 
+// guards the slot allocation and the ids in taskmap against px4_task_stats()
+static pthread_mutex_t task_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// taskmap index of the calling thread, -1 if it was not spawned as a task
+static __thread int _task_index = -1;
+
 typedef struct {
 	px4_main_t entry;
+	int task_index;
 	int argc;
 	char *argv[];
 	// strings are allocated after the
@@ -84,6 +98,13 @@ static void *entry_adapter(void *ptr)
 	pthdata_t *data;
 	data = (pthdata_t *) ptr;
 
+	_task_index = data->task_index;
+#ifdef __PX4_LINUX
+	pthread_mutex_lock(&task_mutex);
+	taskmap[_task_index].tid = syscall(SYS_gettid);
+	pthread_mutex_unlock(&task_mutex);
+#endif
+
 	data->entry(data->argc, data->argv);
 	free(ptr);
 	PX4_DEBUG("Before px4_task_exit");
@@ -179,6 +200,30 @@ px4_task_t px4_task_spawn_cmd(const char *name, int scheduler, int priority, int
 		return (rv < 0) ? rv : -rv;
 	}
 
+	// reserve the task slot first, the thread records its kernel id in it
+	pthread_mutex_lock(&task_mutex);
+
+	for (i = 0; i < PX4_MAX_TASKS; ++i) {
+		if (taskmap[i].isused == false) {
+			taskmap[i].pid = 0;
+			taskmap[i].tid = 0;
+			taskmap[i].name = name;
+			memset(taskmap[i].wakeup_latency, 0, sizeof(taskmap[i].wakeup_latency));
+			taskmap[i].isused = true;
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&task_mutex);
+
+	if (i >= PX4_MAX_TASKS) {
+		free(taskdata);
+		return -ENOSPC;
+	}
+
+	int task_index = i;
+	taskdata->task_index = task_index;
+
 	rv = pthread_create(&task, &attr, &entry_adapter, (void *) taskdata);
 
 	if (rv != 0) {
@@ -189,28 +234,25 @@ px4_task_t px4_task_spawn_cmd(const char *name, int scheduler, int priority, int
 
 			if (rv != 0) {
 				PX4_ERR("px4_task_spawn_cmd: failed to create thread %d %d\n", rv, errno);
+				pthread_mutex_lock(&task_mutex);
+				taskmap[task_index].isused = false;
+				pthread_mutex_unlock(&task_mutex);
 				return (rv < 0) ? rv : -rv;
 			}
 
 		} else {
+			pthread_mutex_lock(&task_mutex);
+			taskmap[task_index].isused = false;
+			pthread_mutex_unlock(&task_mutex);
 			return (rv < 0) ? rv : -rv;
 		}
 	}
 
-	for (i = 0; i < PX4_MAX_TASKS; ++i) {
-		if (taskmap[i].isused == false) {
-			taskmap[i].pid = task;
-			taskmap[i].name = name;
-			taskmap[i].isused = true;
-			break;
-		}
-	}
-
-	if (i >= PX4_MAX_TASKS) {
-		return -ENOSPC;
-	}
+	pthread_mutex_lock(&task_mutex);
+	taskmap[task_index].pid = task;
+	pthread_mutex_unlock(&task_mutex);
 
-	return i;
+	return task_index;
 }
 
 int px4_task_delete(px4_task_t id)
@@ -228,14 +270,18 @@ int px4_task_delete(px4_task_t id)
 
 	// If current thread then exit, otherwise cancel
 	if (pthread_self() == pid) {
+		pthread_mutex_lock(&task_mutex);
 		taskmap[id].isused = false;
+		pthread_mutex_unlock(&task_mutex);
 		pthread_exit(0);
 
 	} else {
 		rv = pthread_cancel(pid);
 	}
 
+	pthread_mutex_lock(&task_mutex);
 	taskmap[id].isused = false;
+	pthread_mutex_unlock(&task_mutex);
 
 	return rv;
 }
@@ -246,6 +292,8 @@ void px4_task_exit(int ret)
 	pthread_t pid = pthread_self();
 
 	// Get pthread ID from the opaque ID
+	pthread_mutex_lock(&task_mutex);
+
 	for (i = 0; i < PX4_MAX_TASKS; ++i) {
 		if (taskmap[i].pid == pid) {
 			taskmap[i].isused = false;
@@ -253,6 +301,8 @@ void px4_task_exit(int ret)
 		}
 	}
 
+	pthread_mutex_unlock(&task_mutex);
+
 	if (i >= PX4_MAX_TASKS)  {
 		PX4_ERR("px4_task_exit: self task not found!");
 
@@ -302,6 +352,95 @@ void px4_show_tasks()
 
 }
 
+#ifdef __PX4_LINUX
+/**
+ * Read the context switch counts of a thread from /proc.
+ */
+static void read_ctx_switches(pid_t tid, px4_task_stats_t &stats)
+{
+	char path[48];
+	char line[64];
+
+	snprintf(path, sizeof(path), "/proc/self/task/%d/status", (int)tid);
+
+	FILE *fp = fopen(path, "r");
+
+	if (fp == NULL) {
+		return;
+	}
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		unsigned long count;
+
+		if (sscanf(line, "voluntary_ctxt_switches: %lu", &count) == 1) {
+			stats.ctx_switches_voluntary = count;
+
+		} else if (sscanf(line, "nonvoluntary_ctxt_switches: %lu", &count) == 1) {
+			stats.ctx_switches_involuntary = count;
+		}
+	}
+
+	fclose(fp);
+}
+#endif
+
+int px4_task_stats(px4_task_stats_t *stats, int max)
+{
+	int count = 0;
+
+	// a task exiting meanwhile would leave a stale thread id to read the clock from
+	pthread_mutex_lock(&task_mutex);
+
+	for (int idx = 0; idx < PX4_MAX_TASKS && count < max; idx++) {
+		if (!taskmap[idx].isused || taskmap[idx].pid == 0) {
+			continue;
+		}
+
+		px4_task_stats_t &s = stats[count];
+		memset(&s, 0, sizeof(s));
+
+		s.id = idx;
+		strncpy(s.name, taskmap[idx].name.c_str(), sizeof(s.name) - 1);
+		memcpy(s.wakeup_latency, taskmap[idx].wakeup_latency, sizeof(s.wakeup_latency));
+
+#ifdef __PX4_LINUX
+		clockid_t cid;
+		struct timespec ts;
+
+		if (pthread_getcpuclockid(taskmap[idx].pid, &cid) == 0 &&
+		    clock_gettime(cid, &ts) == 0) {
+			s.cpu_time = (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+		}
+
+		if (taskmap[idx].tid != 0) {
+			read_ctx_switches(taskmap[idx].tid, s);
+		}
+
+#endif
+		count++;
+	}
+
+	pthread_mutex_unlock(&task_mutex);
+
+	return count;
+}
+
+void px4_task_wakeup_latency(uint32_t latency_us)
+{
+	if (_task_index < 0) {
+		return;
+	}
+
+	static const uint32_t limits[PX4_TASK_WAKEUP_BUCKETS - 1] = { 50, 100, 200, 500, 1000, 2000, 5000 };
+	unsigned bucket = 0;
+
+	while (bucket < PX4_TASK_WAKEUP_BUCKETS - 1 && latency_us >= limits[bucket]) {
+		bucket++;
+	}
+
+	taskmap[_task_index].wakeup_latency[bucket]++;
+}
+
 bool px4_task_is_running(const char *taskname)
 {
 	int idx;
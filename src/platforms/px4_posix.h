@@ -125,6 +125,7 @@ typedef struct {
 	/* Required for PX4 compatability */
 	px4_sem_t   *sem;  	/* Pointer to semaphore used to post output event */
 	void   *priv;     	/* For use by drivers */
+	uint64_t    notified;	/* Time the output event was first posted, 0 if not yet */
 } px4_pollfd_struct_t;
 
 __BEGIN_DECLS
@@ -61,6 +61,7 @@ typedef int px4_task_t;
 #elif defined(__PX4_POSIX) || defined(__PX4_QURT)
 #include <pthread.h>
 #include <sched.h>
+#include <stdint.h>
 
 /** Default scheduler type */
 #define SCHED_DEFAULT	SCHED_FIFO
@@ -92,6 +93,19 @@ typedef struct {
 	int argc;
 	char **argv;
 } px4_task_args_t;
+
+/** Number of buckets of the wakeup latency histogram */
+#define PX4_TASK_WAKEUP_BUCKETS 8
+
+/** CPU accounting of a task, see px4_task_stats() */
+typedef struct {
+	px4_task_t	id;
+	char		name[16];
+	uint64_t	cpu_time;		/**< CPU time used since the task started, in microseconds */
+	uint32_t	ctx_switches_voluntary;	/**< context switches since the task started */
+	uint32_t	ctx_switches_involuntary;
+	uint32_t	wakeup_latency[PX4_TASK_WAKEUP_BUCKETS];	/**< wakeups by lateness, see px4_task_wakeup_latency() */
+} px4_task_stats_t;
 #else
 #error "No target OS defined"
 #endif
@@ -126,5 +140,30 @@ __EXPORT void px4_show_tasks(void);
 /** See if a task is running **/
 __EXPORT bool px4_task_is_running(const char *taskname);
 
+#if defined(__PX4_POSIX) || defined(__PX4_QURT)
+/**
+ * Get the CPU accounting of the running tasks.
+ *
+ * The CPU time is read from the per-thread CPU clocks and the context
+ * switch counts from the kernel, nothing is sampled in the background.
+ *
+ * @param stats		Array to fill, one entry per running task.
+ * @param max		Number of entries of the array.
+ * @return		The number of entries filled.
+ */
+__EXPORT int px4_task_stats(px4_task_stats_t *stats, int max);
+
+/**
+ * Account a wakeup of the calling task.
+ *
+ * px4_poll() accounts timeouts from the requested time and data wakeups
+ * from the time the first event was posted. The histogram buckets are
+ * <50us, <100us, <200us, <500us, <1ms, <2ms, <5ms and above.
+ *
+ * @param latency_us	Time between the wakeup event and the actual wakeup.
+ */
+__EXPORT void px4_task_wakeup_latency(uint32_t latency_us);
+#endif
+
 __END_DECLS
 
@@ -0,0 +1,180 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file px4_work_item.h
+ *
+ * Periodic and topic-triggered module execution on the shared work queues.
+ *
+ * Instead of spawning a task that sleeps in px4_poll(), a module derives
+ * from px4::ScheduledWorkItem, implements Run() and schedules it either on
+ * a fixed interval or on updates of one or more uORB topics. Runs happen
+ * on the HPWORK or LPWORK worker thread, so any number of modules share
+ * those two threads.
+ *
+ * A topic trigger hooks into the uORB node of the topic: publishing
+ * queues the item straight from orb_publish(), without a task or a poll
+ * in between. Triggers arriving while an item is already queued are
+ * coalesced into that run.
+ */
+
+#pragma once
+
+#include <px4_config.h>
+#include <px4_posix.h>
+#include <px4_workqueue.h>
+#include <stdint.h>
+#include <uORB/uORB.h>
+#include <drivers/drv_hrt.h>
+#include <systemlib/perf_counter.h>
+
+namespace px4
+{
+
+class ScheduledWorkItem
+{
+public:
+	/**
+	 * @param name		name used for status output and the run perf counter.
+	 * @param queue		HPWORK or LPWORK.
+	 */
+	ScheduledWorkItem(const char *name, int queue);
+
+	/**
+	 * Derived classes must call ScheduleClear() in their own destructor,
+	 * a run in progress may otherwise still use their members.
+	 */
+	virtual ~ScheduledWorkItem();
+
+	/**
+	 * Run every interval_us, the first run after delay_us.
+	 *
+	 * @return		OK on success.
+	 */
+	int		ScheduleOnInterval(uint32_t interval_us, uint32_t delay_us = 0);
+
+	/**
+	 * Run whenever the given topic instance is published.
+	 *
+	 * May be called several times to trigger on several topics.
+	 *
+	 * @param meta		topic to trigger on.
+	 * @param instance	topic instance.
+	 * @param interval_ms	minimum time between triggers from this topic, 0 for none.
+	 *			A publication within the interval is run once it is over.
+	 * @return		OK on success, -ENOMEM or the error of opening the topic.
+	 */
+	int		ScheduleOnTopic(const struct orb_metadata *meta, unsigned instance = 0, unsigned interval_ms = 0);
+
+	/**
+	 * Also run if none of the topic triggers fired for timeout_us.
+	 */
+	void		ScheduleTimeout(uint32_t timeout_us);
+
+	/**
+	 * Drop all topic triggers. Does not wait for a run in progress and
+	 * may therefore be called from Run().
+	 */
+	void		ScheduleTopicClear();
+
+	/**
+	 * Queue a single run as soon as possible.
+	 */
+	void		ScheduleNow();
+
+	/**
+	 * Stop all scheduling and wait for a run in progress to finish.
+	 * Must not be called from Run().
+	 */
+	void		ScheduleClear();
+
+	/**
+	 * Print run statistics.
+	 */
+	void		print_status();
+
+protected:
+	/**
+	 * Called on the worker thread of the selected queue.
+	 */
+	virtual void	Run() = 0;
+
+private:
+	class TopicTrigger;
+
+	static void	run_trampoline(void *arg);
+	static void	timeout_trampoline(void *arg);
+
+	/**
+	 * Queue a run after delay_us unless one is already pending.
+	 *
+	 * @return		true if a run was queued.
+	 */
+	bool		trigger(uint32_t delay_us = 0);
+
+	/**
+	 * Start checking for the trigger timeout, if needed.
+	 */
+	void		timeout_start();
+
+	const char	*_name;
+	int		_queue;
+	struct work_s	_work;
+	struct work_s	_timeout_work;
+
+	TopicTrigger	*_triggers;		/**< topic triggers, guarded by _lock */
+	px4_sem_t	_lock;
+
+	volatile bool	_queued;		/**< a run is pending on the work queue */
+	volatile bool	_running;		/**< Run() in progress */
+	volatile bool	_cleared;		/**< ScheduleClear() called, do not queue again */
+	volatile bool	_timeout_queued;	/**< the timeout check is pending on the work queue */
+	volatile bool	_timeout_running;	/**< the timeout check is in progress */
+
+	uint32_t	_interval_us;
+	hrt_abstime	_next_run;		/**< deadline of the next interval run */
+
+	uint32_t	_timeout_us;
+	hrt_abstime	_last_trigger;
+
+	uint32_t	_trigger_count;		/**< topic or timeout triggers */
+	uint32_t	_coalesced;		/**< triggers absorbed by an already pending run */
+
+	perf_counter_t	_run_perf;
+
+	/* do not allow copying */
+	ScheduledWorkItem(const ScheduledWorkItem &);
+	ScheduledWorkItem &operator=(const ScheduledWorkItem &);
+};
+
+} // namespace px4
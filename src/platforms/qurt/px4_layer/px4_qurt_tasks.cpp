@@ -309,6 +309,16 @@ void px4_show_tasks()
 
 }
 
+int px4_task_stats(px4_task_stats_t *stats, int max)
+{
+	/* no per-thread CPU clocks on QURT */
+	return 0;
+}
+
+void px4_task_wakeup_latency(uint32_t latency_us)
+{
+}
+
 __BEGIN_DECLS
 
 int px4_getpid()
@@ -122,11 +122,26 @@ load(const char *devname, const char *fname)
 		return 1;
 	}
 
-	if (load_mixer_file(fname, &buf[0], sizeof(buf)) < 0) {
+	bool binary;
+	int buflen = load_mixer_definition(fname, &buf[0], sizeof(buf), &binary);
+
+	if (buflen < 0) {
 		warnx("can't load mixer: %s", fname);
 		return 1;
 	}
 
+	/* preparsed binary mixers are passed as they are */
+	if (binary) {
+		struct mixer_binary_s bin = { (const uint8_t *)&buf[0], (unsigned)buflen };
+
+		if (px4_ioctl(dev, MIXERIOCLOADBIN, (unsigned long)&bin) < 0) {
+			warnx("error loading binary mixers from %s", fname);
+			return 1;
+		}
+
+		return 0;
+	}
+
 	/* XXX pass the buffer to the device */
 	int ret = px4_ioctl(dev, MIXERIOCLOADBUF, (unsigned long)buf);
 
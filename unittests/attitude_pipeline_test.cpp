@@ -0,0 +1,208 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <px4_posix.h>
+#include <drivers/drv_hrt.h>
+#include <systemlib/attitude_pipeline.h>
+#include <uORB/uORB.h>
+#include <uORB/uORBDevices.hpp>
+#include <uORB/topics/vehicle_attitude.h>
+
+#include "gtest/gtest.h"
+
+namespace px4
+{
+void init_once();
+}
+
+struct stage_state {
+	unsigned runs;
+	unsigned teardowns;
+	bool stay;
+	float roll;
+	hrt_abstime latency_sum;
+	hrt_abstime latency_max;
+};
+
+static bool counting_stage(void *arg, const struct vehicle_attitude_s *att)
+{
+	struct stage_state *state = (struct stage_state *)arg;
+
+	if (att == nullptr) {
+		state->teardowns++;
+		return false;
+	}
+
+	state->runs++;
+	state->roll = att->roll;
+
+	hrt_abstime latency = hrt_absolute_time() - att->timestamp;
+	state->latency_sum += latency;
+
+	if (latency > state->latency_max) {
+		state->latency_max = latency;
+	}
+
+	return state->stay;
+}
+
+static struct vehicle_attitude_s attitude(float roll)
+{
+	struct vehicle_attitude_s att = {};
+	att.timestamp = hrt_absolute_time();
+	att.roll = roll;
+	return att;
+}
+
+TEST(AttitudePipelineTest, Lifecycle)
+{
+	struct stage_state state = {};
+	state.stay = true;
+
+	// nothing hosts the pipeline yet
+	ASSERT_EQ(-ENODEV, attitude_pipeline_attach(counting_stage, &state));
+
+	ASSERT_EQ(OK, attitude_pipeline_open());
+	ASSERT_EQ(-EBUSY, attitude_pipeline_open());
+
+	// running without a stage is a no-op
+	struct vehicle_attitude_s att = attitude(0.1f);
+	attitude_pipeline_run(&att);
+
+	ASSERT_EQ(OK, attitude_pipeline_attach(counting_stage, &state));
+	ASSERT_EQ(-EBUSY, attitude_pipeline_attach(counting_stage, &state));
+	ASSERT_TRUE(attitude_pipeline_attached(counting_stage, &state));
+
+	att = attitude(0.2f);
+	attitude_pipeline_run(&att);
+	ASSERT_EQ(1u, state.runs);
+	ASSERT_FLOAT_EQ(0.2f, state.roll);
+
+	// closing the host tears the stage down on the host thread
+	attitude_pipeline_close();
+	ASSERT_EQ(1u, state.teardowns);
+	ASSERT_FALSE(attitude_pipeline_attached(counting_stage, &state));
+	ASSERT_EQ(-ENODEV, attitude_pipeline_attach(counting_stage, &state));
+
+	// a restarted host accepts the stage again
+	ASSERT_EQ(OK, attitude_pipeline_open());
+	ASSERT_EQ(OK, attitude_pipeline_attach(counting_stage, &state));
+	attitude_pipeline_run(&att);
+	ASSERT_EQ(2u, state.runs);
+
+	attitude_pipeline_close();
+	ASSERT_EQ(2u, state.teardowns);
+}
+
+TEST(AttitudePipelineTest, Detach)
+{
+	struct stage_state state = {};
+	state.stay = false;
+
+	ASSERT_EQ(OK, attitude_pipeline_open());
+
+	// a stage returning false is detached after that run
+	ASSERT_EQ(OK, attitude_pipeline_attach(counting_stage, &state));
+	struct vehicle_attitude_s att = attitude(0.1f);
+	attitude_pipeline_run(&att);
+	attitude_pipeline_run(&att);
+	ASSERT_EQ(1u, state.runs);
+	ASSERT_FALSE(attitude_pipeline_attached(counting_stage, &state));
+
+	// a forced detach skips the teardown and the stage never runs again
+	state.stay = true;
+	ASSERT_EQ(OK, attitude_pipeline_attach(counting_stage, &state));
+	attitude_pipeline_detach(counting_stage, &state);
+	attitude_pipeline_run(&att);
+	ASSERT_EQ(1u, state.runs);
+
+	attitude_pipeline_close();
+	ASSERT_EQ(0u, state.teardowns);
+}
+
+static volatile bool subscriber_exit;
+
+/*
+ * The rate controller as its own task: woken on vehicle_attitude.
+ */
+static void *subscriber_task(void *arg)
+{
+	struct stage_state *state = (struct stage_state *)arg;
+	int sub = orb_subscribe(ORB_ID(vehicle_attitude));
+
+	px4_pollfd_struct_t fds[1];
+	fds[0].fd = sub;
+	fds[0].events = POLLIN;
+
+	while (!subscriber_exit) {
+		if (px4_poll(&fds[0], 1, 100) > 0 && (fds[0].revents & POLLIN)) {
+			struct vehicle_attitude_s att;
+			orb_copy(ORB_ID(vehicle_attitude), sub, &att);
+			counting_stage(state, &att);
+		}
+	}
+
+	orb_unsubscribe(sub);
+	return nullptr;
+}
+
+TEST(AttitudePipelineTest, Latency)
+{
+	px4::init_once();
+
+	uORB::DeviceMaster *master = new uORB::DeviceMaster(uORB::PUBSUB);
+	master->init();
+
+	const unsigned samples = 1000;
+	struct vehicle_attitude_s att = attitude(0.0f);
+	orb_advert_t pub = orb_advertise(ORB_ID(vehicle_attitude), &att);
+	ASSERT_TRUE(pub != nullptr);
+
+	// publish to a controller task, time from the estimator's sample to the controller
+	struct stage_state task = {};
+	subscriber_exit = false;
+	pthread_t thread;
+	ASSERT_EQ(0, pthread_create(&thread, nullptr, subscriber_task, &task));
+	usleep(50000);
+
+	for (unsigned i = 0; i < samples; i++) {
+		att = attitude(i);
+		orb_publish(ORB_ID(vehicle_attitude), pub, &att);
+		usleep(1000);
+	}
+
+	subscriber_exit = true;
+	pthread_join(thread, nullptr);
+
+	// publish and hand the same sample to the pipeline stage
+	struct stage_state stage = {};
+	stage.stay = true;
+	ASSERT_EQ(OK, attitude_pipeline_open());
+	ASSERT_EQ(OK, attitude_pipeline_attach(counting_stage, &stage));
+
+	for (unsigned i = 0; i < samples; i++) {
+		att = attitude(i);
+		orb_publish(ORB_ID(vehicle_attitude), pub, &att);
+		attitude_pipeline_run(&att);
+		usleep(1000);
+	}
+
+	attitude_pipeline_close();
+
+	ASSERT_GT(task.runs, samples * 9 / 10);
+	ASSERT_EQ(samples, stage.runs);
+
+	hrt_abstime task_mean = task.latency_sum / task.runs;
+	hrt_abstime stage_mean = stage.latency_sum / stage.runs;
+
+	printf("attitude to controller latency over %u samples:\n", samples);
+	printf("  task:     mean %llu us, max %llu us\n", (unsigned long long)task_mean,
+	       (unsigned long long)task.latency_max);
+	printf("  pipeline: mean %llu us, max %llu us\n", (unsigned long long)stage_mean,
+	       (unsigned long long)stage.latency_max);
+
+	// no wakeup and no copy, the stage runs right after the publish
+	ASSERT_LE(stage_mean, task_mean);
+}
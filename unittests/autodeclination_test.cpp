@@ -14,5 +14,103 @@
 
 TEST(AutoDeclinationTest, AutoDeclination)
 {
-	ASSERT_NEAR(get_mag_declination(47.0, 8.0), 0.6, 0.5) << "declination differs more than 1 degree";
+	ASSERT_NEAR(get_mag_declination(47.0, 8.0), 1.8, 0.5) << "declination differs more than 0.5 degree";
+}
+
+/*
+ * Test values published in the WMM2015 technical report, epoch 2015.0 at
+ * sea level. All three are grid nodes, so only the fixed point rounding of
+ * the tables separates the lookup from the published numbers.
+ */
+struct mag_reference {
+	float lat;
+	float lon;
+	float declination;	/* deg */
+	float inclination;	/* deg */
+	float strength;		/* nT */
+};
+
+static const mag_reference wmm2015_test_values[] = {
+	{  80.0f,    0.0f,  -3.85f,  83.04f, 54836.0f },
+	{   0.0f,  120.0f,   0.57f, -15.89f, 41090.9f },
+	{ -80.0f, -120.0f,  69.81f, -72.39f, 55519.8f },
+};
+
+TEST(AutoDeclinationTest, WMM2015TestValues)
+{
+	for (unsigned i = 0; i < sizeof(wmm2015_test_values) / sizeof(wmm2015_test_values[0]); i++) {
+		const mag_reference &ref = wmm2015_test_values[i];
+
+		/* half a table LSB plus half a digit of the published value */
+		EXPECT_NEAR(get_mag_declination(ref.lat, ref.lon), ref.declination, 0.011f) << "lat " << ref.lat << " lon " << ref.lon;
+		EXPECT_NEAR(get_mag_inclination(ref.lat, ref.lon), ref.inclination, 0.011f) << "lat " << ref.lat << " lon " << ref.lon;
+		EXPECT_NEAR(get_mag_strength(ref.lat, ref.lon), ref.strength * 1e-5f, 0.00006f) << "lat " << ref.lat << " lon " << ref.lon;
+	}
+}
+
+/*
+ * WMM2015 at sea level, epoch 2015.0, between grid nodes, see
+ * Tools/px_generate_mag_tables.py --point LAT LON. The tolerances are the
+ * bilinear interpolation error of the 5 x 10 degree grid.
+ */
+static const mag_reference mag_references[] = {
+	{  47.0f,    8.0f,   1.85f,  62.95f, 47724.0f },	/* Zurich */
+	{  40.0f, -105.25f,  8.69f,  66.52f, 52453.0f },	/* Boulder */
+	{ -33.9f,  151.2f,  12.55f, -64.32f, 57114.0f },	/* Sydney */
+	{ -34.0f,   18.5f, -25.00f, -65.88f, 25594.0f },	/* Cape Town */
+	{   1.3f,  103.8f,   0.23f, -14.42f, 42091.0f },	/* Singapore */
+	{  35.7f,  139.7f,  -7.31f,  49.49f, 46530.0f },	/* Tokyo */
+	{ -15.8f,  -47.9f, -21.27f, -26.08f, 23493.0f },	/* Brasilia */
+	{  64.1f,  -21.9f, -14.52f,  75.49f, 52364.0f },	/* Reykjavik */
+	{  61.2f, -149.9f,  17.26f,  74.22f, 55672.0f },	/* Anchorage */
+	{ -54.8f,  -68.3f,  12.59f, -50.76f, 31959.0f },	/* Ushuaia */
+	{  78.2f,   15.6f,   7.88f,  82.24f, 54774.0f },	/* Longyearbyen */
+	{ -77.8f,  166.7f, 142.27f, -80.60f, 62541.0f },	/* McMurdo */
+};
+
+TEST(AutoDeclinationTest, ReferenceAccuracy)
+{
+	for (unsigned i = 0; i < sizeof(mag_references) / sizeof(mag_references[0]); i++) {
+		const mag_reference &ref = mag_references[i];
+
+		/* declination turns quickly close to the south magnetic pole */
+		const float declination_tolerance = (ref.lat < -75.0f) ? 2.0f : 0.4f;
+
+		EXPECT_NEAR(get_mag_declination(ref.lat, ref.lon), ref.declination, declination_tolerance) << "lat " << ref.lat << " lon " << ref.lon;
+		EXPECT_NEAR(get_mag_inclination(ref.lat, ref.lon), ref.inclination, 0.25f) << "lat " << ref.lat << " lon " << ref.lon;
+		EXPECT_NEAR(get_mag_strength(ref.lat, ref.lon), ref.strength * 1e-5f, 0.0015f) << "lat " << ref.lat << " lon " << ref.lon;
+	}
+}
+
+TEST(AutoDeclinationTest, CachedLookup)
+{
+	struct mag_field_cache_s cache;
+	mag_field_cache_init(&cache);
+
+	/* walk across several cells, the cache must never change the result */
+	for (float lat = 45.0f, lon = 5.0f; lat < 56.0f; lat += 0.37f, lon += 0.53f) {
+		float declination, inclination, strength;
+		ASSERT_EQ(get_mag_field(&cache, lat, lon, &declination, &inclination, &strength), 0);
+
+		EXPECT_EQ(declination, get_mag_declination(lat, lon));
+		EXPECT_EQ(inclination, get_mag_inclination(lat, lon));
+		EXPECT_EQ(strength, get_mag_strength(lat, lon));
+	}
+}
+
+TEST(AutoDeclinationTest, Bounds)
+{
+	struct mag_field_cache_s cache;
+	mag_field_cache_init(&cache);
+
+	float declination;
+	EXPECT_EQ(get_mag_field(&cache, 90.5f, 0.0f, &declination, NULL, NULL), -1);
+	EXPECT_EQ(get_mag_field(&cache, 0.0f, -180.5f, &declination, NULL, NULL), -1);
+	EXPECT_EQ(get_mag_declination(-91.0f, 0.0f), 0.0f);
+
+	/* the poles and the date line are part of the grid */
+	EXPECT_EQ(get_mag_field(&cache, 90.0f, 180.0f, &declination, NULL, NULL), 0);
+	EXPECT_EQ(get_mag_field(&cache, -90.0f, -180.0f, &declination, NULL, NULL), 0);
+	EXPECT_NEAR(get_mag_inclination(90.0f, 0.0f), 88.0f, 2.0f);
+	EXPECT_NEAR(get_mag_inclination(-90.0f, 0.0f), -73.0f, 2.0f);
 }
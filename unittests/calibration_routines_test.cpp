@@ -0,0 +1,220 @@
+#include <math.h>
+#include <stdlib.h>
+
+#include <commander/calibration_routines.h>
+#include <commander/commander_helper.h>
+#include <uORB/uORB.h>
+#include <uORB/topics/sensor_combined.h>
+#include <uORB/topics/vehicle_command.h>
+
+#include "gtest/gtest.h"
+
+/* the fit doesn't talk to uORB, mavlink or the buzzer, the rest of the file does */
+ORB_DEFINE(sensor_combined, struct sensor_combined_s);
+ORB_DEFINE(vehicle_command, struct vehicle_command_s);
+
+extern "C" {
+	int orb_subscribe(const struct orb_metadata *meta) { return -1; }
+	int orb_unsubscribe(int handle) { return -1; }
+	int orb_copy(const struct orb_metadata *meta, int handle, void *buffer) { return -1; }
+	void mavlink_vasprintf(int _fd, int severity, const char *fmt, ...) {}
+}
+
+void tune_positive(bool use_buzzer) {}
+void tune_neutral(bool use_buzzer) {}
+void tune_negative(bool use_buzzer) {}
+
+/* cell size of the mag calibration for 240 samples on a 0.2 Ga sphere */
+static const float cell_size = 5.4f * 0.2f / sqrtf(240.0f) / 3.0f;
+
+/* a point on the unit sphere, spread evenly with a golden angle spiral */
+static void spiral_point(unsigned i, unsigned count, float p[3])
+{
+	const float z = 1.0f - 2.0f * (i + 0.5f) / count;
+	const float r = sqrtf(1.0f - z * z);
+	const float phi = i * 2.39996323f;
+
+	p[0] = r * cosf(phi);
+	p[1] = r * sinf(phi);
+	p[2] = z;
+}
+
+/* add the points of an axis-aligned ellipsoid, skipping covered cells like the calibration */
+static unsigned fill(struct ellipsoid_fit_s *fit, const float center[3], const float radii[3], unsigned count)
+{
+	unsigned added = 0;
+
+	for (unsigned i = 0; i < count; i++) {
+		float p[3];
+		spiral_point(i, count, p);
+
+		const float x = center[0] + radii[0] * p[0];
+		const float y = center[1] + radii[1] * p[1];
+		const float z = center[2] + radii[2] * p[2];
+
+		if (!ellipsoid_fit_covered(fit, x, y, z)) {
+			ellipsoid_fit_add(fit, x, y, z);
+			added++;
+		}
+	}
+
+	return added;
+}
+
+TEST(CalibrationRoutinesTest, Ellipsoid)
+{
+	struct ellipsoid_fit_s fit;
+	ellipsoid_fit_init(&fit, cell_size);
+
+	const float center[3] = { 0.1f, -0.05f, 0.2f };
+	const float radii[3] = { 0.5f, 0.4f, 0.45f };
+	fill(&fit, center, radii, 240);
+
+	float offset[3];
+	float scale[3];
+	float radius;
+	ASSERT_EQ(0, ellipsoid_fit_solve(&fit, offset, scale, &radius));
+
+	// the scales map the ellipsoid onto a sphere of the same volume
+	const float expected_radius = cbrtf(radii[0] * radii[1] * radii[2]);
+	EXPECT_NEAR(expected_radius, radius, 1e-3f);
+
+	for (int i = 0; i < 3; i++) {
+		EXPECT_NEAR(center[i], offset[i], 1e-3f) << "axis " << i;
+		EXPECT_NEAR(expected_radius / radii[i], scale[i], 1e-3f) << "axis " << i;
+	}
+
+	EXPECT_NEAR(1.0f, scale[0] * scale[1] * scale[2], 1e-4f);
+}
+
+TEST(CalibrationRoutinesTest, Sphere)
+{
+	struct ellipsoid_fit_s fit;
+	ellipsoid_fit_init(&fit, cell_size);
+
+	const float center[3] = { -0.2f, 0.15f, 0.05f };
+	const float radii[3] = { 0.3f, 0.3f, 0.3f };
+	fill(&fit, center, radii, 240);
+
+	float offset[3];
+	float scale[3];
+	float radius;
+	ASSERT_EQ(0, ellipsoid_fit_solve(&fit, offset, scale, &radius));
+	EXPECT_NEAR(0.3f, radius, 1e-3f);
+
+	for (int i = 0; i < 3; i++) {
+		EXPECT_NEAR(center[i], offset[i], 1e-3f) << "axis " << i;
+		EXPECT_NEAR(1.0f, scale[i], 1e-3f) << "axis " << i;
+	}
+
+	float sphere_center[3];
+	ASSERT_EQ(0, ellipsoid_fit_sphere(&fit, sphere_center, &radius));
+	EXPECT_NEAR(0.3f, radius, 1e-4f);
+
+	for (int i = 0; i < 3; i++) {
+		EXPECT_NEAR(center[i], sphere_center[i], 1e-4f) << "axis " << i;
+	}
+}
+
+TEST(CalibrationRoutinesTest, SphereFallback)
+{
+	struct ellipsoid_fit_s fit;
+	ellipsoid_fit_init(&fit, cell_size);
+
+	// samples from a single rotation around z only cover a ring, the
+	// ellipsoid is undetermined along z but the sphere is not
+	const float center[3] = { 0.05f, 0.1f, -0.1f };
+	const float r = 0.35f;
+	const float height = 0.1f;
+
+	for (unsigned i = 0; i < 240; i++) {
+		const float phi = i * 2.0f * (float)M_PI / 240;
+		const float x = center[0] + sqrtf(r * r - height * height) * cosf(phi);
+		const float y = center[1] + sqrtf(r * r - height * height) * sinf(phi);
+		const float z = center[2] + ((i % 2) ? height : -height);
+
+		if (!ellipsoid_fit_covered(&fit, x, y, z)) {
+			ellipsoid_fit_add(&fit, x, y, z);
+		}
+	}
+
+	float offset[3];
+	float scale[3];
+	float radius;
+	EXPECT_NE(0, ellipsoid_fit_solve(&fit, offset, scale, &radius));
+
+	ASSERT_EQ(0, ellipsoid_fit_sphere(&fit, offset, &radius));
+	EXPECT_NEAR(r, radius, 1e-3f);
+
+	for (int i = 0; i < 3; i++) {
+		EXPECT_NEAR(center[i], offset[i], 1e-3f) << "axis " << i;
+	}
+}
+
+TEST(CalibrationRoutinesTest, NotEnoughSamples)
+{
+	struct ellipsoid_fit_s fit;
+	ellipsoid_fit_init(&fit, cell_size);
+
+	float p[3] = { 0.3f, 0.0f, 0.0f };
+	ellipsoid_fit_add(&fit, p[0], p[1], p[2]);
+
+	float offset[3];
+	float scale[3];
+	float radius;
+	EXPECT_NE(0, ellipsoid_fit_solve(&fit, offset, scale, &radius));
+	EXPECT_NE(0, ellipsoid_fit_sphere(&fit, offset, &radius));
+}
+
+TEST(CalibrationRoutinesTest, CoverageRejection)
+{
+	struct ellipsoid_fit_s fit;
+	ellipsoid_fit_init(&fit, cell_size);
+
+	// the middle of a cell
+	const float x = 12.5f * cell_size;
+	const float y = 4.5f * cell_size;
+	const float z = -8.5f * cell_size;
+
+	EXPECT_FALSE(ellipsoid_fit_covered(&fit, x, y, z));
+	ellipsoid_fit_add(&fit, x, y, z);
+
+	// the whole cell is covered, its neighbours aren't
+	EXPECT_TRUE(ellipsoid_fit_covered(&fit, x, y, z));
+	EXPECT_TRUE(ellipsoid_fit_covered(&fit, x + cell_size * 0.4f, y - cell_size * 0.4f, z));
+	EXPECT_FALSE(ellipsoid_fit_covered(&fit, x + cell_size, y, z));
+	EXPECT_FALSE(ellipsoid_fit_covered(&fit, x, y, z - cell_size));
+
+	// a vehicle sitting still adds a single sample
+	for (int i = 0; i < 100; i++) {
+		if (!ellipsoid_fit_covered(&fit, x, y, z)) {
+			ellipsoid_fit_add(&fit, x, y, z);
+		}
+	}
+
+	EXPECT_EQ(1u, fit.count);
+
+	// after a full calibration worth of cells, few new cells collide in the hashed bitmap
+	const float center[3] = { 0.0f, 0.0f, 0.0f };
+	const float radii[3] = { 0.5f, 0.5f, 0.5f };
+	ellipsoid_fit_init(&fit, cell_size);
+
+	// samples this far apart only collide in the bitmap
+	EXPECT_GE(fill(&fit, center, radii, 240), 220u);
+
+	unsigned collisions = 0;
+	const unsigned probes = 1000;
+
+	for (unsigned i = 0; i < probes; i++) {
+		// cells far away from the sphere, never filled
+		const float x = 2.0f + (i % 10) * cell_size;
+		const float y = 2.0f + ((i / 10) % 10) * cell_size;
+		const float z = 2.0f + (i / 100) * cell_size;
+
+		if (ellipsoid_fit_covered(&fit, x, y, z)) {
+			collisions++;
+		}
+	}
+
+	EXPECT_LT(collisions, probes / 10);
+}
@@ -1,5 +1,7 @@
 #include <systemlib/mixer/mixer.h>
 #include <systemlib/err.h>
+#include <conversion/rotation.h>
+#include <string.h>
 #include "../../src/systemcmds/tests/tests.h"
 
 #include "gtest/gtest.h"
@@ -8,3 +10,292 @@ TEST(ConversionTest, quad_w_main)
 {
 	ASSERT_EQ(test_conv(0, NULL), 0) << "Conversion test failed";
 }
+
+#define HALF_SQRT_2 0.70710678118654757f
+
+// Switch based rotate_3f() the rotation table replaced, kept as the reference
+static void
+rotate_3f_reference(enum Rotation rot, float &x, float &y, float &z)
+{
+	float tmp;
+
+	switch (rot) {
+	case ROTATION_NONE:
+	case ROTATION_MAX:
+		return;
+
+	case ROTATION_YAW_45: {
+			tmp = HALF_SQRT_2 * (x - y);
+			y   = HALF_SQRT_2 * (x + y);
+			x = tmp;
+			return;
+		}
+
+	case ROTATION_YAW_90: {
+			tmp = x; x = -y; y = tmp;
+			return;
+		}
+
+	case ROTATION_YAW_135: {
+			tmp = -HALF_SQRT_2 * (x + y);
+			y   =  HALF_SQRT_2 * (x - y);
+			x = tmp;
+			return;
+		}
+
+	case ROTATION_YAW_180:
+		x = -x; y = -y;
+		return;
+
+	case ROTATION_YAW_225: {
+			tmp = HALF_SQRT_2 * (y - x);
+			y   = -HALF_SQRT_2 * (x + y);
+			x = tmp;
+			return;
+		}
+
+	case ROTATION_YAW_270: {
+			tmp = x; x = y; y = -tmp;
+			return;
+		}
+
+	case ROTATION_YAW_315: {
+			tmp = HALF_SQRT_2 * (x + y);
+			y   = HALF_SQRT_2 * (y - x);
+			x = tmp;
+			return;
+		}
+
+	case ROTATION_ROLL_180: {
+			y = -y; z = -z;
+			return;
+		}
+
+	case ROTATION_ROLL_180_YAW_45: {
+			tmp = HALF_SQRT_2 * (x + y);
+			y   = HALF_SQRT_2 * (x - y);
+			x = tmp; z = -z;
+			return;
+		}
+
+	case ROTATION_ROLL_180_YAW_90: {
+			tmp = x; x = y; y = tmp; z = -z;
+			return;
+		}
+
+	case ROTATION_ROLL_180_YAW_135: {
+			tmp = HALF_SQRT_2 * (y - x);
+			y   = HALF_SQRT_2 * (y + x);
+			x = tmp; z = -z;
+			return;
+		}
+
+	case ROTATION_PITCH_180: {
+			x = -x; z = -z;
+			return;
+		}
+
+	case ROTATION_ROLL_180_YAW_225: {
+			tmp = -HALF_SQRT_2 * (x + y);
+			y   =  HALF_SQRT_2 * (y - x);
+			x = tmp; z = -z;
+			return;
+		}
+
+	case ROTATION_ROLL_180_YAW_270: {
+			tmp = x; x = -y; y = -tmp; z = -z;
+			return;
+		}
+
+	case ROTATION_ROLL_180_YAW_315: {
+			tmp =  HALF_SQRT_2 * (x - y);
+			y   = -HALF_SQRT_2 * (x + y);
+			x = tmp; z = -z;
+			return;
+		}
+
+	case ROTATION_ROLL_90: {
+			tmp = z; z = y; y = -tmp;
+			return;
+		}
+
+	case ROTATION_ROLL_90_YAW_45: {
+			tmp = z; z = y; y = -tmp;
+			tmp = HALF_SQRT_2 * (x - y);
+			y   = HALF_SQRT_2 * (x + y);
+			x = tmp;
+			return;
+		}
+
+	case ROTATION_ROLL_90_YAW_90: {
+			tmp = z; z = y; y = -tmp;
+			tmp = x; x = -y; y = tmp;
+			return;
+		}
+
+	case ROTATION_ROLL_90_YAW_135: {
+			tmp = z; z = y; y = -tmp;
+			tmp = -HALF_SQRT_2 * (x + y);
+			y   =  HALF_SQRT_2 * (x - y);
+			x = tmp;
+			return;
+		}
+
+	case ROTATION_ROLL_270: {
+			tmp = z; z = -y; y = tmp;
+			return;
+		}
+
+	case ROTATION_ROLL_270_YAW_45: {
+			tmp = z; z = -y; y = tmp;
+			tmp = HALF_SQRT_2 * (x - y);
+			y   = HALF_SQRT_2 * (x + y);
+			x = tmp;
+			return;
+		}
+
+	case ROTATION_ROLL_270_YAW_90: {
+			tmp = z; z = -y; y = tmp;
+			tmp = x; x = -y; y = tmp;
+			return;
+		}
+
+	case ROTATION_ROLL_270_YAW_135: {
+			tmp = z; z = -y; y = tmp;
+			tmp = -HALF_SQRT_2 * (x + y);
+			y   =  HALF_SQRT_2 * (x - y);
+			x = tmp;
+			return;
+		}
+
+	case ROTATION_ROLL_270_YAW_270: {
+			tmp = z; z = -y; y = tmp;
+			tmp = x; x = y; y = -tmp;
+			return;
+		}
+
+	case ROTATION_PITCH_90: {
+			tmp = z; z = -x; x = tmp;
+			return;
+		}
+
+	case ROTATION_PITCH_270: {
+			tmp = z; z = x; x = -tmp;
+			return;
+		}
+
+	case ROTATION_ROLL_180_PITCH_270: {
+			tmp = z; z = x; x = tmp;
+			y = -y;
+			return;
+		}
+
+	case ROTATION_PITCH_90_YAW_180: {
+			tmp = x; x = z; z = tmp;
+			y = -y;
+			return;
+		}
+	}
+}
+
+static const float rotation_test_values[] = {
+	0.0f, -0.0f, 1.0f, -1.0f, 0.5f, -0.25f, 1e-30f, -3.3e-38f, 9.81f, -9.81f,
+	123.456f, -654.321f, 3.4e38f, -3.4e38f, INFINITY, -INFINITY
+};
+
+static bool same_bits(float a, float b)
+{
+	return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+template <enum Rotation ROT>
+static void check_compile_time_rotation(float x, float y, float z)
+{
+	float rx = x, ry = y, rz = z;
+	rotate_3f_reference(ROT, rx, ry, rz);
+	rotate_3f<ROT>(x, y, z);
+	EXPECT_TRUE(same_bits(x, rx) && same_bits(y, ry) && same_bits(z, rz)) << "rotation " << ROT;
+}
+
+TEST(ConversionTest, rotate_3f_matches_switch)
+{
+	const unsigned n = sizeof(rotation_test_values) / sizeof(rotation_test_values[0]);
+
+	for (unsigned rot = 0; rot <= ROTATION_MAX; rot++) {
+		for (unsigned i = 0; i < n; i++) {
+			for (unsigned j = 0; j < n; j++) {
+				for (unsigned k = 0; k < n; k++) {
+					float x = rotation_test_values[i], y = rotation_test_values[j], z = rotation_test_values[k];
+					float rx = x, ry = y, rz = z;
+
+					rotate_3f_reference((enum Rotation)rot, rx, ry, rz);
+					rotate_3f((enum Rotation)rot, x, y, z);
+
+					ASSERT_TRUE(same_bits(x, rx) && same_bits(y, ry) && same_bits(z, rz))
+							<< "rotation " << rot << " input " << i << " " << j << " " << k;
+				}
+			}
+		}
+	}
+}
+
+TEST(ConversionTest, rotate_3f_array_matches_switch)
+{
+	const unsigned n = sizeof(rotation_test_values) / sizeof(rotation_test_values[0]);
+	float xyz[n * 3];
+
+	for (unsigned rot = 0; rot <= ROTATION_MAX; rot++) {
+		for (unsigned i = 0; i < n; i++) {
+			xyz[i * 3 + 0] = rotation_test_values[i];
+			xyz[i * 3 + 1] = rotation_test_values[(i + 5) % n];
+			xyz[i * 3 + 2] = rotation_test_values[(i + 11) % n];
+		}
+
+		rotate_3f_array((enum Rotation)rot, xyz, n);
+
+		for (unsigned i = 0; i < n; i++) {
+			float rx = rotation_test_values[i];
+			float ry = rotation_test_values[(i + 5) % n];
+			float rz = rotation_test_values[(i + 11) % n];
+			rotate_3f_reference((enum Rotation)rot, rx, ry, rz);
+
+			ASSERT_TRUE(same_bits(xyz[i * 3 + 0], rx) && same_bits(xyz[i * 3 + 1], ry) && same_bits(xyz[i * 3 + 2], rz))
+					<< "rotation " << rot << " sample " << i;
+		}
+	}
+}
+
+TEST(ConversionTest, rotate_3f_compile_time_matches_switch)
+{
+	const float x = 0.3f, y = -1.7f, z = 9.81f;
+
+	check_compile_time_rotation<ROTATION_NONE>(x, y, z);
+	check_compile_time_rotation<ROTATION_YAW_45>(x, y, z);
+	check_compile_time_rotation<ROTATION_YAW_90>(x, y, z);
+	check_compile_time_rotation<ROTATION_YAW_135>(x, y, z);
+	check_compile_time_rotation<ROTATION_YAW_180>(x, y, z);
+	check_compile_time_rotation<ROTATION_YAW_225>(x, y, z);
+	check_compile_time_rotation<ROTATION_YAW_270>(x, y, z);
+	check_compile_time_rotation<ROTATION_YAW_315>(x, y, z);
+	check_compile_time_rotation<ROTATION_ROLL_180>(x, y, z);
+	check_compile_time_rotation<ROTATION_ROLL_180_YAW_45>(x, y, z);
+	check_compile_time_rotation<ROTATION_ROLL_180_YAW_90>(x, y, z);
+	check_compile_time_rotation<ROTATION_ROLL_180_YAW_135>(x, y, z);
+	check_compile_time_rotation<ROTATION_PITCH_180>(x, y, z);
+	check_compile_time_rotation<ROTATION_ROLL_180_YAW_225>(x, y, z);
+	check_compile_time_rotation<ROTATION_ROLL_180_YAW_270>(x, y, z);
+	check_compile_time_rotation<ROTATION_ROLL_180_YAW_315>(x, y, z);
+	check_compile_time_rotation<ROTATION_ROLL_90>(x, y, z);
+	check_compile_time_rotation<ROTATION_ROLL_90_YAW_45>(x, y, z);
+	check_compile_time_rotation<ROTATION_ROLL_90_YAW_90>(x, y, z);
+	check_compile_time_rotation<ROTATION_ROLL_90_YAW_135>(x, y, z);
+	check_compile_time_rotation<ROTATION_ROLL_270>(x, y, z);
+	check_compile_time_rotation<ROTATION_ROLL_270_YAW_45>(x, y, z);
+	check_compile_time_rotation<ROTATION_ROLL_270_YAW_90>(x, y, z);
+	check_compile_time_rotation<ROTATION_ROLL_270_YAW_135>(x, y, z);
+	check_compile_time_rotation<ROTATION_PITCH_90>(x, y, z);
+	check_compile_time_rotation<ROTATION_PITCH_270>(x, y, z);
+	check_compile_time_rotation<ROTATION_ROLL_270_YAW_270>(x, y, z);
+	check_compile_time_rotation<ROTATION_ROLL_180_PITCH_270>(x, y, z);
+	check_compile_time_rotation<ROTATION_PITCH_90_YAW_180>(x, y, z);
+}
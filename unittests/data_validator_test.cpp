@@ -0,0 +1,95 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <ecl/validation/data_validator_group.h>
+#include <ecl/validation/data_validator_array.h>
+
+#include "gtest/gtest.h"
+
+/*
+ * Feed the same sample stream to the list based DataValidatorGroup and the
+ * fixed-size DataValidatorArray and require identical decisions.
+ */
+TEST(DataValidatorTest, ArrayMatchesGroup)
+{
+	const unsigned count = 3;
+	DataValidatorGroup group(count);
+	DataValidatorArray<count> array;
+
+	group.set_timeout(50000);
+	array.set_timeout(50000);
+
+	uint64_t error_count[count] = {};
+	int priority[count] = { 50, 75, 50 };
+	srand(42);
+
+	for (unsigned step = 0; step < 20000; step++) {
+		uint64_t timestamp = 1000 + step * 4000ULL;
+
+		for (unsigned i = 0; i < count; i++) {
+			/* sensor 1 drops out for a while, sensor 2 freezes, sensor 0 collects errors */
+			if (i == 1 && step > 3000 && step < 3200) {
+				continue;
+			}
+
+			if (i == 0 && (step % 7) == 0 && step > 8000 && step < 9000) {
+				error_count[i]++;
+			}
+
+			if (i == 2 && step == 12000) {
+				priority[i] = 100;
+			}
+
+			float val[3];
+
+			for (unsigned j = 0; j < 3; j++) {
+				val[j] = (i == 2 && step > 15000 && step < 15500) ? 1.0f : (float)(rand() % 1000) / 100.0f;
+			}
+
+			group.put(i, timestamp, val, error_count[i], priority[i]);
+			array.put(i, timestamp, val, error_count[i], priority[i]);
+		}
+
+		int group_index = -2;
+		int array_index = -2;
+		float *group_best = group.get_best(timestamp, &group_index);
+		const float *array_best = array.get_best(timestamp, &array_index);
+
+		ASSERT_EQ(group_index, array_index) << "step " << step;
+		ASSERT_EQ(group_best == nullptr, array_best == nullptr) << "step " << step;
+
+		if (group_best != nullptr) {
+			ASSERT_EQ(memcmp(group_best, array_best, 3 * sizeof(float)), 0) << "step " << step;
+		}
+
+		ASSERT_EQ(group.failover_count(), array.failover_count()) << "step " << step;
+		ASSERT_EQ(group.get_vibration_factor(timestamp), array.get_vibration_factor(timestamp)) << "step " << step;
+	}
+
+	/* the scenario above must have exercised the failover logic */
+	EXPECT_GT(array.failover_count(), 0u);
+}
+
+TEST(DataValidatorTest, ArrayTimeout)
+{
+	DataValidatorArray<4> array;
+	float val[3] = { 1.0f, 2.0f, 3.0f };
+	float confidence[4];
+
+	array.put(3, 1000, val, 0, 0);
+	array.confidence(1000, confidence);
+
+	EXPECT_EQ(confidence[0], 0.0f);
+	EXPECT_EQ(confidence[3], 1.0f);
+
+	int index;
+	EXPECT_NE(array.get_best(1000, &index), nullptr);
+	EXPECT_EQ(index, 3);
+
+	/* default timeout is 20 ms */
+	array.confidence(1000 + 20001, confidence);
+	EXPECT_EQ(confidence[3], 0.0f);
+
+	/* out of range instances are ignored */
+	array.put(4, 1000, val, 0, 0);
+}
@@ -0,0 +1,69 @@
+#include <math.h>
+
+#include <geo/geo.h>
+
+#include "gtest/gtest.h"
+
+/* a regular grid of points around the reference, out to beyond the fast radius */
+static unsigned fill_grid(double lat_0, double lon_0, double extent_m, double lat[], double lon[], unsigned max_count)
+{
+	const double extent_deg = extent_m / CONSTANTS_RADIUS_OF_EARTH * M_RAD_TO_DEG;
+	const double lon_scale = 1.0 / cos(lat_0 * M_DEG_TO_RAD);
+	unsigned count = 0;
+
+	for (int i = -10; i <= 10; i++) {
+		for (int j = -10; j <= 10; j++) {
+			if (count < max_count) {
+				lat[count] = lat_0 + extent_deg * i / 10.0;
+				lon[count] = lon_0 + extent_deg * lon_scale * j / 10.0;
+				count++;
+			}
+		}
+	}
+
+	return count;
+}
+
+TEST(GeoTest, ProjectArrayMatchesExact)
+{
+	static const double ref_lats[] = { 0.0, 47.3977, -33.9, 64.1, 78.2, 85.0 };
+	static const double extents[] = { 200.0, 2000.0, 20000.0, 200000.0 };
+
+	double lat[441];
+	double lon[441];
+	float x[441];
+	float y[441];
+
+	for (unsigned r = 0; r < sizeof(ref_lats) / sizeof(ref_lats[0]); r++) {
+		struct map_projection_reference_s ref;
+		map_projection_init_timestamped(&ref, ref_lats[r], 8.5456, 1);
+
+		for (unsigned e = 0; e < sizeof(extents) / sizeof(extents[0]); e++) {
+			unsigned count = fill_grid(ref_lats[r], 8.5456, extents[e], lat, lon, 441);
+
+			ASSERT_EQ(0, map_projection_project_array(&ref, lat, lon, x, y, count));
+
+			for (unsigned i = 0; i < count; i++) {
+				float x_exact;
+				float y_exact;
+				map_projection_project(&ref, lat[i], lon[i], &x_exact, &y_exact);
+
+				/* float rounding of the exact result dominates far out */
+				float tolerance = MAP_PROJECTION_FAST_MAX_ERROR + 1e-6f * sqrtf(x_exact * x_exact + y_exact * y_exact);
+				ASSERT_NEAR(x_exact, x[i], tolerance) << "ref lat " << ref_lats[r] << " lat " << lat[i] << " lon " << lon[i];
+				ASSERT_NEAR(y_exact, y[i], tolerance) << "ref lat " << ref_lats[r] << " lat " << lat[i] << " lon " << lon[i];
+			}
+		}
+	}
+}
+
+TEST(GeoTest, ProjectArrayUninitialized)
+{
+	struct map_projection_reference_s ref = {};
+	double lat = 47.0;
+	double lon = 8.0;
+	float x;
+	float y;
+
+	ASSERT_EQ(-1, map_projection_project_array(&ref, &lat, &lon, &x, &y, 1));
+}
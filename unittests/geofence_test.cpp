@@ -0,0 +1,354 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <dataman/dataman.h>
+#include <geo/geo.h>
+#include <mavlink/mavlink_log.h>
+#include <navigator/geofence.h>
+#include <systemlib/param/param.h>
+
+#include "gtest/gtest.h"
+
+/*
+ * The dataman holding the fence vertices, reads fail while dm_read_fails is set
+ */
+static struct fence_vertex_s fence_points[DM_KEY_FENCE_POINTS_MAX];
+static bool dm_read_fails;
+
+extern "C" ssize_t dm_read(dm_item_t item, unsigned char index, void *buffer, size_t buflen)
+{
+	if (dm_read_fails || item != DM_KEY_FENCE_POINTS || index >= DM_KEY_FENCE_POINTS_MAX || buflen != sizeof(struct fence_vertex_s)) {
+		return -1;
+	}
+
+	memcpy(buffer, &fence_points[index], buflen);
+	return buflen;
+}
+
+extern "C" ssize_t dm_write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buffer,
+			    size_t buflen)
+{
+	if (item != DM_KEY_FENCE_POINTS || index >= DM_KEY_FENCE_POINTS_MAX || buflen != sizeof(struct fence_vertex_s)) {
+		return -1;
+	}
+
+	memcpy(&fence_points[index], buffer, buflen);
+	return buflen;
+}
+
+extern "C" int dm_clear(dm_item_t item)
+{
+	memset(fence_points, 0, sizeof(fence_points));
+	return 0;
+}
+
+extern "C" void mavlink_vasprintf(int _fd, int severity, const char *fmt, ...)
+{
+}
+
+/*
+ * The GF_* params, all integers, 0 unless set by a test
+ */
+static const char *const gf_param_names[] = { "GF_ACTION", "GF_ALTMODE", "GF_SOURCE", "GF_COUNT", "GF_MAX_HOR_DIST", "GF_MAX_VER_DIST" };
+static const unsigned gf_param_count = sizeof(gf_param_names) / sizeof(gf_param_names[0]);
+static int32_t gf_param_values[gf_param_count];
+
+extern "C" param_t param_find(const char *name)
+{
+	for (unsigned i = 0; i < gf_param_count; i++) {
+		if (strcmp(name, gf_param_names[i]) == 0) {
+			return i;
+		}
+	}
+
+	return PARAM_INVALID;
+}
+
+extern "C" int param_get_many(const param_t *params, void *const *vals, uint32_t *seqs, unsigned count)
+{
+	for (unsigned i = 0; i < count; i++) {
+		memcpy(vals[i], &gf_param_values[params[i]], sizeof(int32_t));
+		seqs[i]++;
+	}
+
+	return count;
+}
+
+extern "C" int param_set(param_t param, const void *val)
+{
+	memcpy(&gf_param_values[param], val, sizeof(int32_t));
+	return 0;
+}
+
+/* the fences are placed around this point, offsets in meters north and east */
+static const double origin_lat = 47.397742;
+static const double origin_lon = 8.545594;
+
+static void offset_to_global(float north, float east, double *lat, double *lon)
+{
+	struct map_projection_reference_s ref;
+	map_projection_init(&ref, origin_lat, origin_lon);
+	map_projection_reproject(&ref, north, east, lat, lon);
+}
+
+/*
+ * The vertices are stored as float degrees, which places them up to about
+ * 0.2 m off at this latitude. Distances are checked with this tolerance.
+ */
+static const float distance_tolerance = 0.3f;
+
+class GeofenceTest : public ::testing::Test
+{
+protected:
+	virtual void SetUp()
+	{
+		memset(fence_points, 0, sizeof(fence_points));
+		dm_read_fails = false;
+		memset(gf_param_values, 0, sizeof(gf_param_values));
+		snprintf(_filename, sizeof(_filename), "geofence_test_%d.txt", getpid());
+	}
+
+	virtual void TearDown()
+	{
+		unlink(_filename);
+	}
+
+	/* load a closed polygon given in meters from the origin, altitudes 0 to 100 m */
+	void load(Geofence &geofence, const float vertices[][2], unsigned count)
+	{
+		FILE *f = fopen(_filename, "w");
+		ASSERT_TRUE(f != nullptr);
+		fprintf(f, "# test fence\n0 100\n");
+
+		for (unsigned i = 0; i <= count; i++) {
+			double lat, lon;
+			offset_to_global(vertices[i % count][0], vertices[i % count][1], &lat, &lon);
+			fprintf(f, "%.7f %.7f\n", lat, lon);
+		}
+
+		fclose(f);
+		ASSERT_EQ(0, geofence.loadFromFile(_filename));
+		ASSERT_TRUE(geofence.valid());
+	}
+
+	bool inside(Geofence &geofence, float north, float east)
+	{
+		double lat, lon;
+		offset_to_global(north, east, &lat, &lon);
+		return geofence.inside_polygon(lat, lon, 50.0f);
+	}
+
+	float distance(Geofence &geofence, float north, float east)
+	{
+		double lat, lon;
+		offset_to_global(north, east, &lat, &lon);
+		return geofence.distance_to_polygon(lat, lon);
+	}
+
+	bool crosses(Geofence &geofence, float north1, float east1, float north2, float east2)
+	{
+		double lat1, lon1, lat2, lon2;
+		offset_to_global(north1, east1, &lat1, &lon1);
+		offset_to_global(north2, east2, &lat2, &lon2);
+		return geofence.crosses_polygon(lat1, lon1, lat2, lon2);
+	}
+
+	/* the point in polygon test with its fast paths agrees with the sign of the distance */
+	void expect_consistent(Geofence &geofence, float min, float max, float step)
+	{
+		for (float north = min; north <= max; north += step) {
+			for (float east = min; east <= max; east += step) {
+				float d = distance(geofence, north, east);
+
+				if (fabsf(d) > distance_tolerance) {
+					EXPECT_EQ(d > 0.0f, inside(geofence, north, east)) << "north " << north << " east " << east;
+				}
+			}
+		}
+	}
+
+	char _filename[64];
+};
+
+/* 200 m square centered on the origin */
+static const float square[][2] = { { -100, -100 }, { -100, 100 }, { 100, 100 }, { 100, -100 } };
+
+/*
+ * 300 m U open to the north, the arms and the base 100 m wide. The mean of
+ * the vertices, the center of the local frame, lies in the notch.
+ */
+static const float u_shape[][2] = {
+	{ 0, 0 }, { 0, 300 }, { 300, 300 }, { 300, 200 }, { 100, 200 }, { 100, 100 }, { 300, 100 }, { 300, 0 }
+};
+
+TEST_F(GeofenceTest, Empty)
+{
+	Geofence geofence;
+
+	EXPECT_TRUE(geofence.isEmpty());
+	EXPECT_TRUE(inside(geofence, 0, 0));
+	EXPECT_TRUE(isnan(distance(geofence, 0, 0)));
+	EXPECT_FALSE(crosses(geofence, 0, 0, 1000, 1000));
+}
+
+TEST_F(GeofenceTest, Convex)
+{
+	Geofence geofence;
+	load(geofence, square, 4);
+
+	EXPECT_TRUE(inside(geofence, 0, 0));
+	EXPECT_TRUE(inside(geofence, 90, -90));
+	EXPECT_FALSE(inside(geofence, 150, 0));
+	EXPECT_FALSE(inside(geofence, 0, -150));
+
+	// positive inside, negative outside, to the closest edge or corner
+	EXPECT_NEAR(100.0f, distance(geofence, 0, 0), distance_tolerance);
+	EXPECT_NEAR(20.0f, distance(geofence, 80, 10), distance_tolerance);
+	EXPECT_NEAR(-50.0f, distance(geofence, 150, 0), distance_tolerance);
+	EXPECT_NEAR(-50.0f, distance(geofence, 30, 150), distance_tolerance);
+	EXPECT_NEAR(-sqrtf(30 * 30 + 40 * 40), distance(geofence, -130, -140), distance_tolerance);
+
+	// the vertical limits
+	double lat, lon;
+	offset_to_global(0, 0, &lat, &lon);
+	EXPECT_TRUE(geofence.inside_polygon(lat, lon, 99.0f));
+	EXPECT_FALSE(geofence.inside_polygon(lat, lon, 101.0f));
+	EXPECT_FALSE(geofence.inside_polygon(lat, lon, -1.0f));
+
+	expect_consistent(geofence, -150, 150, 7);
+}
+
+TEST_F(GeofenceTest, ConcaveCenterOutside)
+{
+	Geofence geofence;
+	load(geofence, u_shape, 8);
+
+	// the center of the frame is outside, nothing may be taken as inside around it
+	EXPECT_FALSE(inside(geofence, 175, 150));
+	EXPECT_NEAR(-50.0f, distance(geofence, 175, 150), distance_tolerance);
+	EXPECT_FALSE(inside(geofence, 250, 150));
+	EXPECT_FALSE(inside(geofence, 110, 150));
+	EXPECT_NEAR(-10.0f, distance(geofence, 110, 150), distance_tolerance);
+
+	// the arms and the base
+	EXPECT_TRUE(inside(geofence, 200, 30));
+	EXPECT_NEAR(30.0f, distance(geofence, 200, 30), distance_tolerance);
+	EXPECT_TRUE(inside(geofence, 250, 260));
+	EXPECT_NEAR(40.0f, distance(geofence, 250, 260), distance_tolerance);
+	EXPECT_TRUE(inside(geofence, 40, 150));
+	EXPECT_NEAR(40.0f, distance(geofence, 40, 150), distance_tolerance);
+
+	// outside the U
+	EXPECT_FALSE(inside(geofence, -20, 150));
+	EXPECT_NEAR(-20.0f, distance(geofence, -20, 150), distance_tolerance);
+	EXPECT_FALSE(inside(geofence, 320, 50));
+
+	expect_consistent(geofence, -50, 350, 9);
+}
+
+TEST_F(GeofenceTest, Edges)
+{
+	Geofence geofence;
+	load(geofence, square, 4);
+
+	// on an edge and on a vertex the distance vanishes
+	EXPECT_NEAR(0.0f, distance(geofence, 100, 30), distance_tolerance);
+	EXPECT_NEAR(0.0f, distance(geofence, -40, -100), distance_tolerance);
+	EXPECT_NEAR(0.0f, distance(geofence, 100, 100), distance_tolerance);
+
+	// a meter to either side of each edge
+	const float edge_points[][4] = {
+		{ 99, 30, 101, 30 },		// north
+		{ -99, 30, -101, 30 },		// south
+		{ 30, 99, 30, 101 },		// east
+		{ 30, -99, 30, -101 },		// west
+	};
+
+	for (unsigned i = 0; i < sizeof(edge_points) / sizeof(edge_points[0]); i++) {
+		const float *p = edge_points[i];
+
+		EXPECT_TRUE(inside(geofence, p[0], p[1])) << "edge " << i;
+		EXPECT_NEAR(1.0f, distance(geofence, p[0], p[1]), distance_tolerance) << "edge " << i;
+		EXPECT_FALSE(inside(geofence, p[2], p[3])) << "edge " << i;
+		EXPECT_NEAR(-1.0f, distance(geofence, p[2], p[3]), distance_tolerance) << "edge " << i;
+	}
+
+	// just outside a corner, diagonally
+	EXPECT_FALSE(inside(geofence, 101, 101));
+	EXPECT_NEAR(-sqrtf(2.0f), distance(geofence, 101, 101), distance_tolerance);
+}
+
+TEST_F(GeofenceTest, SegmentCrossing)
+{
+	Geofence geofence;
+	load(geofence, u_shape, 8);
+
+	// within one arm, within the base, out of the U
+	EXPECT_FALSE(crosses(geofence, 150, 50, 280, 50));
+	EXPECT_FALSE(crosses(geofence, 50, 20, 50, 280));
+	EXPECT_TRUE(crosses(geofence, 200, 50, 200, -50));
+
+	// from arm to arm through the notch, both ends inside
+	EXPECT_TRUE(inside(geofence, 200, 50));
+	EXPECT_TRUE(inside(geofence, 200, 250));
+	EXPECT_TRUE(crosses(geofence, 200, 50, 200, 250));
+
+	// from the base into the notch
+	EXPECT_TRUE(crosses(geofence, 50, 150, 150, 150));
+
+	// entirely outside, passing the corners
+	EXPECT_FALSE(crosses(geofence, -10, -50, -10, 350));
+	EXPECT_FALSE(crosses(geofence, 150, 120, 290, 180));
+	EXPECT_FALSE(crosses(geofence, -50, 320, 350, 320));
+}
+
+TEST_F(GeofenceTest, OutsideCounter)
+{
+	Geofence geofence;
+	load(geofence, square, 4);
+
+	struct vehicle_global_position_s global_position = {};
+	struct vehicle_gps_position_s gps_position = {};
+	struct home_position_s home = {};
+	global_position.alt = 50.0f;
+
+	// GF_COUNT outside checks in a row are forgiven
+	gf_param_values[param_find("GF_COUNT")] = 2;
+
+	offset_to_global(150, 0, &global_position.lat, &global_position.lon);
+	EXPECT_TRUE(geofence.inside(global_position, gps_position, 50.0f, home, false));
+	EXPECT_TRUE(geofence.inside(global_position, gps_position, 50.0f, home, false));
+	EXPECT_FALSE(geofence.inside(global_position, gps_position, 50.0f, home, false));
+
+	// back inside resets the counter
+	offset_to_global(0, 0, &global_position.lat, &global_position.lon);
+	EXPECT_TRUE(geofence.inside(global_position, gps_position, 50.0f, home, false));
+	offset_to_global(150, 0, &global_position.lat, &global_position.lon);
+	EXPECT_TRUE(geofence.inside(global_position, gps_position, 50.0f, home, false));
+}
+
+TEST_F(GeofenceTest, DatamanFailure)
+{
+	Geofence geofence;
+	load(geofence, square, 4);
+
+	// without any fence read the vehicle can not be placed inside
+	dm_read_fails = true;
+	EXPECT_FALSE(inside(geofence, 0, 0));
+	EXPECT_TRUE(crosses(geofence, -10, -10, 10, 10));
+
+	dm_read_fails = false;
+	EXPECT_TRUE(inside(geofence, 0, 0));
+
+	// a new fence that can not be read leaves the last one in place
+	load(geofence, u_shape, 8);
+	dm_read_fails = true;
+	EXPECT_TRUE(inside(geofence, -50, -50));
+	EXPECT_FALSE(inside(geofence, 50, 250));
+
+	dm_read_fails = false;
+	EXPECT_FALSE(inside(geofence, -50, -50));
+	EXPECT_TRUE(inside(geofence, 50, 250));
+}
@@ -0,0 +1,243 @@
+#include <string.h>
+
+#include <dataman/dataman.h>
+#include <navigator/mission_item_cache.h>
+
+#include "gtest/gtest.h"
+
+/*
+ * The dataman as seen by the cache: the waypoints of each mission key,
+ * identified by their index in the latitude, and every read counted.
+ */
+static const int mission_count = 20;
+static struct mission_item_s dataman[DM_KEY_NUM_KEYS][mission_count];
+static unsigned dataman_reads;
+
+extern "C" ssize_t dm_read(dm_item_t item, unsigned char index, void *buffer, size_t buflen)
+{
+	if (item >= DM_KEY_NUM_KEYS || index >= mission_count || buflen != sizeof(struct mission_item_s)) {
+		return -1;
+	}
+
+	dataman_reads++;
+	memcpy(buffer, &dataman[item][index], buflen);
+	return buflen;
+}
+
+class MissionItemCacheTest : public ::testing::Test
+{
+protected:
+	virtual void SetUp()
+	{
+		memset(dataman, 0, sizeof(dataman));
+
+		for (int key = 0; key < DM_KEY_NUM_KEYS; key++) {
+			for (int i = 0; i < mission_count; i++) {
+				dataman[key][i].lat = key * 100 + i;
+				dataman[key][i].nav_cmd = NAV_CMD_WAYPOINT;
+			}
+		}
+
+		dataman_reads = 0;
+	}
+
+	/* read an item and check it is the one stored under that index */
+	void expect_item(MissionItemCache &cache, dm_item_t key, int index)
+	{
+		struct mission_item_s item;
+		ASSERT_TRUE(cache.read(key, index, &item));
+		EXPECT_DOUBLE_EQ(key * 100 + index, item.lat) << "key " << key << " index " << index;
+	}
+
+	/* the navigator cycles spent on one waypoint */
+	void fly(MissionItemCache &cache, dm_item_t key, int current, unsigned cycles)
+	{
+		for (unsigned i = 0; i < cycles; i++) {
+			cache.prefetch(key, current, mission_count);
+		}
+	}
+};
+
+TEST_F(MissionItemCacheTest, Prefetch)
+{
+	MissionItemCache cache;
+	const dm_item_t key = DM_KEY_WAYPOINTS_OFFBOARD_0;
+
+	// one dataman read per cycle until the cache is full
+	for (unsigned i = 1; i <= MISSION_ITEM_CACHE_SIZE; i++) {
+		cache.prefetch(key, 0, mission_count);
+		EXPECT_EQ(i, dataman_reads);
+	}
+
+	cache.prefetch(key, 0, mission_count);
+	EXPECT_EQ(MISSION_ITEM_CACHE_SIZE, dataman_reads);
+
+	// the current and the next items come from memory
+	for (int i = 0; i < MISSION_ITEM_CACHE_SIZE; i++) {
+		expect_item(cache, key, i);
+	}
+
+	EXPECT_EQ(MISSION_ITEM_CACHE_SIZE, dataman_reads);
+	EXPECT_EQ(nullptr, cache.get(key, MISSION_ITEM_CACHE_SIZE));
+}
+
+TEST_F(MissionItemCacheTest, Eviction)
+{
+	MissionItemCache cache;
+	const dm_item_t key = DM_KEY_WAYPOINTS_OFFBOARD_0;
+
+	fly(cache, key, 0, MISSION_ITEM_CACHE_SIZE);
+
+	// advancing drops the item flown and refills the freed slot
+	fly(cache, key, 1, 1);
+	EXPECT_EQ(nullptr, cache.get(key, 0));
+	ASSERT_NE(nullptr, cache.get(key, MISSION_ITEM_CACHE_SIZE));
+	EXPECT_DOUBLE_EQ(key * 100 + MISSION_ITEM_CACHE_SIZE, cache.get(key, MISSION_ITEM_CACHE_SIZE)->lat);
+
+	// skipping a waypoint drops it as well, the ring keeps the items in place
+	fly(cache, key, 3, 2);
+
+	for (int i = 3; i < 3 + MISSION_ITEM_CACHE_SIZE; i++) {
+		ASSERT_NE(nullptr, cache.get(key, i)) << "index " << i;
+		EXPECT_DOUBLE_EQ(key * 100 + i, cache.get(key, i)->lat);
+	}
+
+	EXPECT_EQ(nullptr, cache.get(key, 2));
+
+	// nothing is read past the end of the mission
+	fly(cache, key, mission_count - 1, MISSION_ITEM_CACHE_SIZE);
+	unsigned reads = dataman_reads;
+	fly(cache, key, mission_count - 1, 1);
+	EXPECT_EQ(reads, dataman_reads);
+	EXPECT_EQ(nullptr, cache.get(key, mission_count));
+	expect_item(cache, key, mission_count - 1);
+	EXPECT_EQ(reads, dataman_reads);
+}
+
+TEST_F(MissionItemCacheTest, Miss)
+{
+	MissionItemCache cache;
+	const dm_item_t key = DM_KEY_WAYPOINTS_OFFBOARD_0;
+
+	// consecutive misses extend the cache, repeated reads hit it
+	expect_item(cache, key, 4);
+	expect_item(cache, key, 5);
+	EXPECT_EQ(2u, dataman_reads);
+	expect_item(cache, key, 4);
+	expect_item(cache, key, 5);
+	EXPECT_EQ(2u, dataman_reads);
+
+	// a miss elsewhere restarts it at that item
+	expect_item(cache, key, 10);
+	EXPECT_EQ(3u, dataman_reads);
+	EXPECT_EQ(nullptr, cache.get(key, 4));
+
+	// an item out of the dataman range fails
+	struct mission_item_s item;
+	EXPECT_FALSE(cache.read(key, mission_count, &item));
+}
+
+TEST_F(MissionItemCacheTest, DoJump)
+{
+	MissionItemCache cache;
+	const dm_item_t key = DM_KEY_WAYPOINTS_OFFBOARD_0;
+
+	fly(cache, key, 8, MISSION_ITEM_CACHE_SIZE);
+
+	// the jump counter written to the dataman is written to the cached copy too
+	struct mission_item_s *jump = cache.get(key, 10);
+	ASSERT_NE(nullptr, jump);
+	jump->nav_cmd = NAV_CMD_DO_JUMP;
+	jump->do_jump_mission_index = 2;
+	jump->do_jump_current_count = 1;
+
+	struct mission_item_s item;
+	unsigned reads = dataman_reads;
+	ASSERT_TRUE(cache.read(key, 10, &item));
+	EXPECT_EQ(reads, dataman_reads);
+	EXPECT_EQ(NAV_CMD_DO_JUMP, item.nav_cmd);
+	EXPECT_EQ(1u, item.do_jump_current_count);
+
+	// jumping back restarts the cache at the jump target
+	fly(cache, key, 2, 1);
+	EXPECT_EQ(reads + 1, dataman_reads);
+	EXPECT_EQ(nullptr, cache.get(key, 10));
+	expect_item(cache, key, 2);
+	EXPECT_EQ(reads + 1, dataman_reads);
+
+	fly(cache, key, 2, MISSION_ITEM_CACHE_SIZE);
+
+	for (int i = 2; i < 2 + MISSION_ITEM_CACHE_SIZE; i++) {
+		expect_item(cache, key, i);
+	}
+
+	// jumping forward past the cached items restarts it as well
+	reads = dataman_reads;
+	fly(cache, key, 15, 1);
+	EXPECT_EQ(reads + 1, dataman_reads);
+	EXPECT_EQ(nullptr, cache.get(key, 9));
+	expect_item(cache, key, 15);
+	EXPECT_EQ(reads + 1, dataman_reads);
+}
+
+TEST_F(MissionItemCacheTest, Invalidate)
+{
+	MissionItemCache cache;
+
+	// an onboard mission update rewrites the items in the dataman
+	fly(cache, DM_KEY_WAYPOINTS_ONBOARD, 0, MISSION_ITEM_CACHE_SIZE);
+	dataman[DM_KEY_WAYPOINTS_ONBOARD][1].lat = -1;
+
+	struct mission_item_s item;
+	ASSERT_TRUE(cache.read(DM_KEY_WAYPOINTS_ONBOARD, 1, &item));
+	EXPECT_DOUBLE_EQ(DM_KEY_WAYPOINTS_ONBOARD * 100 + 1, item.lat);
+
+	cache.invalidate();
+	EXPECT_EQ(nullptr, cache.get(DM_KEY_WAYPOINTS_ONBOARD, 1));
+	ASSERT_TRUE(cache.read(DM_KEY_WAYPOINTS_ONBOARD, 1, &item));
+	EXPECT_DOUBLE_EQ(-1, item.lat);
+
+	// an offboard mission update switches to the other dataman key
+	fly(cache, DM_KEY_WAYPOINTS_OFFBOARD_0, 0, MISSION_ITEM_CACHE_SIZE);
+	cache.invalidate();
+	fly(cache, DM_KEY_WAYPOINTS_OFFBOARD_1, 0, 1);
+
+	for (int i = 0; i < MISSION_ITEM_CACHE_SIZE; i++) {
+		EXPECT_EQ(nullptr, cache.get(DM_KEY_WAYPOINTS_OFFBOARD_0, i));
+	}
+
+	expect_item(cache, DM_KEY_WAYPOINTS_OFFBOARD_1, 0);
+
+	// even without an invalidate, items of another key are never returned
+	fly(cache, DM_KEY_WAYPOINTS_OFFBOARD_0, 0, 1);
+	EXPECT_EQ(nullptr, cache.get(DM_KEY_WAYPOINTS_OFFBOARD_1, 0));
+	expect_item(cache, DM_KEY_WAYPOINTS_OFFBOARD_0, 0);
+}
+
+TEST_F(MissionItemCacheTest, Mission)
+{
+	MissionItemCache cache;
+	const dm_item_t key = DM_KEY_WAYPOINTS_OFFBOARD_0;
+
+	/*
+	 * Fly the mission with a few cycles per waypoint. On each transition
+	 * the mission reads the new current and the next item.
+	 */
+	unsigned transition_reads = 0;
+
+	for (int current = 0; current < mission_count; current++) {
+		unsigned reads = dataman_reads;
+		expect_item(cache, key, current);
+
+		if (current + 1 < mission_count) {
+			expect_item(cache, key, current + 1);
+		}
+
+		transition_reads += dataman_reads - reads;
+		fly(cache, key, current, 3);
+	}
+
+	// only the very first transition waits for the dataman
+	EXPECT_EQ(2u, transition_reads);
+	EXPECT_LE(dataman_reads, (unsigned)mission_count + 2);
+}
@@ -1,5 +1,9 @@
+#include <stdlib.h>
+#include <string.h>
+
 #include <systemlib/mixer/mixer.h>
 #include <systemlib/err.h>
+#include <drivers/drv_hrt.h>
 #include "../../src/systemcmds/tests/tests.h"
 
 #include "gtest/gtest.h"
@@ -10,3 +14,171 @@ TEST(MixerTest, Mixer)
 	char *args[] = {"empty", "../ROMFS/px4fmu_common/mixers/IO_pass.mix", "../ROMFS/px4fmu_common/mixers/quad_w.main.mix"};
 	ASSERT_EQ(test_mixer(3, args), 0) << "IO_pass.mix failed";
 }
+
+static float bench_controls[4][8];
+static unsigned bench_callbacks;
+
+static int bench_callback(uintptr_t handle, uint8_t control_group, uint8_t control_index, float &control)
+{
+	if (control_group >= 4 || control_index >= 8) {
+		return -1;
+	}
+
+	bench_callbacks++;
+	control = bench_controls[control_group][control_index];
+	return 0;
+}
+
+static void bench_randomize_controls()
+{
+	for (unsigned g = 0; g < 4; g++) {
+		for (unsigned c = 0; c < 8; c++) {
+			bench_controls[g][c] = 2.0f * rand() / (float)RAND_MAX - 1.0f;
+		}
+	}
+
+	/* thrust inputs are positive */
+	bench_controls[0][3] = 0.5f * (bench_controls[0][3] + 1.0f);
+	bench_controls[1][3] = 0.5f * (bench_controls[1][3] + 1.0f);
+}
+
+static hrt_abstime bench_time(MixerGroup &group, unsigned cycles, unsigned &callbacks)
+{
+	float outputs[16];
+	uint16_t status = 0;
+
+	srand(42);
+	bench_randomize_controls();
+	bench_callbacks = 0;
+
+	hrt_abstime t = hrt_absolute_time();
+
+	for (unsigned i = 0; i < cycles; i++) {
+		group.mix(outputs, 16, &status);
+	}
+
+	t = hrt_absolute_time() - t;
+	callbacks = bench_callbacks;
+	return t;
+}
+
+static void bench_mixer(const char *filename, int rows)
+{
+	char buf[2048];
+	ASSERT_EQ(0, load_mixer_file(filename, &buf[0], sizeof(buf))) << "failed to load " << filename;
+
+	MixerGroup compiled(bench_callback, 0);
+	MixerGroup legacy(bench_callback, 0);
+
+	unsigned buflen = strlen(buf);
+	ASSERT_EQ(0, compiled.load_from_buf(buf, buflen));
+	buflen = strlen(buf);
+	ASSERT_EQ(0, legacy.load_from_buf(buf, buflen));
+	legacy.discard_compiled();
+
+	/* the compiled path must actually be used */
+	ASSERT_EQ(rows, compiled.compile()) << filename;
+
+	/* both paths must agree */
+	srand(42);
+
+	for (unsigned i = 0; i < 1000; i++) {
+		float out_compiled[16];
+		float out_legacy[16];
+		uint16_t status_compiled = 0;
+		uint16_t status_legacy = 0;
+
+		bench_randomize_controls();
+
+		unsigned n_compiled = compiled.mix(out_compiled, 16, &status_compiled);
+		unsigned n_legacy = legacy.mix(out_legacy, 16, &status_legacy);
+
+		ASSERT_EQ(n_legacy, n_compiled);
+		ASSERT_EQ(status_legacy, status_compiled);
+
+		for (unsigned j = 0; j < n_legacy; j++) {
+			ASSERT_NEAR(out_legacy[j], out_compiled[j], 1e-5f) << filename << " output " << j;
+		}
+	}
+
+	const unsigned cycles = 100000;
+	unsigned callbacks_compiled;
+	unsigned callbacks_legacy;
+	hrt_abstime t_compiled = bench_time(compiled, cycles, callbacks_compiled);
+	hrt_abstime t_legacy = bench_time(legacy, cycles, callbacks_legacy);
+
+	printf("%s: compiled %u us, %u callbacks; legacy %u us, %u callbacks (%u cycles)\n", filename,
+	       (unsigned)t_compiled, callbacks_compiled, (unsigned)t_legacy, callbacks_legacy, cycles);
+}
+
+TEST(MixerTest, CompiledOctoCox)
+{
+	/* a roll and pitch row per rotor, plus yaw and thrust */
+	bench_mixer("../ROMFS/px4fmu_common/mixers/octo_cox.main.mix", 8 + 2);
+}
+
+TEST(MixerTest, CompiledVtol)
+{
+	/* the throttle has a different scale for each sign */
+	bench_mixer("../ROMFS/px4fmu_common/mixers/vtol_AAERT.aux.mix", 4);
+	bench_mixer("../ROMFS/px4fmu_common/mixers/caipirinha_vtol.main.mix", 2 + 2 + 2);
+}
+
+static void binary_mixer(const char *textfile, const char *binfile)
+{
+	char buf[2048];
+	char bin[2048];
+	bool is_binary;
+	ASSERT_EQ(0, load_mixer_file(textfile, &buf[0], sizeof(buf))) << "failed to load " << textfile;
+
+	/* a text file is read as text */
+	ASSERT_EQ((int)strlen(buf), load_mixer_definition(textfile, &bin[0], sizeof(bin), &is_binary));
+	ASSERT_FALSE(is_binary);
+	ASSERT_STREQ(buf, bin);
+
+	int binlen = load_mixer_definition(binfile, &bin[0], sizeof(bin), &is_binary);
+	ASSERT_GT(binlen, 0) << "failed to load " << binfile;
+	ASSERT_TRUE(is_binary);
+
+	MixerGroup text(bench_callback, 0);
+	MixerGroup binary(bench_callback, 0);
+
+	unsigned buflen = strlen(buf);
+	ASSERT_EQ(0, text.load_from_buf(buf, buflen));
+	ASSERT_EQ(0, binary.load_from_binary((const uint8_t *)bin, binlen));
+	ASSERT_EQ(text.count(), binary.count());
+
+	/* truncated or corrupt definitions are rejected */
+	MixerGroup bad(bench_callback, 0);
+	ASSERT_NE(0, bad.load_from_binary((const uint8_t *)bin, binlen - 1));
+	ASSERT_NE(0, bad.load_from_binary((const uint8_t *)buf, strlen(buf)));
+	ASSERT_EQ(0u, bad.count());
+
+	srand(42);
+
+	for (unsigned i = 0; i < 1000; i++) {
+		float out_text[16];
+		float out_binary[16];
+		uint16_t status_text = 0;
+		uint16_t status_binary = 0;
+
+		bench_randomize_controls();
+
+		unsigned n_text = text.mix(out_text, 16, &status_text);
+		unsigned n_binary = binary.mix(out_binary, 16, &status_binary);
+
+		ASSERT_EQ(n_text, n_binary);
+		ASSERT_EQ(status_text, status_binary);
+
+		for (unsigned j = 0; j < n_text; j++) {
+			ASSERT_EQ(out_text[j], out_binary[j]) << binfile << " output " << j;
+		}
+	}
+}
+
+TEST(MixerTest, Binary)
+{
+	/* generated from the text files by Tools/px_mixer_to_bin.py at build time */
+	binary_mixer("../ROMFS/px4fmu_common/mixers/octo_cox.main.mix", MIXER_BINARY_DIR "/octo_cox.main.mixb");
+	binary_mixer("../ROMFS/px4fmu_common/mixers/caipirinha_vtol.main.mix", MIXER_BINARY_DIR "/caipirinha_vtol.main.mixb");
+}
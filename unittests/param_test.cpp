@@ -1,6 +1,11 @@
 #include <systemlib/visibility.h>
 #include <systemlib/param/param.h>
 
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include "gtest/gtest.h"
 
 /*
@@ -149,4 +154,252 @@ TEST(ParamTest, ResetAllExcludesWildcard)
 	_assert_parameter_int_value((param_t)1, 4);
 	_assert_parameter_int_value((param_t)2, 50);
 	_assert_parameter_int_value((param_t)3, 50);
-}
\ No newline at end of file
+}
+
+TEST(ParamTest, ChangeSequence)
+{
+	_add_parameters();
+	param_reset_all();
+
+	uint32_t seq0 = param_get_seq((param_t)0);
+	uint32_t seq1 = param_get_seq((param_t)1);
+	ASSERT_NE(0u, seq0) << "valid parameter has no sequence number";
+	ASSERT_EQ(0u, param_get_seq(PARAM_INVALID));
+
+	int32_t value = 50;
+	param_set((param_t)0, &value);
+	ASSERT_NE(seq0, param_get_seq((param_t)0)) << "sequence number not changed by param_set";
+	ASSERT_EQ(seq1, param_get_seq((param_t)1)) << "sequence number of unchanged parameter changed";
+
+	seq0 = param_get_seq((param_t)0);
+	param_reset((param_t)0);
+	ASSERT_NE(seq0, param_get_seq((param_t)0)) << "sequence number not changed by param_reset";
+}
+
+TEST(ParamTest, GetMany)
+{
+	_add_parameters();
+	param_reset_all();
+
+	param_t params[] = {(param_t)0, (param_t)1, (param_t)3};
+	int32_t values[3] = {};
+	void *const vals[] = {&values[0], &values[1], &values[2]};
+	uint32_t seqs[3] = {};
+
+	ASSERT_EQ(3, param_get_many(params, vals, seqs, 3));
+	ASSERT_EQ(2, values[0]);
+	ASSERT_EQ(4, values[1]);
+	ASSERT_EQ(16, values[2]);
+
+	// nothing changed, nothing copied
+	ASSERT_EQ(0, param_get_many(params, vals, seqs, 3));
+
+	int32_t value = 50;
+	param_set((param_t)1, &value);
+	values[0] = 0;
+	ASSERT_EQ(1, param_get_many(params, vals, seqs, 3));
+	ASSERT_EQ(0, values[0]) << "unchanged parameter was copied";
+	ASSERT_EQ(50, values[1]);
+
+	// without sequence numbers everything is copied
+	ASSERT_EQ(3, param_get_many(params, vals, NULL, 3));
+	ASSERT_EQ(2, values[0]);
+}
+
+static const char *journal_file = "/tmp/param_test_journal";
+
+static off_t _file_size(const char *path)
+{
+	struct stat st;
+
+	if (stat(path, &st) != 0) {
+		return -1;
+	}
+
+	return st.st_size;
+}
+
+static void _start_journal()
+{
+	_add_parameters();
+	unlink(journal_file);
+	param_set_default_file(journal_file);
+	param_reset_all();
+}
+
+TEST(ParamTest, JournalSaveLoad)
+{
+	_start_journal();
+
+	int32_t value = 50;
+	param_set((param_t)0, &value);
+	ASSERT_EQ(0, param_save_default());
+	off_t snapshot_size = _file_size(journal_file);
+	ASSERT_GT(snapshot_size, 0);
+
+	value = 60;
+	param_set((param_t)1, &value);
+	ASSERT_EQ(0, param_save_default());
+	ASSERT_GT(_file_size(journal_file), snapshot_size) << "save did not append a record";
+
+	// nothing changed, nothing appended
+	off_t journal_size = _file_size(journal_file);
+	ASSERT_EQ(0, param_save_default());
+	ASSERT_EQ(journal_size, _file_size(journal_file));
+
+	param_reset_all();
+	ASSERT_EQ(0, param_load_default());
+	_assert_parameter_int_value((param_t)0, 50);
+	_assert_parameter_int_value((param_t)1, 60);
+	_assert_parameter_int_value((param_t)2, 8);
+	ASSERT_FALSE(param_value_unsaved((param_t)1));
+
+	// a reset can't be appended, the file is rewritten
+	param_reset((param_t)0);
+	ASSERT_EQ(0, param_save_default());
+	ASSERT_LT(_file_size(journal_file), journal_size);
+	ASSERT_EQ(0, param_load_default());
+	_assert_parameter_int_value((param_t)0, 2);
+	_assert_parameter_int_value((param_t)1, 60);
+
+	param_set_default_file(NULL);
+}
+
+TEST(ParamTest, JournalLoadFromFd)
+{
+	_start_journal();
+
+	int32_t value = 50;
+	param_set((param_t)0, &value);
+	ASSERT_EQ(0, param_save_default());
+
+	value = 60;
+	param_set((param_t)1, &value);
+	ASSERT_EQ(0, param_save_default());
+
+	// 'param load <file>' of the default file applies the records too
+	int fd = open(journal_file, O_RDONLY);
+	ASSERT_GE(fd, 0);
+	ASSERT_EQ(0, param_load(fd));
+	close(fd);
+	_assert_parameter_int_value((param_t)0, 50);
+	_assert_parameter_int_value((param_t)1, 60);
+
+	// the load reset everything, the next save is a complete snapshot
+	ASSERT_EQ(0, param_save_default());
+	param_reset_all();
+	ASSERT_EQ(0, param_load_default());
+	_assert_parameter_int_value((param_t)0, 50);
+	_assert_parameter_int_value((param_t)1, 60);
+
+	param_reset_all();
+	fd = open(journal_file, O_RDONLY);
+	ASSERT_GE(fd, 0);
+	ASSERT_EQ(0, param_import(fd));
+	close(fd);
+	_assert_parameter_int_value((param_t)0, 50);
+	_assert_parameter_int_value((param_t)1, 60);
+
+	param_set_default_file(NULL);
+}
+
+TEST(ParamTest, JournalTornRecord)
+{
+	_start_journal();
+
+	int32_t value = 50;
+	param_set((param_t)0, &value);
+	ASSERT_EQ(0, param_save_default());
+
+	value = 60;
+	param_set((param_t)0, &value);
+	param_set((param_t)1, &value);
+	ASSERT_EQ(0, param_save_default());
+
+	// cut the last record short as if power was lost while writing it
+	ASSERT_EQ(0, truncate(journal_file, _file_size(journal_file) - 3));
+
+	ASSERT_EQ(0, param_load_default());
+	_assert_parameter_int_value((param_t)0, 50);
+	_assert_parameter_int_value((param_t)1, 4);
+
+	// the next save drops the torn record
+	value = 70;
+	param_set((param_t)1, &value);
+	ASSERT_EQ(0, param_save_default());
+	ASSERT_EQ(0, param_load_default());
+	_assert_parameter_int_value((param_t)0, 50);
+	_assert_parameter_int_value((param_t)1, 70);
+
+	param_set_default_file(NULL);
+}
+
+TEST(ParamTest, JournalCompaction)
+{
+	_start_journal();
+
+	for (int32_t i = 0; i < 1000; i++) {
+		param_set((param_t)0, &i);
+		ASSERT_EQ(0, param_save_default());
+	}
+
+	ASSERT_LT(_file_size(journal_file), 4096) << "journal was not compacted";
+
+	ASSERT_EQ(0, param_load_default());
+	_assert_parameter_int_value((param_t)0, 999);
+
+	param_set_default_file(NULL);
+}
+
+TEST(ParamTest, JournalTruncatedTail)
+{
+	_start_journal();
+
+	// both parameters are always saved together
+	int32_t value = 10;
+	param_set((param_t)0, &value);
+	param_set((param_t)1, &value);
+	ASSERT_EQ(0, param_save_default());
+	off_t base_size = _file_size(journal_file);
+
+	value = 20;
+	param_set((param_t)0, &value);
+	param_set((param_t)1, &value);
+	ASSERT_EQ(0, param_save_default());
+	off_t full_size = _file_size(journal_file);
+	ASSERT_GT(full_size, base_size);
+
+	FILE *f = fopen(journal_file, "rb");
+	ASSERT_TRUE(f != NULL);
+	char contents[full_size];
+	ASSERT_EQ((size_t)full_size, fread(contents, 1, full_size, f));
+	fclose(f);
+
+	// power lost after every possible byte of the last record
+	for (off_t cut = base_size; cut < full_size; cut++) {
+		f = fopen(journal_file, "wb");
+		ASSERT_TRUE(f != NULL);
+		ASSERT_EQ((size_t)cut, fwrite(contents, 1, cut, f));
+		fclose(f);
+
+		param_reset_all();
+		ASSERT_EQ(0, param_load_default()) << "cut at " << cut;
+		_assert_parameter_int_value((param_t)0, 10);
+		_assert_parameter_int_value((param_t)1, 10);
+	}
+
+	// a tail whose length runs past the end of the file is dropped too
+	f = fopen(journal_file, "wb");
+	ASSERT_TRUE(f != NULL);
+	ASSERT_EQ((size_t)full_size, fwrite(contents, 1, full_size, f));
+	int32_t len = 1000;
+	ASSERT_EQ(sizeof(len), fwrite(&len, 1, sizeof(len), f));
+	fclose(f);
+
+	param_reset_all();
+	ASSERT_EQ(0, param_load_default());
+	_assert_parameter_int_value((param_t)0, 20);
+	_assert_parameter_int_value((param_t)1, 20);
+
+	param_set_default_file(NULL);
+}
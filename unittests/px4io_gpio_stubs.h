@@ -0,0 +1,31 @@
+#pragma once
+
+/*
+ * Host stand-ins for the STM32 GPIO interface and the PX4IO board pins
+ * used by the px4iofirmware register code. Forced into the test build,
+ * on the board these come from board_config.h.
+ */
+
+#include <malloc.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define GPIO_LED1		1
+#define GPIO_LED2		2
+#define GPIO_LED3		3
+#define GPIO_LED4		4
+#define GPIO_SPEKTRUM_PWR_EN	5
+#define GPIO_SBUS_OENABLE	6
+#define GPIO_SERVO_FAULT_DETECT	7
+#define GPIO_BTN_SAFETY		8
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void stm32_gpiowrite(uint32_t pinset, bool value);
+bool stm32_gpioread(uint32_t pinset);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,235 @@
+#include <stdarg.h>
+#include <string.h>
+
+#include <drivers/drv_hrt.h>
+
+extern "C" {
+#include <px4iofirmware/px4io.h>
+}
+
+#include "gtest/gtest.h"
+
+/*
+ * Stand-ins for the IO firmware parts registers.c talks to.
+ */
+extern "C" {
+	struct sys_state_s system_state;
+	volatile uint8_t debug_level = 0;
+
+	uint16_t adc_measure(unsigned channel) { return 0xffff; }
+	void dsm_bind(uint16_t cmd, int pulses) {}
+	void isr_debug(uint8_t level, const char *fmt, ...) {}
+	int mixer_handle_text(const void *buffer, size_t length) { return 0; }
+	void schedule_reboot(uint32_t time_delta_usec) {}
+	void stm32_gpiowrite(uint32_t pinset, bool value) {}
+	bool stm32_gpioread(uint32_t pinset) { return false; }
+	uint32_t up_pwm_servo_get_rate_group(unsigned group) { return 0; }
+	int up_pwm_servo_set_rate_group_update(unsigned group, unsigned rate) { return 0; }
+
+	void serial_unittest_transfer(struct IOPacket *pkt);
+}
+
+/*
+ * Loopback transport: the IO serial packet handler answers in place.
+ */
+static void io_loopback(IOPacket &pkt)
+{
+	serial_unittest_transfer(&pkt);
+}
+
+/*
+ * FMU side of a transaction, returns the reply code.
+ */
+static uint8_t io_transfer(uint8_t code, uint8_t page, uint8_t offset, const uint16_t *regs, unsigned count,
+			   IOPacket &reply)
+{
+	IOPacket pkt = {};
+	pkt.count_code = count | code;
+	pkt.page = page;
+	pkt.offset = offset;
+
+	if (regs != nullptr) {
+		memcpy(&pkt.regs[0], regs, count * 2);
+	}
+
+	pkt.crc = crc_packet(&pkt);
+
+	io_loopback(pkt);
+
+	uint8_t crc = pkt.crc;
+	pkt.crc = 0;
+	EXPECT_EQ(crc, crc_packet(&pkt)) << "reply CRC mismatch";
+
+	reply = pkt;
+	return PKT_CODE(pkt);
+}
+
+static uint8_t io_batch(const uint16_t *request, unsigned count, IOPacket &reply)
+{
+	return io_transfer(PKT_CODE_BATCH, 0, 0, request, count, reply);
+}
+
+static const unsigned status_count = PX4IO_P_STATUS_MIXER - PX4IO_P_STATUS_FLAGS + 1;
+static const unsigned raw_rc_count = PX4IO_P_RAW_RC_BASE + PX4IO_RC_INPUT_CHANNELS;
+
+/*
+ * Builds the update the FMU driver sends every poll cycle: all control
+ * groups out, status, R/C input and servo outputs back.
+ */
+static unsigned build_full_update(uint16_t *request)
+{
+	unsigned n = 0;
+
+	for (unsigned group = 0; group < PX4IO_CONTROL_GROUPS; group++) {
+		request[n++] = PX4IO_BATCH_ADDRESS(PX4IO_PAGE_CONTROLS, group * PX4IO_PROTOCOL_MAX_CONTROL_COUNT);
+		request[n++] = PX4IO_BATCH_WRITE | PX4IO_CONTROL_CHANNELS;
+
+		for (unsigned i = 0; i < PX4IO_CONTROL_CHANNELS; i++) {
+			request[n++] = SIGNED_TO_REG(group * 1000 + i * 10);
+		}
+	}
+
+	request[n++] = PX4IO_BATCH_ADDRESS(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS);
+	request[n++] = PX4IO_BATCH_READ | status_count;
+	request[n++] = PX4IO_BATCH_ADDRESS(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT);
+	request[n++] = PX4IO_BATCH_READ | raw_rc_count;
+	request[n++] = PX4IO_BATCH_ADDRESS(PX4IO_PAGE_SERVOS, 0);
+	request[n++] = PX4IO_BATCH_READ | PX4IO_SERVO_COUNT;
+
+	return n;
+}
+
+static void fill_io_state()
+{
+	for (unsigned i = 0; i < raw_rc_count; i++) {
+		r_page_raw_rc_input[i] = 1000 + i;
+	}
+
+	r_page_raw_rc_input[PX4IO_P_RAW_RC_COUNT] = PX4IO_RC_INPUT_CHANNELS;
+
+	for (unsigned i = 0; i < PX4IO_SERVO_COUNT; i++) {
+		r_page_servos[i] = 1500 + i;
+	}
+
+	r_status_flags = PX4IO_P_STATUS_FLAGS_RC_OK | PX4IO_P_STATUS_FLAGS_SAFETY_OFF;
+	r_mixer_limits = PX4IO_P_STATUS_MIXER_UPPER_LIMIT;
+}
+
+TEST(PX4IORegistersTest, BatchFullUpdate)
+{
+	fill_io_state();
+
+	uint16_t request[PKT_MAX_REGS];
+	unsigned count = build_full_update(request);
+	ASSERT_LE(count, (unsigned)PKT_MAX_REGS) << "full update does not fit into one packet";
+
+	IOPacket reply;
+	ASSERT_EQ(PKT_CODE_SUCCESS, io_batch(request, count, reply));
+	ASSERT_EQ(status_count + raw_rc_count + PX4IO_SERVO_COUNT, PKT_COUNT(reply));
+
+	// the controls arrived
+	for (unsigned group = 0; group < PX4IO_CONTROL_GROUPS; group++) {
+		for (unsigned i = 0; i < PX4IO_CONTROL_CHANNELS; i++) {
+			ASSERT_EQ((int)(group * 1000 + i * 10), REG_TO_SIGNED(r_page_controls[CONTROL_PAGE_INDEX(group, i)]));
+		}
+	}
+
+	ASSERT_TRUE(r_status_flags & PX4IO_P_STATUS_FLAGS_FMU_OK);
+
+	// the reads match single transfers of the same registers
+	IOPacket single;
+	const uint16_t *values = &reply.regs[0];
+
+	ASSERT_EQ(PKT_CODE_SUCCESS, io_transfer(PKT_CODE_READ, PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, nullptr,
+						status_count, single));
+	ASSERT_EQ(0, memcmp(values, &single.regs[0], status_count * 2));
+	values += status_count;
+
+	ASSERT_EQ(PKT_CODE_SUCCESS, io_transfer(PKT_CODE_READ, PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, nullptr,
+						raw_rc_count, single));
+	ASSERT_EQ(0, memcmp(values, &single.regs[0], raw_rc_count * 2));
+	values += raw_rc_count;
+
+	ASSERT_EQ(PKT_CODE_SUCCESS, io_transfer(PKT_CODE_READ, PX4IO_PAGE_SERVOS, 0, nullptr, PX4IO_SERVO_COUNT, single));
+	ASSERT_EQ(0, memcmp(values, &single.regs[0], PX4IO_SERVO_COUNT * 2));
+}
+
+TEST(PX4IORegistersTest, BatchReadsInOrder)
+{
+	fill_io_state();
+
+	// the same registers twice, with a write in between
+	const uint16_t request[] = {
+		PX4IO_BATCH_ADDRESS(PX4IO_PAGE_CONTROLS, 0), PX4IO_BATCH_READ | 2,
+		PX4IO_BATCH_ADDRESS(PX4IO_PAGE_CONTROLS, 0), PX4IO_BATCH_WRITE | 2, 11, 22,
+		PX4IO_BATCH_ADDRESS(PX4IO_PAGE_CONTROLS, 0), PX4IO_BATCH_READ | 2,
+	};
+
+	r_page_controls[0] = 1;
+	r_page_controls[1] = 2;
+
+	IOPacket reply;
+	ASSERT_EQ(PKT_CODE_SUCCESS, io_batch(request, sizeof(request) / sizeof(request[0]), reply));
+	ASSERT_EQ(4, PKT_COUNT(reply));
+	ASSERT_EQ(1, reply.regs[0]);
+	ASSERT_EQ(2, reply.regs[1]);
+	ASSERT_EQ(11, reply.regs[2]);
+	ASSERT_EQ(22, reply.regs[3]);
+}
+
+TEST(PX4IORegistersTest, BatchRejectsBadOperations)
+{
+	IOPacket reply;
+
+	// operation header cut short
+	const uint16_t truncated[] = {
+		PX4IO_BATCH_ADDRESS(PX4IO_PAGE_SERVOS, 0), PX4IO_BATCH_READ | 1,
+		PX4IO_BATCH_ADDRESS(PX4IO_PAGE_SERVOS, 0),
+	};
+	ASSERT_EQ(PKT_CODE_ERROR, io_batch(truncated, 3, reply));
+
+	// write announcing more values than it carries
+	const uint16_t short_write[] = {
+		PX4IO_BATCH_ADDRESS(PX4IO_PAGE_CONTROLS, 0), PX4IO_BATCH_WRITE | 4, 1, 2,
+	};
+	ASSERT_EQ(PKT_CODE_ERROR, io_batch(short_write, 4, reply));
+
+	// read past the end of the page
+	const uint16_t long_read[] = {
+		PX4IO_BATCH_ADDRESS(PX4IO_PAGE_SERVOS, 0), PX4IO_BATCH_READ | (PX4IO_SERVO_COUNT + 1),
+	};
+	ASSERT_EQ(PKT_CODE_ERROR, io_batch(long_read, 2, reply));
+
+	// unknown page
+	const uint16_t bad_page[] = {
+		PX4IO_BATCH_ADDRESS(200, 0), PX4IO_BATCH_READ | 1,
+	};
+	ASSERT_EQ(PKT_CODE_ERROR, io_batch(bad_page, 2, reply));
+
+	// reads not fitting into the reply packet
+	const uint16_t too_much[] = {
+		PX4IO_BATCH_ADDRESS(PX4IO_PAGE_RAW_RC_INPUT, 0), PX4IO_BATCH_READ | raw_rc_count,
+		PX4IO_BATCH_ADDRESS(PX4IO_PAGE_RAW_RC_INPUT, 0), PX4IO_BATCH_READ | raw_rc_count,
+		PX4IO_BATCH_ADDRESS(PX4IO_PAGE_RAW_RC_INPUT, 0), PX4IO_BATCH_READ | raw_rc_count,
+	};
+	ASSERT_EQ(PKT_CODE_ERROR, io_batch(too_much, 6, reply));
+
+	// an empty batch is fine and reads nothing
+	ASSERT_EQ(PKT_CODE_SUCCESS, io_batch(nullptr, 0, reply));
+	ASSERT_EQ(0, PKT_COUNT(reply));
+}
+
+TEST(PX4IORegistersTest, BatchCorruptPacket)
+{
+	const uint16_t request[] = {
+		PX4IO_BATCH_ADDRESS(PX4IO_PAGE_SERVOS, 0), PX4IO_BATCH_READ | 1,
+	};
+
+	IOPacket pkt = {};
+	pkt.count_code = 2 | PKT_CODE_BATCH;
+	memcpy(&pkt.regs[0], request, sizeof(request));
+	pkt.crc = crc_packet(&pkt) ^ 0x5a;
+
+	io_loopback(pkt);
+	ASSERT_EQ(PKT_CODE_CORRUPT, PKT_CODE(pkt));
+}
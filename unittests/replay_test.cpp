@@ -0,0 +1,275 @@
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <drivers/drv_hrt.h>
+#include <px4_posix.h>
+#include <systemlib/param/param.h>
+#include <uORB/uORB.h>
+#include <uORB/uORBDevices.hpp>
+#include <uORB/topics/parameter_update.h>
+#include <uORB/topics/sensor_combined.h>
+#include <uORB/topics/vehicle_gps_position.h>
+
+#include <replay/replay_reader.h>
+
+#include "gtest/gtest.h"
+
+/* defined by param.c in the firmware */
+ORB_DEFINE(parameter_update, struct parameter_update_s);
+
+/* the test logs don't apply parameters */
+extern "C" {
+	param_t param_find(const char *name) { return PARAM_INVALID; }
+	param_type_t param_type(param_t param) { return PARAM_TYPE_UNKNOWN; }
+	int param_set(param_t param, const void *val) { return -1; }
+
+	int replay_thread_main(int argc, char *argv[]);
+}
+
+namespace px4
+{
+void init_once();
+}
+
+static const char *generic_log = "testdata/replay_generic.bin";
+static const char *sdlog2_log = "testdata/replay_sdlog2.bin";
+static const char *topics = "sensor_combined,vehicle_gps_position,airspeed,distance_sensor";
+
+struct Sample {
+	std::string topic;
+	uint8_t instance;
+	hrt_abstime timestamp;
+	std::vector<uint8_t> data;
+
+	bool operator==(const Sample &other) const
+	{
+		return topic == other.topic && instance == other.instance &&
+		       timestamp == other.timestamp && data == other.data;
+	}
+};
+
+static std::vector<Sample> read_log(const char *path)
+{
+	std::vector<Sample> samples;
+	const struct replay_record_s *record;
+	int res;
+
+	EXPECT_EQ(0, replay_reader_open(path, topics, false));
+
+	while ((res = replay_reader_next(&record)) == 1) {
+		Sample s;
+		s.topic = record->meta->o_name;
+		s.instance = record->instance;
+		s.timestamp = record->timestamp;
+		s.data.assign(record->data, record->data + record->meta->o_size);
+		samples.push_back(s);
+	}
+
+	EXPECT_EQ(0, res);
+	replay_reader_close();
+
+	return samples;
+}
+
+/* the replay publishes to the uORB devices, created once per process */
+static void init_orb()
+{
+	static uORB::DeviceMaster *master = nullptr;
+
+	if (master == nullptr) {
+		px4::init_once();
+		master = new uORB::DeviceMaster(uORB::PUBSUB);
+		master->init();
+	}
+}
+
+static unsigned count_topic(const std::vector<Sample> &samples, const char *topic)
+{
+	unsigned count = 0;
+
+	for (const Sample &s : samples) {
+		count += (s.topic == topic);
+	}
+
+	return count;
+}
+
+TEST(ReplayTest, GenericLogIsDeterministic)
+{
+	std::vector<Sample> first = read_log(generic_log);
+	std::vector<Sample> second = read_log(generic_log);
+
+	ASSERT_EQ(34u, first.size());
+	EXPECT_TRUE(first == second);
+
+	EXPECT_EQ(20u, count_topic(first, "sensor_combined"));
+	EXPECT_EQ(4u, count_topic(first, "vehicle_gps_position"));
+	EXPECT_EQ(10u, count_topic(first, "airspeed"));
+	/* logged with an older layout */
+	EXPECT_EQ(0u, count_topic(first, "distance_sensor"));
+	/* not selected */
+	EXPECT_EQ(0u, count_topic(first, "vehicle_attitude"));
+}
+
+TEST(ReplayTest, GenericLogIsSortedByTimestamp)
+{
+	std::vector<Sample> samples = read_log(generic_log);
+
+	ASSERT_FALSE(samples.empty());
+
+	for (size_t i = 1; i < samples.size(); i++) {
+		EXPECT_LE(samples[i - 1].timestamp, samples[i].timestamp) << "sample " << i;
+	}
+
+	/* the GPS sample is logged after the sensors, but was taken before them */
+	EXPECT_EQ("vehicle_gps_position", samples[0].topic);
+	EXPECT_EQ(996500u, samples[0].timestamp);
+
+	/* equal timestamps keep the log order */
+	EXPECT_EQ("sensor_combined", samples[1].topic);
+	EXPECT_EQ("airspeed", samples[2].topic);
+	EXPECT_EQ(samples[1].timestamp, samples[2].timestamp);
+}
+
+TEST(ReplayTest, Sdlog2Log)
+{
+	std::vector<Sample> samples = read_log(sdlog2_log);
+	std::vector<Sample> again = read_log(sdlog2_log);
+
+	EXPECT_TRUE(samples == again);
+	ASSERT_EQ(24u, samples.size());
+	EXPECT_EQ(20u, count_topic(samples, "sensor_combined"));
+	EXPECT_EQ(4u, count_topic(samples, "vehicle_gps_position"));
+
+	unsigned n = 0;
+
+	for (const Sample &s : samples) {
+		if (s.topic == "sensor_combined") {
+			struct sensor_combined_s sensors;
+			memcpy(&sensors, s.data.data(), sizeof(sensors));
+
+			EXPECT_EQ(1000000u + n * 4000, sensors.timestamp);
+			EXPECT_FLOAT_EQ(0.01f * n, sensors.gyro_rad_s[0]);
+			EXPECT_FLOAT_EQ(-9.8f, sensors.accelerometer_m_s2[2]);
+			/* the baro is logged every 4th time */
+			EXPECT_FLOAT_EQ(1013.0f - (n / 4) * 4, sensors.baro_pres_mbar[0]);
+			EXPECT_EQ(1000000u + (n / 4) * 16000, sensors.baro_timestamp[0]);
+			n++;
+
+		} else {
+			struct vehicle_gps_position_s gps;
+			memcpy(&gps, s.data.data(), sizeof(gps));
+
+			EXPECT_EQ(s.timestamp, gps.timestamp_position);
+			EXPECT_EQ(3, gps.fix_type);
+			EXPECT_EQ(473977418, gps.lat);
+			EXPECT_FLOAT_EQ(5.0f, gps.vel_m_s);
+		}
+	}
+}
+
+TEST(ReplayTest, CorruptLog)
+{
+	FILE *f = fopen("replay_corrupt.bin", "wb");
+	ASSERT_NE(nullptr, f);
+
+	/* the header of the first message is cut short */
+	const uint8_t data[] = { 0xA3, 0x95, 0x80, 0x81, 0x0B };
+	fwrite(data, 1, sizeof(data), f);
+	fclose(f);
+
+	const struct replay_record_s *record;
+	ASSERT_EQ(0, replay_reader_open("replay_corrupt.bin", topics, false));
+	EXPECT_EQ(-1, replay_reader_next(&record));
+	replay_reader_close();
+
+	unlink("replay_corrupt.bin");
+}
+
+TEST(ReplayTest, PublishesInVirtualTime)
+{
+	init_orb();
+
+	std::vector<Sample> samples = read_log(generic_log);
+	ASSERT_FALSE(samples.empty());
+
+	const Sample *last = nullptr;
+
+	for (const Sample &s : samples) {
+		if (s.topic == "sensor_combined") {
+			last = &s;
+		}
+	}
+
+	ASSERT_NE(nullptr, last);
+
+	const char *argv[] = { "replay", "replay", "start", "-f", generic_log, "-t", "sensor_combined", nullptr };
+	EXPECT_EQ(0, replay_thread_main(7, (char **)argv));
+
+	/* the clock stops at the last sample */
+	EXPECT_EQ(last->timestamp, hrt_absolute_time());
+
+	struct sensor_combined_s sensors;
+	int sub = orb_subscribe(ORB_ID(sensor_combined));
+	ASSERT_GE(sub, 0);
+	ASSERT_EQ(0, orb_copy(ORB_ID(sensor_combined), sub, &sensors));
+	EXPECT_EQ(0, memcmp(&sensors, last->data.data(), sizeof(sensors)));
+	orb_unsubscribe(sub);
+}
+
+TEST(ReplayTest, ShiftsTimestampsPastVirtualTime)
+{
+	init_orb();
+
+	std::vector<Sample> samples = read_log(generic_log);
+	ASSERT_FALSE(samples.empty());
+
+	const Sample *first = nullptr;
+	const Sample *last = nullptr;
+
+	for (const Sample &s : samples) {
+		if (s.topic == "sensor_combined") {
+			if (first == nullptr) {
+				first = &s;
+			}
+
+			last = &s;
+		}
+	}
+
+	ASSERT_NE(nullptr, last);
+
+	/* the clock is already past the log start, it must not go backwards */
+	hrt_set_virtual_time(last->timestamp + 1000000);
+	const hrt_abstime offset = hrt_absolute_time() - first->timestamp;
+
+	/* the replay advertises a new instance if a previous test published one */
+	const int instance = (orb_exists(ORB_ID(sensor_combined), 0) == 0) ? 1 : 0;
+
+	const char *argv[] = { "replay", "replay", "start", "-f", generic_log, "-t", "sensor_combined", nullptr };
+	EXPECT_EQ(0, replay_thread_main(7, (char **)argv));
+
+	EXPECT_EQ(last->timestamp + offset, hrt_absolute_time());
+
+	struct sensor_combined_s sensors;
+	int sub = orb_subscribe_multi(ORB_ID(sensor_combined), instance);
+	ASSERT_GE(sub, 0);
+	ASSERT_EQ(0, orb_copy(ORB_ID(sensor_combined), sub, &sensors));
+	orb_unsubscribe(sub);
+
+	struct sensor_combined_s logged;
+	memcpy(&logged, last->data.data(), sizeof(logged));
+
+	EXPECT_EQ(logged.timestamp + offset, sensors.timestamp);
+
+	for (int i = 0; i < 3; i++) {
+		EXPECT_EQ(logged.gyro_timestamp[i] != 0 ? logged.gyro_timestamp[i] + offset : 0, sensors.gyro_timestamp[i]);
+		EXPECT_EQ(logged.baro_timestamp[i] != 0 ? logged.baro_timestamp[i] + offset : 0, sensors.baro_timestamp[i]);
+	}
+
+	/* the data itself is untouched */
+	EXPECT_EQ(logged.gyro_rad_s[0], sensors.gyro_rad_s[0]);
+	EXPECT_EQ(logged.baro_alt_meter[0], sensors.baro_alt_meter[0]);
+}
@@ -0,0 +1,163 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+#include <uORB/uORB.h>
+#include <uORB/topics/airspeed.h>
+#include <uORB/topics/esc_status.h>
+#include <uORB/topics/parameter_update.h>
+#include <uORB/topics/position_setpoint_triplet.h>
+#include <uORB/topics/vehicle_attitude.h>
+#include <uORB/topics/vehicle_gps_position.h>
+
+extern "C" {
+#include <sdlog2/sdlog2_generic.h>
+}
+
+#include "gtest/gtest.h"
+
+/* defined by param.c in the firmware */
+ORB_DEFINE(parameter_update, struct parameter_update_s);
+
+TEST(SDLog2GenericTest, TopicLayoutsMatchStructs)
+{
+	size_t count;
+	const struct orb_metadata *const *topics = orb_get_topics(&count);
+
+	ASSERT_GT(count, 0u);
+
+	for (size_t i = 0; i < count; i++) {
+		const struct orb_metadata *meta = topics[i];
+
+		ASSERT_NE(nullptr, meta->o_fields) << meta->o_name;
+		EXPECT_EQ((int)meta->o_size, sdlog2_generic_fields_size(meta->o_fields)) << meta->o_name;
+	}
+}
+
+/* the layout places the field where the compiler put it */
+#define EXPECT_LAYOUT_OFFSET(_layout, _struct, _field) \
+	EXPECT_EQ((int)offsetof(struct _struct, _field), sdlog2_generic_field_offset(_layout, #_field)) << #_struct "." #_field
+
+#define EXPECT_FIELD_OFFSET(_topic, _field) EXPECT_LAYOUT_OFFSET((ORB_ID(_topic))->o_fields, _topic##_s, _field)
+
+/* layout of a message nested in a topic */
+static const char *nested_layout(const char *layout, const char *type)
+{
+	std::string prefix = std::string("\n") + type + ":";
+	const char *p = strstr(layout, prefix.c_str());
+	return (p != nullptr) ? p + prefix.size() : "";
+}
+
+TEST(SDLog2GenericTest, TopicLayoutsMatchOffsets)
+{
+	/* padding after 8 bit and bool fields */
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, timestamp_position);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, lat);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, lon);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, alt);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, timestamp_variance);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, s_variance_m_s);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, c_variance_rad);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, fix_type);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, eph);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, epv);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, noise_per_ms);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, jamming_indicator);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, timestamp_velocity);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, vel_m_s);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, vel_n_m_s);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, vel_e_m_s);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, vel_d_m_s);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, cog_rad);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, vel_ned_valid);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, timestamp_time);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, time_utc_usec);
+	EXPECT_FIELD_OFFSET(vehicle_gps_position, satellites_used);
+
+	/* arrays */
+	EXPECT_FIELD_OFFSET(vehicle_attitude, timestamp);
+	EXPECT_FIELD_OFFSET(vehicle_attitude, mag_vibration);
+	EXPECT_FIELD_OFFSET(vehicle_attitude, rate_offsets);
+	EXPECT_FIELD_OFFSET(vehicle_attitude, R);
+	EXPECT_FIELD_OFFSET(vehicle_attitude, q);
+	EXPECT_FIELD_OFFSET(vehicle_attitude, g_comp);
+	EXPECT_FIELD_OFFSET(vehicle_attitude, R_valid);
+	EXPECT_FIELD_OFFSET(vehicle_attitude, q_valid);
+
+	EXPECT_FIELD_OFFSET(airspeed, timestamp);
+	EXPECT_FIELD_OFFSET(airspeed, indicated_airspeed_m_s);
+	EXPECT_FIELD_OFFSET(airspeed, true_airspeed_m_s);
+	EXPECT_FIELD_OFFSET(airspeed, true_airspeed_unfiltered_m_s);
+	EXPECT_FIELD_OFFSET(airspeed, air_temperature_celsius);
+
+	/* doubles after bools, nested in the triplet */
+	const char *setpoint = nested_layout((ORB_ID(position_setpoint_triplet))->o_fields, "position_setpoint");
+	EXPECT_LAYOUT_OFFSET(setpoint, position_setpoint_s, valid);
+	EXPECT_LAYOUT_OFFSET(setpoint, position_setpoint_s, type);
+	EXPECT_LAYOUT_OFFSET(setpoint, position_setpoint_s, x);
+	EXPECT_LAYOUT_OFFSET(setpoint, position_setpoint_s, position_valid);
+	EXPECT_LAYOUT_OFFSET(setpoint, position_setpoint_s, vx);
+	EXPECT_LAYOUT_OFFSET(setpoint, position_setpoint_s, velocity_valid);
+	EXPECT_LAYOUT_OFFSET(setpoint, position_setpoint_s, lat);
+	EXPECT_LAYOUT_OFFSET(setpoint, position_setpoint_s, lon);
+	EXPECT_LAYOUT_OFFSET(setpoint, position_setpoint_s, alt);
+	EXPECT_LAYOUT_OFFSET(setpoint, position_setpoint_s, yaw_valid);
+	EXPECT_LAYOUT_OFFSET(setpoint, position_setpoint_s, yawspeed);
+	EXPECT_LAYOUT_OFFSET(setpoint, position_setpoint_s, loiter_radius);
+	EXPECT_LAYOUT_OFFSET(setpoint, position_setpoint_s, loiter_direction);
+	EXPECT_LAYOUT_OFFSET(setpoint, position_setpoint_s, pitch_min);
+	EXPECT_LAYOUT_OFFSET(setpoint, position_setpoint_s, a_x);
+	EXPECT_LAYOUT_OFFSET(setpoint, position_setpoint_s, acceleration_valid);
+	EXPECT_LAYOUT_OFFSET(setpoint, position_setpoint_s, acceleration_is_force);
+
+	/* nested messages */
+	EXPECT_FIELD_OFFSET(position_setpoint_triplet, previous);
+	EXPECT_FIELD_OFFSET(position_setpoint_triplet, current);
+	EXPECT_FIELD_OFFSET(position_setpoint_triplet, next);
+	EXPECT_FIELD_OFFSET(position_setpoint_triplet, nav_state);
+
+	EXPECT_FIELD_OFFSET(esc_status, counter);
+	EXPECT_FIELD_OFFSET(esc_status, timestamp);
+	EXPECT_FIELD_OFFSET(esc_status, esc_count);
+	EXPECT_FIELD_OFFSET(esc_status, esc_connectiontype);
+	EXPECT_FIELD_OFFSET(esc_status, esc);
+}
+
+TEST(SDLog2GenericTest, FieldOffset)
+{
+	EXPECT_EQ(0, sdlog2_generic_field_offset("uint64_t timestamp;float x;", "timestamp"));
+	EXPECT_EQ(8, sdlog2_generic_field_offset("uint64_t timestamp;float x;", "x"));
+	EXPECT_EQ(12, sdlog2_generic_field_offset("uint32_t count;inner[2] items;float x;\n"
+			"inner:uint16_t value;uint8_t[2] _padding0;", "x"));
+
+	/* prefixes of a name don't match */
+	EXPECT_EQ(-1, sdlog2_generic_field_offset("uint64_t timestamp;float x;", "time"));
+	/* only the fields of the outermost struct */
+	EXPECT_EQ(-1, sdlog2_generic_field_offset("inner value;\ninner:float x;", "x"));
+	EXPECT_EQ(-1, sdlog2_generic_field_offset("float x", "x"));
+}
+
+TEST(SDLog2GenericTest, LayoutSize)
+{
+	EXPECT_EQ(12, sdlog2_generic_fields_size("uint64_t timestamp;float x;"));
+	EXPECT_EQ(24, sdlog2_generic_fields_size("uint64_t timestamp;char[8] name;uint8_t[8] _padding0;"));
+
+	/* nested messages are listed after the fields */
+	EXPECT_EQ(12, sdlog2_generic_fields_size("uint32_t count;inner[2] items;\n"
+			"inner:uint16_t value;uint8_t[2] _padding0;"));
+
+	EXPECT_EQ(0, sdlog2_generic_fields_size(""));
+}
+
+TEST(SDLog2GenericTest, LayoutErrors)
+{
+	/* missing separator */
+	EXPECT_EQ(-1, sdlog2_generic_fields_size("uint64_t timestamp"));
+	/* unknown type */
+	EXPECT_EQ(-1, sdlog2_generic_fields_size("uint64_t timestamp;inner value;"));
+	/* broken array */
+	EXPECT_EQ(-1, sdlog2_generic_fields_size("float[3 x;"));
+	/* recursive nesting */
+	EXPECT_EQ(-1, sdlog2_generic_fields_size("inner value;\ninner:inner value;"));
+}
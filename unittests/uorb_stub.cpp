@@ -21,3 +21,12 @@ int	orb_publish(const struct orb_metadata *meta, orb_advert_t handle, const void
 }
 
 
+
+int	orb_check_multi(const int *handles, bool *updated, unsigned n)
+{
+	for (unsigned i = 0; i < n; i++) {
+		updated[i] = false;
+	}
+
+	return 0;
+}
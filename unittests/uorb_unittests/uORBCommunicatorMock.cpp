@@ -73,7 +73,8 @@ int16_t uORB_test::uORBCommunicatorMock::add_subscription
        rc = _rx_handler->process_add_subscription
            (
               _topic_translation_map[messageName],
-              msgRateInHz
+              msgRateInHz,
+              0
            );
     }
   }
@@ -97,7 +98,8 @@ int16_t uORB_test::uORBCommunicatorMock::remove_subscription
     {
        rc = _rx_handler->process_remove_subscription
            (
-              _topic_translation_map[messageName]
+              _topic_translation_map[messageName],
+              0
            );
     }
   }
@@ -128,6 +130,7 @@ int16_t uORB_test::uORBCommunicatorMock::send_message
   if( uORB::Manager::get_instance()->is_remote_subscriber_present( messageName ) )
   {
     _msgCounters[messageName]._send_messageCount++;
+    _lastData[messageName].assign( (const char*)data, length );
     if( strcmp(messageName, "topicA") == 0 )
     {
       memcpy( &_topicAData, (void*)data, length );
@@ -191,6 +194,22 @@ bool uORB_test::uORBCommunicatorMock::get_remote_topicB_data
   return rc;
 }
 
+bool uORB_test::uORBCommunicatorMock::get_remote_data
+(
+    const char * messageName,
+    void* data,
+    size_t length
+)
+{
+  std::map<std::string, std::string>::iterator it = _lastData.find( messageName );
+  if( it == _lastData.end() || it->second.size() != length )
+  {
+    return false;
+  }
+  memcpy( data, it->second.data(), length );
+  return true;
+}
+
 void uORB_test::uORBCommunicatorMock::reset_counters()
 {
   InterfaceCounters resetCounter;
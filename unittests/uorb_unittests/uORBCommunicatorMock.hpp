@@ -118,6 +118,7 @@ class uORB_test::uORBCommunicatorMock : public uORBCommunicator::IChannel
 
   bool get_remote_topicA_data( struct orb_topic_A* data );
   bool get_remote_topicB_data( struct orb_topic_B* data );
+  bool get_remote_data( const char * messageName, void* data, size_t length );
 
   void reset_counters();
 
@@ -135,6 +136,7 @@ class uORB_test::uORBCommunicatorMock : public uORBCommunicator::IChannel
   struct orb_topic_B _topicBData;
 
   std::map<std::string, InterfaceCounters> _msgCounters;
+  std::map<std::string, std::string> _lastData;
 };
 
 #endif /* _uORBCommunicatorMock_test_hpp_ */
@@ -70,7 +70,8 @@ int16_t uORB_test::uORBCommunicatorMockLoopback::add_subscription
        rc = _rx_handler->process_add_subscription
            (
               _topic_translation_map[messageName].c_str(),
-              msgRateInHz
+              msgRateInHz,
+              0
            );
     }
   }
@@ -90,7 +91,8 @@ int16_t uORB_test::uORBCommunicatorMockLoopback::remove_subscription
     {
        rc = _rx_handler->process_remove_subscription
            (
-              _topic_translation_map[messageName].c_str()
+              _topic_translation_map[messageName].c_str(),
+              0
            );
     }
   }
@@ -242,7 +242,7 @@ namespace uORB_test
      // remote.
      ASSERT_NE( ( _sub_fd = orb_subscribe(ORB_ID(topicB) ) ), -1 ) << "Subscribe failed for topicB: %d" << errno;
      PX4_INFO( "subscribe fd: %d", _sub_fd );
-     ASSERT_EQ( rx_handler->process_add_subscription( "topicB", 1 ), 0 );
+     ASSERT_EQ( rx_handler->process_add_subscription( "topicB", 0, 0 ), 0 );
      c = _comm_channel.get_interface_counters( "topicB" );
      ASSERT_EQ( c._send_messageCount, 0 );
 
@@ -272,7 +272,7 @@ namespace uORB_test
      ASSERT_EQ( test_val.val, 2 );
 
      // step 6.
-     ASSERT_EQ( rx_handler->process_remove_subscription( "topicB" ), 0 );
+     ASSERT_EQ( rx_handler->process_remove_subscription( "topicB", 0 ), 0 );
      ASSERT_EQ( orb_unsubscribe( _sub_fd ), OK );
 
      //step 7. publish new data.
@@ -288,6 +288,262 @@ namespace uORB_test
 
    }
 
+   TEST_F(uORBCommunicatorTest, send_message_rate_limited )
+   {
+     // the publications are forwarded at most at the rate the remote
+     // subscriber asked for.
+     // Steps:
+     // 0. reset the interface counters.
+     // 1. add a local subscriber and a remote subscriber at 1Hz.
+     // 2. advertize the topic, the initial data is sent.
+     // 3. publish new data right away, it should not be sent.
+     // 4. add the remote subscriber again without rate limit, the
+     //    current data is sent.
+     // 5. publish new data, it should be sent.
+     // 6. remove the subscribers.
+
+     //step 0.
+     _comm_channel.reset_counters();
+     uORB_test::uORBCommunicatorMock::InterfaceCounters c;
+
+     //step 1.
+     ORB_DEFINE( topicB_rate, struct orb_topic_B );
+     uORBCommunicator::IChannelRxHandler* rx_handler = _comm_channel.get_rx_handler();
+     ASSERT_NE( ( _sub_fd = orb_subscribe(ORB_ID(topicB_rate) ) ), -1 ) << "Subscribe failed for topicB_rate: %d" << errno;
+     ASSERT_EQ( rx_handler->process_add_subscription( "topicB_rate", 1, 0 ), 0 );
+
+     //step 2.
+     _topicB.val = 1;
+     _pub_ptr = orb_advertise(ORB_ID(topicB_rate), &_topicB);
+     ASSERT_TRUE( _pub_ptr != nullptr ) << "Failed to advertize uORB Topic topicB_rate: errno: " << errno;
+     c = _comm_channel.get_interface_counters( "topicB_rate" );
+     ASSERT_EQ( c._send_messageCount, 1 );
+
+     //step 3.
+     for( int i = 2; i < 5; i++ )
+     {
+       _topicB.val = i;
+       ASSERT_EQ( orb_publish( ORB_ID(topicB_rate), _pub_ptr, &_topicB), OK );
+     }
+     c = _comm_channel.get_interface_counters( "topicB_rate" );
+     ASSERT_EQ( c._send_messageCount, 1 );
+
+     //step 4.
+     ASSERT_EQ( rx_handler->process_add_subscription( "topicB_rate", 0, 0 ), 0 );
+     c = _comm_channel.get_interface_counters( "topicB_rate" );
+     ASSERT_EQ( c._send_messageCount, 2 );
+
+     //step 5.
+     _topicB.val = 5;
+     ASSERT_EQ( orb_publish( ORB_ID(topicB_rate), _pub_ptr, &_topicB), OK );
+     c = _comm_channel.get_interface_counters( "topicB_rate" );
+     ASSERT_EQ( c._send_messageCount, 3 );
+
+     //step 6.
+     ASSERT_EQ( rx_handler->process_remove_subscription( "topicB_rate", 0 ), 0 );
+     ASSERT_EQ( orb_unsubscribe( _sub_fd ), OK );
+   }
+
+   TEST_F(uORBCommunicatorTest, send_message_only_changed )
+   {
+     // in send-if-changed mode, publications equal to the last one sent
+     // are not forwarded.
+     // Steps:
+     // 0. reset the interface counters.
+     // 1. add a local and a remote subscriber, and advertize the topic.
+     // 2. enable the send-if-changed mode.
+     // 3. publish the same data twice, it should be sent once.
+     // 4. publish different data, it should be sent.
+     // 5. disable the mode, the same data should be sent again.
+     // 6. remove the subscribers.
+
+     //step 0.
+     _comm_channel.reset_counters();
+     uORB_test::uORBCommunicatorMock::InterfaceCounters c;
+
+     //step 1.
+     ORB_DEFINE( topicB_changed, struct orb_topic_B );
+     uORBCommunicator::IChannelRxHandler* rx_handler = _comm_channel.get_rx_handler();
+     ASSERT_NE( ( _sub_fd = orb_subscribe(ORB_ID(topicB_changed) ) ), -1 ) << "Subscribe failed for topicB_changed: %d" << errno;
+     ASSERT_EQ( rx_handler->process_add_subscription( "topicB_changed", 0, 0 ), 0 );
+     _topicB.val = 1;
+     _pub_ptr = orb_advertise(ORB_ID(topicB_changed), &_topicB);
+     ASSERT_TRUE( _pub_ptr != nullptr ) << "Failed to advertize uORB Topic topicB_changed: errno: " << errno;
+     c = _comm_channel.get_interface_counters( "topicB_changed" );
+     ASSERT_EQ( c._send_messageCount, 1 );
+
+     //step 2.
+     uORB::DeviceNode* node = uORB::DeviceMaster::GetDeviceNode( "/obj/topicB_changed0" );
+     ASSERT_TRUE( node != nullptr );
+     ASSERT_EQ( node->set_remote_only_changed( true ), OK );
+
+     //step 3.
+     ASSERT_EQ( orb_publish( ORB_ID(topicB_changed), _pub_ptr, &_topicB), OK );
+     ASSERT_EQ( orb_publish( ORB_ID(topicB_changed), _pub_ptr, &_topicB), OK );
+     c = _comm_channel.get_interface_counters( "topicB_changed" );
+     ASSERT_EQ( c._send_messageCount, 2 );
+
+     //step 4.
+     _topicB.val = 2;
+     ASSERT_EQ( orb_publish( ORB_ID(topicB_changed), _pub_ptr, &_topicB), OK );
+     c = _comm_channel.get_interface_counters( "topicB_changed" );
+     ASSERT_EQ( c._send_messageCount, 3 );
+
+     //step 5.
+     ASSERT_EQ( node->set_remote_only_changed( false ), OK );
+     ASSERT_EQ( orb_publish( ORB_ID(topicB_changed), _pub_ptr, &_topicB), OK );
+     c = _comm_channel.get_interface_counters( "topicB_changed" );
+     ASSERT_EQ( c._send_messageCount, 4 );
+
+     //step 6.
+     ASSERT_EQ( rx_handler->process_remove_subscription( "topicB_changed", 0 ), 0 );
+     ASSERT_EQ( orb_unsubscribe( _sub_fd ), OK );
+   }
+
+   TEST_F(uORBCommunicatorTest, send_message_trailing )
+   {
+     // the last publication of a burst held back by the rate limit is
+     // sent once the interval has passed.
+     // Steps:
+     // 0. reset the interface counters.
+     // 1. add a local subscriber and a remote subscriber at 20Hz.
+     // 2. advertize the topic, the initial data is sent.
+     // 3. publish a burst, nothing is sent right away.
+     // 4. after the interval the last publication of the burst is sent.
+     // 5. remove the subscribers.
+
+     //step 0.
+     _comm_channel.reset_counters();
+     uORB_test::uORBCommunicatorMock::InterfaceCounters c;
+
+     //step 1.
+     ORB_DEFINE( topicB_trailing, struct orb_topic_B );
+     uORBCommunicator::IChannelRxHandler* rx_handler = _comm_channel.get_rx_handler();
+     ASSERT_NE( ( _sub_fd = orb_subscribe(ORB_ID(topicB_trailing) ) ), -1 ) << "Subscribe failed for topicB_trailing: %d" << errno;
+     ASSERT_EQ( rx_handler->process_add_subscription( "topicB_trailing", 20, 0 ), 0 );
+
+     //step 2.
+     _topicB.val = 1;
+     _pub_ptr = orb_advertise(ORB_ID(topicB_trailing), &_topicB);
+     ASSERT_TRUE( _pub_ptr != nullptr ) << "Failed to advertize uORB Topic topicB_trailing: errno: " << errno;
+
+     //step 3.
+     for( int i = 2; i < 5; i++ )
+     {
+       _topicB.val = i;
+       ASSERT_EQ( orb_publish( ORB_ID(topicB_trailing), _pub_ptr, &_topicB), OK );
+     }
+     c = _comm_channel.get_interface_counters( "topicB_trailing" );
+     ASSERT_EQ( c._send_messageCount, 1 );
+
+     //step 4.
+     usleep( 200000 );
+     c = _comm_channel.get_interface_counters( "topicB_trailing" );
+     ASSERT_EQ( c._send_messageCount, 2 );
+     struct orb_topic_B remote;
+     ASSERT_TRUE( _comm_channel.get_remote_data( "topicB_trailing", &remote, sizeof( remote ) ) );
+     ASSERT_EQ( remote.val, 4 );
+
+     // nothing more to send
+     usleep( 100000 );
+     c = _comm_channel.get_interface_counters( "topicB_trailing" );
+     ASSERT_EQ( c._send_messageCount, 2 );
+
+     //step 5.
+     ASSERT_EQ( rx_handler->process_remove_subscription( "topicB_trailing", 0 ), 0 );
+     ASSERT_EQ( orb_unsubscribe( _sub_fd ), OK );
+   }
+
+   TEST_F(uORBCommunicatorTest, send_message_rate_per_subscriber )
+   {
+     // every remote subscriber has its own rate, a publication is
+     // forwarded as long as one of them is due.
+     // Steps:
+     // 0. reset the interface counters.
+     // 1. add a local subscriber, a remote subscriber at 1Hz and one
+     //    without limit, and advertize the topic.
+     // 2. publish, everything is sent for the subscriber without limit.
+     // 3. remove that subscriber, the publications are limited to 1Hz.
+     // 4. remove the subscribers.
+
+     //step 0.
+     _comm_channel.reset_counters();
+     uORB_test::uORBCommunicatorMock::InterfaceCounters c;
+
+     //step 1.
+     ORB_DEFINE( topicB_subscribers, struct orb_topic_B );
+     uORBCommunicator::IChannelRxHandler* rx_handler = _comm_channel.get_rx_handler();
+     ASSERT_NE( ( _sub_fd = orb_subscribe(ORB_ID(topicB_subscribers) ) ), -1 ) << "Subscribe failed for topicB_subscribers: %d" << errno;
+     ASSERT_EQ( rx_handler->process_add_subscription( "topicB_subscribers", 1, 1 ), 0 );
+     ASSERT_EQ( rx_handler->process_add_subscription( "topicB_subscribers", 0, 2 ), 0 );
+     _topicB.val = 1;
+     _pub_ptr = orb_advertise(ORB_ID(topicB_subscribers), &_topicB);
+     ASSERT_TRUE( _pub_ptr != nullptr ) << "Failed to advertize uORB Topic topicB_subscribers: errno: " << errno;
+     c = _comm_channel.get_interface_counters( "topicB_subscribers" );
+     ASSERT_EQ( c._send_messageCount, 1 );
+
+     //step 2.
+     for( int i = 2; i < 5; i++ )
+     {
+       _topicB.val = i;
+       ASSERT_EQ( orb_publish( ORB_ID(topicB_subscribers), _pub_ptr, &_topicB), OK );
+     }
+     c = _comm_channel.get_interface_counters( "topicB_subscribers" );
+     ASSERT_EQ( c._send_messageCount, 4 );
+
+     //step 3.
+     ASSERT_EQ( rx_handler->process_remove_subscription( "topicB_subscribers", 2 ), 0 );
+     // the set of remote topics is per name, the 1Hz subscriber is still there
+     ASSERT_EQ( rx_handler->process_add_subscription( "topicB_subscribers", 1, 1 ), 0 );
+     _comm_channel.reset_counters();
+     ASSERT_EQ( orb_publish( ORB_ID(topicB_subscribers), _pub_ptr, &_topicB), OK );
+     c = _comm_channel.get_interface_counters( "topicB_subscribers" );
+     ASSERT_EQ( c._send_messageCount, 0 );
+
+     //step 4.
+     ASSERT_EQ( rx_handler->process_remove_subscription( "topicB_subscribers", 1 ), 0 );
+     ASSERT_EQ( orb_unsubscribe( _sub_fd ), OK );
+   }
+
+   TEST_F(uORBCommunicatorTest, send_message_rate_per_instance )
+   {
+     // every instance of a topic is rate limited on its own.
+     // Steps:
+     // 0. add a local subscriber and advertize two instances.
+     // 1. add a remote subscriber at 1Hz, the data of both instances is sent.
+     // 2. publish both instances, nothing is sent.
+     // 3. remove the subscribers.
+
+     //step 0.
+     ORB_DEFINE( topicB_instances, struct orb_topic_B );
+     uORBCommunicator::IChannelRxHandler* rx_handler = _comm_channel.get_rx_handler();
+     ASSERT_NE( ( _sub_fd = orb_subscribe(ORB_ID(topicB_instances) ) ), -1 ) << "Subscribe failed for topicB_instances: %d" << errno;
+     int instance0, instance1;
+     _topicB.val = 1;
+     orb_advert_t pub0 = orb_advertise_multi(ORB_ID(topicB_instances), &_topicB, &instance0, ORB_PRIO_DEFAULT);
+     orb_advert_t pub1 = orb_advertise_multi(ORB_ID(topicB_instances), &_topicB, &instance1, ORB_PRIO_DEFAULT);
+     ASSERT_TRUE( pub0 != nullptr && pub1 != nullptr );
+     ASSERT_EQ( instance0, 0 );
+     ASSERT_EQ( instance1, 1 );
+
+     //step 1.
+     _comm_channel.reset_counters();
+     uORB_test::uORBCommunicatorMock::InterfaceCounters c;
+     ASSERT_EQ( rx_handler->process_add_subscription( "topicB_instances", 1, 0 ), 0 );
+     c = _comm_channel.get_interface_counters( "topicB_instances" );
+     ASSERT_EQ( c._send_messageCount, 2 );
+
+     //step 2.
+     ASSERT_EQ( orb_publish( ORB_ID(topicB_instances), pub0, &_topicB), OK );
+     ASSERT_EQ( orb_publish( ORB_ID(topicB_instances), pub1, &_topicB), OK );
+     c = _comm_channel.get_interface_counters( "topicB_instances" );
+     ASSERT_EQ( c._send_messageCount, 2 );
+
+     //step 3.
+     ASSERT_EQ( rx_handler->process_remove_subscription( "topicB_instances", 0 ), 0 );
+     ASSERT_EQ( orb_unsubscribe( _sub_fd ), OK );
+   }
+
    //========== UNIT tests to verify the process_receive_message interface
    //========== of rx handler.
    TEST_F( uORBCommunicatorTest, rx_handler_rcv_data_case1 )
@@ -368,7 +624,7 @@ namespace uORB_test
 
      //step 4.
      uORBCommunicator::IChannelRxHandler* rx_handler = _comm_channel.get_rx_handler();
-     ASSERT_EQ( rx_handler->process_add_subscription( "topicB", 1 ), 0 );
+     ASSERT_EQ( rx_handler->process_add_subscription( "topicB", 0, 0 ), 0 );
      c = _comm_channel.get_interface_counters( "topicB" );
      ASSERT_EQ( c._send_messageCount, 1 );
 
@@ -476,6 +732,67 @@ namespace uORB_test
      ASSERT_EQ( orb_publish( ORB_ID(topicA), pub_topicA_ptr, &topicA), OK );
 
    }
+
+   //================= Unit tests for orb_check_multi ====================
+   // this test will validate that orb_check_multi reports the same update
+   // state as individual orb_check calls for a batch of handles.
+   //=====================================================================
+   TEST_F( uORBCommunicatorTest, check_multi )
+   {
+     struct orb_topic_B topicB;
+     struct orb_topic_B topicBLocal;
+     bool updated[3];
+     int handles[3];
+
+     topicB.val = 1;
+     orb_advert_t pub_ptr = orb_advertise( ORB_ID(topicB_clone), &topicB );
+     ASSERT_NE( pub_ptr, nullptr ) << "advertise failed: " << errno;
+
+     handles[0] = orb_subscribe( ORB_ID(topicB_clone) );
+     handles[1] = orb_subscribe( ORB_ID(topicB_clone) );
+     ASSERT_GE( handles[0], 0 );
+     ASSERT_GE( handles[1], 0 );
+
+     // nothing has been published since the subscriptions were made.
+     ASSERT_EQ( orb_check_multi( handles, updated, 2 ), OK );
+     ASSERT_FALSE( updated[0] );
+     ASSERT_FALSE( updated[1] );
+
+     // both subscribers see a new publication.
+     topicB.val = 2;
+     ASSERT_EQ( orb_publish( ORB_ID(topicB_clone), pub_ptr, &topicB ), OK );
+     ASSERT_EQ( orb_check_multi( handles, updated, 2 ), OK );
+     ASSERT_TRUE( updated[0] );
+     ASSERT_TRUE( updated[1] );
+
+     // copying on one handle only clears that handle.
+     ASSERT_EQ( orb_copy( ORB_ID(topicB_clone), handles[0], &topicBLocal ), OK );
+     ASSERT_EQ( orb_check_multi( handles, updated, 2 ), OK );
+     ASSERT_FALSE( updated[0] );
+     ASSERT_TRUE( updated[1] );
+
+     ASSERT_EQ( orb_copy( ORB_ID(topicB_clone), handles[1], &topicBLocal ), OK );
+     ASSERT_EQ( orb_check_multi( handles, updated, 2 ), OK );
+     ASSERT_FALSE( updated[0] );
+     ASSERT_FALSE( updated[1] );
+
+     // a new publication flags every handle again.
+     topicB.val = 3;
+     ASSERT_EQ( orb_publish( ORB_ID(topicB_clone), pub_ptr, &topicB ), OK );
+     ASSERT_EQ( orb_check_multi( handles, updated, 2 ), OK );
+     ASSERT_TRUE( updated[0] );
+     ASSERT_TRUE( updated[1] );
+
+     // an invalid handle fails the call but leaves the others valid.
+     handles[2] = -1;
+     ASSERT_EQ( orb_check_multi( handles, updated, 3 ), PX4_ERROR );
+     ASSERT_TRUE( updated[0] );
+     ASSERT_TRUE( updated[1] );
+     ASSERT_FALSE( updated[2] );
+
+     ASSERT_EQ( orb_unsubscribe( handles[0] ), OK );
+     ASSERT_EQ( orb_unsubscribe( handles[1] ), OK );
+   }
 }
 
 
@@ -0,0 +1,414 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "muorb/shm/uORBShmChannel.hpp"
+#include "gtest/gtest.h"
+#include "px4_log.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+namespace uORB_test
+{
+  static uint64_t monotonic_us()
+  {
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+  }
+
+  // receives the loopback messages, the first 8 bytes of each message are
+  // the send time and the rest is filled with a counter pattern.
+  class ShmRxHandler : public uORBCommunicator::IChannelRxHandler
+  {
+   public:
+    ShmRxHandler() :
+      _count( 0 ), _torn( 0 ), _last_counter( 0 ), _latency_sum( 0 ), _latency_max( 0 ),
+      _added( 0 ), _removed( 0 ), _last_rate( -1 )
+    {
+      pthread_mutex_init( &_lock, nullptr );
+      pthread_cond_init( &_cond, nullptr );
+    }
+
+    ~ShmRxHandler()
+    {
+      pthread_cond_destroy( &_cond );
+      pthread_mutex_destroy( &_lock );
+    }
+
+    virtual int16_t process_add_subscription( const char *messageName, int32_t msgRateInHz, uint32_t subscriber )
+    {
+      pthread_mutex_lock( &_lock );
+      _added++;
+      _last_rate = msgRateInHz;
+      pthread_cond_signal( &_cond );
+      pthread_mutex_unlock( &_lock );
+      return 0;
+    }
+
+    virtual int16_t process_remove_subscription( const char *messageName, uint32_t subscriber )
+    {
+      pthread_mutex_lock( &_lock );
+      _removed++;
+      pthread_cond_signal( &_cond );
+      pthread_mutex_unlock( &_lock );
+      return 0;
+    }
+
+    virtual int16_t process_received_message( const char *messageName, int32_t length, uint8_t *data )
+    {
+      uint64_t now = monotonic_us();
+      uint64_t sent;
+      memcpy( &sent, data, sizeof( sent ) );
+
+      // all pattern bytes must come from the same publication
+      bool torn = false;
+      for( int32_t i = sizeof( sent ) + 1; i < length; i++ ) {
+        if( data[i] != data[sizeof( sent )] ) {
+          torn = true;
+        }
+      }
+
+      pthread_mutex_lock( &_lock );
+      _count++;
+      _torn += torn ? 1 : 0;
+      _last_counter = ( length > (int32_t)sizeof( sent ) ) ? data[sizeof( sent )] : 0;
+      _latency_sum += now - sent;
+      if( now - sent > _latency_max ) {
+        _latency_max = now - sent;
+      }
+      pthread_cond_signal( &_cond );
+      pthread_mutex_unlock( &_lock );
+      return 0;
+    }
+
+    void reset()
+    {
+      pthread_mutex_lock( &_lock );
+      _count = _torn = 0;
+      _last_counter = 0;
+      _latency_sum = _latency_max = 0;
+      pthread_mutex_unlock( &_lock );
+    }
+
+    // wait until count messages were received, false on timeout
+    bool wait_for( unsigned count, int timeout_ms )
+    {
+      return wait_until( &_count, count, timeout_ms );
+    }
+
+    // wait until the remote subscriptions were added and removed this often
+    bool wait_for_subscriptions( unsigned added, unsigned removed, int timeout_ms )
+    {
+      return wait_until( &_added, added, timeout_ms ) && wait_until( &_removed, removed, timeout_ms );
+    }
+
+    pthread_mutex_t _lock;
+    pthread_cond_t _cond;
+    unsigned _count;
+    unsigned _torn;
+    uint8_t _last_counter;
+    uint64_t _latency_sum;
+    uint64_t _latency_max;
+    unsigned _added;
+    unsigned _removed;
+    int32_t _last_rate;
+
+   private:
+    bool wait_until( const unsigned *counter, unsigned count, int timeout_ms )
+    {
+      struct timespec deadline;
+      clock_gettime( CLOCK_REALTIME, &deadline );
+      deadline.tv_sec += timeout_ms / 1000;
+      deadline.tv_nsec += ( timeout_ms % 1000 ) * 1000000;
+      if( deadline.tv_nsec >= 1000000000 ) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+      }
+
+      pthread_mutex_lock( &_lock );
+      int ret = 0;
+      while( *counter < count && ret == 0 ) {
+        ret = pthread_cond_timedwait( &_cond, &_lock, &deadline );
+      }
+      bool ok = *counter >= count;
+      pthread_mutex_unlock( &_lock );
+      return ok;
+    }
+  };
+
+  class uORBShmChannelTest : public ::testing::Test
+  {
+   protected:
+    virtual void SetUp()
+    {
+      snprintf( _segment, sizeof( _segment ), "/px4_uorb_test_%d", (int)getpid() );
+      ASSERT_EQ( _tx.attach( _segment ), 0 );
+      ASSERT_EQ( _rx.attach( _segment ), 0 );
+      _rx.register_handler( &_handler );
+      _rx.Start();
+    }
+
+    virtual void TearDown()
+    {
+      _rx.Stop();
+      _rx.detach();
+      _tx.detach();
+    }
+
+    void fill( uint8_t *buf, int32_t length, uint8_t counter )
+    {
+      uint64_t now = monotonic_us();
+      memcpy( buf, &now, sizeof( now ) );
+      memset( buf + sizeof( now ), counter, length - sizeof( now ) );
+    }
+
+    char _segment[64];
+    uORB::ShmChannel _tx;
+    uORB::ShmChannel _rx;
+    ShmRxHandler _handler;
+  };
+
+  TEST_F( uORBShmChannelTest, no_subscriber )
+  {
+    // nothing is delivered for topics that were never subscribed
+    uint8_t buf[64];
+    fill( buf, sizeof( buf ), 1 );
+    ASSERT_EQ( _tx.send_message( "topicA", sizeof( buf ), buf ), 0 );
+    ASSERT_FALSE( _handler.wait_for( 1, 200 ) );
+  }
+
+  TEST_F( uORBShmChannelTest, latched_data )
+  {
+    // a new subscriber gets the current data of the topic
+    uint8_t buf[64];
+    ASSERT_EQ( _rx.add_subscription( "topicA", 1 ), 0 );
+    ASSERT_EQ( _rx.remove_subscription( "topicA" ), 0 );
+    fill( buf, sizeof( buf ), 7 );
+    ASSERT_EQ( _tx.send_message( "topicA", sizeof( buf ), buf ), 0 );
+
+    ASSERT_EQ( _rx.add_subscription( "topicA", 1 ), 0 );
+    ASSERT_TRUE( _handler.wait_for( 1, 1000 ) );
+    ASSERT_EQ( _handler._last_counter, 7 );
+  }
+
+  TEST_F( uORBShmChannelTest, no_echo )
+  {
+    // the publishing channel doesn't receive its own data
+    ShmRxHandler tx_handler;
+    uint8_t buf[64];
+    _tx.register_handler( &tx_handler );
+    _tx.Start();
+    ASSERT_EQ( _tx.add_subscription( "topicA", 1 ), 0 );
+    ASSERT_EQ( _rx.add_subscription( "topicA", 1 ), 0 );
+    fill( buf, sizeof( buf ), 3 );
+    ASSERT_EQ( _tx.send_message( "topicA", sizeof( buf ), buf ), 0 );
+    ASSERT_TRUE( _handler.wait_for( 1, 1000 ) );
+    ASSERT_FALSE( tx_handler.wait_for( 1, 200 ) );
+    _tx.Stop();
+  }
+
+  TEST_F( uORBShmChannelTest, too_large )
+  {
+    // topics larger than a slot are dropped without failing the publication
+    static uint8_t buf[uORB::ShmChannel::SLOT_DATA_SIZE + 1];
+    ASSERT_EQ( _rx.add_subscription( "topicA", 1 ), 0 );
+    fill( buf, sizeof( buf ), 1 );
+    ASSERT_EQ( _tx.send_message( "topicA", sizeof( buf ), buf ), 0 );
+    ASSERT_FALSE( _handler.wait_for( 1, 200 ) );
+  }
+
+  TEST_F( uORBShmChannelTest, local_topics_use_no_slot )
+  {
+    // topics only subscribed within the publishing process don't take a slot
+    uint8_t buf[64];
+    char name[uORB::ShmChannel::MAX_NAME_LEN];
+    for( int i = 0; i < uORB::ShmChannel::MAX_SLOTS + 10; i++ ) {
+      snprintf( name, sizeof( name ), "local%d", i );
+      ASSERT_EQ( _tx.add_subscription( name, 0 ), 0 );
+      fill( buf, sizeof( buf ), 1 );
+      ASSERT_EQ( _tx.send_message( name, sizeof( buf ), buf ), 0 );
+    }
+
+    ASSERT_EQ( _rx.add_subscription( "topicA", 0 ), 0 );
+    fill( buf, sizeof( buf ), 5 );
+    ASSERT_EQ( _tx.send_message( "topicA", sizeof( buf ), buf ), 0 );
+    ASSERT_TRUE( _handler.wait_for( 1, 1000 ) );
+    ASSERT_EQ( _handler._last_counter, 5 );
+  }
+
+  TEST_F( uORBShmChannelTest, remote_subscription_rate )
+  {
+    // the subscriptions of other processes are passed to the handler, each
+    // process with its own rate, and they are released when the process dies
+    int to_child[2];
+    int from_child[2];
+    ASSERT_EQ( pipe( to_child ), 0 );
+    ASSERT_EQ( pipe( from_child ), 0 );
+
+    pid_t pid = fork();
+    ASSERT_GE( pid, 0 );
+    if( pid == 0 ) {
+      uORB::ShmChannel *child = new uORB::ShmChannel();
+      char c = 0;
+      if( child->attach( _segment ) == 0 && child->add_subscription( "topicB", 10 ) == 0 &&
+          child->add_subscription( "topicC", 10 ) == 0 ) {
+        c = 1;
+      }
+      // exit without detaching once the parent saw the subscriptions
+      if( write( from_child[1], &c, 1 ) == 1 ) {
+        (void)read( to_child[0], &c, 1 );
+      }
+      _exit( 0 );
+    }
+
+    char c = 0;
+    ASSERT_EQ( read( from_child[0], &c, 1 ), 1 );
+    ASSERT_EQ( c, 1 );
+    ASSERT_TRUE( _handler.wait_for_subscriptions( 2, 0, 1000 ) );
+    ASSERT_EQ( _handler._last_rate, 10 );
+
+    // a second subscriber, which then changes its rate
+    ASSERT_EQ( _tx.add_subscription( "topicB", 50 ), 0 );
+    ASSERT_TRUE( _handler.wait_for_subscriptions( 3, 0, 1000 ) );
+    ASSERT_EQ( _handler._last_rate, 50 );
+    ASSERT_EQ( _tx.add_subscription( "topicB", 0 ), 0 );
+    ASSERT_TRUE( _handler.wait_for_subscriptions( 4, 0, 1000 ) );
+    ASSERT_EQ( _handler._last_rate, 0 );
+    ASSERT_EQ( _tx.remove_subscription( "topicB" ), 0 );
+    ASSERT_TRUE( _handler.wait_for_subscriptions( 4, 1, 1000 ) );
+
+    ASSERT_EQ( write( to_child[1], &c, 1 ), 1 );
+    int status;
+    ASSERT_EQ( waitpid( pid, &status, 0 ), pid );
+    close( to_child[0] );
+    close( to_child[1] );
+    close( from_child[0] );
+    close( from_child[1] );
+
+    // topicB and topicC lose their remote subscriber
+    ASSERT_EQ( _tx.reap(), 1 );
+    ASSERT_EQ( _tx.reap(), 0 );
+    ASSERT_TRUE( _handler.wait_for_subscriptions( 4, 3, 1000 ) );
+  }
+
+  TEST_F( uORBShmChannelTest, dead_writer )
+  {
+    // a process that dies while writing leaves the slot locked, the next
+    // writer takes it over instead of spinning forever
+    ASSERT_EQ( _rx.add_subscription( "topicA", 0 ), 0 );
+
+    pid_t pid = fork();
+    ASSERT_GE( pid, 0 );
+    if( pid == 0 ) {
+      // the data runs into an inaccessible page, the copy into the slot faults
+      const long page = sysconf( _SC_PAGESIZE );
+      uint8_t *mem = (uint8_t *)mmap( nullptr, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+      uORB::ShmChannel *child = new uORB::ShmChannel();
+      if( mem != MAP_FAILED && mprotect( mem + page, page, PROT_NONE ) == 0 && child->attach( _segment ) == 0 ) {
+        memset( mem, 9, page );
+        child->send_message( "topicA", uORB::ShmChannel::SLOT_DATA_SIZE, mem + page - 100 );
+      }
+      _exit( 0 );
+    }
+
+    int status;
+    ASSERT_EQ( waitpid( pid, &status, 0 ), pid );
+    ASSERT_TRUE( WIFSIGNALED( status ) );
+    ASSERT_FALSE( _handler.wait_for( 1, 200 ) );
+
+    uint8_t buf[64];
+    fill( buf, sizeof( buf ), 4 );
+    uint64_t start = monotonic_us();
+    ASSERT_EQ( _tx.send_message( "topicA", sizeof( buf ), buf ), 0 );
+    ASSERT_LT( monotonic_us() - start, 100000u );
+    ASSERT_TRUE( _handler.wait_for( 1, 1000 ) );
+    ASSERT_EQ( _handler._last_counter, 4 );
+    ASSERT_EQ( _handler._torn, 0u );
+    ASSERT_EQ( _tx.reap(), 1 );
+  }
+
+  TEST_F( uORBShmChannelTest, loopback_stress )
+  {
+    // latency is measured with one message in flight, throughput by
+    // publishing back to back. uORB semantics allow the receiver to skip
+    // samples then, but it must never see a torn message and must end up
+    // with the last one.
+    static const int32_t sizes[] = { 16, 64, 256, 1024 };
+    static const unsigned ping_count = 1000;
+    static const unsigned burst_count = 100000;
+    uint8_t buf[uORB::ShmChannel::SLOT_DATA_SIZE];
+
+    ASSERT_EQ( _rx.add_subscription( "topicA", 1 ), 0 );
+
+    for( unsigned s = 0; s < sizeof( sizes ) / sizeof( sizes[0] ); s++ ) {
+      const int32_t size = sizes[s];
+
+      // latency
+      _handler.reset();
+      for( unsigned i = 1; i <= ping_count; i++ ) {
+        fill( buf, size, i );
+        ASSERT_EQ( _tx.send_message( "topicA", size, buf ), 0 );
+        ASSERT_TRUE( _handler.wait_for( i, 1000 ) ) << "message " << i << " of size " << size << " lost";
+      }
+      double latency_avg = (double)_handler._latency_sum / ping_count;
+      uint64_t latency_max = _handler._latency_max;
+
+      // throughput
+      _handler.reset();
+      uint64_t start = monotonic_us();
+      for( unsigned i = 1; i <= burst_count; i++ ) {
+        fill( buf, size, i );
+        ASSERT_EQ( _tx.send_message( "topicA", size, buf ), 0 );
+      }
+      double elapsed = ( monotonic_us() - start ) / 1e6;
+
+      // wait for the receiver to catch up with the last message
+      for( int i = 0; i < 100 && _handler._last_counter != (uint8_t)burst_count; i++ ) {
+        usleep( 10000 );
+      }
+
+      PX4_INFO( "size %4d: latency avg %6.1f us max %5llu us, %8.0f msgs/s %7.1f MB/s published, %u received",
+                (int)size, latency_avg, (unsigned long long)latency_max, burst_count / elapsed,
+                burst_count * size / elapsed / 1e6, _handler._count );
+
+      ASSERT_EQ( _handler._torn, 0u );
+      ASSERT_EQ( _handler._last_counter, (uint8_t)burst_count );
+    }
+  }
+}
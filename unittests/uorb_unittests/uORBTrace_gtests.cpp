@@ -0,0 +1,195 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "uORBTrace.hpp"
+#include "uORBGtestTopics.hpp"
+#include "gtest/gtest.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+namespace uORB_test
+{
+  struct TraceEvent
+  {
+    std::string name;
+    std::string type;
+    unsigned long long ts;
+    unsigned long long tid;
+    unsigned instance;
+    unsigned generation;
+  };
+
+  class uORBTraceTest : public ::testing::Test
+  {
+   protected:
+    virtual void SetUp()
+    {
+      snprintf( _path, sizeof( _path ), "/tmp/uorb_trace_test_%d.json", (int)getpid() );
+    }
+
+    virtual void TearDown()
+    {
+      uORB::Trace::stop();
+      unlink( _path );
+    }
+
+    // dump the ring and parse the events back, one per line
+    bool dump( std::vector<TraceEvent> &events )
+    {
+      events.clear();
+      if( uORB::Trace::dump( _path ) != OK ) {
+        return false;
+      }
+
+      FILE *f = fopen( _path, "r" );
+      if( f == nullptr ) {
+        return false;
+      }
+
+      char line[256];
+      bool ok = fgets( line, sizeof( line ), f ) != nullptr && strcmp( line, "{\"traceEvents\":[\n" ) == 0;
+      while( ok && fgets( line, sizeof( line ), f ) != nullptr ) {
+        if( strcmp( line, "]}\n" ) == 0 || strcmp( line, "\n" ) == 0 ) {
+          continue;
+        }
+        char name[64], type[16];
+        TraceEvent e;
+        if( sscanf( line, "{\"name\":\"%63[^\"]\",\"cat\":\"%15[^\"]\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%llu,\"pid\":0,"
+                    "\"tid\":%llu,\"args\":{\"instance\":%u,\"generation\":%u}}",
+                    name, type, &e.ts, &e.tid, &e.instance, &e.generation ) != 6 ) {
+          ok = false;
+          break;
+        }
+        e.name = name;
+        e.type = type;
+        events.push_back( e );
+      }
+
+      fclose( f );
+      return ok;
+    }
+
+    char _path[64];
+  };
+
+  static void *record_thread( void *arg )
+  {
+    uORB::Trace::record( uORB::Trace::COPY, ORB_ID( topicB ), 1, 7 );
+    return nullptr;
+  }
+
+  TEST_F( uORBTraceTest, record_dump )
+  {
+    ASSERT_EQ( uORB::Trace::start( 16 ), OK );
+    ASSERT_EQ( uORB::Trace::start( 16 ), -EBUSY );
+
+    uORB::Trace::record( uORB::Trace::PUBLISH, ORB_ID( topicA ), 0, 1 );
+    pthread_t thread;
+    ASSERT_EQ( pthread_create( &thread, nullptr, record_thread, nullptr ), 0 );
+    pthread_join( thread, nullptr );
+    uORB::Trace::record( uORB::Trace::NOTIFY, ORB_ID( topicA ), 0, 1 );
+
+    std::vector<TraceEvent> events;
+    ASSERT_TRUE( dump( events ) );
+    ASSERT_EQ( events.size(), 3u );
+
+    EXPECT_EQ( events[0].name, "topicA" );
+    EXPECT_EQ( events[0].type, "publish" );
+    EXPECT_EQ( events[0].generation, 1u );
+    EXPECT_EQ( events[1].name, "topicB" );
+    EXPECT_EQ( events[1].type, "copy" );
+    EXPECT_EQ( events[1].instance, 1u );
+    EXPECT_EQ( events[1].generation, 7u );
+    EXPECT_EQ( events[2].type, "notify" );
+
+    // each thread has its own id, and time goes forward
+    EXPECT_EQ( events[0].tid, events[2].tid );
+    EXPECT_NE( events[0].tid, events[1].tid );
+    EXPECT_LE( events[0].ts, events[1].ts );
+    EXPECT_LE( events[1].ts, events[2].ts );
+
+    // nothing is recorded once stopped
+    uORB::Trace::record( uORB::Trace::PUBLISH, ORB_ID( topicA ), 0, 2 );
+    ASSERT_TRUE( dump( events ) );
+    ASSERT_EQ( events.size(), 3u );
+  }
+
+  TEST_F( uORBTraceTest, wrap_around )
+  {
+    // the size is rounded down to a power of two, the oldest events are overwritten
+    ASSERT_EQ( uORB::Trace::start( 10 ), OK );
+    for( unsigned i = 0; i < 20; i++ ) {
+      uORB::Trace::record( uORB::Trace::PUBLISH, ORB_ID( topicA ), 0, i );
+    }
+
+    std::vector<TraceEvent> events;
+    ASSERT_TRUE( dump( events ) );
+    ASSERT_EQ( events.size(), 8u );
+    for( unsigned i = 0; i < 8; i++ ) {
+      EXPECT_EQ( events[i].generation, 12 + i );
+    }
+  }
+
+  TEST_F( uORBTraceTest, resize )
+  {
+    // a restart with another size replaces the ring, a restart clears it
+    ASSERT_EQ( uORB::Trace::start( 4 ), OK );
+    for( unsigned i = 0; i < 4; i++ ) {
+      uORB::Trace::record( uORB::Trace::PUBLISH, ORB_ID( topicA ), 0, i );
+    }
+    uORB::Trace::stop();
+
+    ASSERT_EQ( uORB::Trace::start( 64 ), OK );
+    for( unsigned i = 0; i < 40; i++ ) {
+      uORB::Trace::record( uORB::Trace::PUBLISH, ORB_ID( topicA ), 0, i );
+    }
+
+    std::vector<TraceEvent> events;
+    ASSERT_TRUE( dump( events ) );
+    ASSERT_EQ( events.size(), 40u );
+    EXPECT_EQ( events[0].generation, 0u );
+    EXPECT_EQ( events[39].generation, 39u );
+
+    ASSERT_EQ( uORB::Trace::start( 2 ), OK );
+    uORB::Trace::record( uORB::Trace::PUBLISH, ORB_ID( topicA ), 0, 100 );
+    ASSERT_TRUE( dump( events ) );
+    ASSERT_EQ( events.size(), 1u );
+    EXPECT_EQ( events[0].generation, 100u );
+
+    ASSERT_EQ( uORB::Trace::start( 0 ), -EINVAL );
+  }
+}
@@ -0,0 +1,192 @@
+/*
+ * Threads, memory and context switches of modules following a topic,
+ * each in a task of its own or as work items on HPWORK.
+ *
+ * Linux only, reads /proc/self. Run without arguments for tasks and
+ * with -w for work items, each in a fresh process:
+ *
+ *   work_item_benchmark && work_item_benchmark -w
+ */
+
+#include <dirent.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <px4_posix.h>
+#include <px4_tasks.h>
+#include <px4_work_item.h>
+#include <uORB/uORB.h>
+#include <uORB/uORBDevices.hpp>
+
+namespace px4
+{
+void init_once();
+}
+
+struct work_item_benchmark_s {
+	uint64_t timestamp;
+	int32_t value;
+};
+
+ORB_DEFINE(work_item_benchmark, struct work_item_benchmark_s);
+
+static const unsigned modules = 3;
+static const unsigned samples = 1000;
+static const unsigned sample_interval_us = 1000;
+
+static volatile bool task_should_exit = false;
+
+static int module_task(int argc, char *argv[])
+{
+	int sub = orb_subscribe(ORB_ID(work_item_benchmark));
+	struct work_item_benchmark_s data;
+
+	px4_pollfd_struct_t fds[1];
+	fds[0].fd = sub;
+	fds[0].events = POLLIN;
+
+	while (!task_should_exit) {
+		if (px4_poll(&fds[0], 1, 100) > 0) {
+			orb_copy(ORB_ID(work_item_benchmark), sub, &data);
+		}
+	}
+
+	orb_unsubscribe(sub);
+	return 0;
+}
+
+class ModuleItem : public px4::ScheduledWorkItem
+{
+public:
+	ModuleItem() : ScheduledWorkItem("work_item_benchmark", HPWORK), _sub(-1) {}
+	~ModuleItem() { ScheduleClear(); }
+
+protected:
+	void Run()
+	{
+		struct work_item_benchmark_s data;
+
+		if (_sub < 0) {
+			_sub = orb_subscribe(ORB_ID(work_item_benchmark));
+		}
+
+		orb_copy(ORB_ID(work_item_benchmark), _sub, &data);
+	}
+
+private:
+	int _sub;
+};
+
+/* voluntary and involuntary context switches of all threads of the process */
+static long context_switches()
+{
+	long sum = 0;
+	DIR *dir = opendir("/proc/self/task");
+	struct dirent *entry;
+
+	while ((entry = readdir(dir)) != nullptr) {
+		if (entry->d_name[0] == '.') {
+			continue;
+		}
+
+		char path[32 + sizeof(entry->d_name)];
+		snprintf(path, sizeof(path), "/proc/self/task/%s/status", entry->d_name);
+		FILE *f = fopen(path, "r");
+
+		if (f == nullptr) {
+			continue;
+		}
+
+		char line[128];
+
+		while (fgets(line, sizeof(line), f) != nullptr) {
+			long value;
+
+			if (sscanf(line, "voluntary_ctxt_switches: %ld", &value) == 1 ||
+			    sscanf(line, "nonvoluntary_ctxt_switches: %ld", &value) == 1) {
+				sum += value;
+			}
+		}
+
+		fclose(f);
+	}
+
+	closedir(dir);
+	return sum;
+}
+
+/* a field of /proc/self/status, in kB or as a count */
+static long process_status(const char *field)
+{
+	FILE *f = fopen("/proc/self/status", "r");
+	char line[128];
+	long value = -1;
+
+	if (f == nullptr) {
+		return -1;
+	}
+
+	while (fgets(line, sizeof(line), f) != nullptr) {
+		if (strncmp(line, field, strlen(field)) == 0 && line[strlen(field)] == ':') {
+			sscanf(line + strlen(field) + 1, "%ld", &value);
+			break;
+		}
+	}
+
+	fclose(f);
+	return value;
+}
+
+int main(int argc, char *argv[])
+{
+	bool work_items = (argc > 1 && strcmp(argv[1], "-w") == 0);
+
+	px4::init_once();
+
+	uORB::DeviceMaster *master = new uORB::DeviceMaster(uORB::PUBSUB);
+	master->init();
+
+	struct work_item_benchmark_s data = {};
+	orb_advert_t pub = orb_advertise(ORB_ID(work_item_benchmark), &data);
+
+	long threads = process_status("Threads");
+	long vm_size = process_status("VmSize");
+	long vm_rss = process_status("VmRSS");
+
+	ModuleItem items[modules];
+
+	for (unsigned i = 0; i < modules; i++) {
+		if (work_items) {
+			items[i].ScheduleOnTopic(ORB_ID(work_item_benchmark));
+
+		} else {
+			px4_task_spawn_cmd("work_item_benchmark", SCHED_DEFAULT, SCHED_PRIORITY_MAX - 5, 2000, module_task, nullptr);
+		}
+	}
+
+	usleep(200000);
+
+	long switches = context_switches();
+
+	for (unsigned i = 0; i < samples; i++) {
+		data.value = i;
+		orb_publish(ORB_ID(work_item_benchmark), pub, &data);
+		usleep(sample_interval_us);
+	}
+
+	switches = context_switches() - switches;
+
+	printf("%u modules as %s, %u samples at %u us:\n", modules, work_items ? "work items" : "tasks", samples,
+	       sample_interval_us);
+	printf("  threads added:            %ld\n", process_status("Threads") - threads);
+	printf("  virtual memory added:     %ld kB\n", process_status("VmSize") - vm_size);
+	printf("  resident memory added:    %ld kB\n", process_status("VmRSS") - vm_rss);
+	printf("  context switches/sample:  %.1f\n", (double)switches / samples);
+	fflush(stdout);
+
+	/* the tasks are not joined, leave without running destructors under them */
+	task_should_exit = true;
+	usleep(200000);
+	_exit(0);
+}
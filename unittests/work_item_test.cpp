@@ -0,0 +1,181 @@
+#include <unistd.h>
+
+#include <px4_posix.h>
+#include <px4_work_item.h>
+#include <uORB/uORB.h>
+#include <uORB/uORBDevices.hpp>
+
+#include "gtest/gtest.h"
+
+namespace px4
+{
+void init_once();
+}
+
+struct work_item_test_s {
+	uint64_t timestamp;
+	int32_t value;
+};
+
+ORB_DEFINE(work_item_test, struct work_item_test_s);
+
+class CountingItem : public px4::ScheduledWorkItem
+{
+public:
+	CountingItem(int queue) :
+		ScheduledWorkItem("work_item_test", queue),
+		runs(0),
+		gate(nullptr)
+	{}
+
+	~CountingItem() { ScheduleClear(); }
+
+	volatile unsigned runs;
+
+	/* if set, every run blocks until the gate is posted */
+	px4_sem_t *volatile gate;
+
+protected:
+	void Run()
+	{
+		runs++;
+
+		if (gate != nullptr) {
+			while (px4_sem_wait(gate) != 0) {
+			}
+		}
+	}
+};
+
+class WorkItemTest : public ::testing::Test
+{
+public:
+	static void SetUpTestCase()
+	{
+		px4::init_once();
+
+		uORB::DeviceMaster *master = new uORB::DeviceMaster(uORB::PUBSUB);
+		master->init();
+
+		struct work_item_test_s data = {};
+		_pub = orb_advertise(ORB_ID(work_item_test), &data);
+	}
+
+	void publish(int count, unsigned spacing_us)
+	{
+		struct work_item_test_s data = {};
+
+		for (int i = 0; i < count; i++) {
+			data.value = i;
+			orb_publish(ORB_ID(work_item_test), _pub, &data);
+			usleep(spacing_us);
+		}
+	}
+
+	static orb_advert_t _pub;
+};
+
+orb_advert_t WorkItemTest::_pub = nullptr;
+
+TEST_F(WorkItemTest, Interval)
+{
+	CountingItem item(HPWORK);
+
+	ASSERT_EQ(OK, item.ScheduleOnInterval(10000));
+	usleep(205000);
+	item.ScheduleClear();
+
+	/* first run immediately, then every 10 ms without drifting */
+	ASSERT_GE(item.runs, 18u);
+	ASSERT_LE(item.runs, 22u);
+
+	unsigned runs = item.runs;
+	usleep(50000);
+	ASSERT_EQ(runs, item.runs);
+}
+
+TEST_F(WorkItemTest, TopicTrigger)
+{
+	CountingItem item(LPWORK);
+
+	ASSERT_EQ(OK, item.ScheduleOnTopic(ORB_ID(work_item_test)));
+
+	/* publishing queues the item directly */
+	unsigned runs = item.runs;
+
+	publish(20, 5000);
+	usleep(20000);
+
+	ASSERT_EQ(runs + 20, item.runs);
+
+	/* no more runs once the trigger is gone */
+	item.ScheduleTopicClear();
+	runs = item.runs;
+	publish(5, 5000);
+	usleep(20000);
+
+	ASSERT_EQ(runs, item.runs);
+}
+
+TEST_F(WorkItemTest, TopicInterval)
+{
+	CountingItem item(LPWORK);
+
+	ASSERT_EQ(OK, item.ScheduleOnTopic(ORB_ID(work_item_test), 0, 20));
+	unsigned runs = item.runs;
+
+	/* 50 ms of publications every 5 ms, runs at 0, 20 and 40 ms */
+	publish(10, 5000);
+	unsigned limited = item.runs - runs;
+
+	/* the publication within the last interval still gets its run */
+	usleep(30000);
+
+	ASSERT_GE(limited, 2u);
+	ASSERT_LE(limited, 3u);
+	ASSERT_EQ(runs + 4, item.runs);
+
+	item.ScheduleClear();
+}
+
+TEST_F(WorkItemTest, Coalesce)
+{
+	px4_sem_t gate;
+	px4_sem_init(&gate, 0, 0);
+
+	CountingItem item(LPWORK);
+
+	ASSERT_EQ(OK, item.ScheduleOnTopic(ORB_ID(work_item_test)));
+	usleep(100000);
+	unsigned runs = item.runs;
+	item.gate = &gate;
+
+	/* the first run blocks, everything published meanwhile needs only one more run */
+	publish(1, 10000);
+	publish(10, 1000);
+
+	px4_sem_post(&gate);
+	usleep(10000);
+	px4_sem_post(&gate);
+	usleep(10000);
+
+	ASSERT_EQ(runs + 2, item.runs);
+
+	item.gate = nullptr;
+	px4_sem_post(&gate);
+	item.ScheduleClear();
+	px4_sem_destroy(&gate);
+}
+
+TEST_F(WorkItemTest, Timeout)
+{
+	CountingItem item(HPWORK);
+
+	ASSERT_EQ(OK, item.ScheduleOnTopic(ORB_ID(work_item_test)));
+	item.ScheduleTimeout(20000);
+	usleep(205000);
+	item.ScheduleClear();
+
+	ASSERT_GE(item.runs, 7u);
+	ASSERT_LE(item.runs, 11u);
+}